@@ -71,6 +71,17 @@ namespace OpenMS
     void apply(std::vector<PeptideIdentification>& ids, 
                Size number_of_runs = 0);
 
+    /**
+        @brief Calculates the consensus IDs for many spectra or (consensus) features.
+
+        The results are the same as when calling apply() for every element of @p ids_list, but work can be shared between spectra/features and done in parallel (e.g. the computation of sequence similarities, see ConsensusIDAlgorithmSimilarity).
+
+        @param ids_list Peptide identifications of the individual spectra/features (input: more than one each, output: one each)
+        @param number_of_runs Number of ID runs for each element of @p ids_list (default/empty: size of the respective list of identifications)
+    */
+    void apply(const std::vector<std::vector<PeptideIdentification>*>& ids_list,
+               const std::vector<Size>& number_of_runs = std::vector<Size>());
+
     /// Virtual destructor
     ~ConsensusIDAlgorithm() override;
 
@@ -103,6 +114,13 @@ namespace OpenMS
     virtual void apply_(std::vector<PeptideIdentification>& ids,
                         SequenceGrouping& results) = 0;
 
+    /**
+       @brief Preparation for consensus computation on many spectra/features (may be reimplemented by subclasses).
+
+       Called by the batch version of apply() after the peptide identifications have been preprocessed (sorted, filtered, made unique), but before apply_() is called for the individual spectra/features. Implementations may do work in parallel, but must not modify @p ids_list. The default implementation does nothing.
+    */
+    virtual void prepare_(const std::vector<std::vector<PeptideIdentification>*>& ids_list);
+
     /// Docu in base class
     void updateMembers_() override;
 
@@ -111,6 +129,13 @@ namespace OpenMS
                               const AASequence& peptide);
 
   private:
+    /// Sort and filter the peptide hits of each ID run (the same for all algorithms)
+    void preprocessIDs_(std::vector<PeptideIdentification>& ids) const;
+
+    /// Compute the consensus for one spectrum/feature from preprocessed IDs
+    void computeConsensus_(std::vector<PeptideIdentification>& ids,
+                           Size number_of_runs);
+
    /// Not implemented
     ConsensusIDAlgorithm(const ConsensusIDAlgorithm&);
 
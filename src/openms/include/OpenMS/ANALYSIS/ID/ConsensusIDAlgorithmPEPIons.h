@@ -69,7 +69,8 @@ namespace OpenMS
     void updateMembers_() override;
 
     /// Sequence similarity based on matching ions
-    double getSimilarity_(AASequence seq1, AASequence seq2) override;
+    double computeSimilarity_(const AASequence& seq1,
+                              const AASequence& seq2) const override;
 
   };
 
@@ -168,12 +168,12 @@ namespace OpenMS
     /// SeqAn amino acid sequence
     typedef ::seqan::String< ::seqan::AminoAcid> SeqAnSequence;
 
+    /// SeqAn alignment data structure
+    typedef ::seqan::Align<SeqAnSequence, ::seqan::ArrayGaps> SeqAnAlignment;
+
     /// Similarity scoring method
     SeqAnScore scoring_method_;
 
-    /// Alignment data structure
-    ::seqan::Align<SeqAnSequence, ::seqan::ArrayGaps> alignment_;
-
     /// Not implemented
     ConsensusIDAlgorithmPEPMatrix(const ConsensusIDAlgorithmPEPMatrix&);
 
@@ -184,7 +184,8 @@ namespace OpenMS
     void updateMembers_() override;
 
     /// Sequence similarity based on substitution matrix (ignores PTMs)
-    double getSimilarity_(AASequence seq1, AASequence seq2) override;
+    double computeSimilarity_(const AASequence& seq1,
+                              const AASequence& seq2) const override;
 
   };
 
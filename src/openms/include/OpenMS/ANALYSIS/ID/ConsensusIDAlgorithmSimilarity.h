@@ -36,6 +36,8 @@
 
 #include <OpenMS/ANALYSIS/ID/ConsensusIDAlgorithm.h>
 
+#include <unordered_map>
+
 namespace OpenMS
 {
   /**
@@ -45,7 +47,9 @@ namespace OpenMS
 
     Nahnsen <em>et al.</em>: <a href="https://doi.org/10.1021/pr2002879">Probabilistic consensus scoring improves tandem mass spectrometry peptide identification</a> (J. Proteome Res., 2011, PMID: 21644507).
 
-    Derived classes should implement getSimilarity_(), which defines how similarity of two peptide sequences is quantified.
+    Derived classes should implement computeSimilarity_(), which defines how similarity of two peptide sequences is quantified.
+
+    Similarities are cached (across spectra/features), since the same peptide sequences tend to occur again and again. When consensus IDs for many spectra/features are computed at once (batch version of apply()), all required similarities are computed in parallel beforehand.
 
     @htmlinclude OpenMS_ConsensusIDAlgorithmSimilarity.parameters
     
@@ -58,20 +62,37 @@ namespace OpenMS
     /// Default constructor
     ConsensusIDAlgorithmSimilarity();
 
+    /// Hash function for pairs of peptide sequences
+    struct SequencePairHash
+    {
+      std::size_t operator()(const std::pair<AASequence, AASequence>& seqs) const
+      {
+        std::hash<AASequence> hasher;
+        std::size_t seed = hasher(seqs.first);
+        seed ^= hasher(seqs.second) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        return seed;
+      }
+    };
+
     /// Mapping: pair of peptide sequences -> sequence similarity
-    typedef std::map<std::pair<AASequence, AASequence>, double> SimilarityCache;
+    typedef std::unordered_map<std::pair<AASequence, AASequence>, double,
+                               SequencePairHash> SimilarityCache;
 
-    /// Cache for already computed sequence similarities
+    /// Cache for already computed sequence similarities (subclasses must clear it if parameters change)
     SimilarityCache similarities_;
 
     /**
        @brief Sequence similarity calculation (to be implemented by subclasses).
 
-       Implementations should use/update the cache of previously computed similarities.
+       The sequences are different and ordered (@p seq1 < @p seq2). This function may be called from several threads concurrently, so it must not modify the object.
 
        @return Similarity between two sequences in the range [0, 1]
     */
-    virtual double getSimilarity_(AASequence seq1, AASequence seq2) = 0;
+    virtual double computeSimilarity_(const AASequence& seq1,
+                                      const AASequence& seq2) const = 0;
+
+    /// Sequence similarity (uses/updates the cache of previously computed similarities)
+    double getSimilarity_(const AASequence& seq1, const AASequence& seq2);
 
   private:
     /// Not implemented
@@ -83,6 +104,10 @@ namespace OpenMS
     /// Consensus scoring
     void apply_(std::vector<PeptideIdentification>& ids,
                         SequenceGrouping& results) override;
+
+    /// Compute all similarities required for the consensus scoring (in parallel)
+    void prepare_(const std::vector<std::vector<PeptideIdentification>*>&
+                  ids_list) override;
   };
 
 } // namespace OpenMS
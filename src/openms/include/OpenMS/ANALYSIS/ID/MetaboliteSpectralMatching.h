@@ -159,14 +159,49 @@ namespace OpenMS
     ~MetaboliteSpectralMatching() override;
 
     /// hyperscore computation
-    double computeHyperScore(MSSpectrum, MSSpectrum, const double&, const double&);
+    double computeHyperScore(const MSSpectrum&, const MSSpectrum&, const double&, const double&) const;
 
-    /// main method of MetaboliteSpectralMatching
+    /**
+      @brief main method of MetaboliteSpectralMatching
+
+      The spectral library is sorted by precursor m/z and flattened once into
+      contiguous peak arrays, the query spectra are then searched in parallel
+      against it (without copying any spectrum per candidate).
+    */
     void run(PeakMap &, PeakMap &, MzTab &);
 
   protected:
     void updateMembers_() override;
 
+    /// Read-only view on the m/z sorted peaks of a spectrum stored in contiguous arrays
+    struct PeakArrayView_
+    {
+      const double* mz;
+      const float* intensity;
+      Size size;
+    };
+
+    /// Spectral library flattened into contiguous peak arrays (same order as the library)
+    struct LibraryIndex_
+    {
+      std::vector<double> precursor_mz;
+      std::vector<Int> precursor_charge;
+      /// peaks of spectrum i are stored at [peak_offset[i], peak_offset[i + 1])
+      std::vector<Size> peak_offset;
+      std::vector<double> peak_mz;
+      std::vector<float> peak_intensity;
+
+      /// view on the peaks of library spectrum @p i
+      PeakArrayView_ getPeaks(Size i) const;
+    };
+
+    /// flatten the (precursor m/z sorted) spectral library @p spec_db into @p index
+    void buildLibraryIndex_(const PeakMap& spec_db, LibraryIndex_& index) const;
+
+    /// hyperscore computation on peak array views (see computeHyperScore())
+    double computeHyperScore_(const PeakArrayView_& exp_peaks, const PeakArrayView_& db_peaks,
+                              const double& fragment_mass_error, const double& mz_lower_bound) const;
+
   private:
     /// private member functions
     void exportMzTab_(const std::vector<SpectralMatch>&, MzTab&);
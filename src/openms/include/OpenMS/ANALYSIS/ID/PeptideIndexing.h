@@ -49,6 +49,7 @@
 #include <OpenMS/METADATA/PeptideEvidence.h>
 #include <OpenMS/METADATA/PeptideIdentification.h>
 #include <OpenMS/METADATA/ProteinIdentification.h>
+#include <OpenMS/SYSTEM/Profiler.h>
 #include <OpenMS/SYSTEM/StopWatch.h>
 #include <OpenMS/SYSTEM/SysInfo.h>
 
@@ -188,6 +189,7 @@ public:
     template<typename T>
     ExitCodes run(FASTAContainer<T>& proteins, std::vector<ProteinIdentification>& prot_ids, std::vector<PeptideIdentification>& pep_ids)
     {
+      OPENMS_PROFILE_PHASE("PeptideIndexing");
       // no decoy string provided? try to deduce from data
       if (decoy_string_.empty())
       {
@@ -336,6 +338,8 @@ public:
         /*
            Aho Corasick (fast)
         */
+        OPENMS_PROFILE_PHASE("PeptideIndexing: Aho-Corasick search");
+        OPENMS_PROFILE_COUNTER("PeptideIndexing: peptides", length(pep_DB));
         LOG_INFO << "Searching with up to " << aaa_max_ << " ambiguous amino acid(s) and " << mm_max_ << " mismatch(es)!" << std::endl;
         SysInfo::MemUsage mu;
         LOG_INFO << "Building trie ...";
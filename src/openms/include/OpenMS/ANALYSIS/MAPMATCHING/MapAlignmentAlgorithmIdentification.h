@@ -43,6 +43,7 @@
 #include <OpenMS/KERNEL/FeatureMap.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/METADATA/PeptideIdentification.h>
+#include <OpenMS/SYSTEM/Profiler.h>
 
 #include <cmath> // for "abs"
 #include <limits> // for "max"
@@ -104,6 +105,7 @@ public:
                std::vector<TransformationDescription>& transformations,
                Int reference_index = -1)
     {
+      OPENMS_PROFILE_PHASE("MapAlignmentAlgorithmIdentification");
       checkParameters_(data.size());
       startProgress(0, 3, "aligning maps");
 
@@ -57,6 +57,11 @@ namespace OpenMS
     The affine transformation is then computed from this
     cluster of potential poses, hence the name pose clustering.
 
+    Only 'num_used_points' elements of each map are considered, selected by
+    intensity (optionally stratified by retention time, see 'point_selection'),
+    which bounds the number of hashed pairs of pairs independent of the map
+    size. The hashing is done in parallel if OpenMP is available.
+
     @sa PoseClusteringShiftSuperimposer
 
     @htmlinclude OpenMS_PoseClusteringAffineSuperimposer.parameters
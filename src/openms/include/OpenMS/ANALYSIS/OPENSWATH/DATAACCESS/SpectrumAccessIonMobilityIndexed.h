@@ -0,0 +1,151 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessOpenMSInMemory.h>
+
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+   * @brief An in-memory spectrum access with a two-dimensional (m/z, ion mobility) index
+   *
+   * For ion mobility enhanced DIA data (e.g. diaPASEF), each spectrum is a
+   * whole frame that carries a very large number of peaks, each of which has
+   * an m/z and an ion mobility value. Extracting a small m/z x ion mobility
+   * window from such a spectrum by walking through the m/z sorted peaks
+   * requires touching (and loading) the full frame.
+   *
+   * This class holds all data in memory (see SpectrumAccessOpenMSInMemory)
+   * and additionally builds a block index for every spectrum that carries an
+   * ion mobility array: the peaks are ordered by m/z and cut into blocks of
+   * (at most) @p block_size peaks, within each block the peaks are ordered by
+   * ion mobility. Each block stores its m/z and ion mobility range, so a
+   * window query only visits blocks that overlap the window in m/z and ion
+   * mobility and uses binary search on the ion mobility within each block.
+   * The extraction time thus scales with the size of the window and not with
+   * the size of the frame.
+   *
+   * The index stores the peak order, a copy of the ion mobility values and
+   * the block boundaries; m/z and intensity values are shared with the
+   * underlying in-memory spectra. Light clones share the index.
+   *
+   * All windows are open intervals, i.e. a peak is inside the window if
+   * mz_start < m/z < mz_end and im_start < ion mobility < im_end (which is
+   * consistent with ChromatogramExtractorAlgorithm and the drift time
+   * filtering in OpenSwathScoring).
+   *
+  */
+  class OPENMS_DLLAPI SpectrumAccessIonMobilityIndexed :
+    public SpectrumAccessOpenMSInMemory
+  {
+public:
+
+    /**
+     * @brief Constructor
+     *
+     * @param origin The spectrum access from which all data is loaded into memory
+     * @param block_size Maximal number of peaks per index block
+     *
+    */
+    explicit SpectrumAccessIonMobilityIndexed(OpenSwath::ISpectrumAccess & origin, Size block_size = 128);
+
+    /// Destructor
+    ~SpectrumAccessIonMobilityIndexed() override;
+
+    /// Copy constructor (only copies pointers, the index is shared)
+    SpectrumAccessIonMobilityIndexed(const SpectrumAccessIonMobilityIndexed & rhs);
+
+    /// Light clone operator (actual data will not get copied)
+    boost::shared_ptr<OpenSwath::ISpectrumAccess> lightClone() const override;
+
+    /// Whether the spectrum with the given id has an ion mobility index
+    bool hasIonMobilityIndex(int id) const;
+
+    /// Number of peaks of the spectrum with the given id
+    Size getNrPeaks(int id) const;
+
+    /**
+     * @brief Sum the intensities of all peaks within an m/z x ion mobility window
+     *
+     * @note The spectrum needs to have an ion mobility index (see hasIonMobilityIndex())
+     *
+    */
+    double integrateWindow(int id, double mz_start, double mz_end, double im_start, double im_end) const;
+
+    /**
+     * @brief Return all peaks within an m/z x ion mobility window
+     *
+     * The returned spectrum is sorted by m/z and carries an "Ion Mobility"
+     * data array. For spectra without an ion mobility index, the unfiltered
+     * spectrum is returned.
+     *
+    */
+    OpenSwath::SpectrumPtr getSpectrumByIdAndWindow(int id, double mz_start, double mz_end, double im_start, double im_end) const;
+
+protected:
+
+    /// Block index for a single spectrum
+    struct SpectrumIndex
+    {
+      /// peak indices, ordered by m/z block and by ion mobility within each block
+      std::vector<UInt32> order;
+      /// ion mobility values in the order given by @p order
+      std::vector<double> im;
+      /// start of each block in @p order (and one past the end of the last block)
+      std::vector<Size> block_begin;
+      /// m/z range of each block
+      std::vector<double> block_mz_min;
+      std::vector<double> block_mz_max;
+      /// ion mobility range of each block
+      std::vector<double> block_im_min;
+      std::vector<double> block_im_max;
+    };
+
+    /// Build the block index for a single spectrum
+    static void buildIndex_(const OpenSwath::Spectrum& spectrum, Size block_size, SpectrumIndex& index);
+
+    /// Call @p f with the peak index of every peak within the window
+    template <typename FunctionType>
+    void forEachPeakInWindow_(int id, double mz_start, double mz_end, double im_start, double im_end, FunctionType f) const;
+
+    /// one (possibly empty) index per spectrum
+    boost::shared_ptr<const std::vector<SpectrumIndex> > indices_;
+  };
+
+} //end namespace OpenMS
+
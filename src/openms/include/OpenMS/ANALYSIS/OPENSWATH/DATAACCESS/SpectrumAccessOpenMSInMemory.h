@@ -105,7 +105,7 @@ public:
 
     std::string getChromatogramNativeID(int id) const override;
 
-private:
+protected:
 
     std::vector< OpenSwath::SpectrumPtr > spectra_;
     std::vector< OpenSwath::SpectrumMeta > spectra_meta_;
@@ -170,7 +170,7 @@ protected:
       @brief Check whether fragment ion are unique ion signatures in vector within threshold and return matching peptidoforms
 
       @param fragment_ion the queried fragment ion
-      @param ions a vector of pairs of fragment ion m/z and peptide sequences which could interfere with fragment_ion
+      @param ions a vector of pairs of fragment ion m/z and peptide sequences which could interfere with fragment_ion, sorted by m/z
       @param mz_threshold the threshold within which to search for interferences
 
       @value a vector of strings containing all peptidoforms with which fragment_ion overlaps
@@ -270,7 +270,9 @@ protected:
     /**
       @brief Generate target in silico map
 
-      @details Used internally by MRMAssay::uisTransitions
+      @details Used internally by MRMAssay::uisTransitions. The ion series
+      of the peptidoforms are generated in parallel, the fragment ion vectors
+      of the resulting ion map are sorted by m/z.
 
     */
     void generateTargetInSilicoMap_(const OpenMS::TargetedExperiment& exp,
@@ -299,7 +301,9 @@ protected:
     /**
       @brief Generate decoy in silico map
 
-      @details Used internally by MRMAssay::uisTransitions
+      @details Used internally by MRMAssay::uisTransitions. The ion series
+      of the peptidoforms are generated in parallel, the fragment ion vectors
+      of the resulting ion map are sorted by m/z.
 
     */
     void generateDecoyInSilicoMap_(const OpenMS::TargetedExperiment& exp,
@@ -135,6 +135,10 @@ public:
                         TransformationDescription trafo, PeakMap& swath_map);
 
     /** @brief Pick features in one experiment containing chromatogram
+     *
+     * The transition groups are picked and scored in parallel (each thread
+     * uses its own picker and scorer), the output features are ordered by
+     * transition group as in the serial case.
      *
      * @param input The input chromatograms
      * @param output The output features with corresponding scores
@@ -207,6 +211,19 @@ public:
     void setMS1Map(OpenSwath::SpectrumAccessPtr ms1_map)
     {
       ms1_map_ = ms1_map;
+      spectrum_cache_->clear();
+    }
+
+    /** @brief Returns the cache of added-up spectra used for full-spectrum scoring
+     *
+     * The cache is shared by all peak groups scored by this object and
+     * allows to query its hit rate. Its size is bounded (see
+     * OpenSwath_Spectrum_Cache::setCapacity).
+     *
+    */
+    OpenSwath_Spectrum_Cache& getSpectrumCache()
+    {
+      return *spectrum_cache_;
     }
 
     /** @brief Map the chromatograms to the transitions.
@@ -309,6 +326,7 @@ private:
 
     // data
     OpenSwath::SpectrumAccessPtr ms1_map_;
+    boost::shared_ptr<OpenSwath_Spectrum_Cache> spectrum_cache_;
 
   };
 }
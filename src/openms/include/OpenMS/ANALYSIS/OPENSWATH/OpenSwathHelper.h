@@ -125,6 +125,39 @@ public:
                                        double min_upper_edge_dist,
                                        double lower, double upper);
 
+    /**
+      @brief Select transitions between lower and upper, returning only their indices
+
+      Selects the same transitions and compounds as selectSwathTransitions(),
+      but stores their (ascending) indices in @p targeted_exp. Use
+      selectTransitions() to create the selected experiment later on.
+
+      @param[in] targeted_exp Transition list for selection
+      @param[out] transition_indices Indices of the selected transitions
+      @param[out] compound_indices Indices of the compounds of the selected transitions
+      @param[in] min_upper_edge_dist Distance in Th to the upper edge
+      @param[in] lower Lower edge of SWATH window (in Th)
+      @param[in] upper Upper edge of SWATH window (in Th)
+    */
+    static void selectSwathTransitionIndices(const OpenSwath::LightTargetedExperiment& targeted_exp,
+                                             std::vector<Size>& transition_indices,
+                                             std::vector<Size>& compound_indices,
+                                             double min_upper_edge_dist,
+                                             double lower, double upper);
+
+    /**
+      @brief Adds the transitions and compounds selected by selectSwathTransitionIndices() (and their proteins)
+
+      @param[in] targeted_exp Transition list the indices refer to
+      @param[in] transition_indices Indices of the selected transitions
+      @param[in] compound_indices Indices of the selected compounds
+      @param[out] selected_transitions Selected transitions
+    */
+    static void selectTransitions(const OpenSwath::LightTargetedExperiment& targeted_exp,
+                                  const std::vector<Size>& transition_indices,
+                                  const std::vector<Size>& compound_indices,
+                                  OpenSwath::LightTargetedExperiment& selected_transitions);
+
     /**
       @brief Get the lower / upper offset for this SWATH map and do some sanity checks
 
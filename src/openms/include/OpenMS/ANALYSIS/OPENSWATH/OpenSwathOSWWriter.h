@@ -44,6 +44,8 @@
 #include <sqlite3.h>
 
 #include <fstream>
+#include <map>
+#include <utility>
 
 namespace OpenMS
 {
@@ -54,6 +56,15 @@ namespace OpenMS
    * The class can take a FeatureMap and create a set of string from it
    * suitable for output to OSW using the prepareLine function.
    *
+   * If checkpointing is enabled (see setCheckpointing()), the completed units
+   * of work (batches of compounds of a SWATH window) are recorded in a
+   * CHECKPOINT table, in the same transaction as their features. A run that
+   * was interrupted can then be resumed on the same output file and skips
+   * all units that were recorded (see isCheckpointed()). The checksums of
+   * the library, the input and the parameters (see setCheckpointSources())
+   * as well as the scoring flags are stored alongside in a CHECKPOINT_META table and need to
+   * match when resuming.
+   *
    */
   class OPENMS_DLLAPI OpenSwathOSWWriter
   {
@@ -64,6 +75,12 @@ namespace OpenMS
     bool use_ms1_traces_;
     bool sonar_;
     bool enable_uis_scoring_;
+    bool checkpointing_;
+    String library_checksum_;
+    String input_checksum_;
+    String parameter_checksum_;
+    /// completed units of a resumed run: (SWATH window, batch) -> (batch size, number of compounds)
+    std::map<std::pair<Size, Size>, std::pair<Size, Size> > checkpoints_;
 
   public:
 
@@ -78,7 +95,8 @@ namespace OpenMS
       doWrite_(!output_filename.empty()),
       use_ms1_traces_(ms1_scores),
       sonar_(sonar),
-      enable_uis_scoring_(uis_scores)
+      enable_uis_scoring_(uis_scores),
+      checkpointing_(false)
       {}
 
     static int callback(void * /* NotUsed */, int argc, char **argv, char **azColName)
@@ -97,9 +115,107 @@ namespace OpenMS
       return doWrite_;
     }
 
+    /**
+     * @brief Enables checkpointing, i.e. resumable runs
+     *
+     * Needs to be set before writeHeader() is called. If the output file
+     * already contains the results of a run with checkpointing enabled,
+     * writeHeader() continues this run (and its run identifier) instead of
+     * creating the tables.
+     *
+     */
+    void setCheckpointing(bool checkpointing)
+    {
+      checkpointing_ = checkpointing;
+    }
+
+    /**
+     * @brief Sets the checksums of the sources of a checkpointed run
+     *
+     * Needs to be set before writeHeader() is called. The checksums are
+     * recorded with a new run and compared when resuming a run, so that an
+     * output file is not continued with a different library, input or
+     * configuration (e.g. the content of a file changed while its name
+     * stayed the same, or an extraction window was changed).
+     *
+     * @param library_checksum Checksum of the transition library
+     * @param input_checksum Checksum of the input file(s)
+     * @param parameter_checksum Checksum of the parameters that influence the results
+     *
+     */
+    void setCheckpointSources(const String& library_checksum, const String& input_checksum, const String& parameter_checksum)
+    {
+      library_checksum_ = library_checksum;
+      input_checksum_ = input_checksum;
+      parameter_checksum_ = parameter_checksum;
+    }
+
+    /// Whether the completed units of work are recorded (see setCheckpointing())
+    bool isCheckpointing() const
+    {
+      return doWrite_ && checkpointing_;
+    }
+
+    /**
+     * @brief Whether a unit of work was completed by a previous (interrupted) run
+     *
+     * @param swath_window The index of the SWATH window
+     * @param batch The index of the batch of compounds within the window
+     * @param batch_size The number of compounds per batch
+     * @param nr_compounds The number of compounds in this batch
+     *
+     * @exception Exception::IllegalArgument is thrown if the unit was recorded
+     * with a different batch size or number of compounds (i.e. the library or
+     * the parameters changed since, resuming would mix different batches)
+     *
+     */
+    bool isCheckpointed(Size swath_window, Size batch, Size batch_size, Size nr_compounds) const
+    {
+      std::map<std::pair<Size, Size>, std::pair<Size, Size> >::const_iterator it =
+        checkpoints_.find(std::make_pair(swath_window, batch));
+      if (it == checkpoints_.end())
+      {
+        return false;
+      }
+      if (it->second != std::make_pair(batch_size, nr_compounds))
+      {
+        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+            "Cannot resume from " + output_filename_ + ": batch " + String(batch) + " of SWATH window " +
+            String(swath_window) + " was written with a different batch size or number of compounds.");
+      }
+      return true;
+    }
+
+    /// Returns the number of units of work that were completed by a previous run
+    Size getNumberOfCheckpoints() const
+    {
+      return checkpoints_.size();
+    }
+
+    /**
+     * @brief Prepare the record of a completed unit of work
+     *
+     * The statement needs to be written together with the features of the
+     * unit (using a single call to writeLines), so that both are stored in the
+     * same transaction.
+     *
+     * @returns A string to be written using writeLines
+     *
+     */
+    String prepareCheckpoint(Size swath_window, Size batch, Size batch_size, Size nr_compounds) const
+    {
+      std::stringstream sql;
+      sql << "INSERT INTO CHECKPOINT (SWATH_WINDOW, BATCH, BATCH_SIZE, NR_COMPOUNDS) VALUES ("
+          << swath_window << ", " << batch << ", " << batch_size << ", " << nr_compounds << "); ";
+      return sql.str();
+    }
+
     /**
      * @brief Initializes file by generating SQLite tables
      *
+     * The tables and the run are created in a single transaction, an
+     * interrupted call does not leave a partially initialized file behind.
+     *
      */
     void writeHeader()
     {
@@ -114,8 +230,16 @@ namespace OpenMS
         fprintf(stderr, "Can't open database: %s\n", sqlite3_errmsg(db));
       }
 
+      // Continue a previous run if checkpointing is enabled
+      checkpoints_.clear();
+      if (checkpointing_ && resumeRun_(db))
+      {
+        sqlite3_close(db);
+        return;
+      }
+
       // Create SQL structure
-      const char * create_sql =
+      std::string create_sql =
         "CREATE TABLE RUN(" \
         "ID INT PRIMARY KEY NOT NULL," \
         "FILENAME TEXT NOT NULL); " \
@@ -211,14 +335,25 @@ namespace OpenMS
         "VAR_ISOTOPE_OVERLAP_SCORE REAL NULL); " ;
 
 
-      // Execute SQL create statement
-      rc = sqlite3_exec(db, create_sql, callback, nullptr, &zErrMsg);
-      if( rc != SQLITE_OK )
+      if (checkpointing_)
       {
-        std::string error_message = zErrMsg;
-        sqlite3_free(zErrMsg);
-        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-            error_message);
+        create_sql +=
+          "CREATE TABLE CHECKPOINT(" \
+          "SWATH_WINDOW INT NOT NULL," \
+          "BATCH INT NOT NULL," \
+          "BATCH_SIZE INT NOT NULL," \
+          "NR_COMPOUNDS INT NOT NULL," \
+          "PRIMARY KEY (SWATH_WINDOW, BATCH)); " \
+
+          "CREATE TABLE CHECKPOINT_META(" \
+          "KEY TEXT PRIMARY KEY NOT NULL," \
+          "VALUE TEXT NOT NULL); ";
+
+        std::map<String, String> meta = checkpointMeta_();
+        for (std::map<String, String>::const_iterator it = meta.begin(); it != meta.end(); ++it)
+        {
+          create_sql += "INSERT INTO CHECKPOINT_META (KEY, VALUE) VALUES ('" + it->first + "', '" + it->second + "'); ";
+        }
       }
 
       // Insert run_id information
@@ -226,16 +361,21 @@ namespace OpenMS
       sql_run << "INSERT INTO RUN (ID, FILENAME) VALUES ("
               << *(int64_t*)&run_id_ << ", '" // Conversion from UInt64 to int64_t to support SQLite
               << input_filename_ << "'); ";
+      create_sql += sql_run.str();
 
-      // Execute SQL insert statement
-      rc = sqlite3_exec(db, sql_run.str().c_str(), callback, nullptr, &zErrMsg);
+      // Execute SQL create and insert statements in one transaction
+      sqlite3_exec(db, "BEGIN TRANSACTION", nullptr, nullptr, nullptr);
+      rc = sqlite3_exec(db, create_sql.c_str(), callback, nullptr, &zErrMsg);
       if( rc != SQLITE_OK )
       {
         std::string error_message = zErrMsg;
         sqlite3_free(zErrMsg);
+        sqlite3_exec(db, "ROLLBACK TRANSACTION", nullptr, nullptr, nullptr);
+        sqlite3_close(db);
         throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
             error_message);
       }
+      sqlite3_exec(db, "END TRANSACTION", nullptr, nullptr, nullptr);
 
       sqlite3_close(db);
     }
@@ -569,6 +709,107 @@ namespace OpenMS
       sqlite3_close(db);
     }
 
+  protected:
+
+    /**
+     * @brief Reads run identifier and completed units of a previous run
+     *
+     * @returns false if the database does not contain results yet
+     *
+     * @exception Exception::IllegalArgument is thrown if the results were
+     * written without checkpointing, for a different input file, library or
+     * with different scoring flags
+     *
+     */
+    bool resumeRun_(sqlite3 * db)
+    {
+      sqlite3_stmt * stmt;
+      sqlite3_prepare(db, "SELECT name FROM sqlite_master WHERE type='table' AND name IN ('RUN', 'CHECKPOINT');", -1, &stmt, nullptr);
+      bool has_run = false, has_checkpoint = false;
+      while (sqlite3_step(stmt) == SQLITE_ROW)
+      {
+        const String name(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)));
+        has_run = has_run || name == "RUN";
+        has_checkpoint = has_checkpoint || name == "CHECKPOINT";
+      }
+      sqlite3_finalize(stmt);
+
+      if (!has_run)
+      {
+        return false;
+      }
+      if (!has_checkpoint)
+      {
+        sqlite3_close(db);
+        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+            "Cannot resume from " + output_filename_ + ": the file contains results which were not written in checkpoint mode.");
+      }
+
+      // continue with the identifier of the previous run
+      sqlite3_prepare(db, "SELECT ID, FILENAME FROM RUN;", -1, &stmt, nullptr);
+      if (sqlite3_step(stmt) == SQLITE_ROW)
+      {
+        int64_t run_id = sqlite3_column_int64(stmt, 0);
+        run_id_ = *(UInt64*)&run_id; // Conversion from int64_t (SQLite) to UInt64
+        const String filename(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1)));
+        if (filename != input_filename_)
+        {
+          sqlite3_finalize(stmt);
+          sqlite3_close(db);
+          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+              "Cannot resume from " + output_filename_ + ": the results were computed from " + filename +
+              " instead of " + input_filename_ + ".");
+        }
+      }
+      sqlite3_finalize(stmt);
+
+      // the sources and scoring flags need to be the same as in the previous run
+      std::map<String, String> meta;
+      if (sqlite3_prepare(db, "SELECT KEY, VALUE FROM CHECKPOINT_META;", -1, &stmt, nullptr) == SQLITE_OK)
+      {
+        while (sqlite3_step(stmt) == SQLITE_ROW)
+        {
+          meta[reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0))] = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+        }
+      }
+      sqlite3_finalize(stmt);
+
+      std::map<String, String> expected = checkpointMeta_();
+      for (std::map<String, String>::const_iterator it = expected.begin(); it != expected.end(); ++it)
+      {
+        std::map<String, String>::const_iterator found = meta.find(it->first);
+        if (found == meta.end() || found->second != it->second)
+        {
+          sqlite3_close(db);
+          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+              "Cannot resume from " + output_filename_ + ": " + it->first + " of the previous run (" +
+              (found == meta.end() ? String("unknown") : found->second) + ") differs from the current one (" + it->second + ").");
+        }
+      }
+
+      sqlite3_prepare(db, "SELECT SWATH_WINDOW, BATCH, BATCH_SIZE, NR_COMPOUNDS FROM CHECKPOINT;", -1, &stmt, nullptr);
+      while (sqlite3_step(stmt) == SQLITE_ROW)
+      {
+        checkpoints_[std::make_pair(Size(sqlite3_column_int64(stmt, 0)), Size(sqlite3_column_int64(stmt, 1)))] =
+          std::make_pair(Size(sqlite3_column_int64(stmt, 2)), Size(sqlite3_column_int64(stmt, 3)));
+      }
+      sqlite3_finalize(stmt);
+      return true;
+    }
+
+    /// The sources and scoring flags of a checkpointed run (stored in CHECKPOINT_META)
+    std::map<String, String> checkpointMeta_() const
+    {
+      std::map<String, String> meta;
+      meta["LIBRARY_CHECKSUM"] = library_checksum_;
+      meta["INPUT_CHECKSUM"] = input_checksum_;
+      meta["PARAMETER_CHECKSUM"] = parameter_checksum_;
+      meta["USE_MS1_TRACES"] = String(int(use_ms1_traces_));
+      meta["ENABLE_UIS_SCORING"] = String(int(enable_uis_scoring_));
+      meta["SONAR"] = String(int(sonar_));
+      return meta;
+    }
+
   };
 
 }
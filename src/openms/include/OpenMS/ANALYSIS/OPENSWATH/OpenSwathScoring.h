@@ -44,6 +44,9 @@
 // scoring
 #include <OpenMS/ANALYSIS/OPENSWATH/DIAScoring.h>
 
+#include <list>
+#include <map>
+#include <tuple>
 #include <vector>
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
@@ -479,6 +482,69 @@ var_yseries_score   -0.0327896378737766
 
   };
 
+  /** @brief A cache for summed (and resampled) spectra used in full-spectrum scoring
+   *
+   * Many peak groups within one SWATH window share the same apex retention
+   * time and thus the same spectrum (or set of added-up spectra). This cache
+   * stores the result of OpenSwathScoring::fetchSpectrumSwath keyed by the
+   * map, the index of the spectrum closest to the apex, the number of
+   * spectra added up and the drift time range so that it can be reused
+   * across DIA, precursor and identification (IPF) scoring.
+   *
+   * Maps are identified by their spectrum access pointer. The cache holds a
+   * reference to each map it contains spectra of, so a map cannot be
+   * replaced by a different one at the same address while it is cached. At
+   * most getCapacity() spectra are kept, the least recently used ones are
+   * removed first.
+   *
+   * The cache is not thread-safe, each thread needs to hold its own
+   * instance.
+   *
+  */
+  struct OPENMS_DLLAPI OpenSwath_Spectrum_Cache
+  {
+    /// map, closest spectrum index, number of spectra to add, lower and upper drift time
+    typedef std::tuple<OpenSwath::SpectrumAccessPtr, int, int, double, double> KeyType;
+
+    Size hits;
+    Size misses;
+
+    /// Constructor, keeps at most @p capacity spectra
+    explicit OpenSwath_Spectrum_Cache(Size capacity = 256);
+
+    /// Returns the spectrum stored for @p key (and counts a hit) or an empty pointer (and counts a miss)
+    OpenSwath::SpectrumPtr get(const KeyType& key);
+
+    /// Stores @p spectrum for @p key, removing the least recently used spectrum if the cache is full
+    void insert(const KeyType& key, const OpenSwath::SpectrumPtr& spectrum);
+
+    /// Number of cached spectra
+    Size size() const;
+
+    /// Maximal number of cached spectra
+    Size getCapacity() const;
+
+    /// Sets the maximal number of cached spectra (removing the least recently used ones if necessary)
+    void setCapacity(Size capacity);
+
+    /// Removes all cached spectra and resets the hit/miss counters
+    void clear();
+
+    /// Fraction of lookups that were answered from the cache (0 if no lookup was performed)
+    double getHitRate() const;
+
+protected:
+    /// cached spectra, most recently used first
+    typedef std::list<std::pair<KeyType, OpenSwath::SpectrumPtr> > EntryList;
+
+    /// removes the least recently used spectra until at most capacity_ remain
+    void evict_();
+
+    Size capacity_;
+    EntryList entries_;
+    std::map<KeyType, EntryList::iterator> index_;
+  };
+
   /** @brief A class that calls the scoring routines
    *
    * Use this class to invoke the individual OpenSWATH scoring routines.
@@ -493,6 +559,7 @@ var_yseries_score   -0.0327896378737766
     int add_up_spectra_;
     double spacing_for_spectra_resampling_;
     OpenSwath_Scores_Usage su_;
+    boost::shared_ptr<OpenSwath_Spectrum_Cache> spectrum_cache_;
 
   public:
 
@@ -517,6 +584,20 @@ var_yseries_score   -0.0327896378737766
                     double spacing_for_spectra_resampling,
                     const OpenSwath_Scores_Usage & su);
 
+    /** @brief Set a cache for the spectra retrieved by fetchSpectrumSwath
+     *
+     * If set, added-up spectra are looked up in (and stored to) the cache
+     * instead of being recomputed for every peak group. The cache may be
+     * shared between several scoring objects of the same thread.
+     *
+     * @param cache The cache to use (a null pointer disables caching)
+     *
+    */
+    void setSpectrumCache(const boost::shared_ptr<OpenSwath_Spectrum_Cache>& cache);
+
+    /// Returns the spectrum cache (may be a null pointer)
+    const boost::shared_ptr<OpenSwath_Spectrum_Cache>& getSpectrumCache() const;
+
     /** @brief Score a single peakgroup in a chromatogram using only chromatographic properties.
      *
      * This function only uses the chromatographic properties (coelution,
@@ -605,7 +686,7 @@ var_yseries_score   -0.0327896378737766
     */
     void calculateDIAScores(OpenSwath::IMRMFeature* imrmfeature, 
         const std::vector<TransitionType> & transitions,
-        std::vector<OpenSwath::SwathMap> swath_maps,
+        const std::vector<OpenSwath::SwathMap>& swath_maps,
         OpenSwath::SpectrumAccessPtr ms1_map,
         OpenMS::DIAScoring & diascoring,
         const CompoundType& compound,
@@ -644,7 +725,7 @@ var_yseries_score   -0.0327896378737766
     */
     void calculateDIAIdScores(OpenSwath::IMRMFeature* imrmfeature,
         const TransitionType & transition,
-        const std::vector<OpenSwath::SwathMap> swath_maps,
+        const std::vector<OpenSwath::SwathMap>& swath_maps,
         OpenMS::DIAScoring & diascoring,
         OpenSwath_Scores & scores,
         double drift_lower, double drift_upper);
@@ -674,7 +755,7 @@ var_yseries_score   -0.0327896378737766
      * @return Added up spectrum
      *
     */
-    OpenSwath::SpectrumPtr fetchSpectrumSwath(std::vector<OpenSwath::SwathMap> swath_maps,
+    OpenSwath::SpectrumPtr fetchSpectrumSwath(const std::vector<OpenSwath::SwathMap>& swath_maps,
                                               double RT, int nr_spectra_to_add, const double, const double);
     OpenSwath::SpectrumPtr fetchSpectrumSwath(OpenSwath::SpectrumAccessPtr swath_map,
                                               double RT, int nr_spectra_to_add, const double, const double);
@@ -47,6 +47,7 @@
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessOpenMS.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessTransforming.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessOpenMSInMemory.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessIonMobilityIndexed.h>
 #include <OpenMS/OPENSWATHALGO/DATAACCESS/SwathMap.h>
 
 // Helpers
@@ -118,13 +119,9 @@ protected:
     /** @brief Constructor
      *
      *  @param use_ms1_traces Whether to use MS1 data
-     *  @param threads_outer_loop How many threads should be used for the outer
-     *  loop (-1 will use all threads in the outer loop)
-     *
-     *  @note The total number of threads should be divisible by this number
-     *  (e.g. use 8 in outer loop if you have 24 threads in total and 3 will be
-     *  used for the inner loop).
-     *
+     *  @param threads_outer_loop How many SWATH windows may be processed (and
+     *  held in memory) at the same time (-1 will only be limited by the number
+     *  of threads)
      *
      **/
     OpenSwathWorkflowBase(bool use_ms1_traces, bool use_ms1_ion_mobility, int threads_outer_loop) :
@@ -182,6 +179,20 @@ protected:
                                        const bool ms1 = false,
                                        const int ms1_isotopes = -1) const;
 
+    /** @brief Load a map into memory
+     *
+     * Creates an in-memory copy of the map (see SpectrumAccessOpenMSInMemory).
+     * If ion mobility extraction is requested in @p cp, the copy additionally
+     * carries an (m/z, ion mobility) block index (see
+     * SpectrumAccessIonMobilityIndexed) so that extraction and scoring only
+     * touch the relevant parts of each frame.
+     *
+     * @param map The map to load into memory
+     * @param cp Parameter set for the chromatogram extraction
+     *
+    */
+    static OpenSwath::SpectrumAccessPtr loadIntoMemory_(const OpenSwath::SpectrumAccessPtr& map, const ChromExtractParams & cp);
+
 
     /**
      * @brief Spectrum Access to the MS1 map (note that this is *not* threadsafe!)
@@ -198,13 +209,12 @@ protected:
     /// Whether to use ion mobility extraction on MS1 traces
     bool use_ms1_ion_mobility_;
 
-    /** @brief How many threads should be used for the outer loop
+    /** @brief How many SWATH windows may be processed at the same time
      *
-     *  @note A value of -1 will use all threads in the outer loop
+     *  All threads work on batches of the windows being processed, this only
+     *  bounds the memory used for them (e.g. when loading the windows into memory).
      *
-     *  @note The total number of threads should be divisible by this number
-     *  (e.g. use 8 in outer loop if you have 24 threads in total and 3 will be
-     *  used for the inner loop).
+     *  @note A value of -1 will only be limited by the number of threads
      *
      **/
     int threads_outer_loop_;
@@ -365,9 +375,12 @@ protected:
    *
    *    - Obtain precursor ion chromatograms (if enabled) through MS1Extraction_()
    *    - Perform scoring of precursor ion chromatograms if no MS2 is given
-   *    - Iterate through each SWATH-MS window:
-   *      - Select which transitions to extract (proceed in batches) using OpenSwathHelper::selectSwathTransitions()
-   *      - Iterate through each batch of transitions:
+   *    - Split the work into tasks of one batch of transitions of one SWATH-MS window,
+   *      which all threads process in order (no nested parallelism, windows of
+   *      different size are balanced automatically):
+   *      - Select which transitions to extract using OpenSwathHelper::selectSwathTransitions()
+   *        (done by the first task of a window, the last task releases the window)
+   *      - For each batch of transitions:
    *        - Extract current batch of transitions from current SWATH window:
    *          - Select transitions for current batch (see selectCompoundsForBatch_())
    *          - Prepare transition extraction (see prepareExtractionCoordinates_())
@@ -388,17 +401,15 @@ protected:
     /** @brief Constructor
      *
      *  @param use_ms1_traces Whether to use MS1 data
-     *  @param threads_outer_loop How many threads should be used for the outer
-     *  loop (-1 will use all threads in the outer loop)
-     *
-     *  @note The total number of threads should be divisible by this number
-     *  (e.g. use 8 in outer loop if you have 24 threads in total and 3 will be
-     *  used for the inner loop).
-     *
+     *  @param threads_outer_loop How many SWATH windows may be processed (and
+     *  held in memory) at the same time (-1 will only be limited by the number
+     *  of threads)
      *
      **/
     OpenSwathWorkflow(bool use_ms1_traces, bool use_ms1_ion_mobility, int threads_outer_loop) :
-      OpenSwathWorkflowBase(use_ms1_traces, use_ms1_ion_mobility, threads_outer_loop)
+      OpenSwathWorkflowBase(use_ms1_traces, use_ms1_ion_mobility, threads_outer_loop),
+      spectrum_cache_hits_(0),
+      spectrum_cache_misses_(0)
     {
     }
 
@@ -426,6 +437,11 @@ protected:
      * potentially decrease the utility of parallelization while loading data
      * into memory will increase memory usage but decrease execution time.
      *
+     * @note If checkpointing is enabled in \p result_osw (see
+     * OpenSwathOSWWriter::setCheckpointing), each completed batch is recorded
+     * together with its features and the batches recorded by a previous,
+     * interrupted run are skipped.
+     *
     */
     void performExtraction(const std::vector< OpenSwath::SwathMap > & swath_maps,
                            const TransformationDescription trafo,
@@ -499,6 +515,8 @@ protected:
      * @param tsv_writer TSV writer for storing output (on the fly)
      * @param osw_writer OSW Writer object to store identified features in SQLite format
      * @param ms1only If true, will only score on MS1 level and ignore MS2 level
+     * @param osw_checkpoint Statement recording the completed unit of work
+     * (see OpenSwathOSWWriter::prepareCheckpoint), written together with the features
      *
     */
     void scoreAllChromatograms_(
@@ -513,7 +531,8 @@ protected:
         OpenSwathTSVWriter & tsv_writer,
         OpenSwathOSWWriter & osw_writer,
         int nr_ms1_isotopes = 0,
-        bool ms1only = false) const;
+        bool ms1only = false,
+        const String& osw_checkpoint = "") const;
 
     /** @brief Select which compounds to analyze in the next batch (and copy to output)
      *
@@ -547,6 +566,13 @@ protected:
       const std::vector<OpenSwath::LightTransition>& all_transitions,
       std::vector<OpenSwath::LightTransition>& output);
 
+    /// Logs the hit rate of the spectrum caches used in scoreAllChromatograms_() and resets the counters
+    void logSpectrumCacheStatistics_();
+
+    /// Spectrum cache hits and misses of all batches scored so far (see OpenSwath_Spectrum_Cache)
+    mutable Size spectrum_cache_hits_;
+    mutable Size spectrum_cache_misses_;
+
   };
 
   /**
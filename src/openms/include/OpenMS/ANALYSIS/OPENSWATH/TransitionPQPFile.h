@@ -69,6 +69,17 @@ private:
     */
     void readPQPInput_(const char* filename, std::vector<TSVTransition>& transition_list, bool legacy_traml_id = false);
 
+    /** @brief Read PQP SQLite file in chunks
+     *
+     * @param filename The input file
+     * @param process_chunk Callback for each chunk of transitions
+     * @param legacy_traml_id Should legacy TraML IDs be used (boolean)?
+     * @param chunk_size Number of transitions per chunk
+     *
+    */
+    void readPQPInput_(const char* filename, const std::function<void(std::vector<TSVTransition>&)>& process_chunk,
+                       bool legacy_traml_id = false, Size chunk_size = 100000);
+
     /** @brief Write a TargetedExperiment to a file
      *
      * @param filename Name of the output file
@@ -76,6 +87,15 @@ private:
     */
     void writePQPOutput_(const char* filename, OpenMS::TargetedExperiment& targeted_exp);
 
+    /** @brief Convert a tsv/mrm file to a PQP file chunk by chunk
+     *
+     * @param tsv_filename The input file
+     * @param filetype The type of the input file ("mrm" or "tsv")
+     * @param pqp_filename The output file
+     * @param chunk_size Number of transitions per chunk (and transaction)
+    */
+    void streamTSVToPQP_(const char* tsv_filename, FileTypes::Type filetype, const char* pqp_filename, Size chunk_size);
+
 public:
 
     //@{
@@ -112,6 +132,31 @@ public:
     */
     void convertPQPToTargetedExperiment(const char* filename, OpenSwath::LightTargetedExperiment& targeted_exp, bool legacy_traml_id = false);
 
+    /** @brief Read in a tsv/mrm file and write it directly to a PQP file
+     *
+     * The transition list is parsed in parallel and written in chunks (one
+     * transaction per chunk), neither the full transition list nor a
+     * TargetedExperiment is ever kept in memory; only the identifiers of
+     * proteins, peptides and precursors are. The content is the same as
+     * when converting through a TargetedExperiment, but the database
+     * identifiers are assigned in order of appearance in the input.
+     *
+     * The input is validated like TransitionTSVFile::validateTargetedExperiment
+     * does for a TargetedExperiment: duplicate transition identifiers and
+     * transition groups mixing peptides and compounds are rejected. Since
+     * proteins, peptides and compounds are derived from the transitions,
+     * no other invalid reference can occur.
+     *
+     * @param tsv_filename The input file
+     * @param filetype The type of the input file ("mrm" or "tsv")
+     * @param pqp_filename The output file (removed again if the conversion fails)
+     * @param chunk_size Number of transitions per chunk (and transaction)
+     *
+     * @exception Exception::IllegalArgument is thrown if the input contains duplicate or invalid references
+     *
+    */
+    void convertTSVToPQP(const char* tsv_filename, FileTypes::Type filetype, const char* pqp_filename, Size chunk_size = 100000);
+
   };
 }
 
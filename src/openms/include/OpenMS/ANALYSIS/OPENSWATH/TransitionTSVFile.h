@@ -43,6 +43,7 @@
 #include <OpenMS/DATASTRUCTURES/DefaultParamHandler.h>
 
 #include <fstream>
+#include <functional>
 
 namespace OpenMS
 {
@@ -225,6 +226,59 @@ protected:
     */
     void TSVToTargetedExperiment_(std::vector<TSVTransition>& transition_list, OpenSwath::LightTargetedExperiment& exp);
 
+    /// Bookkeeping of an incremental (chunk by chunk) conversion to a LightTargetedExperiment
+    struct LightConversionState
+    {
+      std::map<String, Size> compound_map; ///< compound id -> index in the compounds
+      std::map<String, int> protein_map; ///< proteins seen so far
+      std::map<String, String> label_sequences; ///< peptide group label -> peptide sequence
+      std::vector<std::size_t> compound_indices; ///< index of the compound of each transition
+    };
+
+    /** @brief Add a chunk of TSVTransition to a LightTargetedExperiment
+     *
+     * Can be called repeatedly with consecutive chunks of a transition list,
+     * the result is the same as converting the whole list at once (after
+     * calling finishLightTargetedExperiment_).
+     *
+    */
+    void addToLightTargetedExperiment_(std::vector<TSVTransition>& transition_list, OpenSwath::LightTargetedExperiment& exp, LightConversionState& state);
+
+    /// Finish an incremental conversion (groups the transitions by compound)
+    void finishLightTargetedExperiment_(OpenSwath::LightTargetedExperiment& exp, LightConversionState& state);
+
+    /** @brief Read tab or comma separated input in chunks
+     *
+     * The file is read in chunks of @p chunk_size lines, each chunk is
+     * parsed in parallel and then handed to @p process_chunk (in file
+     * order), such that the full transition list never needs to be kept in
+     * memory.
+     *
+     * @param filename The input file
+     * @param filetype The type of file ("mrm" or "tsv")
+     * @param process_chunk Callback for each chunk of parsed transitions
+     * @param chunk_size Number of lines per chunk
+     *
+    */
+    void readUnstructuredTSVInput_(const char* filename, FileTypes::Type filetype,
+                                   const std::function<void(std::vector<TSVTransition>&)>& process_chunk,
+                                   Size chunk_size = 100000);
+
+    /** @brief Resolve mixed sequence groups incrementally
+     *
+     * Same as resolveMixedSequenceGroups_(std::vector<TSVTransition>&) but
+     * keeps the sequence of each peptide group label in @p label_sequences so
+     * that consecutive chunks of a transition list can be processed.
+     *
+    */
+    void resolveMixedSequenceGroups_(std::vector<TSVTransition>& transition_list, std::map<String, String>& label_sequences);
+
+    /// Populate a new TargetedExperiment::Peptide object from a row in the csv
+    void createPeptide_(std::vector<TSVTransition>::iterator& tr_it, OpenMS::TargetedExperiment::Peptide& peptide);
+
+    /// Populate a new TargetedExperiment::Compound object (a metabolite) from a row in the csv
+    void createCompound_(std::vector<TSVTransition>::iterator& tr_it, OpenMS::TargetedExperiment::Compound& compound);
+
     /** @name  Conversion functions from TSVTransition objects to TraML datastructures
      *
      * These functions convert the relevant data from a TSVTransition to the
@@ -274,6 +328,19 @@ private:
     */
     void readUnstructuredTSVInput_(const char* filename, FileTypes::Type filetype, std::vector<TSVTransition>& transition_list);
 
+    /** @brief Parse a single line of a transition list
+     *
+     * Thread-safe, does not parse any peptide sequences: if the group id
+     * needs to be generated from the sequence, @p generate_group_id is set
+     * and the caller has to generate it.
+     *
+     * @return false if the transition should be skipped
+     *
+    */
+    bool parseTransition_(const std::string& line, int line_nr, char delimiter, FileTypes::Type filetype,
+                          const std::map<std::string, int>& header_dict, TSVTransition& mytransition,
+                          bool& generate_group_id, bool& spectrast_legacy);
+
     void spectrastRTExtract(const String str_inp, double & value, bool & spectrast_legacy);
 
     bool spectrastAnnotationExtract(const String str_inp, TSVTransition & mytransition);
@@ -305,12 +372,6 @@ private:
     /// Helper function to assign retention times to compounds and peptides
     void interpretRetentionTime_(std::vector<TargetedExperiment::RetentionTime>& retention_times, const OpenMS::DataValue rt_value);
 
-    /// Populate a new TargetedExperiment::Peptide object from a row in the csv
-    void createPeptide_(std::vector<TSVTransition>::iterator& tr_it, OpenMS::TargetedExperiment::Peptide& peptide);
-
-    /// Populate a new TargetedExperiment::Compound object (a metabolite) from a row in the csv
-    void createCompound_(std::vector<TSVTransition>::iterator& tr_it, OpenMS::TargetedExperiment::Compound& compound);
-
     void addModification_(std::vector<TargetedExperiment::Peptide::Modification>& mods,
                           int location, const ResidueModification& rmod);
     //@}
@@ -40,6 +40,8 @@
 #include <OpenMS/METADATA/PeptideIdentification.h>
 #include <OpenMS/METADATA/ProteinIdentification.h>
 
+#include <unordered_map>
+
 namespace OpenMS
 {
   /**
@@ -47,6 +49,8 @@ namespace OpenMS
 
       This class is used by @ref TOPP_ProteinQuantifier. See there for further documentation.
 
+      While quantitative data is read, peptides are looked up via a hash index (instead of comparing sequences in the result map). Peptide and protein abundances are then computed in parallel (if OpenMP is available); the results do not depend on the number of threads.
+
       @htmlinclude OpenMS_PeptideAndProteinQuant.parameters
   */
   class OPENMS_DLLAPI PeptideAndProteinQuant :
@@ -191,6 +195,12 @@ private:
     /// Protein quantification data
     ProteinQuant prot_quant_;
 
+    /// Hash index into @p pep_quant_ for fast lookup while reading data (map elements are not invalidated by insertion; cleared after reading)
+    std::unordered_map<AASequence, PeptideData*> pep_index_;
+
+    /// Get the data for a peptide (new elements are created in @p pep_quant_ as necessary)
+    PeptideData& getPeptideData_(const AASequence& seq);
+
 
     /**
          @brief Get the "canonical" annotation (a single peptide hit) of a feature/consensus feature from the associated list of peptide identifications.
@@ -203,9 +213,9 @@ private:
     /**
          @brief Gather quantitative information from a feature.
 
-         Store quantitative information from @p feature in member @p pep_quant_, based on the peptide annotation in @p hit. If @p hit is empty ("ambiguous/no annotation"), nothing is stored.
+         Add the intensity of @p feature to the abundance of its sample in @p abundances (the abundances of the annotated peptide and charge state in member @p pep_quant_).
     */
-    void quantifyFeature_(const FeatureHandle& feature, const PeptideHit& hit);
+    void quantifyFeature_(const FeatureHandle& feature, SampleAbundances& abundances);
 
     /**
          @brief Order keys (charges/peptides for peptide/protein quantification) according to how many samples they allow to quantify, breaking ties by total abundance.
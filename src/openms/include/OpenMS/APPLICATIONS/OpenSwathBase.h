@@ -78,6 +78,7 @@
 
 
 #include <OpenMS/APPLICATIONS/TOPPBase.h>
+#include <OpenMS/SYSTEM/Profiler.h>
 
 
 
@@ -192,6 +193,8 @@ protected:
                       const bool sort_swath_maps,
                       const bool sonar)
   {
+    OPENMS_PROFILE_PHASE("OpenSwath: load SWATH files");
+
     // (i) Load files
     loadSwathFiles_(file_list, split_file, tmp, readoptions, exp_meta, swath_maps);
 
@@ -326,6 +329,7 @@ protected:
                                                         const String& tr_file,
                                                         const Param& tsv_reader_param)
   {
+    OPENMS_PROFILE_PHASE("OpenSwath: load transition list");
     OpenSwath::LightTargetedExperiment transition_exp;
     ProgressLogger progresslogger;
     progresslogger.setLogType(log_type_);
@@ -42,6 +42,7 @@
 
 #include <vector>
 #include <iosfwd>
+#include <functional>
 
 namespace OpenMS
 {
@@ -635,4 +636,28 @@ protected:
 
 } // namespace OpenMS
 
+namespace std
+{
+  /**
+    @brief Hash function for AASequence (e.g. for use in std::unordered_map)
+
+    Residues and terminal modifications are unique objects (see ResidueDB and ModificationsDB), so hashing their addresses is consistent with AASequence::operator==.
+  */
+  template <>
+  struct hash<OpenMS::AASequence>
+  {
+    std::size_t operator()(const OpenMS::AASequence& seq) const
+    {
+      std::hash<const void*> hasher;
+      std::size_t seed = hasher(seq.getNTerminalModification());
+      for (OpenMS::Size i = 0; i < seq.size(); ++i)
+      {
+        seed ^= hasher(&seq[i]) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+      }
+      seed ^= hasher(seq.getCTerminalModification()) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+      return seed;
+    }
+  };
+} // namespace std
+
 
@@ -0,0 +1,181 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/DATASTRUCTURES/String.h>
+#include <OpenMS/DATASTRUCTURES/ListUtils.h>
+
+#include <set>
+#include <utility>
+#include <vector>
+
+class QFile;
+
+namespace OpenMS
+{
+  class EmpiricalFormula;
+
+  /** @ingroup Chemistry
+
+      @brief Binary snapshot of the content of a chemistry database
+
+      Parsing the XML and OBO files ElementDB, ResidueDB and ModificationsDB
+      are built from dominates the start-up time of short running tools. After
+      parsing its source files, a database therefore writes its content into a
+      snapshot, which is memory mapped and read back by the next process
+      instead of parsing the sources again.
+
+      A snapshot is only used if it was written by the same OpenMS version
+      and snapshot format and if the SHA-1 checksums of the source files
+      still match the ones recorded in it. Otherwise the database is built
+      from its sources and the snapshot is replaced (atomically, so that
+      concurrently starting processes never see a partial file).
+
+      Snapshots are stored in the "cache" subdirectory of the OpenMS home
+      directory ($HOME/.OpenMS or $OPENMS_HOME_PATH/.OpenMS). They can be
+      disabled by setting the environment variable OPENMS_DISABLE_DB_SNAPSHOT.
+
+      Values are appended with the write functions and store() writes the
+      file. After a successful open(), the read functions return the values
+      in the same order; they throw Exception::ParseError if the snapshot
+      ends prematurely.
+  */
+  class OPENMS_DLLAPI ChemistryDBSnapshot
+  {
+public:
+    /// Version of the snapshot layout, to be increased whenever a database changes what it writes
+    static const Int FORMAT_VERSION;
+
+    /**
+      @brief Constructor
+
+      @param name Name of the snapshot (the name of the database)
+      @param source_files Files the database is built from (located with File::find())
+    */
+    ChemistryDBSnapshot(const String& name, const StringList& source_files);
+
+    /// Destructor (unmaps the snapshot)
+    ~ChemistryDBSnapshot();
+
+    /// Returns false if snapshots are disabled by the environment
+    static bool isEnabled();
+
+    /// Returns the path of the snapshot file
+    const String& getPath() const;
+
+    /// Sets the path of the snapshot file (default: cache directory in the OpenMS home directory)
+    void setPath(const String& path);
+
+    /**
+      @brief Maps the snapshot into memory and checks that it is up to date
+
+      @return false if snapshots are disabled or the snapshot is missing, invalid or outdated
+    */
+    bool open();
+
+    /**
+      @brief Writes the values added by the write functions as new snapshot
+
+      @return false if the snapshot could not be written (e.g. no write permission); this is not an error
+    */
+    bool store();
+
+    /** @name Writing
+    */
+    //@{
+    void writeInt(Int64 value);
+    void writeSize(Size value);
+    void writeDouble(double value);
+    void writeString(const String& value);
+    void writeStringSet(const std::set<String>& value);
+    void writeFormula(const EmpiricalFormula& value);
+    //@}
+
+    /** @name Reading
+
+        @throw Exception::ParseError if the end of the snapshot is reached
+    */
+    //@{
+    Int64 readInt();
+    Size readSize();
+    double readDouble();
+    String readString();
+    std::set<String> readStringSet();
+    /// reads a formula, the elements are looked up in ElementDB (throws Exception::ParseError for unknown elements)
+    EmpiricalFormula readFormula();
+    //@}
+
+    /**
+      @brief Reads the entries (full names and values as strings) of a parameter XML file, using a snapshot if possible
+
+      This is what ElementDB and ResidueDB are built from.
+
+      @throw Exception::FileNotFound if @p param_file cannot be found
+      @throw Exception::ParseError if @p param_file cannot be parsed
+    */
+    static void loadParamEntries(const String& name, const String& param_file, std::vector<std::pair<String, String> >& entries);
+
+protected:
+    /// computes the header of the snapshot (identifying the version and the source files)
+    const String& getHeader_();
+
+    /// copies @p size bytes of the mapped snapshot to @p data
+    void read_(void* data, Size size);
+
+    /// appends @p size bytes to the data to be stored
+    void write_(const void* data, Size size);
+
+    String name_;
+    StringList source_files_;
+    String path_;
+    String header_;
+
+    /// data to be written by store()
+    std::string buffer_;
+
+    /// mapped snapshot file (after open())
+    QFile* file_;
+    const char* data_;
+    const char* data_end_;
+
+private:
+    /// Not implemented
+    ChemistryDBSnapshot(const ChemistryDBSnapshot&);
+
+    /// Not implemented
+    ChemistryDBSnapshot& operator=(const ChemistryDBSnapshot&);
+  };
+
+} // namespace OpenMS
@@ -0,0 +1,108 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+namespace OpenMS
+{
+  /**
+      @brief Lightweight peptide representation for candidate generation in database search
+
+      A LightPeptide is a non-owning view on an unmodified (protein) sequence. Its mass is computed from a
+      LightPeptide::MassTable that is filled once per search, so weighing a candidate requires neither parsing, nor
+      ResidueDB lookups, nor heap allocation. This allows to discard candidates without a matching precursor before
+      the (expensive) AASequence and its modified variants are created.
+
+      @note The string the view refers to (usually FASTAFile::FASTAEntry::sequence) must outlive the LightPeptide.
+
+      @ingroup Chemistry
+  */
+  class OPENMS_DLLAPI LightPeptide
+  {
+public:
+
+    /**
+        @brief Table of internal residue masses indexed by one-letter code
+
+        The table is filled from the unmodified residues in ResidueDB. Letters without a residue of defined mass
+        (e.g. 'X') have mass NaN, which propagates to all masses computed from them.
+    */
+    class OPENMS_DLLAPI MassTable
+    {
+public:
+      /// constructor (queries ResidueDB, so construct outside of parallel sections)
+      MassTable();
+
+      /// returns the internal monoisotopic mass of residue @p one_letter_code
+      inline double getMass(char one_letter_code) const
+      {
+        return masses_[static_cast<unsigned char>(one_letter_code)];
+      }
+
+      /// returns the mass that is added to the sum of internal residues to obtain the full (neutral) peptide
+      inline double getInternalToFull() const
+      {
+        return internal_to_full_;
+      }
+
+private:
+      double masses_[256];
+      double internal_to_full_;
+    };
+
+    /** @name Constructors and Destructors
+    */
+    //@{
+    /// default constructor (empty sequence)
+    LightPeptide();
+
+    /// constructor from a view on an unmodified sequence
+    explicit LightPeptide(const StringView& sequence);
+    //@}
+
+    /// returns the unmodified sequence
+    const StringView& getSequence() const;
+
+    /// returns the number of residues
+    Size size() const;
+
+    /// returns the neutral monoisotopic mass of the full (unmodified) peptide
+    double getMonoWeight(const MassTable& masses) const;
+
+protected:
+    StringView sequence_;
+  };
+}
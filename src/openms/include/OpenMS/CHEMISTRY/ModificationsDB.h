@@ -38,11 +38,14 @@
 #include <OpenMS/DATASTRUCTURES/String.h>
 #include <OpenMS/CHEMISTRY/ResidueModification.h>
 
+#include <boost/unordered_map.hpp>
+
 #include <set>
 
 namespace OpenMS
 {
   // forward declarations
+  class ChemistryDBSnapshot;
   class ResidueModification;
   class Residue;
 
@@ -68,6 +71,10 @@ namespace OpenMS
       In some scenarios, it might be useful to define different modification
       databases. This can be done by providing a path when initializing
       ModificationsDB.
+
+      Parsing the source files takes considerable time, the parsed database
+      is therefore cached in a binary snapshot (see ChemistryDBSnapshot) that
+      is used instead as long as the source files do not change.
   */
   class OPENMS_DLLAPI ModificationsDB
   {
@@ -202,7 +209,7 @@ protected:
     std::vector<ResidueModification*> mods_;
 
     /// Stores the mappings of (unique) names to the modifications
-    Map<String, std::set<const ResidueModification*> > modification_names_;
+    boost::unordered_map<String, std::set<const ResidueModification*> > modification_names_;
 
     /// Helper function to check if a residue matches the origin for a modification
     bool residuesMatch_(const String& residue, char origin) const;
@@ -243,6 +250,16 @@ private:
 
     /// Adds modifications from a given file in Unimod XML format
     void readFromUnimodXMLFile(const String& filename);
+
+    /**
+       @brief Reads the modifications and their names from @p snapshot
+
+       @return false (leaving the database empty) if the snapshot is outdated or cannot be read
+    */
+    bool readFromSnapshot_(ChemistryDBSnapshot& snapshot);
+
+    /// Writes the modifications and their names to @p snapshot
+    void writeToSnapshot_(ChemistryDBSnapshot& snapshot) const;
     
   };
 }
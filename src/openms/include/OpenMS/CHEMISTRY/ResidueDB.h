@@ -39,6 +39,8 @@
 #include <OpenMS/DATASTRUCTURES/String.h>
 
 #include <set>
+#include <utility>
+#include <vector>
 
 namespace OpenMS
 {
@@ -195,6 +197,13 @@ protected:
     */
     void readResiduesFromFile_(const String& filename);
 
+    /**
+       @brief builds the residues from the (name, value) entries of a residue file
+
+       @throw Exception::ParseError if the entries cannot be parsed
+    */
+    void readResidues_(const std::vector<std::pair<String, String> >& entries);
+
     /// parses a residue, given the key/value pairs from i.e. an XML file
     Residue* parseResidue_(Map<String, String>& values);
 
@@ -214,7 +223,7 @@ protected:
     // fast lookup table for residues
     Residue* residue_by_one_letter_code_[256];
 
-    Map<String, Map<String, Residue*> > residue_mod_names_;
+    boost::unordered_map<String, boost::unordered_map<String, Residue*> > residue_mod_names_;
 
     std::set<Residue*> residues_;
 
@@ -87,14 +87,23 @@ namespace OpenMS
     /// returns a spectrum with the ion types, that are set in the tool parameters
     virtual void getSpectrum(PeakSpectrum & spec, const AASequence & peptide, Int min_charge, Int max_charge) const;
 
+    /**
+      @brief Computes the prefix mass ladder of a peptide
+
+      After the call, @p prefix_masses has size peptide.size() + 1 and entry i contains the summed internal
+      residue masses of the first i residues plus the N-terminal modification. The mass of every prefix or suffix
+      fragment can then be obtained in constant time. The vector is resized, so it can be reused across calls.
+    */
+    static void getPrefixMasses(std::vector<double> & prefix_masses, const AASequence & peptide);
+
     /// overwrite
     void updateMembers_() override;
 
     //@}
 
     protected:
-      /// adds peaks to a spectrum of the given ion-type, peptide, charge, and intensity, also adds charges and ion names to the DataArrays, if the add_metainfo parameter is set to true
-      virtual void addPeaks_(PeakSpectrum & spectrum, const AASequence & peptide, DataArrays::StringDataArray& ion_names, DataArrays::IntegerDataArray& charges, Residue::ResidueType res_type, Int charge = 1) const;
+      /// adds peaks to a spectrum of the given ion-type, peptide, charge, and intensity, also adds charges and ion names to the DataArrays, if the add_metainfo parameter is set to true. Fragment masses are taken from @p prefix_masses (see getPrefixMasses()).
+      virtual void addPeaks_(PeakSpectrum & spectrum, const AASequence & peptide, const std::vector<double> & prefix_masses, DataArrays::StringDataArray& ion_names, DataArrays::IntegerDataArray& charges, Residue::ResidueType res_type, Int charge = 1) const;
 
       /// adds the precursor peaks to the spectrum, also adds charges and ion names to the DataArrays, if the add_metainfo parameter is set to true
       virtual void addPrecursorPeaks_(PeakSpectrum & spec, const AASequence & peptide, DataArrays::StringDataArray& ion_names, DataArrays::IntegerDataArray& charges, Int charge = 1) const;
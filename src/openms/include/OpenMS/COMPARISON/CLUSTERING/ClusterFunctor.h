@@ -37,6 +37,7 @@
 #include <OpenMS/DATASTRUCTURES/DistanceMatrix.h>
 #include <OpenMS/CONCEPT/Exception.h>
 #include <OpenMS/COMPARISON/CLUSTERING/ClusterAnalyzer.h>
+#include <OpenMS/COMPARISON/CLUSTERING/SparseDistanceGraph.h>
 
 #include <vector>
 
@@ -96,9 +97,42 @@ public:
     */
     virtual void operator()(DistanceMatrix<float> & original_distance, std::vector<BinaryTreeNode> & cluster_tree, const float threshold = 1) const = 0;
 
+    /**
+        @brief clusters the indices according to the distances stored in a sparse graph
+
+        @param distances SparseDistanceGraph containing the distances of the elements to be clustered, all pairs without an edge have distance 1
+        @param cluster_tree vector< BinaryTreeNode >, represents the clustering as in operator(), clustering steps that exceed @p threshold are dummy nodes with distance -1
+        @param threshold float value, the minimal distance from which on cluster merging is considered unrealistic
+
+        The default implementation throws Exception::NotImplemented.
+        @throw ClusterFunctor::InsufficientInput thrown if input is <2
+    */
+    virtual void clusterSparse(const SparseDistanceGraph & distances, std::vector<BinaryTreeNode> & cluster_tree, const float threshold = 1) const;
+
     /// registers all derived products
     static void registerChildren();
 
+protected:
+    /// how the distance of two merged clusters is derived from their element distances in agglomerateSparse_()
+    enum SparseLinkage
+    {
+      SPARSE_AVERAGE, ///< average distance of all element pairs
+      SPARSE_COMPLETE ///< maximal distance of all element pairs
+    };
+
+    /**
+        @brief agglomerative clustering on a SparseDistanceGraph
+
+        Only clusters connected by at least one edge are candidates for a merge,
+        the missing element pairs contribute distance 1 to @p linkage.
+        Merging stops once no pair of clusters is closer than @p threshold,
+        the remaining steps are filled with dummy nodes (see fillDummyNodes_()).
+    */
+    static void agglomerateSparse_(const SparseDistanceGraph & distances, std::vector<BinaryTreeNode> & cluster_tree, const float threshold, SparseLinkage linkage);
+
+    /// completes @p cluster_tree to @p n - 1 steps, joining the lowest of the cluster representatives @p representatives with all others at distance -1
+    static void fillDummyNodes_(std::vector<Size> representatives, Size n, std::vector<BinaryTreeNode> & cluster_tree);
+
   };
 
 }
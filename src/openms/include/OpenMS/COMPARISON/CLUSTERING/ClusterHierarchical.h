@@ -44,11 +44,13 @@
 #include <OpenMS/DATASTRUCTURES/DistanceMatrix.h>
 #include <OpenMS/COMPARISON/CLUSTERING/ClusterFunctor.h>
 #include <OpenMS/COMPARISON/CLUSTERING/ClusterAnalyzer.h>
+#include <OpenMS/COMPARISON/CLUSTERING/SparseDistanceGraph.h>
 #include <OpenMS/COMPARISON/SPECTRA/PeakSpectrumCompareFunctor.h>
 #include <OpenMS/COMPARISON/SPECTRA/BinnedSpectrum.h>
 #include <OpenMS/COMPARISON/SPECTRA/BinnedSpectrumCompareFunctor.h>
 #include <OpenMS/CONCEPT/Exception.h>
 
+#include <algorithm>
 #include <vector>
 
 namespace OpenMS
@@ -187,6 +189,115 @@ public:
       clusterer(original_distance, cluster_tree, threshold_);
     }
 
+    /**
+        @brief Computes the distances of all pairs passing a precursor m/z prefilter
+
+        Only pairs of elements whose @p precursor_mz values differ by at most @p precursor_mz_tolerance are compared,
+        pairs with a distance of at least @p max_distance are dropped. All other pairs are considered to have distance 1.
+        The comparisons are done in parallel, so @p comparator must be thread-safe (const).
+        The memory needed grows with the number of retained edges instead of quadratically.
+
+        Dropping edges with @p max_distance smaller than 1 does not change the result of single or complete linkage
+        as long as it is not smaller than the clustering threshold. For average linkage it is an approximation.
+
+        @param data vector of objects to be compared
+        @param precursor_mz the precursor m/z of each element of @p data
+        @param precursor_mz_tolerance maximal precursor m/z difference (in Th) of two elements to be compared
+        @param comparator similarity functor fitting for types in data, yielding values in range [0,1]
+        @param distances the resulting graph (distance = 1 - similarity)
+        @param max_distance edges with at least this distance are not stored
+
+        @throw Exception::InvalidSize if @p precursor_mz and @p data do not have the same size
+    */
+    template <typename Data, typename SimilarityComparator>
+    static void computeSparseDistances(const std::vector<Data> & data,
+      const std::vector<double> & precursor_mz,
+      double precursor_mz_tolerance,
+      const SimilarityComparator & comparator,
+      SparseDistanceGraph & distances,
+      float max_distance = 1)
+    {
+      if (precursor_mz.size() != data.size())
+      {
+        throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, precursor_mz.size());
+      }
+      distances.clear(data.size());
+
+      // sweep over the elements in order of precursor m/z
+      std::vector<std::pair<double, Size> > order;
+      order.reserve(data.size());
+      for (Size i = 0; i < data.size(); ++i)
+      {
+        order.push_back(std::make_pair(precursor_mz[i], i));
+      }
+      std::sort(order.begin(), order.end());
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+      {
+        std::vector<SparseDistanceGraph::Edge> edges;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16) nowait
+#endif
+        for (SignedSize k = 0; k < (SignedSize)order.size(); ++k)
+        {
+          const Size i = order[k].second;
+          for (Size l = k + 1; l < order.size() && order[l].first - order[k].first <= precursor_mz_tolerance; ++l)
+          {
+            const Size j = order[l].second;
+            // distance value is 1-similarity value, since similarity is in range of [0,1]
+            const float distance = 1 - comparator(data[i], data[j]);
+            if (distance < max_distance)
+            {
+              edges.push_back(SparseDistanceGraph::Edge(i, j, distance));
+            }
+          }
+        }
+#ifdef _OPENMP
+#pragma omp critical (ClusterHierarchical_computeSparseDistances)
+#endif
+        distances.addEdges(edges);
+      }
+      // independent of the thread scheduling
+      distances.sortEdges();
+    }
+
+    /**
+        @brief Clustering function on a sparse distance graph
+
+        Same as cluster(), but only the pairs of elements passing the precursor m/z prefilter are compared (see computeSparseDistances())
+        and @p clusterer runs on the resulting graph (see ClusterFunctor::clusterSparse()).
+        Clustering stops if the ClusterHierarchical::threshold_ is reached by the ClusterFunctor.
+
+        @param data vector of objects to be clustered
+        @param precursor_mz the precursor m/z of each element of @p data
+        @param precursor_mz_tolerance maximal precursor m/z difference (in Th) of two elements to be compared
+        @param comparator similarity functor fitting for types in data
+        @param clusterer a clustermethod implementation, baseclass ClusterFunctor
+        @param cluster_tree the vector that will hold the BinaryTreeNodes representing the clustering
+        @param distances the SparseDistanceGraph holding the computed distances, will be made newly if given size does not fit to the number of elements given in @p data
+        @param max_distance edges with at least this distance are not stored (see computeSparseDistances())
+        @see ClusterFunctor, BinaryTreeNode, ClusterAnalyzer
+    */
+    template <typename Data, typename SimilarityComparator>
+    void clusterSparse(const std::vector<Data> & data,
+      const std::vector<double> & precursor_mz,
+      double precursor_mz_tolerance,
+      const SimilarityComparator & comparator,
+      const ClusterFunctor & clusterer,
+      std::vector<BinaryTreeNode> & cluster_tree,
+      SparseDistanceGraph & distances,
+      float max_distance = 1)
+    {
+      if (distances.dimensionsize() != data.size())
+      {
+        computeSparseDistances(data, precursor_mz, precursor_mz_tolerance, comparator, distances, max_distance);
+      }
+
+      clusterer.clusterSparse(distances, cluster_tree, threshold_);
+    }
+
     /// get the threshold
     double getThreshold()
     {
@@ -195,7 +306,7 @@ public:
 
     /// set the threshold (in terms of distance)
     /// The default is 1, i.e. only at similarity 0 the clustering stops.
-    /// Warning: clustering is not supported by all methods yet (e.g. SingleLinkage does ignore it).
+    /// Warning: clustering is not supported by all methods yet (e.g. SingleLinkage does ignore it, except in clusterSparse()).
     void setThreshold(double x)
     {
       threshold_ = x;
@@ -83,6 +83,16 @@ public:
     */
     void operator()(DistanceMatrix<float> & original_distance, std::vector<BinaryTreeNode> & cluster_tree, const float threshold = 1) const override;
 
+    /**
+        @brief clusters the indices according to the distances of a sparse graph
+
+        Gives the same result as operator() on a DistanceMatrix holding the edges of @p distances and distance 1 for all other pairs,
+        but only clusters sharing an edge are considered for merging.
+    @throw ClusterFunctor::InsufficientInput thrown if input is <2
+    @see ClusterFunctor::clusterSparse
+    */
+    void clusterSparse(const SparseDistanceGraph & distances, std::vector<BinaryTreeNode> & cluster_tree, const float threshold = 1) const override;
+
     /// creates a new instance of a CompleteLinkage object
     static ClusterFunctor * create();
 
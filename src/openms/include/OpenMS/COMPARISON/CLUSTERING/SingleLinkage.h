@@ -83,6 +83,18 @@ public:
     */
     void operator()(DistanceMatrix<float> & original_distance, std::vector<BinaryTreeNode> & cluster_tree, const float threshold = 1) const override;
 
+    /**
+        @brief clusters the indices according to the distances of a sparse graph
+
+        Single linkage is computed as the minimum spanning forest of @p distances (Kruskal's algorithm),
+        so the memory needed grows with the number of edges only. Contrary to operator(), @p threshold is supported:
+        edges with a distance of at least @p threshold are not merged and the remaining steps are dummy nodes (distance -1).
+        Unconnected components are joined by dummy nodes as well.
+    @throw ClusterFunctor::InsufficientInput thrown if input is <2
+    @see ClusterFunctor::clusterSparse
+    */
+    void clusterSparse(const SparseDistanceGraph & distances, std::vector<BinaryTreeNode> & cluster_tree, const float threshold = 1) const override;
+
     /// creates a new instance of a SingleLinkage object
     static ClusterFunctor * create();
 
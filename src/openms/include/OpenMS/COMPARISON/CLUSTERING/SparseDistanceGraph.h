@@ -0,0 +1,116 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+//
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/OpenMSConfig.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+      @brief Sparse symmetric distance matrix, stored as a list of edges
+
+      In contrast to DistanceMatrix only the distances of pairs that were
+      actually computed are stored, so the memory grows with the number of
+      edges instead of quadratically with the number of elements. The distance
+      of all other pairs is assumed to be 1, i.e. the maximal distance of a
+      normalized similarity (see ClusterHierarchical::computeSparseDistances).
+
+      Each pair of elements must be added at most once.
+
+      @see ClusterFunctor::clusterSparse()
+
+      @ingroup SpectraClustering
+  */
+  class OPENMS_DLLAPI SparseDistanceGraph
+  {
+public:
+    /// An edge between two elements, strict order is kept: first < second
+    struct OPENMS_DLLAPI Edge
+    {
+      Size first;
+      Size second;
+      float distance;
+
+      Edge(Size i, Size j, float d);
+
+      /// order by distance (ties are broken by the element indices)
+      bool operator<(const Edge& rhs) const;
+    };
+
+    /// default constructor, creates a graph of @p dimensionsize elements without edges
+    explicit SparseDistanceGraph(Size dimensionsize = 0);
+
+    /// destructor
+    ~SparseDistanceGraph();
+
+    /// number of elements (not edges)
+    Size dimensionsize() const;
+
+    /// number of stored edges
+    Size edgeCount() const;
+
+    /// removes all edges and sets the number of elements to @p dimensionsize
+    void clear(Size dimensionsize = 0);
+
+    /**
+        @brief adds the distance @p distance between the elements @p i and @p j
+
+        @throw Exception::IndexOverflow if @p i or @p j is not smaller than dimensionsize()
+        @throw Exception::IllegalArgument if @p i equals @p j
+    */
+    void addEdge(Size i, Size j, float distance);
+
+    /// appends the edges @p edges (which are not checked)
+    void addEdges(const std::vector<Edge>& edges);
+
+    /// the stored edges
+    const std::vector<Edge>& getEdges() const;
+
+    /// sorts the edges by ascending distance
+    void sortEdges();
+
+protected:
+    /// number of elements
+    Size dimensionsize_;
+
+    /// the edges
+    std::vector<Edge> edges_;
+  };
+
+}
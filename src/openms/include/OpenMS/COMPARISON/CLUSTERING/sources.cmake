@@ -14,6 +14,7 @@ GridBasedCluster.h
 GridBasedClustering.h
 HashGrid.h
 SingleLinkage.h
+SparseDistanceGraph.h
 )
 
 ### add path to the filenames
@@ -533,6 +533,24 @@ public:
       return size_;
     }   
 
+    /// character at position @p i (not range checked)
+    inline char operator[](Size i) const
+    {
+      return begin_[i];
+    }
+
+    /// pointer to the first character of the view
+    inline const char* begin() const
+    {
+      return begin_;
+    }
+
+    /// pointer behind the last character of the view
+    inline const char* end() const
+    {
+      return begin_ + size_;
+    }
+
     /// create String object from view
     inline String getString() const
     {
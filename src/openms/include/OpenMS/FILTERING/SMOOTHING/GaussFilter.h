@@ -91,121 +91,28 @@ public:
       */
     void filter(MSSpectrum & spectrum)
     {
-      typedef std::vector<double> ContainerT;
-
-      // make sure the right data type is set
-      spectrum.setType(SpectrumSettings::PROFILE);
-      bool found_signal = false;
-      const Size data_size = spectrum.size();
-      ContainerT mz_in(data_size), int_in(data_size), mz_out(data_size), int_out(data_size);
-
-      // copy spectrum to container
-      for (Size p = 0; p < spectrum.size(); ++p)
-      {
-        mz_in[p] = spectrum[p].getMZ();
-        int_in[p] = static_cast<double>(spectrum[p].getIntensity());
-      }
-
-      // apply filter
-      ContainerT::iterator mz_out_it = mz_out.begin();
-      ContainerT::iterator int_out_it = int_out.begin();
-      found_signal = gauss_algo_.filter(mz_in.begin(), mz_in.end(), int_in.begin(), mz_out_it, int_out_it);
-
-      // If all intensities are zero in the scan and the scan has a reasonable size, throw an exception.
-      // This is the case if the Gaussian filter is smaller than the spacing of raw data
-      if (!found_signal && spectrum.size() >= 3)
-      {
-        String error_message = "Found no signal. The Gaussian width is probably smaller than the spacing in your profile data. Try to use a bigger width.";
-        if (spectrum.getRT() > 0.0)
-        {
-          error_message += String(" The error occurred in the spectrum with retention time ") + spectrum.getRT() + ".";
-        }
-        LOG_ERROR << error_message << std::endl;
-      }
-      else
-      {
-        // copy the new data into the spectrum
-        ContainerT::iterator mz_it = mz_out.begin();
-        ContainerT::iterator int_it = int_out.begin();
-        for (Size p = 0; mz_it != mz_out.end(); mz_it++, int_it++, p++)
-        {
-          spectrum[p].setIntensity(*int_it);
-          spectrum[p].setMZ(*mz_it);
-        }
-      }
+      filter_(spectrum, gauss_algo_);
     }
 
+    /**
+      @brief Smoothes an MSChromatogram.
+
+      @exception Exception::IllegalArgument is thrown, if @em use_ppm_tolerance is set.
+    */
     void filter(MSChromatogram & chromatogram)
     {
-      typedef std::vector<double> ContainerT;
-
-      if (param_.getValue("use_ppm_tolerance").toBool())
-      {
-        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
-          "GaussFilter: Cannot use ppm tolerance on chromatograms");
-      }
-
-      bool found_signal = false;
-      const Size data_size = chromatogram.size();
-      ContainerT rt_in(data_size), int_in(data_size), rt_out(data_size), int_out(data_size);
-
-      // copy spectrum to container
-      for (Size p = 0; p < chromatogram.size(); ++p)
-      {
-        rt_in[p] = chromatogram[p].getRT();
-        int_in[p] = chromatogram[p].getIntensity();
-      }
-
-      // apply filter
-      ContainerT::iterator mz_out_it = rt_out.begin();
-      ContainerT::iterator int_out_it = int_out.begin();
-      found_signal = gauss_algo_.filter(rt_in.begin(), rt_in.end(), int_in.begin(), mz_out_it, int_out_it);
-
-      // If all intensities are zero in the scan and the scan has a reasonable size, throw an exception.
-      // This is the case if the Gaussian filter is smaller than the spacing of raw data
-      if (!found_signal && chromatogram.size() >= 3)
-      {
-        String error_message = "Found no signal. The Gaussian width is probably smaller than the spacing in your chromatogram data. Try to use a bigger width.";
-        if (chromatogram.getMZ() > 0.0)
-        {
-          error_message += String(" The error occurred in the chromatogram with m/z time ") + chromatogram.getMZ() + ".";
-        }
-        LOG_ERROR << error_message << std::endl;
-      }
-      else
-      {
-        // copy the new data into the spectrum
-        ContainerT::iterator mz_it = rt_out.begin();
-        ContainerT::iterator int_it = int_out.begin();
-        for (Size p = 0; mz_it != rt_out.end(); mz_it++, int_it++, p++)
-        {
-          chromatogram[p].setIntensity(*int_it);
-          chromatogram[p].setMZ(*mz_it);
-        }
-      }
+      checkChromatogramParameters_();
+      filter_(chromatogram, gauss_algo_);
     }
 
     /**
       @brief Smoothes an MSExperiment containing profile data.
 
-      @exception Exception::IllegalArgument is thrown, if the @em gaussian_width parameter is too small.
+      Spectra and chromatograms are smoothed in parallel.
+
+      @exception Exception::IllegalArgument is thrown, if @em use_ppm_tolerance is set and the experiment contains chromatograms (before anything is smoothed).
     */
-    void filterExperiment(PeakMap & map)
-    {
-      Size progress = 0;
-      startProgress(0, map.size() + map.getChromatograms().size(), "smoothing data");
-      for (Size i = 0; i < map.size(); ++i)
-      {
-        filter(map[i]);
-        setProgress(++progress);
-      }
-      for (Size i = 0; i < map.getChromatograms().size(); ++i)
-      {
-        filter(map.getChromatogram(i));
-        setProgress(++progress);
-      }
-      endProgress();
-    }
+    void filterExperiment(PeakMap & map);
 
 protected:
 
@@ -214,6 +121,15 @@ protected:
     /// The spacing of the pre-tabulated kernel coefficients
     double spacing_;
 
+    /// Throws Exception::IllegalArgument if the parameters cannot be used for chromatograms
+    void checkChromatogramParameters_() const;
+
+    /// Smoothes a spectrum using the kernel of @p gauss_algo (which is modified in ppm mode)
+    void filter_(MSSpectrum & spectrum, GaussFilterAlgorithm & gauss_algo) const;
+
+    /// Smoothes a chromatogram using the kernel of @p gauss_algo
+    void filter_(MSChromatogram & chromatogram, GaussFilterAlgorithm & gauss_algo) const;
+
     // Docu in base class
     void updateMembers_() override;
   };
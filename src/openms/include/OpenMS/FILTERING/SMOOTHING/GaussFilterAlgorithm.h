@@ -81,19 +81,13 @@ public:
     */
     bool filter(OpenMS::Interfaces::SpectrumPtr spectrum)
     {
-      // create new arrays for mz / intensity data and set their size
+      // create new arrays for mz / intensity data
       OpenMS::Interfaces::BinaryDataArrayPtr intensity_array(new OpenMS::Interfaces::BinaryDataArray);
       OpenMS::Interfaces::BinaryDataArrayPtr mz_array(new OpenMS::Interfaces::BinaryDataArray);
-      mz_array->data.resize(spectrum->getMZArray()->data.size());
-      intensity_array->data.resize(spectrum->getMZArray()->data.size());
+      mz_array->data = spectrum->getMZArray()->data;
 
       // apply the filter
-      bool ret_val = filter(
-          spectrum->getMZArray()->data.begin(), 
-          spectrum->getMZArray()->data.end(),
-          spectrum->getIntensityArray()->data.begin(),
-          mz_array->data.begin(), intensity_array->data.begin()
-          );
+      bool ret_val = filter(mz_array->data, spectrum->getIntensityArray()->data, intensity_array->data);
       // set the data of the spectrum to the new mz / int arrays
       spectrum->setMZArray(mz_array);
       spectrum->setIntensityArray(intensity_array);
@@ -105,19 +99,13 @@ public:
     */
     bool filter(OpenMS::Interfaces::ChromatogramPtr chromatogram)
     {
-      // create new arrays for rt / intensity data and set their size
+      // create new arrays for rt / intensity data
       OpenMS::Interfaces::BinaryDataArrayPtr intensity_array(new OpenMS::Interfaces::BinaryDataArray);
       OpenMS::Interfaces::BinaryDataArrayPtr rt_array(new OpenMS::Interfaces::BinaryDataArray);
-      rt_array->data.resize(chromatogram->getTimeArray()->data.size());
-      intensity_array->data.resize(chromatogram->getTimeArray()->data.size());
+      rt_array->data = chromatogram->getTimeArray()->data;
 
       // apply the filter
-      bool ret_val = filter(
-          chromatogram->getTimeArray()->data.begin(), 
-          chromatogram->getTimeArray()->data.end(),
-          chromatogram->getIntensityArray()->data.begin(),
-          rt_array->data.begin(), intensity_array->data.begin()
-          );
+      bool ret_val = filter(rt_array->data, chromatogram->getIntensityArray()->data, intensity_array->data);
       // set the data of the chromatogram to the new rt / int arrays
       chromatogram->setTimeArray(rt_array);
       chromatogram->setIntensityArray(intensity_array);
@@ -162,10 +150,36 @@ public:
       return found_signal;
     }
 
+    /**
+      @brief Smoothes the intensities of data stored in contiguous arrays.
+
+      Computes the same values as the iterator version, but the interpolated
+      kernel value of each data point in the window is computed once per
+      window (instead of once for each of its two adjacent trapezoids) and
+      the convolution runs over plain arrays.
+
+      The coefficient table (see initialize()) is the only part of the kernel
+      which does not depend on the data, it is computed once and used for all
+      spectra. The interpolated weights depend on the exact distances between
+      the data points, so they are not cached across spectra. In ppm mode the
+      table depends on the exact m/z of each data point, a cache keyed by the
+      kernel width would therefore (almost) never be hit.
+
+      @param mz The positions (m/z or RT), sorted ascending
+      @param intensity The intensities (at least as many as positions)
+      @param intensity_out The smoothed intensities (resized to the number of positions)
+
+      @return Whether any smoothed intensity is non-zero
+    */
+    bool filter(const std::vector<double>& mz, const std::vector<double>& intensity, std::vector<double>& intensity_out);
+
     void initialize(double gaussian_width, double spacing, double ppm_tolerance, bool use_ppm_tolerance);
 
 protected:
 
+    /// Returns the (linearly interpolated) kernel coefficient at distance @p distance from the center, using the first @p middle coefficients
+    double interpolateCoefficient_(double distance, Size middle) const;
+
     ///Coefficients
     std::vector<double> coeffs_;
     /// The standard derivation  \f$ \sigma \f$.
@@ -184,15 +184,13 @@ public:
 
     /**
       @brief Removed the noise from an MSSpectrum containing profile data.
+
+      Same result as the iterator version, but the intensities are smoothed
+      in a contiguous array (see smoothIntensities()).
     */
     void filter(MSSpectrum & spectrum)
     {
-      // copy the data AND META DATA to the output container
-      MSSpectrum output = spectrum;
-      // filter
-      filter(spectrum.begin(), spectrum.end(), output.begin());
-      // swap back
-      std::swap(spectrum, output);
+      filterPeaks_(spectrum);
     }
 
     /**
@@ -200,35 +198,47 @@ public:
     */
     void filter(MSChromatogram & chromatogram)
     {
-      // copy the data AND META DATA to the output container
-      MSChromatogram output = chromatogram;
-      // filter
-      filter(chromatogram.begin(), chromatogram.end(), output.begin());
-      // swap back
-      std::swap(chromatogram, output);
+      filterPeaks_(chromatogram);
     }
 
     /**
       @brief Removed the noise from an MSExperiment containing profile data.
+
+      Spectra and chromatograms are smoothed in parallel.
+    */
+    void filterExperiment(PeakMap & map);
+
+    /**
+      @brief Smoothes the intensities @p in of @p n equidistant data points into @p out
+
+      Computes the same values as the iterator version of filter(). The output
+      positions of the steady state are processed in blocks, adding one filter
+      coefficient at a time to all positions of a block, which allows the
+      compiler to vectorize the convolution. Nothing is done if there are less
+      data points than the frame length.
     */
-    void filterExperiment(PeakMap & map)
+    void smoothIntensities(const double * in, double * out, Size n) const;
+
+protected:
+    /// Smoothes the intensities of a spectrum or chromatogram in place
+    template <class ContainerT>
+    void filterPeaks_(ContainerT & container) const
     {
-      Size progress = 0;
-      startProgress(0, map.size() + map.getChromatograms().size(), "smoothing data");
-      for (Size i = 0; i < map.size(); ++i)
+      const Size n = container.size();
+      if (frame_size_ > n) { return; }
+
+      std::vector<double> in(n), out(n);
+      for (Size p = 0; p < n; ++p)
       {
-        filter(map[i]);
-        setProgress(++progress);
+        in[p] = container[p].getIntensity();
       }
-      for (Size i = 0; i < map.getChromatograms().size(); ++i)
+      smoothIntensities(&in[0], &out[0], n);
+      for (Size p = 0; p < n; ++p)
       {
-        filter(map.getChromatogram(i));
-        setProgress(++progress);
+        container[p].setIntensity(out[p]);
       }
-      endProgress();
     }
 
-protected:
     /// Coefficients
     std::vector<double> coeffs_;
 
@@ -0,0 +1,121 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/INTERFACES/IMSDataConsumer.h>
+
+#include <OpenMS/KERNEL/StandardTypes.h>
+#include <OpenMS/KERNEL/MSSpectrum.h>
+#include <OpenMS/KERNEL/MSChromatogram.h>
+#include <OpenMS/TRANSFORMATIONS/RAW2PEAK/PeakPickerHiRes.h>
+
+namespace OpenMS
+{
+
+    /**
+      @brief Picks spectra and chromatograms on the fly with PeakPickerHiRes
+
+      Spectra and chromatograms are collected in batches of a fixed size. Each
+      full batch is picked in parallel (see PeakPickerHiRes::pickSpectra) and
+      then passed on, in input order, to the next consumer (e.g. a
+      PlainMSDataWritingConsumer). Memory usage is bounded by the batch size,
+      independent of the size of the input file.
+
+      Spectra that are not selected for picking (parameter 'ms_levels' of the
+      peak picker) are passed on unchanged.
+
+      @note Call flush() after the last spectrum/chromatogram was consumed.
+      The destructor flushes remaining data as well, but it cannot throw, so
+      errors (e.g. from the next consumer) are only logged there. The next
+      consumer must not be deleted before this object.
+    */
+    class OPENMS_DLLAPI MSDataPickingConsumer :
+      public Interfaces::IMSDataConsumer
+    {
+
+    public:
+
+      /**
+        @brief Constructor
+
+        @param next_consumer  consumer that receives the picked data
+        @param picker  peak picker to use (copied)
+        @param batch_size  number of spectra (or chromatograms) picked together
+        @param check_spectrum_type  if set, an exception is thrown if a centroided spectrum is selected for picking
+
+        @note This does not transfer ownership of the consumer
+      */
+      MSDataPickingConsumer(Interfaces::IMSDataConsumer* next_consumer, const PeakPickerHiRes& picker, Size batch_size = 1000, bool check_spectrum_type = true);
+
+      /// Destructor, flushes remaining data to the next consumer (errors are logged, not thrown)
+      ~MSDataPickingConsumer() override;
+
+      void setExpectedSize(Size expectedSpectra, Size expectedChromatograms) override;
+
+      void setExperimentalSettings(const ExperimentalSettings& exp) override;
+
+      /**
+        @brief Adds a spectrum to the current batch
+
+        @throw Exception::IllegalArgument if the spectrum is centroided but selected for picking (and spectrum types are checked)
+      */
+      void consumeSpectrum(SpectrumType& s) override;
+
+      void consumeChromatogram(ChromatogramType& c) override;
+
+      /**
+        @brief Picks all buffered data and passes it on to the next consumer
+
+        Call this explicitly when done, exceptions are only propagated from here.
+      */
+      void flush();
+
+    protected:
+
+      /// picks and passes on the buffered spectra
+      void flushSpectra_();
+
+      /// picks and passes on the buffered chromatograms
+      void flushChromatograms_();
+
+      Interfaces::IMSDataConsumer* next_consumer_;
+      PeakPickerHiRes picker_;
+      Size batch_size_;
+      bool check_spectrum_type_;
+      std::vector<SpectrumType> spectra_;
+      std::vector<ChromatogramType> chromatograms_;
+    };
+
+} //end namespace OpenMS
+
@@ -7,6 +7,7 @@ set(sources_list_h
   MSDataAggregatingConsumer.h
   MSDataCachedConsumer.h
   MSDataChainingConsumer.h
+  MSDataPickingConsumer.h
   MSDataStoringConsumer.h
   MSDataSqlConsumer.h
   MSDataTransformingConsumer.h
@@ -37,6 +37,7 @@
 #include <OpenMS/KERNEL/StandardTypes.h>
 
 #include <OpenMS/FORMAT/ControlledVocabulary.h>
+#include <OpenMS/FORMAT/HANDLERS/XMLHandler.h>
 #include <OpenMS/METADATA/ProteinHit.h>
 #include <OpenMS/CHEMISTRY/AASequence.h>
 #include <OpenMS/CONCEPT/UniqueIdGenerator.h>
@@ -153,8 +154,10 @@ protected:
       void parseSpectrumIdentificationProtocolElements_(xercesc::DOMNodeList* spectrumIdentificationProtocolElements);
       void parseInputElements_(xercesc::DOMNodeList* inputElements);
       void parseSpectrumIdentificationListElements_(xercesc::DOMNodeList* spectrumIdentificationListElements);
+      /// Appends the PeptideIdentification of one SpectrumIdentificationResult of the SpectrumIdentificationList @p sil to pep_id_
+      void parseSpectrumIdentificationResultElement_(xercesc::DOMElement* spectrumIdentificationResultElement, const String& sil);
       void parseSpectrumIdentificationItemSetXLMS(std::set<String>::const_iterator set_it, std::multimap<String, int> xl_val_map, xercesc::DOMElement* element_res, String spectrumID);
-      void parseSpectrumIdentificationItemElement_(xercesc::DOMElement* spectrumIdentificationItemElement, PeptideIdentification& spectrum_identification, String& spectrumIdentificationList_ref);
+      void parseSpectrumIdentificationItemElement_(xercesc::DOMElement* spectrumIdentificationItemElement, PeptideIdentification& spectrum_identification, const String& spectrumIdentificationList_ref);
       void parseProteinDetectionHypothesisElement_(xercesc::DOMElement* proteinDetectionHypothesisElement, ProteinIdentification& protein_identification);
       void parseProteinAmbiguityGroupElement_(xercesc::DOMElement* proteinAmbiguityGroupElement, ProteinIdentification& protein_identification);
       void parseProteinDetectionListElements_(xercesc::DOMNodeList* proteinDetectionListElements);
@@ -174,6 +177,9 @@ protected:
 
 
 private:
+      /// the streaming reader feeds single records through the parsing functions above
+      friend class MzIdentMLStreamHandler;
+
       MzIdentMLDOMHandler();
       MzIdentMLDOMHandler(const MzIdentMLDOMHandler& rhs);
       MzIdentMLDOMHandler& operator=(const MzIdentMLDOMHandler& rhs);
@@ -245,6 +251,9 @@ private:
       XMLCh* xml_cvparam_tag_ptr_;
       XMLCh* xml_name_attr_ptr_;
 
+      /// Helper class for string conversion (releases the transcoded strings)
+      StringManager sm_;
+
       xercesc::XercesDOMParser mzid_parser_;
 
       //from AnalysisSoftware
@@ -0,0 +1,171 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/FORMAT/HANDLERS/XMLHandler.h>
+#include <OpenMS/FORMAT/HANDLERS/MzIdentMLDOMHandler.h>
+#include <OpenMS/FORMAT/MzIdentMLFile.h>
+#include <OpenMS/METADATA/ProteinIdentification.h>
+#include <OpenMS/METADATA/PeptideIdentification.h>
+
+#include <xercesc/dom/DOMDocument.hpp>
+#include <xercesc/dom/DOMElement.hpp>
+#include <xercesc/dom/DOMImplementation.hpp>
+
+#include <vector>
+
+namespace OpenMS
+{
+  class ProgressLogger;
+
+  namespace Internal
+  {
+    /**
+        @brief XML SAX handler for reading MzIdentML files in bounded memory
+
+        The document is parsed with SAX. Only the element currently read
+        (e.g. one DBSequence, Peptide, PeptideEvidence or
+        SpectrumIdentificationResult) is built as a small DOM fragment, which
+        is passed to the parsing functions of MzIdentMLDOMHandler and released
+        afterwards. Peptide, PeptideEvidence and DBSequence records only end up
+        in the lookup tables of the DOM handler, the PeptideIdentifications are
+        handed to the consumer in batches as soon as they are complete. Hence
+        the memory consumption depends on the size of the lookup tables, not on
+        the size of the document.
+
+        The SpectrumIdentification, SpectrumIdentificationProtocol and input
+        elements are collected and parsed when the AnalysisData section starts,
+        in the same order as the DOM handler does.
+
+        Cross-linking MS files need the complete document (the peptides are
+        read differently depending on the search protocol stored after them).
+        If one is encountered, parsing stops before any identification was
+        reported and requiresDOM() returns @em true.
+
+        @note Do not use this class. It is only needed in MzIdentMLFile.
+    */
+    class OPENMS_DLLAPI MzIdentMLStreamHandler :
+      public XMLHandler
+    {
+public:
+      /// Constructor for a read-only handler appending to @p pro_id and reporting the PeptideIdentifications to @p consumer
+      MzIdentMLStreamHandler(std::vector<ProteinIdentification>& pro_id, MzIdentMLFile::PeptideIdentificationConsumer& consumer, Size batch_size, const String& filename, const String& version, const ProgressLogger& logger);
+
+      /// Destructor
+      ~MzIdentMLStreamHandler() override;
+
+      /// Returns if the file has to be read with MzIdentMLDOMHandler (cross-linking MS data)
+      bool requiresDOM() const;
+
+      // Docu in base class
+      void startElement(const XMLCh* const /*uri*/, const XMLCh* const /*local_name*/, const XMLCh* const qname, const xercesc::Attributes& attributes) override;
+
+      // Docu in base class
+      void endElement(const XMLCh* const /*uri*/, const XMLCh* const /*local_name*/, const XMLCh* const qname) override;
+
+      // Docu in base class
+      void characters(const XMLCh* const chars, const XMLSize_t length) override;
+
+      // Docu in base class
+      void endDocument() override;
+
+protected:
+      /// Parses the collected SpectrumIdentification, SpectrumIdentificationProtocol and input elements
+      void parseSettings_();
+
+      /// Passes the completed record to the DOM handler and releases it
+      void parseRecord_(xercesc::DOMElement* record);
+
+      /// Hands the PeptideIdentifications read so far to the consumer
+      void flush_();
+
+      /// Creates a new document for the record fragments (releasing the old one)
+      void renewRecordDocument_();
+
+      /// ProteinIdentifications (one per SpectrumIdentification)
+      std::vector<ProteinIdentification>& pro_id_;
+
+      /// PeptideIdentifications not yet handed to the consumer
+      std::vector<PeptideIdentification> batch_;
+
+      /// Parsing functions and lookup tables
+      MzIdentMLDOMHandler dom_handler_;
+
+      /// Consumer of the PeptideIdentifications
+      MzIdentMLFile::PeptideIdentificationConsumer& consumer_;
+
+      /// Number of PeptideIdentifications handed to the consumer at once
+      Size batch_size_;
+
+      /// Creates the documents below
+      xercesc::DOMImplementation* dom_impl_;
+
+      /// Document holding the record currently read
+      xercesc::DOMDocument* record_doc_;
+
+      /// Document collecting the elements parsed by parseSettings_()
+      xercesc::DOMDocument* settings_doc_;
+
+      /// Root of the fragment currently built (null if the current element is not recorded)
+      xercesc::DOMElement* fragment_root_;
+
+      /// Innermost open element of the fragment currently built
+      xercesc::DOMElement* current_;
+
+      /// Character data of the innermost open element
+      std::basic_string<XMLCh> text_;
+
+      /// Number of records read with the current record document
+      Size records_in_document_;
+
+      /// Id of the SpectrumIdentificationList currently read
+      String sil_id_;
+
+      /// Number of SpectrumIdentificationList elements read
+      Size sil_count_;
+
+      /// Whether parseSettings_() was called already
+      bool settings_parsed_;
+
+      /// Whether the file contains cross-linking MS data
+      bool requires_dom_;
+
+private:
+      MzIdentMLStreamHandler();
+      MzIdentMLStreamHandler(const MzIdentMLStreamHandler& rhs);
+      MzIdentMLStreamHandler& operator=(const MzIdentMLStreamHandler& rhs);
+    };
+  } // namespace Internal
+} // namespace OpenMS
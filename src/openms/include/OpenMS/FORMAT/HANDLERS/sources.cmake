@@ -11,6 +11,7 @@ MascotXMLHandler.h
 MzDataHandler.h
 MzIdentMLDOMHandler.h
 MzIdentMLHandler.h
+MzIdentMLStreamHandler.h
 MzMLHandler.h
 MzMLHandlerHelper.h
 MzMLSpectrumDecoder.h
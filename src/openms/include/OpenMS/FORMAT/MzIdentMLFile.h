@@ -50,7 +50,10 @@ namespace OpenMS
 
       This file adapter exposes the internal MzIdentML processing capabilities to the library. The file
       adapter interface is kept the same as idXML file adapter for downward capability reasons.
-      For now, read-in will be performed with DOM write-out with STREAM
+      Read-in is streamed: the referenced Peptide, PeptideEvidence and DBSequence
+      records are kept in compact lookup tables and the PeptideIdentifications
+      are built one SpectrumIdentificationResult at a time (see transform()).
+      Cross-linking MS files are read with DOM. Write-out is performed with STREAM.
 
       @note due to the limited capabilities of idXML/PeptideIdentification/ProteinIdentification not all
         MzIdentML features can be supported. Development for these structures will be discontinued, a new
@@ -69,6 +72,24 @@ namespace OpenMS
     public ProgressLogger
   {
 public:
+    /**
+        @brief Receives the PeptideIdentifications read by transform() in batches
+
+        The batches are handed over in file order. The consumer may take over
+        the content of a batch (e.g. by swapping or moving it away).
+    */
+    class OPENMS_DLLAPI PeptideIdentificationConsumer
+    {
+public:
+      /// Destructor
+      virtual ~PeptideIdentificationConsumer()
+      {
+      }
+
+      /// Processes the next batch of PeptideIdentifications
+      virtual void consume(std::vector<PeptideIdentification>& batch) = 0;
+    };
+
     ///Default constructor
     MzIdentMLFile();
     ///Destructor
@@ -82,6 +103,20 @@ public:
     */
     void load(const String& filename, std::vector<ProteinIdentification>& poid, std::vector<PeptideIdentification>& peid);
 
+    /**
+        @brief Streams the identifications of a MzIdentML file to a consumer.
+
+        The PeptideIdentifications are passed to @p consumer in batches of
+        @p batch_size as soon as they are read, so that only the batch and the
+        lookup tables of the file (peptides, peptide evidences, protein
+        sequences) are held in memory. The ProteinIdentifications are appended
+        to @p poid and are complete when the function returns.
+
+        @exception Exception::FileNotFound is thrown if the file could not be opened
+        @exception Exception::ParseError is thrown if an error occurs during parsing
+    */
+    void transform(const String& filename, std::vector<ProteinIdentification>& poid, PeptideIdentificationConsumer& consumer, Size batch_size = 10000);
+
     /**
         @brief Stores the identifications in a MzIdentML file.
 
@@ -135,6 +135,14 @@ public:
       */
       bool fit(std::vector<double> & search_engine_scores, std::vector<double> & probabilities);
 
+      /**
+          @brief computes the posterior error probabilities for all given scores (in parallel, if OpenMP is available).
+          @param search_engine_scores the data points (need not be the ones used for fitting, e.g. if the model was fit on a subsample)
+          @param probabilities the probability for each data point, in the same order. If it has some content it will be overwritten.
+          @note fit has to be used before using this function.
+      */
+      void computeProbabilities(const std::vector<double> & search_engine_scores, std::vector<double> & probabilities) const;
+
       ///Writes the distributions densities into the two vectors for a set of scores. Incorrect_densities represent the incorrectly assigned sequences.
       void fillDensities(std::vector<double> & x_scores, std::vector<double> & incorrect_density, std::vector<double> & correct_density);
       ///computes the Maximum Likelihood with a log-likelihood function.
@@ -212,6 +220,9 @@ private:
       /// transform different score types to a range and score orientation that the model can handle (engine string is assumed in upper-case)
       static double transformScore_(const String & engine, const PeptideHit & hit);
 
+      /// computes the posterior probability of being incorrectly assigned for each data point (the E-step of the EM algorithm)
+      void computePosteriors_(const std::vector<double> & incorrect_density, const std::vector<double> & correct_density, std::vector<double> & posteriors) const;
+
       /// assignment operator (not implemented)
       PosteriorErrorProbabilityModel & operator=(const PosteriorErrorProbabilityModel & rhs);
       ///Copy constructor (not implemented)
@@ -0,0 +1,215 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/config.h>
+
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+#include <OpenMS/SYSTEM/StopWatch.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Lightweight, thread-safe recording of processing phases, counters and histograms
+
+    Algorithms mark their phases with OPENMS_PROFILE_PHASE("name"), which
+    records the enclosing scope, and may add to named counters
+    (OPENMS_PROFILE_COUNTER) or histograms (OPENMS_PROFILE_HISTOGRAM).
+    For each phase, the wall clock time, the CPU time of the process (CPU time
+    divided by wall time is the average number of busy threads), the peak
+    resident memory at the end of the phase and the bytes read and written by
+    the process during the phase are recorded.
+
+    Recording is disabled by default, in which case a marker costs a single
+    atomic load. If OpenMS is configured with ENABLE_PROFILING=OFF, the
+    macros expand to nothing. TOPP tools enable recording with the
+    <tt>-profile \<file\></tt> option.
+
+    Since CPU time and I/O are measured for the whole process, phases should
+    mark coarse steps of an algorithm, not the body of a (parallel) loop.
+
+    @ingroup System
+  */
+  class OPENMS_DLLAPI Profiler
+  {
+public:
+    /// Output formats of store()
+    enum ReportFormat
+    {
+      JSON,          ///< summary per phase name, counters and histograms
+      CHROME_TRACE,  ///< every phase as event, viewable in chrome://tracing or Perfetto
+      SIZE_OF_REPORTFORMAT
+    };
+
+    /// Names of the report formats
+    static const std::string NamesOfReportFormat[SIZE_OF_REPORTFORMAT];
+
+    /// A finished phase
+    struct PhaseRecord
+    {
+      String name;
+      Size thread = 0;              ///< index of the recording thread (in order of first use)
+      Size depth = 0;               ///< nesting level within the recording thread
+      double start = 0.0;           ///< seconds since the profiler was enabled
+      double wall_time = 0.0;       ///< seconds
+      double cpu_time = 0.0;        ///< seconds, user and system time of the process
+      size_t peak_memory_kb = 0;    ///< peak resident memory of the process at the end of the phase
+      size_t bytes_read = 0;        ///< bytes read by the process during the phase
+      size_t bytes_written = 0;     ///< bytes written by the process during the phase
+    };
+
+    /// Aggregated values added to a histogram (in bins of powers of two)
+    struct Histogram
+    {
+      Size count = 0;
+      double sum = 0.0;
+      double min = 0.0;
+      double max = 0.0;
+      Size non_positive = 0;        ///< number of values <= 0
+      std::map<Int, Size> bins;     ///< number of values in [2^k, 2^(k+1)) for key k
+    };
+
+    /// Records a phase from construction to destruction (use OPENMS_PROFILE_PHASE)
+    class OPENMS_DLLAPI ScopedPhase
+    {
+public:
+      /// Starts the phase if the profiler is enabled. @p name must outlive the phase.
+      explicit ScopedPhase(const char* name);
+      /// Records the phase
+      ~ScopedPhase();
+
+      ScopedPhase(const ScopedPhase&) = delete;
+      ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+private:
+      const char* name_;
+      bool active_;
+      double start_;
+      StopWatch stop_watch_;
+      size_t bytes_read_;
+      size_t bytes_written_;
+    };
+
+    /// The profiler of the process
+    static Profiler& getInstance();
+
+    /// Is recording enabled?
+    static bool isEnabled()
+    {
+      return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /// Clears all recorded data and enables recording
+    void enable();
+
+    /// Disables recording (recorded data is kept)
+    void disable();
+
+    /// Clears all recorded data
+    void clear();
+
+    /// Adds @p value to the counter @p name
+    void addCounter(const String& name, double value);
+
+    /// Adds @p value to the histogram @p name
+    void addHistogramValue(const String& name, double value);
+
+    /// Returns the finished phases in order of completion
+    std::vector<PhaseRecord> getPhases() const;
+
+    /// Returns the counters
+    std::map<String, double> getCounters() const;
+
+    /// Returns the histograms
+    std::map<String, Histogram> getHistograms() const;
+
+    /**
+      @brief Writes the recorded data to @p filename
+
+      @exception Exception::UnableToCreateFile if the file cannot be written
+    */
+    void store(const String& filename, ReportFormat format) const;
+
+private:
+    Profiler();
+
+    /// Seconds since the profiler was enabled
+    double now_() const;
+
+    /// Index of the calling thread
+    static Size threadIndex_();
+
+    /// Adds a finished phase
+    void addPhase_(const PhaseRecord& phase);
+
+    void storeJSON_(std::ostream& os) const;
+    void storeChromeTrace_(std::ostream& os) const;
+
+    static std::atomic<bool> enabled_;
+
+    mutable std::mutex mutex_;
+    std::chrono::steady_clock::time_point origin_;
+    std::vector<PhaseRecord> phases_;
+    /// value and time of the last update
+    std::map<String, std::pair<double, double> > counters_;
+    std::map<String, Histogram> histograms_;
+  };
+
+} // namespace OpenMS
+
+#define OPENMS_PROFILE_CONCAT_IMPL_(a, b) a ## b
+#define OPENMS_PROFILE_CONCAT_(a, b) OPENMS_PROFILE_CONCAT_IMPL_(a, b)
+
+#ifdef ENABLE_PROFILING
+/// Records the enclosing scope as phase @p name (a string literal)
+#define OPENMS_PROFILE_PHASE(name) OpenMS::Profiler::ScopedPhase OPENMS_PROFILE_CONCAT_(openms_profile_phase_, __LINE__)(name)
+/// Adds @p value to the counter @p name
+#define OPENMS_PROFILE_COUNTER(name, value) \
+  do { if (OpenMS::Profiler::isEnabled()) OpenMS::Profiler::getInstance().addCounter(name, value); } while (false)
+/// Adds @p value to the histogram @p name
+#define OPENMS_PROFILE_HISTOGRAM(name, value) \
+  do { if (OpenMS::Profiler::isEnabled()) OpenMS::Profiler::getInstance().addHistogramValue(name, value); } while (false)
+#else
+#define OPENMS_PROFILE_PHASE(name)
+#define OPENMS_PROFILE_COUNTER(name, value) do { } while (false)
+#define OPENMS_PROFILE_HISTOGRAM(name, value) do { } while (false)
+#endif
@@ -43,7 +43,7 @@ namespace OpenMS
 	/**
 	@brief Some functions to get system information
 
-	Supports current memory and peak memory consumption.
+	Supports current memory and peak memory consumption as well as I/O counters.
 
 	*/
 	class OPENMS_DLLAPI SysInfo
@@ -59,17 +59,25 @@ namespace OpenMS
   
       /// Get peak memory consumption in KiloBytes (KB)
       /// On Windows, this is equivalent to 'Working Set (Memory)' in Task Manager.
-      /// On other OS this might be very unreliable, depending on operating system and kernel version.
+      /// On other OS the maximum resident set size (getrusage) is reported.
       ///
       /// @param mem_virtual Total virtual memory allocated by this process
       /// @return True on success, false otherwise. If false is returned, then @p mem_virtual is set to 0.
       static bool getProcessPeakMemoryConsumption(size_t& mem_virtual);
 
+      /// Get the number of bytes read and written by this process so far
+      /// Only supported on Windows and Linux (where reads served from the page cache are included).
+      ///
+      /// @param bytes_read Bytes read (from files, pipes, sockets) by this process
+      /// @param bytes_written Bytes written by this process
+      /// @return True on success, false otherwise. If false is returned, then both values are set to 0.
+      static bool getProcessIOBytes(size_t& bytes_read, size_t& bytes_written);
+
       /**
         @brief A convenience class to report either absolute or delta (between two timepoints) RAM usage
 
         Working RAM and Peak RAM usage are recorded at two time points ('before' and 'after').
-        @note Peak RAM is only supported on WindowsOS; other OS will only report Working RAM usage
+        @note Peak RAM is reported as maximum resident set size on other OS than Windows
         
         When constructed, MemUsage automatically queries the present RAM usage (first timepoint), i.e. calls @ref before().
         Data for the second timepoint can be recorded using @ref after().
@@ -131,9 +131,11 @@ public:
     void pick(const MSChromatogram& input, MSChromatogram& output, std::vector<PeakBoundary>& boundaries) const;
 
     /**
-     * @brief Applies the peak-picking algorithm to a map (MSExperiment). This
-     * method picks peaks for each scan in the map consecutively. The resulting
-     * picked peaks are written to the output map.
+     * @brief Applies the peak-picking algorithm to a map (MSExperiment). The
+     * resulting picked peaks are written to the output map.
+     *
+     * Spectra and chromatograms are picked in parallel (if OpenMP is
+     * enabled); the order of the output is the same as the order of the input.
      *
      * @param input  input map in profile mode
      * @param output  output map with picked peaks
@@ -142,9 +144,12 @@ public:
     void pickExperiment(const PeakMap& input, PeakMap& output, const bool check_spectrum_type = true) const;
 
     /**
-     * @brief Applies the peak-picking algorithm to a map (MSExperiment). This
-     * method picks peaks for each scan in the map consecutively. The resulting
-     * picked peaks are written to the output map.
+     * @brief Applies the peak-picking algorithm to a map (MSExperiment). The
+     * resulting picked peaks are written to the output map.
+     *
+     * Spectra and chromatograms are picked in parallel (if OpenMP is
+     * enabled); the order of the output (and of the boundaries) is the same
+     * as the order of the input.
      *
      * @param input  input map in profile mode
      * @param output  output map with picked peaks
@@ -155,14 +160,45 @@ public:
     void pickExperiment(const PeakMap& input, PeakMap& output, std::vector<std::vector<PeakBoundary> >& boundaries_spec, std::vector<std::vector<PeakBoundary> >& boundaries_chrom, const bool check_spectrum_type = true) const;
 
     /**
-      @brief Applies the peak-picking algorithm to a map (MSExperiment). This
-      method picks peaks for each scan in the map consecutively. The resulting
-      picked peaks are written to the output map.
+      @brief Applies the peak-picking algorithm to a map (MSExperiment). The
+      resulting picked peaks are written to the output map.
+
+      Spectra and chromatograms are read from disc in batches (serially), each
+      batch is then picked in parallel (if OpenMP is enabled).
 
       Currently we have to give up const-correctness but we know that everything on disc is constant
     */
     void pickExperiment(/* const */ OnDiscMSExperiment& input, PeakMap& output, const bool check_spectrum_type = true) const;
 
+    /**
+      @brief Applies the peak-picking algorithm to a batch of spectra in place.
+
+      Only spectra selected by the parameter 'ms_levels' (in auto mode: all
+      spectra which are not centroided yet) are picked, all others are left
+      unchanged. The spectra are picked in parallel (if OpenMP is enabled).
+      This is the building block for streaming (low memory) peak picking, see
+      MSDataPickingConsumer.
+
+      @param spectra  spectra to pick, will be replaced by the picked spectra
+      @param check_spectrum_type  if set, checks spectrum type and throws an exception if a centroided spectrum is selected for picking
+
+      @throw Exception::IllegalArgument if a centroided spectrum is selected for picking and @p check_spectrum_type is set
+    */
+    void pickSpectra(std::vector<MSSpectrum>& spectra, const bool check_spectrum_type = true) const;
+
+    /**
+      @brief Decides whether @p spectrum is picked (or copied unchanged) according to the 'ms_levels' parameter
+
+      @throw Exception::IllegalArgument if a centroided spectrum is selected for picking and @p check_spectrum_type is set
+    */
+    bool isSelectedForPicking(const MSSpectrum& spectrum, const bool check_spectrum_type = true) const;
+
+    /**
+      @brief Applies the peak-picking algorithm to a batch of chromatograms
+      in place. The chromatograms are picked in parallel (if OpenMP is enabled).
+    */
+    void pickChromatograms(std::vector<MSChromatogram>& chromatograms) const;
+
 protected:
     // signal-to-noise parameter
     double signal_to_noise_;
@@ -185,6 +221,9 @@ protected:
     /// unit of 'FWHM' float data array (can be absolute or ppm).
     bool report_FWHM_as_ppm_;
 
+    /// parameters of the signal-to-noise estimator (cached, to avoid copying them for every spectrum)
+    Param snt_param_;
+
     // docu in base class
     void updateMembers_() override;
 
@@ -82,8 +82,50 @@ namespace OpenMS
       return;
     }
 
-    number_of_runs_ = (number_of_runs != 0) ? number_of_runs : ids.size();
+    preprocessIDs_(ids);
+    computeConsensus_(ids, number_of_runs);
+  }
+
+
+  void ConsensusIDAlgorithm::apply(
+    const vector<vector<PeptideIdentification>*>& ids_list,
+    const vector<Size>& number_of_runs)
+  {
+    if (!number_of_runs.empty() && (number_of_runs.size() != ids_list.size()))
+    {
+      throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+                                   number_of_runs.size());
+    }
 
+    // preprocessing is independent for each spectrum/feature:
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 100)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)ids_list.size(); ++i)
+    {
+      preprocessIDs_(*ids_list[i]);
+    }
+
+    prepare_(ids_list); // subclass-specific (e.g. similarity computation)
+
+    for (Size i = 0; i < ids_list.size(); ++i)
+    {
+      if (ids_list[i]->empty()) continue; // abort if no IDs present
+      computeConsensus_(*ids_list[i],
+                        number_of_runs.empty() ? 0 : number_of_runs[i]);
+    }
+  }
+
+
+  void ConsensusIDAlgorithm::prepare_(
+    const vector<vector<PeptideIdentification>*>& /* ids_list */)
+  {
+  }
+
+
+  void ConsensusIDAlgorithm::preprocessIDs_(
+    vector<PeptideIdentification>& ids) const
+  {
     // prepare data here, so that it doesn't have to happen in each algorithm:
     for (vector<PeptideIdentification>::iterator pep_it = ids.begin(); 
          pep_it != ids.end(); ++pep_it)
@@ -97,6 +139,13 @@ namespace OpenMS
     }
     // make sure there are no duplicated hits (by sequence):
     IDFilter::removeDuplicatePeptideHits(ids, true);
+  }
+
+
+  void ConsensusIDAlgorithm::computeConsensus_(
+    vector<PeptideIdentification>& ids, Size number_of_runs)
+  {
+    number_of_runs_ = (number_of_runs != 0) ? number_of_runs : ids.size();
 
     SequenceGrouping results;
     apply_(ids, results); // actual (subclass-specific) processing
@@ -45,6 +45,72 @@ namespace OpenMS
   }
 
 
+  double ConsensusIDAlgorithmSimilarity::getSimilarity_(const AASequence& seq1,
+                                                       const AASequence& seq2)
+  {
+    if (seq1 == seq2) return 1.0;
+    // order of sequences matters for cache look-up:
+    pair<AASequence, AASequence> seq_pair = ((seq2 < seq1) ? // no "operator>"
+                                             make_pair(seq2, seq1) :
+                                             make_pair(seq1, seq2));
+    SimilarityCache::iterator pos = similarities_.find(seq_pair);
+    if (pos != similarities_.end()) return pos->second; // score found in cache
+
+    double score_sim = computeSimilarity_(seq_pair.first, seq_pair.second);
+    similarities_[seq_pair] = score_sim; // cache the similarity score
+    return score_sim;
+  }
+
+
+  void ConsensusIDAlgorithmSimilarity::prepare_(
+    const vector<vector<PeptideIdentification>*>& ids_list)
+  {
+    // collect sequence pairs that will be compared in "apply_" and are not in
+    // the cache yet (elements of unordered maps don't move on insertion):
+    vector<SimilarityCache::value_type*> new_pairs;
+    for (vector<vector<PeptideIdentification>*>::const_iterator list_it =
+           ids_list.begin(); list_it != ids_list.end(); ++list_it)
+    {
+      const vector<PeptideIdentification>& ids = **list_it;
+      for (vector<PeptideIdentification>::const_iterator id1 = ids.begin();
+           id1 != ids.end(); ++id1)
+      {
+        // each pair of ID runs is considered once (similarity is symmetric):
+        for (vector<PeptideIdentification>::const_iterator id2 = id1 + 1;
+             id2 != ids.end(); ++id2)
+        {
+          for (vector<PeptideHit>::const_iterator hit1 =
+                 id1->getHits().begin(); hit1 != id1->getHits().end(); ++hit1)
+          {
+            const AASequence& seq1 = hit1->getSequence();
+            for (vector<PeptideHit>::const_iterator hit2 =
+                   id2->getHits().begin(); hit2 != id2->getHits().end();
+                 ++hit2)
+            {
+              const AASequence& seq2 = hit2->getSequence();
+              if (seq1 == seq2) continue;
+              pair<SimilarityCache::iterator, bool> ins = similarities_.insert(
+                make_pair((seq2 < seq1) ? make_pair(seq2, seq1) :
+                          make_pair(seq1, seq2), 0.0));
+              if (ins.second) new_pairs.push_back(&(*ins.first));
+            }
+          }
+        }
+      }
+    }
+
+    // compute the missing similarities:
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 100)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)new_pairs.size(); ++i)
+    {
+      new_pairs[i]->second = computeSimilarity_(new_pairs[i]->first.first,
+                                                new_pairs[i]->first.second);
+    }
+  }
+
+
   void ConsensusIDAlgorithmSimilarity::apply_(
     vector<PeptideIdentification>& ids, SequenceGrouping& results)
   {
@@ -43,6 +43,10 @@
 #include <OpenMS/FILTERING/TRANSFORMERS/SpectraMerger.h>
 #include <OpenMS/FILTERING/TRANSFORMERS/WindowMower.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace OpenMS
 {
 
@@ -285,90 +289,35 @@ MetaboliteSpectralMatching::~MetaboliteSpectralMatching()
 
 /// public methods
 
-double MetaboliteSpectralMatching::computeHyperScore(MSSpectrum exp_spectrum, MSSpectrum db_spectrum,
-                             const double& fragment_mass_error, const double& mz_lower_bound)
+double MetaboliteSpectralMatching::computeHyperScore(const MSSpectrum& exp_spectrum, const MSSpectrum& db_spectrum,
+                             const double& fragment_mass_error, const double& mz_lower_bound) const
 {
-
-  double dot_product(0.0);
-  Size matched_ions_count(0);
-
-  // scan for matching peaks between observed and DB stored spectra
-  for (MSSpectrum::iterator frag_it = exp_spectrum.MZBegin(mz_lower_bound); frag_it != exp_spectrum.end(); ++frag_it)
-  {
-    double frag_mz = frag_it->getMZ();
-
-    double mz_offset = fragment_mass_error;
-
-    if (mz_error_unit_ == "ppm")
-    {
-      mz_offset = frag_mz * 1e-6 * fragment_mass_error;
-    }
-
-    MSSpectrum::iterator db_mass_it = db_spectrum.MZBegin(frag_mz - mz_offset);
-    MSSpectrum::iterator db_mass_end = db_spectrum.MZEnd(frag_mz + mz_offset);
-
-    std::pair<double, Peak1D> nearest_peak(mz_offset + 1.0, Peak1D());
-
-    // linear search for peak nearest to observed fragment peak
-    for (; db_mass_it != db_mass_end; ++db_mass_it)
-    {
-      double db_mz(db_mass_it->getMZ());
-      double abs_mass_diff(std::abs(frag_mz - db_mz));
-
-      if (abs_mass_diff < nearest_peak.first) {
-        nearest_peak.first = abs_mass_diff;
-        nearest_peak.second = *db_mass_it;
-      }
-    }
-
-    // update dot product
-    if (nearest_peak.second.getIntensity() > 0.0)
-    {
-      ++matched_ions_count;
-      dot_product += frag_it->getIntensity() * nearest_peak.second.getIntensity();
-    }
-  }
-
-  double matched_ions_term(0.0);
-
-  // return score 0 if too few matched ions
-  if (matched_ions_count < 3)
-  {
-    return matched_ions_term;
-  }
-
-
-  if (matched_ions_count <= boost::math::max_factorial<double>::value)
+  std::vector<double> exp_mz(exp_spectrum.size()), db_mz(db_spectrum.size());
+  std::vector<float> exp_int(exp_spectrum.size()), db_int(db_spectrum.size());
+  for (Size i = 0; i < exp_spectrum.size(); ++i)
   {
-    matched_ions_term = std::log(boost::math::factorial<double>((double)matched_ions_count));
-  }
-  else
-  {
-    matched_ions_term = std::log(boost::math::factorial<double>(boost::math::max_factorial<double>::value));
+    exp_mz[i] = exp_spectrum[i].getMZ();
+    exp_int[i] = exp_spectrum[i].getIntensity();
   }
-
-  double hyperscore(std::log(dot_product) + matched_ions_term);
-
-
-  if (hyperscore < 0)
+  for (Size i = 0; i < db_spectrum.size(); ++i)
   {
-    hyperscore = 0;
+    db_mz[i] = db_spectrum[i].getMZ();
+    db_int[i] = db_spectrum[i].getIntensity();
   }
 
-  return hyperscore;
+  PeakArrayView_ exp_peaks = {exp_mz.data(), exp_int.data(), exp_mz.size()};
+  PeakArrayView_ db_peaks = {db_mz.data(), db_int.data(), db_mz.size()};
+  return computeHyperScore_(exp_peaks, db_peaks, fragment_mass_error, mz_lower_bound);
 }
 
 void MetaboliteSpectralMatching::run(PeakMap & msexp, PeakMap & spec_db, MzTab& mztab_out)
 {
   std::sort(spec_db.begin(), spec_db.end(), PrecursorMZLess);
 
-  std::vector<double> mz_keys;
-
-  // copy precursor m/z values to vector for searching
-  for (Size spec_idx = 0; spec_idx < spec_db.size(); ++spec_idx)
-  {
-    mz_keys.push_back(spec_db[spec_idx].getPrecursors()[0].getMZ());
-  }
+  // copy precursor m/z values and peaks to contiguous arrays for searching
+  LibraryIndex_ library;
+  buildLibraryIndex_(spec_db, library);
+  const std::vector<double>& mz_keys = library.precursor_mz;
 
   // remove potential noise peaks by selecting the ten most intense peak per 100 Da window
   WindowMower wm;
@@ -387,21 +336,34 @@ void MetaboliteSpectralMatching::run(PeakMap & msexp, PeakMap & spec_db, MzTab&
   wm.filterPeakMap(msexp);
 
 
-  // container storing results
-  std::vector<SpectralMatch> matching_results;
-
+  // results of each query spectrum (filled in parallel, concatenated in input order)
+  std::vector<std::vector<SpectralMatch> > spectrum_results(msexp.size());
 
-  for (Size spec_idx = 0; spec_idx < msexp.size(); ++spec_idx)
+  Size progress = 0;
+  startProgress(0, msexp.size(), "searching spectral library");
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (SignedSize spec_idx = 0; spec_idx < (SignedSize)msexp.size(); ++spec_idx)
   {
-    // std::cout << "merged spectrum no. " << spec_idx << " with #fragment ions: " << msexp[spec_idx].size() << std::endl;
+    const MSSpectrum& query = msexp[spec_idx];
+    std::vector<SpectralMatch>& matching_results = spectrum_results[spec_idx];
+
+    // the query peaks are copied once and scored against all candidates
+    std::vector<double> query_mz(query.size());
+    std::vector<float> query_int(query.size());
+    for (Size i = 0; i < query.size(); ++i)
+    {
+      query_mz[i] = query[i].getMZ();
+      query_int[i] = query[i].getIntensity();
+    }
+    const PeakArrayView_ query_peaks = {query_mz.data(), query_int.data(), query_mz.size()};
 
     // iterate over all precursor masses
-    for (Size prec_idx = 0; prec_idx < msexp[spec_idx].getPrecursors().size(); ++prec_idx)
+    for (Size prec_idx = 0; prec_idx < query.getPrecursors().size(); ++prec_idx)
     {
       // get precursor m/z
-      double precursor_mz(msexp[spec_idx].getPrecursors()[prec_idx].getMZ());
-
-      // std::cout << "precursor no. " << prec_idx << ": mz " << precursor_mz << " ";
+      double precursor_mz(query.getPrecursors()[prec_idx].getMZ());
 
       double prec_mz_lowerbound, prec_mz_upperbound;
 
@@ -417,60 +379,39 @@ void MetaboliteSpectralMatching::run(PeakMap & msexp, PeakMap & spec_db, MzTab&
         prec_mz_upperbound = precursor_mz + ppm_offset;
       }
 
-
-      // std::cout << "lower mz: " << prec_mz_lowerbound << " ";
-      // std::cout << "upper mz: " << prec_mz_upperbound << std::endl;
-
       std::vector<double>::const_iterator lower_it = std::lower_bound(mz_keys.begin(), mz_keys.end(), prec_mz_lowerbound);
       std::vector<double>::const_iterator upper_it = std::upper_bound(mz_keys.begin(), mz_keys.end(), prec_mz_upperbound);
 
       Size start_idx(lower_it - mz_keys.begin());
       Size end_idx(upper_it - mz_keys.begin());
 
-      //std::cout << "identifying " << msexp[spec_idx].getMetaValue("Massbank_Accession_ID") << std::endl;
-
       std::vector<SpectralMatch> partial_results;
 
       for (Size search_idx = start_idx; search_idx < end_idx; ++search_idx)
       {
-        // do spectral matching
-        // std::cout << "scanning " << spec_db[search_idx].getPrecursors()[0].getMZ() << " " << spec_db[search_idx].getMetaValue("Metabolite_Name") << std::endl;
-
         // check for charge state of precursor ions: do they match?
-        if ( (ion_mode_ == "positive" && spec_db[search_idx].getPrecursors()[0].getCharge() < 0) || (ion_mode_ == "negative" && spec_db[search_idx].getPrecursors()[0].getCharge() > 0))
+        if ( (ion_mode_ == "positive" && library.precursor_charge[search_idx] < 0) || (ion_mode_ == "negative" && library.precursor_charge[search_idx] > 0))
         {
           continue;
         }
 
-        double hyperscore(computeHyperScore(msexp[spec_idx], spec_db[search_idx], fragment_mz_error_, 0.0));
+        // do spectral matching
+        double hyperscore(computeHyperScore_(query_peaks, library.getPeaks(search_idx), fragment_mz_error_, 0.0));
 
-        // std::cout << " scored with " << hyperScore << std::endl;
         if (hyperscore > 0)
         {
-          // std::cout << "  ** detected " << spec_db[search_idx].getMetaValue("Massbank_Accession_ID") << " " << spec_db[search_idx].getMetaValue("Metabolite_Name") << " scored with " << hyperscore << std::endl;
-
           // score result temporarily
           SpectralMatch tmp_match;
           tmp_match.setObservedPrecursorMass(precursor_mz);
-          tmp_match.setFoundPrecursorMass(spec_db[search_idx].getPrecursors()[0].getMZ());
-          double obs_rt = std::floor(msexp[spec_idx].getRT() * 10)/10.0;
+          tmp_match.setFoundPrecursorMass(library.precursor_mz[search_idx]);
+          double obs_rt = std::floor(query.getRT() * 10)/10.0;
           tmp_match.setObservedPrecursorRT(obs_rt);
-          tmp_match.setFoundPrecursorCharge(spec_db[search_idx].getPrecursors()[0].getCharge());
+          tmp_match.setFoundPrecursorCharge(library.precursor_charge[search_idx]);
           tmp_match.setMatchingScore(hyperscore);
           tmp_match.setObservedSpectrumIndex(spec_idx);
           tmp_match.setMatchingSpectrumIndex(search_idx);
 
-          tmp_match.setPrimaryIdentifier(spec_db[search_idx].getMetaValue("Massbank_Accession_ID"));
-          tmp_match.setSecondaryIdentifier(spec_db[search_idx].getMetaValue("HMDB_ID"));
-          tmp_match.setSumFormula(spec_db[search_idx].getMetaValue("Sum_Formula"));
-          tmp_match.setCommonName(spec_db[search_idx].getMetaValue("Metabolite_Name"));
-          tmp_match.setInchiString(spec_db[search_idx].getMetaValue("Inchi_String"));
-          tmp_match.setSMILESString(spec_db[search_idx].getMetaValue("SMILES_String"));
-          tmp_match.setPrecursorAdduct(spec_db[search_idx].getMetaValue("Precursor_Ion"));
-
-
           partial_results.push_back(tmp_match);
-
         }
       }
 
@@ -486,7 +427,6 @@ void MetaboliteSpectralMatching::run(PeakMap & msexp, PeakMap & spec_db, MzTab&
 
         for (Size result_idx = 0; result_idx < last_result_idx; ++result_idx)
         {
-          // std::cout << "score: " << partial_results[result_idx].getMatchingScore() << " " << partial_results[result_idx].getMatchingSpectrumIndex() << std::endl;
           matching_results.push_back(partial_results[result_idx]);
         }
       }
@@ -500,7 +440,37 @@ void MetaboliteSpectralMatching::run(PeakMap & msexp, PeakMap & spec_db, MzTab&
       }
 
     } // end precursor loop
+
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+    ++progress;
+
+    IF_MASTERTHREAD
+    {
+      setProgress(progress);
+    }
   } // end spectra loop
+  endProgress();
+
+  // container storing results, the meta information is only looked up for the reported matches
+  std::vector<SpectralMatch> matching_results;
+  for (Size spec_idx = 0; spec_idx < spectrum_results.size(); ++spec_idx)
+  {
+    for (std::vector<SpectralMatch>::iterator match_it = spectrum_results[spec_idx].begin(); match_it != spectrum_results[spec_idx].end(); ++match_it)
+    {
+      const MSSpectrum& db_spectrum = spec_db[match_it->getMatchingSpectrumIndex()];
+      match_it->setPrimaryIdentifier(db_spectrum.getMetaValue("Massbank_Accession_ID"));
+      match_it->setSecondaryIdentifier(db_spectrum.getMetaValue("HMDB_ID"));
+      match_it->setSumFormula(db_spectrum.getMetaValue("Sum_Formula"));
+      match_it->setCommonName(db_spectrum.getMetaValue("Metabolite_Name"));
+      match_it->setInchiString(db_spectrum.getMetaValue("Inchi_String"));
+      match_it->setSMILESString(db_spectrum.getMetaValue("SMILES_String"));
+      match_it->setPrecursorAdduct(db_spectrum.getMetaValue("Precursor_Ion"));
+
+      matching_results.push_back(*match_it);
+    }
+  }
 
   // write final results to MzTab
   exportMzTab_(matching_results, mztab_out);
@@ -519,6 +489,125 @@ void MetaboliteSpectralMatching::updateMembers_()
 }
 
 
+MetaboliteSpectralMatching::PeakArrayView_ MetaboliteSpectralMatching::LibraryIndex_::getPeaks(Size i) const
+{
+  PeakArrayView_ view = {peak_mz.data() + peak_offset[i], peak_intensity.data() + peak_offset[i], peak_offset[i + 1] - peak_offset[i]};
+  return view;
+}
+
+void MetaboliteSpectralMatching::buildLibraryIndex_(const PeakMap& spec_db, LibraryIndex_& index) const
+{
+  Size n_peaks(0);
+  for (Size spec_idx = 0; spec_idx < spec_db.size(); ++spec_idx)
+  {
+    n_peaks += spec_db[spec_idx].size();
+  }
+
+  index.precursor_mz.clear();
+  index.precursor_charge.clear();
+  index.peak_offset.clear();
+  index.peak_mz.clear();
+  index.peak_intensity.clear();
+
+  index.precursor_mz.reserve(spec_db.size());
+  index.precursor_charge.reserve(spec_db.size());
+  index.peak_offset.reserve(spec_db.size() + 1);
+  index.peak_mz.reserve(n_peaks);
+  index.peak_intensity.reserve(n_peaks);
+
+  index.peak_offset.push_back(0);
+  for (Size spec_idx = 0; spec_idx < spec_db.size(); ++spec_idx)
+  {
+    const MSSpectrum& spectrum = spec_db[spec_idx];
+    index.precursor_mz.push_back(spectrum.getPrecursors()[0].getMZ());
+    index.precursor_charge.push_back(spectrum.getPrecursors()[0].getCharge());
+    for (MSSpectrum::ConstIterator peak_it = spectrum.begin(); peak_it != spectrum.end(); ++peak_it)
+    {
+      index.peak_mz.push_back(peak_it->getMZ());
+      index.peak_intensity.push_back(peak_it->getIntensity());
+    }
+    index.peak_offset.push_back(index.peak_mz.size());
+  }
+}
+
+double MetaboliteSpectralMatching::computeHyperScore_(const PeakArrayView_& exp_peaks, const PeakArrayView_& db_peaks,
+                                                      const double& fragment_mass_error, const double& mz_lower_bound) const
+{
+  double dot_product(0.0);
+  Size matched_ions_count(0);
+
+  const double* db_mz_begin = db_peaks.mz;
+  const double* db_mz_end = db_peaks.mz + db_peaks.size;
+
+  // scan for matching peaks between observed and DB stored spectra
+  for (Size frag_idx = std::lower_bound(exp_peaks.mz, exp_peaks.mz + exp_peaks.size, mz_lower_bound) - exp_peaks.mz;
+       frag_idx < exp_peaks.size; ++frag_idx)
+  {
+    double frag_mz = exp_peaks.mz[frag_idx];
+
+    double mz_offset = fragment_mass_error;
+
+    if (mz_error_unit_ == "ppm")
+    {
+      mz_offset = frag_mz * 1e-6 * fragment_mass_error;
+    }
+
+    const double* db_mass_it = std::lower_bound(db_mz_begin, db_mz_end, frag_mz - mz_offset);
+    const double* db_mass_end = std::upper_bound(db_mass_it, db_mz_end, frag_mz + mz_offset);
+
+    double nearest_diff(mz_offset + 1.0);
+    float nearest_intensity(0.0);
+
+    // linear search for peak nearest to observed fragment peak
+    for (; db_mass_it != db_mass_end; ++db_mass_it)
+    {
+      double abs_mass_diff(std::abs(frag_mz - *db_mass_it));
+
+      if (abs_mass_diff < nearest_diff)
+      {
+        nearest_diff = abs_mass_diff;
+        nearest_intensity = db_peaks.intensity[db_mass_it - db_mz_begin];
+      }
+    }
+
+    // update dot product
+    if (nearest_intensity > 0.0)
+    {
+      ++matched_ions_count;
+      dot_product += exp_peaks.intensity[frag_idx] * nearest_intensity;
+    }
+  }
+
+  double matched_ions_term(0.0);
+
+  // return score 0 if too few matched ions
+  if (matched_ions_count < 3)
+  {
+    return matched_ions_term;
+  }
+
+
+  if (matched_ions_count <= boost::math::max_factorial<double>::value)
+  {
+    matched_ions_term = std::log(boost::math::factorial<double>((double)matched_ions_count));
+  }
+  else
+  {
+    matched_ions_term = std::log(boost::math::factorial<double>(boost::math::max_factorial<double>::value));
+  }
+
+  double hyperscore(std::log(dot_product) + matched_ions_term);
+
+
+  if (hyperscore < 0)
+  {
+    hyperscore = 0;
+  }
+
+  return hyperscore;
+}
+
+
 /// private methods
 
 void MetaboliteSpectralMatching::exportMzTab_(const std::vector<SpectralMatch>& overall_results, MzTab& mztab_out)
@@ -33,6 +33,7 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/ANALYSIS/MAPMATCHING/FeatureGroupingAlgorithmKD.h>
+#include <OpenMS/SYSTEM/Profiler.h>
 #include <OpenMS/ANALYSIS/MAPMATCHING/MapAlignmentAlgorithmKD.h>
 #include <OpenMS/METADATA/ProteinIdentification.h>
 #include <OpenMS/METADATA/PeptideIdentification.h>
@@ -107,6 +108,7 @@ namespace OpenMS
   void FeatureGroupingAlgorithmKD::group_(const vector<MapType>& input_maps,
                                           ConsensusMap& out)
   {
+    OPENMS_PROFILE_PHASE("FeatureGroupingAlgorithmKD");
     // set parameters
     String mz_unit(param_.getValue("mz_unit").toString());
     mz_ppm_ = mz_unit == "ppm";
@@ -33,6 +33,7 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/ANALYSIS/MAPMATCHING/FeatureGroupingAlgorithmLabeled.h>
+#include <OpenMS/SYSTEM/Profiler.h>
 #include <OpenMS/ANALYSIS/MAPMATCHING/LabeledPairFinder.h>
 
 #include <OpenMS/KERNEL/ConversionHelper.h>
@@ -56,6 +57,7 @@ namespace OpenMS
 
   void FeatureGroupingAlgorithmLabeled::group(const std::vector<FeatureMap> & maps, ConsensusMap & out)
   {
+    OPENMS_PROFILE_PHASE("FeatureGroupingAlgorithmLabeled");
     //check that the number of maps is ok
     if (maps.size() != 1)
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Exactly one map must be given!");
@@ -33,6 +33,7 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/ANALYSIS/MAPMATCHING/FeatureGroupingAlgorithmQT.h>
+#include <OpenMS/SYSTEM/Profiler.h>
 #include <OpenMS/ANALYSIS/MAPMATCHING/QTClusterFinder.h>
 #include <OpenMS/METADATA/ProteinIdentification.h>
 #include <OpenMS/METADATA/PeptideIdentification.h>
@@ -58,6 +59,7 @@ namespace OpenMS
   void FeatureGroupingAlgorithmQT::group_(const vector<MapType>& maps,
                                           ConsensusMap& out)
   {
+    OPENMS_PROFILE_PHASE("FeatureGroupingAlgorithmQT");
     // check that the number of maps is ok:
     if (maps.size() < 2)
     {
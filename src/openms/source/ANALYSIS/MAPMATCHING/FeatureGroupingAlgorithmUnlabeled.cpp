@@ -33,6 +33,7 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/ANALYSIS/MAPMATCHING/FeatureGroupingAlgorithmUnlabeled.h>
+#include <OpenMS/SYSTEM/Profiler.h>
 #include <OpenMS/ANALYSIS/MAPMATCHING/StablePairFinder.h>
 
 namespace OpenMS
@@ -54,6 +55,7 @@ namespace OpenMS
 
   void FeatureGroupingAlgorithmUnlabeled::group(const std::vector<FeatureMap> & maps, ConsensusMap & out)
   {
+    OPENMS_PROFILE_PHASE("FeatureGroupingAlgorithmUnlabeled");
     // check that the number of maps is ok
     if (maps.size() < 2)
     {
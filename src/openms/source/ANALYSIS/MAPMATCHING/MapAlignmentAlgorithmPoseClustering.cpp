@@ -33,6 +33,7 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/ANALYSIS/MAPMATCHING/MapAlignmentAlgorithmPoseClustering.h>
+#include <OpenMS/SYSTEM/Profiler.h>
 #include <OpenMS/FORMAT/FeatureXMLFile.h>
 #include <OpenMS/FORMAT/FileHandler.h>
 
@@ -78,13 +79,13 @@ namespace OpenMS
   void MapAlignmentAlgorithmPoseClustering::align(const PeakMap& map, TransformationDescription& trafo)
   {
     ConsensusMap map_scene;
-    PeakMap map2(map);
-    MapConversion::convert(1, map2, map_scene, max_num_peaks_considered_); // copy MSExperiment here, since it is sorted internally by intensity
+    MapConversion::convert(1, map, map_scene, max_num_peaks_considered_);
     align(map_scene, trafo);
   }
 
   void MapAlignmentAlgorithmPoseClustering::align(const ConsensusMap& map, TransformationDescription& trafo)
   {
+    OPENMS_PROFILE_PHASE("MapAlignmentAlgorithmPoseClustering");
     // TODO: move this to updateMembers_? (if ConsensusMap prevails)
     // TODO: why does superimposer work on consensus map???
     const ConsensusMap & map_model = reference_;
@@ -92,7 +93,10 @@ namespace OpenMS
 
     // run superimposer to find the global transformation
     TransformationDescription si_trafo;
-    superimposer_.run(map_model, map_scene, si_trafo);
+    {
+      OPENMS_PROFILE_PHASE("MapAlignmentAlgorithmPoseClustering: superimposer");
+      superimposer_.run(map_model, map_scene, si_trafo);
+    }
 
     // apply transformation to consensus features and contained feature
     // handles
@@ -113,7 +117,10 @@ namespace OpenMS
     std::vector<ConsensusMap> input(2);
     input[0] = map_model;
     input[1] = map_scene;
-    pairfinder_.run(input, result);
+    {
+      OPENMS_PROFILE_PHASE("MapAlignmentAlgorithmPoseClustering: pair finder");
+      pairfinder_.run(input, result);
+    }
 
     // calculate the local transformation
     si_trafo.invert(); // to undo the transformation applied above
@@ -136,6 +143,7 @@ namespace OpenMS
         }
       }
     }
+    OPENMS_PROFILE_HISTOGRAM("MapAlignmentAlgorithmPoseClustering: matched features per map", data.size());
     trafo = TransformationDescription(data);
     trafo.fitModel("linear");
   }
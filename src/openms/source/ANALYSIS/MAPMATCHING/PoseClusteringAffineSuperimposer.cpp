@@ -34,6 +34,7 @@
 
 #include <OpenMS/ANALYSIS/MAPMATCHING/PoseClusteringAffineSuperimposer.h>
 #include <OpenMS/FILTERING/BASELINE/MorphologicalFilter.h>
+#include <OpenMS/KERNEL/ComparatorUtils.h>
 #include <OpenMS/MATH/STATISTICS/BasicStatistics.h>
 #include <OpenMS/MATH/MISC/LinearInterpolation.h>
 
@@ -62,6 +63,19 @@ namespace OpenMS
                                                 "and to disregard weak signals during alignment.  For using all points, set this to -1.");
     defaults_.setMinInt("num_used_points", -1);
 
+    defaults_.setValue("point_selection", "intensity", "How the 'num_used_points' elements of each map are selected.  "
+                                                       "'intensity': the most intense ones.  'rt_stratified': the retention time "
+                                                       "range is split into 'rt_strata' intervals of equal length, each of which "
+                                                       "contributes (up to) its 'num_used_points' / 'rt_strata' most intense elements, "
+                                                       "the remaining slots are filled with the most intense elements left.  This avoids "
+                                                       "that the alignment only relies on the most crowded part of the gradient.",
+                       ListUtils::create<String>("advanced"));
+    defaults_.setValidStrings("point_selection", ListUtils::create<String>("intensity,rt_stratified"));
+
+    defaults_.setValue("rt_strata", 10, "Number of retention time intervals for 'point_selection' 'rt_stratified'.",
+                       ListUtils::create<String>("advanced"));
+    defaults_.setMinInt("rt_strata", 1);
+
     defaults_.setValue("scaling_bucket_size", 0.005, "The scaling of the retention time "
                                                      "interval is being hashed into buckets of this size during pose "
                                                      "clustering.  A good choice for this would be a bit smaller than the "
@@ -134,50 +148,109 @@ namespace OpenMS
   }
 
   /**
-    @brief Estimates scaling by trying different (weighted) affine transformations.
-
-    Basically try all combinations of two pairs from map model (i,j) and two
-    pairs from map scene (k,l) and compute shift and scale based on these
-    four points. The computed value is weighed by the intensity of all
-    points, thus this is a density-based approach.
+    @brief Reduces @p map to (at most) @p n of its elements, ranked by intensity.
 
-    In the first round, compute and store every combination. In the second
-    round, only consider quadruplets where the scaling factor matches the
-    estimated bounds of (scale_low_1,scale_high_1), discard all other data.
+    Without stratification, the @p n most intense elements are kept. With
+    @p rt_strata > 1, the retention time range is split into intervals of
+    equal length and each interval first contributes its min(available, n /
+    rt_strata) most intense elements, the remaining slots are filled with the
+    most intense elements not selected yet. Exactly min(n, map.size())
+    elements are kept in both cases, thus the number of hashed quadruplets
+    stays bounded independent of the map size.
 
   */
-  void affineTransformationHashing(const bool do_dump_pairs,
-                                   const std::vector<Peak2D> & model_map,
-                                   const std::vector<Peak2D> & scene_map,
-                                   Math::LinearInterpolation<double, double>& scaling_hash_1,
-                                   Math::LinearInterpolation<double, double>& scaling_hash_2,
-                                   Math::LinearInterpolation<double, double>& rt_low_hash_,
-                                   Math::LinearInterpolation<double, double>& rt_high_hash_,
-                                   const int hashing_round,
-                                   const double rt_pair_min_distance,
-                                   const String dump_pairs_basename,
-                                   const Int dump_buckets_serial,
-                                   const double mz_pair_max_distance,
-                                   const double winlength_factor_baseline,
-                                   const double total_intensity_ratio,
-                                   const double scale_low_1,
-                                   const double scale_high_1,
-                                   const double rt_low, const double rt_high)
+  void selectPoints(std::vector<Peak2D>& map, const Size n, const UInt rt_strata)
   {
-    Size const model_map_size = model_map.size();   // i j
-    Size const scene_map_size = scene_map.size();   // k l
+    if (map.size() <= n)
+    {
+      return;
+    }
 
-    String dump_pairs_filename;
-    std::ofstream dump_pairs_file;
-    if (do_dump_pairs)
+    if (rt_strata <= 1)
     {
-      dump_pairs_filename = dump_pairs_basename + "_phase_two_" + String(dump_buckets_serial);
-      dump_pairs_file.open(dump_pairs_filename.c_str());
-      dump_pairs_file << "#" << ' ' << "i" << ' ' << "j" << ' ' << "k" << ' ' << "l" << ' ' << std::endl;
+      // sort the last data points by ascending intensity (from the right, using reverse iterators)
+      //  -> linear in complexity, should be faster than sorting and then taking cutoff
+      std::nth_element(map.rbegin(), map.rbegin() + (map.size() - n), map.rend(), Peak2D::IntensityLess());
+      map.resize(n);
+      return;
+    }
+
+    // rank all elements by decreasing intensity (ties broken by position in the input for reproducibility)
+    std::stable_sort(map.begin(), map.end(), reverseComparator(Peak2D::IntensityLess()));
+
+    const double min_rt = std::min_element(map.begin(), map.end(), Peak2D::RTLess())->getRT();
+    const double max_rt = std::max_element(map.begin(), map.end(), Peak2D::RTLess())->getRT();
+    const double stratum_width = (max_rt - min_rt) / rt_strata;
+    const Size quota = n / rt_strata;
+
+    std::vector<Size> stratum_count(rt_strata, 0);
+    std::vector<bool> selected(map.size(), false);
+    Size nr_selected = 0;
+    for (Size index = 0; index < map.size() && nr_selected < n; ++index)
+    {
+      Size stratum = 0;
+      if (stratum_width > 0)
+      {
+        stratum = std::min(Size((map[index].getRT() - min_rt) / stratum_width), Size(rt_strata - 1));
+      }
+      if (stratum_count[stratum] < quota)
+      {
+        ++stratum_count[stratum];
+        selected[index] = true;
+        ++nr_selected;
+      }
+    }
+    // fill up with the most intense elements left
+    for (Size index = 0; index < map.size() && nr_selected < n; ++index)
+    {
+      if (!selected[index])
+      {
+        selected[index] = true;
+        ++nr_selected;
+      }
+    }
+
+    Size kept = 0;
+    for (Size index = 0; index < map.size(); ++index)
+    {
+      if (selected[index])
+      {
+        map[kept++] = map[index];
+      }
     }
+    map.resize(kept);
+  }
+
+  /**
+    @brief Hashes the affine transformations of all quadruplets whose first
+    point in the model map (i) lies in [i_begin, i_end).
+
+    See affineTransformationHashing(), pairs are written to @p
+    dump_pairs_file unless it is a null pointer.
+
+  */
+  void affineTransformationHashingRange(const Size i_begin, const Size i_end,
+                                        const std::vector<Peak2D> & model_map,
+                                        const std::vector<Peak2D> & scene_map,
+                                        Math::LinearInterpolation<double, double>& scaling_hash_1,
+                                        Math::LinearInterpolation<double, double>& scaling_hash_2,
+                                        Math::LinearInterpolation<double, double>& rt_low_hash_,
+                                        Math::LinearInterpolation<double, double>& rt_high_hash_,
+                                        const int hashing_round,
+                                        const double rt_pair_min_distance,
+                                        std::ofstream * dump_pairs_file,
+                                        const double mz_pair_max_distance,
+                                        const double winlength_factor_baseline,
+                                        const double total_intensity_ratio,
+                                        const double scale_low_1,
+                                        const double scale_high_1,
+                                        const double rt_low, const double rt_high)
+  {
+    Size const model_map_size = model_map.size();   // i j
+    Size const scene_map_size = scene_map.size();   // k l
 
     // first point in model map (i)
-    for (Size i = 0, i_low = 0, i_high = 0, k_low = 0, k_high = 0; i < model_map_size - 1; ++i)
+    for (Size i = i_begin, i_low = 0, i_high = 0, k_low = 0, k_high = 0; i < i_end; ++i)
     {
       // Adjust window around i in model map (get all features in a m/z range of item i in the model map)
       while (i_low < model_map_size && model_map[i_low].getMZ() < model_map[i].getMZ() - mz_pair_max_distance)
@@ -294,9 +367,9 @@ namespace OpenMS
               const double rt_high_image = shift + rt_high * scaling;
               rt_high_hash_.addValue(rt_high_image, similarity_ik_jl);
 
-              if (do_dump_pairs)
+              if (dump_pairs_file)
               {
-                dump_pairs_file << i << ' ' << model_map[i].getRT() << ' ' << model_map[i].getMZ() << ' ' << j << ' ' << model_map[j].getRT() << ' '
+                *dump_pairs_file << i << ' ' << model_map[i].getRT() << ' ' << model_map[i].getMZ() << ' ' << j << ' ' << model_map[j].getRT() << ' '
                                 << model_map[j].getMZ() << ' ' << k << ' ' << scene_map[k].getRT() << ' ' << scene_map[k].getMZ() << ' ' << l << ' '
                                 << scene_map[l].getRT() << ' ' << scene_map[l].getMZ() << ' ' << similarity_ik_jl << ' ' << std::endl;
               }
@@ -307,6 +380,112 @@ namespace OpenMS
     }   // i
   }
 
+  /**
+    @brief Estimates scaling by trying different (weighted) affine transformations.
+
+    Basically try all combinations of two pairs from map model (i,j) and two
+    pairs from map scene (k,l) and compute shift and scale based on these
+    four points. The computed value is weighed by the intensity of all
+    points, thus this is a density-based approach.
+
+    In the first round, compute and store every combination. In the second
+    round, only consider quadruplets where the scaling factor matches the
+    estimated bounds of (scale_low_1,scale_high_1), discard all other data.
+
+    The first points of the model map (i) are split into a fixed number of
+    blocks which are hashed in parallel, each into its own (small) histograms.
+    These are summed up in the order of the blocks, thus the result does not
+    depend on the number of threads. Dumping the pairs is done serially.
+
+  */
+  void affineTransformationHashing(const bool do_dump_pairs,
+                                   const std::vector<Peak2D> & model_map,
+                                   const std::vector<Peak2D> & scene_map,
+                                   Math::LinearInterpolation<double, double>& scaling_hash_1,
+                                   Math::LinearInterpolation<double, double>& scaling_hash_2,
+                                   Math::LinearInterpolation<double, double>& rt_low_hash_,
+                                   Math::LinearInterpolation<double, double>& rt_high_hash_,
+                                   const int hashing_round,
+                                   const double rt_pair_min_distance,
+                                   const String dump_pairs_basename,
+                                   const Int dump_buckets_serial,
+                                   const double mz_pair_max_distance,
+                                   const double winlength_factor_baseline,
+                                   const double total_intensity_ratio,
+                                   const double scale_low_1,
+                                   const double scale_high_1,
+                                   const double rt_low, const double rt_high)
+  {
+    typedef Math::LinearInterpolation<double, double> LinearInterpolationType_;
+    Size const model_map_size = model_map.size();
+    if (model_map_size < 2)
+    {
+      return;
+    }
+
+    if (do_dump_pairs)
+    {
+      String dump_pairs_filename = dump_pairs_basename + "_phase_two_" + String(dump_buckets_serial);
+      std::ofstream dump_pairs_file(dump_pairs_filename.c_str());
+      dump_pairs_file << "#" << ' ' << "i" << ' ' << "j" << ' ' << "k" << ' ' << "l" << ' ' << std::endl;
+      affineTransformationHashingRange(0, model_map_size - 1, model_map, scene_map,
+                                       scaling_hash_1, scaling_hash_2, rt_low_hash_, rt_high_hash_,
+                                       hashing_round, rt_pair_min_distance, &dump_pairs_file,
+                                       mz_pair_max_distance, winlength_factor_baseline, total_intensity_ratio,
+                                       scale_low_1, scale_high_1, rt_low, rt_high);
+      return;
+    }
+
+    // the work per first point decreases with i (j > i), many blocks balance this
+    const Size max_blocks = 64;
+    const Size nr_blocks = std::min(max_blocks, model_map_size - 1);
+    const Size block_size = (model_map_size - 1 + nr_blocks - 1) / nr_blocks;
+
+    // per-block copies of the hash tables (same mapping, empty buckets)
+    std::vector<LinearInterpolationType_> block_hashes(4 * nr_blocks);
+    for (Size b = 0; b < nr_blocks; ++b)
+    {
+      block_hashes[4 * b] = scaling_hash_1;
+      block_hashes[4 * b + 1] = scaling_hash_2;
+      block_hashes[4 * b + 2] = rt_low_hash_;
+      block_hashes[4 * b + 3] = rt_high_hash_;
+      for (Size h = 4 * b; h < 4 * b + 4; ++h)
+      {
+        std::fill(block_hashes[h].getData().begin(), block_hashes[h].getData().end(), 0.0);
+      }
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (SignedSize b = 0; b < (SignedSize)nr_blocks; ++b)
+    {
+      const Size i_begin = b * block_size;
+      const Size i_end = std::min(i_begin + block_size, model_map_size - 1);
+      affineTransformationHashingRange(i_begin, i_end, model_map, scene_map,
+                                       block_hashes[4 * b], block_hashes[4 * b + 1],
+                                       block_hashes[4 * b + 2], block_hashes[4 * b + 3],
+                                       hashing_round, rt_pair_min_distance, nullptr,
+                                       mz_pair_max_distance, winlength_factor_baseline, total_intensity_ratio,
+                                       scale_low_1, scale_high_1, rt_low, rt_high);
+    }
+
+    // merge the histograms in block order
+    LinearInterpolationType_* hashes[4] = { &scaling_hash_1, &scaling_hash_2, &rt_low_hash_, &rt_high_hash_ };
+    for (Size h = 0; h < 4; ++h)
+    {
+      LinearInterpolationType_::container_type& data = hashes[h]->getData();
+      for (Size b = 0; b < nr_blocks; ++b)
+      {
+        const LinearInterpolationType_::container_type& block_data = block_hashes[4 * b + h].getData();
+        for (Size index = 0; index < data.size(); ++index)
+        {
+          data[index] += block_data[index];
+        }
+      }
+    }
+  }
+
   /**
     @brief Estimates likely position of the scale factor based on scaling_hash_1.
 
@@ -809,22 +988,11 @@ namespace OpenMS
     {
       // truncate the data as necessary
       const Size num_used_points = (Int) param_.getValue("num_used_points");
+      const UInt rt_strata = param_.getValue("point_selection") == "rt_stratified" ? (UInt) param_.getValue("rt_strata") : 1;
 
-      // sort the last data points by ascending intensity (from the right, using reverse iterators)
-      //  -> linear in complexity, should be faster than sorting and then taking cutoff
-      if (model_map.size() > num_used_points)
-      {
-        std::nth_element(model_map.rbegin(), model_map.rbegin() + (model_map.size() - num_used_points),
-            model_map.rend(), Peak2D::IntensityLess());
-        model_map.resize(num_used_points);
-      }
+      selectPoints(model_map, num_used_points, rt_strata);
       setProgress(++actual_progress);
-      if (scene_map.size() > num_used_points)
-      {
-        std::nth_element(scene_map.rbegin(), scene_map.rbegin() + (scene_map.size() - num_used_points),
-            scene_map.rend(), Peak2D::IntensityLess());
-        scene_map.resize(num_used_points);
-      }
+      selectPoints(scene_map, num_used_points, rt_strata);
       setProgress(++actual_progress);
     }
     // sort by ascending m/z
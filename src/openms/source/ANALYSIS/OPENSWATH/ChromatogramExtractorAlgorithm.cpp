@@ -33,11 +33,14 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/ANALYSIS/OPENSWATH/ChromatogramExtractorAlgorithm.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessIonMobilityIndexed.h>
 
 #include <OpenMS/DATASTRUCTURES/String.h>
 
 #include <OpenMS/CONCEPT/Exception.h>
 
+#include <algorithm>
+
 namespace OpenMS
 {
 
@@ -291,12 +294,54 @@ namespace OpenMS
         "Input to extractChromatogram needs to be sorted by m/z");
     }
 
+    // For ion mobility indexed data, the signal of each coordinate can be
+    // integrated directly from the (m/z, ion mobility) index which only
+    // touches the relevant part of the spectrum (requires that all
+    // coordinates are extracted in ion mobility).
+    const SpectrumAccessIonMobilityIndexed* im_indexed = nullptr;
+    if (im_extraction_window > 0.0 && used_filter == 1 &&
+        std::all_of(extraction_coordinates.begin(), extraction_coordinates.end(),
+          [](const ExtractionCoordinates& c) { return c.ion_mobility >= 0.0; }))
+    {
+      im_indexed = dynamic_cast<const SpectrumAccessIonMobilityIndexed*>(input.get());
+    }
+
     //go through all spectra
     startProgress(0, input_size, "Extracting chromatograms");
     for (Size scan_idx = 0; scan_idx < input_size; ++scan_idx)
     {
       setProgress(scan_idx);
 
+      if (im_indexed != nullptr && im_indexed->hasIonMobilityIndex(scan_idx))
+      {
+        if (im_indexed->getNrPeaks(scan_idx) == 0)
+        {
+          continue;
+        }
+
+        double current_rt = input->getSpectrumMetaById(scan_idx).RT;
+        for (Size k = 0; k < extraction_coordinates.size(); ++k)
+        {
+          const ExtractionCoordinates& coord = extraction_coordinates[k];
+          if (coord.rt_end - coord.rt_start > 0 &&
+               (current_rt < coord.rt_start || current_rt > coord.rt_end) )
+          {
+            continue;
+          }
+
+          // same extraction window as in extract_value_tophat
+          double half_window = ppm ? coord.mz * mz_extraction_window / 2.0 * 1.0e-6 : mz_extraction_window / 2.0;
+          double integrated_intensity = im_indexed->integrateWindow(scan_idx,
+              coord.mz - half_window, coord.mz + half_window,
+              coord.ion_mobility - im_extraction_window / 2.0, coord.ion_mobility + im_extraction_window / 2.0);
+
+          // Time is first, intensity is second
+          output[k]->getTimeArray()->data.push_back(current_rt);
+          output[k]->getIntensityArray()->data.push_back(integrated_intensity);
+        }
+        continue;
+      }
+
       OpenSwath::SpectrumPtr sptr = input->getSpectrumById(scan_idx);
       OpenSwath::SpectrumMeta s_meta = input->getSpectrumMetaById(scan_idx);
 
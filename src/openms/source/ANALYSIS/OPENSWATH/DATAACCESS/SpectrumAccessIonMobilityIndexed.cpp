@@ -0,0 +1,241 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessIonMobilityIndexed.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace OpenMS
+{
+
+  SpectrumAccessIonMobilityIndexed::SpectrumAccessIonMobilityIndexed(OpenSwath::ISpectrumAccess & origin, Size block_size) :
+    SpectrumAccessOpenMSInMemory(origin)
+  {
+    if (block_size == 0)
+    {
+      throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "The block size of the ion mobility index needs to be larger than zero.");
+    }
+
+    boost::shared_ptr<std::vector<SpectrumIndex> > indices(new std::vector<SpectrumIndex>(spectra_.size()));
+    for (Size i = 0; i < spectra_.size(); ++i)
+    {
+      buildIndex_(*spectra_[i], block_size, (*indices)[i]);
+    }
+    indices_ = indices;
+  }
+
+  SpectrumAccessIonMobilityIndexed::~SpectrumAccessIonMobilityIndexed() {}
+
+  SpectrumAccessIonMobilityIndexed::SpectrumAccessIonMobilityIndexed(const SpectrumAccessIonMobilityIndexed & rhs) :
+    SpectrumAccessOpenMSInMemory(rhs),
+    indices_(rhs.indices_)
+  {
+    // this only copies the pointers and not the actual data or index
+  }
+
+  boost::shared_ptr<OpenSwath::ISpectrumAccess> SpectrumAccessIonMobilityIndexed::lightClone() const
+  {
+    return boost::shared_ptr<SpectrumAccessIonMobilityIndexed>(new SpectrumAccessIonMobilityIndexed(*this));
+  }
+
+  bool SpectrumAccessIonMobilityIndexed::hasIonMobilityIndex(int id) const
+  {
+    OPENMS_PRECONDITION(id >= 0, "Id needs to be larger than zero");
+    OPENMS_PRECONDITION(id < (int)getNrSpectra(), "Id cannot be larger than number of spectra");
+    return !(*indices_)[id].block_begin.empty();
+  }
+
+  Size SpectrumAccessIonMobilityIndexed::getNrPeaks(int id) const
+  {
+    OPENMS_PRECONDITION(id >= 0, "Id needs to be larger than zero");
+    OPENMS_PRECONDITION(id < (int)getNrSpectra(), "Id cannot be larger than number of spectra");
+    return spectra_[id]->getMZArray()->data.size();
+  }
+
+  void SpectrumAccessIonMobilityIndexed::buildIndex_(const OpenSwath::Spectrum& spectrum, Size block_size, SpectrumIndex& index)
+  {
+    OpenSwath::BinaryDataArrayPtr im_arr = spectrum.getDriftTimeArray();
+    if (!im_arr)
+    {
+      return; // no ion mobility data, leave index empty
+    }
+
+    const std::vector<double>& mz = spectrum.getMZArray()->data;
+    const std::vector<double>& im = im_arr->data;
+    if (im.size() != mz.size())
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "Ion mobility and m/z arrays need to have the same size: " + String(im.size()) + " != " + String(mz.size()));
+    }
+    if (mz.size() > std::numeric_limits<UInt32>::max())
+    {
+      throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, mz.size());
+    }
+
+    // order all peaks by m/z (the spectrum is usually sorted already)
+    Size n = mz.size();
+    index.order.resize(n);
+    for (Size k = 0; k < n; ++k)
+    {
+      index.order[k] = static_cast<UInt32>(k);
+    }
+    if (!std::is_sorted(mz.begin(), mz.end()))
+    {
+      std::stable_sort(index.order.begin(), index.order.end(),
+        [&mz](UInt32 a, UInt32 b) { return mz[a] < mz[b]; });
+    }
+
+    // cut into blocks of consecutive m/z and order each block by ion mobility
+    Size nr_blocks = (n + block_size - 1) / block_size;
+    index.block_begin.reserve(nr_blocks + 1);
+    index.block_mz_min.reserve(nr_blocks);
+    index.block_mz_max.reserve(nr_blocks);
+    index.block_im_min.reserve(nr_blocks);
+    index.block_im_max.reserve(nr_blocks);
+    for (Size start = 0; start < n; start += block_size)
+    {
+      Size end = std::min(start + block_size, n);
+      index.block_begin.push_back(start);
+      index.block_mz_min.push_back(mz[index.order[start]]);
+      index.block_mz_max.push_back(mz[index.order[end - 1]]);
+      std::sort(index.order.begin() + start, index.order.begin() + end,
+        [&im](UInt32 a, UInt32 b) { return im[a] < im[b]; });
+      index.block_im_min.push_back(im[index.order[start]]);
+      index.block_im_max.push_back(im[index.order[end - 1]]);
+    }
+    index.block_begin.push_back(n);
+
+    index.im.resize(n);
+    for (Size k = 0; k < n; ++k)
+    {
+      index.im[k] = im[index.order[k]];
+    }
+  }
+
+  template <typename FunctionType>
+  void SpectrumAccessIonMobilityIndexed::forEachPeakInWindow_(int id, double mz_start, double mz_end,
+                                                              double im_start, double im_end, FunctionType f) const
+  {
+    const SpectrumIndex& index = (*indices_)[id];
+    const std::vector<double>& mz = spectra_[id]->getMZArray()->data;
+    Size nr_blocks = index.block_mz_min.size();
+
+    // the blocks are sorted by m/z: skip all blocks that end before the window
+    Size b = std::distance(index.block_mz_max.begin(),
+      std::upper_bound(index.block_mz_max.begin(), index.block_mz_max.end(), mz_start));
+    for (; b < nr_blocks && index.block_mz_min[b] < mz_end; ++b)
+    {
+      if (index.block_im_max[b] <= im_start || index.block_im_min[b] >= im_end)
+      {
+        continue; // block does not overlap in ion mobility
+      }
+
+      // within a block, peaks are sorted by ion mobility
+      std::vector<double>::const_iterator first = index.im.begin() + index.block_begin[b];
+      std::vector<double>::const_iterator last = index.im.begin() + index.block_begin[b + 1];
+      for (std::vector<double>::const_iterator it = std::upper_bound(first, last, im_start);
+           it != last && *it < im_end; ++it)
+      {
+        UInt32 peak = index.order[std::distance(index.im.begin(), it)];
+        if (mz[peak] > mz_start && mz[peak] < mz_end)
+        {
+          f(peak);
+        }
+      }
+    }
+  }
+
+  double SpectrumAccessIonMobilityIndexed::integrateWindow(int id, double mz_start, double mz_end, double im_start, double im_end) const
+  {
+    OPENMS_PRECONDITION(id >= 0, "Id needs to be larger than zero");
+    OPENMS_PRECONDITION(id < (int)getNrSpectra(), "Id cannot be larger than number of spectra");
+    OPENMS_PRECONDITION(hasIonMobilityIndex(id), "Spectrum needs to have an ion mobility index");
+
+    const std::vector<double>& intensity = spectra_[id]->getIntensityArray()->data;
+    double integrated_intensity = 0;
+    forEachPeakInWindow_(id, mz_start, mz_end, im_start, im_end,
+      [&integrated_intensity, &intensity](UInt32 peak) { integrated_intensity += intensity[peak]; });
+    return integrated_intensity;
+  }
+
+  OpenSwath::SpectrumPtr SpectrumAccessIonMobilityIndexed::getSpectrumByIdAndWindow(int id, double mz_start, double mz_end,
+                                                                                    double im_start, double im_end) const
+  {
+    OPENMS_PRECONDITION(id >= 0, "Id needs to be larger than zero");
+    OPENMS_PRECONDITION(id < (int)getNrSpectra(), "Id cannot be larger than number of spectra");
+
+    if (!hasIonMobilityIndex(id))
+    {
+      return spectra_[id];
+    }
+
+    std::vector<UInt32> peaks;
+    forEachPeakInWindow_(id, mz_start, mz_end, im_start, im_end,
+      [&peaks](UInt32 peak) { peaks.push_back(peak); });
+
+    // restore m/z order (ties are resolved by the original peak order)
+    const std::vector<double>& mz = spectra_[id]->getMZArray()->data;
+    std::sort(peaks.begin(), peaks.end(),
+      [&mz](UInt32 a, UInt32 b) { return mz[a] < mz[b] || (mz[a] == mz[b] && a < b); });
+
+    const std::vector<double>& intensity = spectra_[id]->getIntensityArray()->data;
+    const std::vector<double>& im = spectra_[id]->getDriftTimeArray()->data;
+
+    OpenSwath::BinaryDataArrayPtr mz_arr_out(new OpenSwath::BinaryDataArray);
+    OpenSwath::BinaryDataArrayPtr intens_arr_out(new OpenSwath::BinaryDataArray);
+    OpenSwath::BinaryDataArrayPtr im_arr_out(new OpenSwath::BinaryDataArray);
+    im_arr_out->description = "Ion Mobility";
+    mz_arr_out->data.reserve(peaks.size());
+    intens_arr_out->data.reserve(peaks.size());
+    im_arr_out->data.reserve(peaks.size());
+    for (UInt32 peak : peaks)
+    {
+      mz_arr_out->data.push_back(mz[peak]);
+      intens_arr_out->data.push_back(intensity[peak]);
+      im_arr_out->data.push_back(im[peak]);
+    }
+
+    OpenSwath::SpectrumPtr output(new OpenSwath::Spectrum);
+    output->setMZArray(mz_arr_out);
+    output->setIntensityArray(intens_arr_out);
+    output->getDataArrays().push_back(im_arr_out);
+    return output;
+  }
+
+} //end namespace OpenMS
+
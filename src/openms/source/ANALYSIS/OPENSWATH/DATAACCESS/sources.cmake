@@ -6,6 +6,7 @@ set(sources_list
 MRMFeatureAccessOpenMS.cpp
 SpectrumAccessOpenMS.cpp
 SpectrumAccessOpenMSCached.cpp
+SpectrumAccessIonMobilityIndexed.cpp
 SpectrumAccessOpenMSInMemory.cpp
 SpectrumAccessSqMass.cpp
 SpectrumAccessTransforming.cpp
@@ -34,8 +34,105 @@
 
 #include <OpenMS/ANALYSIS/OPENSWATH/MRMAssay.h>
 
+#include <algorithm>
+#include <exception>
+
 namespace OpenMS
 {
+  namespace
+  {
+    /// All peptidoforms of a single (target or decoy) peptide and their theoretical ion series
+    struct InSilicoPeptidoforms
+    {
+      InSilicoPeptidoforms() :
+        precursor_charge(1),
+        precursor_mz(0.0),
+        precursor_swath(-1)
+      {
+      }
+
+      int precursor_charge;
+      double precursor_mz;
+      int precursor_swath;
+      std::vector<AASequence> sequences;
+      std::vector<std::string> modified;
+      std::vector<String> unmodified;
+      std::vector<MRMIonSeries::IonSeries> ionseries;
+    };
+
+    /**
+      @brief Compute the theoretical ion series of all peptidoforms in parallel
+
+      The peptidoforms themselves need to be enumerated beforehand (serially),
+      since modifying an AASequence may add residues to the ResidueDB.
+    */
+    void computeInSilicoIonSeries(std::vector<InSilicoPeptidoforms>& peptides,
+                                  const std::vector<String>& fragment_types,
+                                  const std::vector<size_t>& fragment_charges,
+                                  bool enable_specific_losses,
+                                  bool enable_unspecific_losses,
+                                  const ProgressLogger& logger)
+    {
+      Size progress = 0;
+      Size first_error = peptides.size();
+      std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 100)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)peptides.size(); ++i)
+      {
+        InSilicoPeptidoforms& pep = peptides[i];
+        try
+        {
+          MRMIonSeries mrmis;
+          pep.modified.resize(pep.sequences.size());
+          pep.unmodified.resize(pep.sequences.size());
+          pep.ionseries.resize(pep.sequences.size());
+          for (Size k = 0; k < pep.sequences.size(); ++k)
+          {
+            pep.modified[k] = pep.sequences[k].toString();
+            pep.unmodified[k] = pep.sequences[k].toUnmodifiedString();
+            pep.ionseries[k] = mrmis.getIonSeries(pep.sequences[k], pep.precursor_charge, fragment_types, fragment_charges,
+                                                  enable_specific_losses, enable_unspecific_losses);
+          }
+        }
+        catch (...)
+        {
+#ifdef _OPENMP
+#pragma omp critical (MRMAssay_HandleException)
+#endif
+          {
+            if (Size(i) < first_error)
+            {
+              first_error = i;
+              error = std::current_exception();
+            }
+          }
+        }
+#ifdef _OPENMP
+#pragma omp critical (MRMAssay_Progress)
+#endif
+        logger.setProgress(++progress);
+      }
+      if (error)
+      {
+        std::rethrow_exception(error);
+      }
+    }
+
+    /// Sort the fragment ions of each peptide by m/z (and peptidoform) for binary search
+    void sortIonMap(MRMAssay::IonMapT& ion_map)
+    {
+      for (MRMAssay::IonMapT::iterator swath_it = ion_map.begin(); swath_it != ion_map.end(); ++swath_it)
+      {
+        for (auto seq_it = swath_it->second.begin(); seq_it != swath_it->second.end(); ++seq_it)
+        {
+          std::sort(seq_it->second.begin(), seq_it->second.end());
+        }
+      }
+    }
+  }
+
   MRMAssay::MRMAssay()
   {
   }
@@ -48,12 +145,13 @@ namespace OpenMS
   {
     std::vector<std::string> isoforms;
 
-    for (std::vector<std::pair<double, std::string> >::const_iterator i_it = ions.begin(); i_it != ions.end(); ++i_it)
+    // ions are sorted by m/z: skip all ions below the window and collect the
+    // ones within (both conditions are monotonic in the ion m/z)
+    std::vector<std::pair<double, std::string> >::const_iterator i_it = std::partition_point(ions.begin(), ions.end(),
+        [&](const std::pair<double, std::string>& ion) { return !(ion.first + mz_threshold >= fragment_ion); });
+    for (; i_it != ions.end() && i_it->first - mz_threshold <= fragment_ion; ++i_it)
     {
-      if (i_it->first - mz_threshold <= fragment_ion && i_it->first + mz_threshold >= fragment_ion)
-      {
-        isoforms.push_back(i_it->second);
-      }
+      isoforms.push_back(i_it->second);
     }
 
     std::sort(isoforms.begin(), isoforms.end());
@@ -320,60 +418,70 @@ namespace OpenMS
                                             IonMapT & TargetIonMap,
                                             PeptideMapT& TargetPeptideMap)
   {
-    OpenMS::MRMIonSeries mrmis;
-
     // Step 1: Generate target in silico peptide map containing theoretical transitions
-    Size progress = 0;
-    startProgress(0, exp.getPeptides().size(), "Generation of target in silico peptide map");
-    for (size_t i = 0; i < exp.getPeptides().size(); ++i)
+    const std::vector<TargetedExperiment::Peptide>& peptides = exp.getPeptides();
+    std::vector<InSilicoPeptidoforms> insilico(peptides.size());
+    for (size_t i = 0; i < peptides.size(); ++i)
     {
-      setProgress(progress++);
-
-      TargetedExperiment::Peptide peptide = exp.getPeptides()[i];
+      const TargetedExperiment::Peptide& peptide = peptides[i];
       OpenMS::AASequence peptide_sequence = TargetedExperimentHelper::getAASequence(peptide);
       int precursor_charge = 1;
       if (peptide.hasCharge()) 
       {
         precursor_charge = peptide.getChargeState();
       }
-      double precursor_mz = peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge;
-      int precursor_swath = getSwath_(swathes, precursor_mz);
+      insilico[i].precursor_charge = precursor_charge;
+      insilico[i].precursor_mz = peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge;
+      insilico[i].precursor_swath = getSwath_(swathes, insilico[i].precursor_mz);
 
       // Compute all alternative peptidoforms compatible with ModificationsDB
-      std::vector<OpenMS::AASequence> alternative_peptide_sequences = combineModifications_(peptide_sequence);  
+      insilico[i].sequences = combineModifications_(peptide_sequence);
 
       // Some permutations might be too complex, skip if threshold is reached
-      if (alternative_peptide_sequences.size() > max_num_alternative_localizations)
+      if (insilico[i].sequences.size() > max_num_alternative_localizations)
       {
         LOG_DEBUG << "[uis] Peptide skipped (too many permutations possible): " << peptide.id << std::endl;
-        continue;
+        insilico[i].sequences.clear();
       }
+    }
+
+    // Generate theoretical ion series of all peptidoforms
+    startProgress(0, peptides.size(), "Generation of target in silico peptide map");
+    computeInSilicoIonSeries(insilico, fragment_types, fragment_charges, enable_specific_losses, enable_unspecific_losses, *this);
+    endProgress();
+
+    // Merge in peptide order
+    for (size_t i = 0; i < peptides.size(); ++i)
+    {
+      const TargetedExperiment::Peptide& peptide = peptides[i];
+      const InSilicoPeptidoforms& pep = insilico[i];
+      double precursor_mz = Math::roundDecimal(pep.precursor_mz, round_decPow);
 
       // Iterate over all peptidoforms
-      for (std::vector<OpenMS::AASequence>::iterator alt_aa = alternative_peptide_sequences.begin(); alt_aa != alternative_peptide_sequences.end(); ++alt_aa)
-      { 
+      for (Size k = 0; k < pep.sequences.size(); ++k)
+      {
         // Append peptidoform to index
-        TargetSequenceMap[precursor_swath][alt_aa->toUnmodifiedString()].insert(alt_aa->toString());
-        // Generate theoretical ion series
-        MRMIonSeries::IonSeries ionseries = mrmis.getIonSeries(*alt_aa, precursor_charge, fragment_types, fragment_charges, enable_specific_losses, enable_unspecific_losses);
+        TargetSequenceMap[pep.precursor_swath][pep.unmodified[k]].insert(pep.modified[k]);
+        std::vector<std::pair<double, std::string> >& ions = TargetIonMap[pep.precursor_swath][pep.unmodified[k]];
+        std::vector<std::pair<std::string, double> >& transitions = TargetPeptideMap[peptide.id];
 
         if (enable_ms2_precursors)
         {
           // Add precursor to theoretical transitions
-          TargetIonMap[precursor_swath][alt_aa->toUnmodifiedString()].push_back(std::make_pair(Math::roundDecimal(precursor_mz, round_decPow), alt_aa->toString()));
-          TargetPeptideMap[peptide.id].push_back(std::make_pair("MS2_Precursor_i0", Math::roundDecimal(precursor_mz, round_decPow)));
+          ions.push_back(std::make_pair(precursor_mz, pep.modified[k]));
+          transitions.push_back(std::make_pair("MS2_Precursor_i0", precursor_mz));
         }
 
         // Iterate over all theoretical transitions
-        for (boost::unordered_map<String, double>::iterator im_it = ionseries.begin(); im_it != ionseries.end(); ++im_it)
+        for (MRMIonSeries::IonSeries::const_iterator im_it = pep.ionseries[k].begin(); im_it != pep.ionseries[k].end(); ++im_it)
         {
           // Append transition to indices to find interfering transitions
-          TargetIonMap[precursor_swath][alt_aa->toUnmodifiedString()].push_back(std::make_pair(Math::roundDecimal(im_it->second, round_decPow), alt_aa->toString()));
-          TargetPeptideMap[peptide.id].push_back(std::make_pair(im_it->first, Math::roundDecimal(im_it->second, round_decPow)));
+          ions.push_back(std::make_pair(Math::roundDecimal(im_it->second, round_decPow), pep.modified[k]));
+          transitions.push_back(std::make_pair(im_it->first, Math::roundDecimal(im_it->second, round_decPow)));
         }
       }
     }
-    endProgress();
+    sortIonMap(TargetIonMap);
   }
 
   void MRMAssay::generateDecoySequences_(const SequenceMapT& TargetSequenceMap,
@@ -453,16 +561,12 @@ namespace OpenMS
                                            IonMapT & DecoyIonMap,
                                            PeptideMapT& DecoyPeptideMap)
   {
-    MRMIonSeries mrmis;
-
     // Step 2b: Generate decoy in silico peptide map containing theoretical transitions
-    Size progress = 0;
-    startProgress(0, exp.getPeptides().size(), "Generation of decoy in silico peptide map");
-    for (size_t i = 0; i < exp.getPeptides().size(); ++i)
+    const std::vector<TargetedExperiment::Peptide>& peptides = exp.getPeptides();
+    std::vector<InSilicoPeptidoforms> insilico(peptides.size());
+    for (size_t i = 0; i < peptides.size(); ++i)
     {
-      setProgress(progress++);
-
-      TargetedExperiment::Peptide peptide = exp.getPeptides()[i];
+      const TargetedExperiment::Peptide& peptide = peptides[i];
       int precursor_charge = 1;
       if (peptide.hasCharge()) 
       {
@@ -476,8 +580,9 @@ namespace OpenMS
       }
 
       OpenMS::AASequence peptide_sequence = TargetedExperimentHelper::getAASequence(peptide);
-      double precursor_mz = peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge;
-      int precursor_swath = getSwath_(swathes, precursor_mz);
+      insilico[i].precursor_charge = precursor_charge; // use same charge state as target
+      insilico[i].precursor_mz = peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge;
+      insilico[i].precursor_swath = getSwath_(swathes, insilico[i].precursor_mz);
 
       // Copy properties of target peptide to decoy and get sequence from map
       TargetedExperiment::Peptide decoy_peptide = peptide;
@@ -488,32 +593,44 @@ namespace OpenMS
 
       // Compute all alternative peptidoforms compatible with ModificationsDB
       // Infers residue specificity from target sequence but is applied to decoy sequence
-      const std::vector<OpenMS::AASequence> alternative_decoy_peptide_sequences = combineDecoyModifications_(peptide_sequence, decoy_peptide_sequence);
+      insilico[i].sequences = combineDecoyModifications_(peptide_sequence, decoy_peptide_sequence);
+    }
+
+    // Generate theoretical ion series of all peptidoforms
+    startProgress(0, peptides.size(), "Generation of decoy in silico peptide map");
+    computeInSilicoIonSeries(insilico, fragment_types, fragment_charges, enable_specific_losses, enable_unspecific_losses, *this);
+    endProgress();
+
+    // Merge in peptide order (decoy peptides share the id of their target)
+    for (size_t i = 0; i < peptides.size(); ++i)
+    {
+      const TargetedExperiment::Peptide& peptide = peptides[i];
+      const InSilicoPeptidoforms& pep = insilico[i];
+      double precursor_mz = Math::roundDecimal(pep.precursor_mz, round_decPow);
 
       // Iterate over all peptidoforms
-      for (auto alt_aa = alternative_decoy_peptide_sequences.begin(); alt_aa != alternative_decoy_peptide_sequences.end(); ++alt_aa)
+      for (Size k = 0; k < pep.sequences.size(); ++k)
       {
-        // Generate theoretical ion series
-        MRMIonSeries::IonSeries ionseries = mrmis.getIonSeries(*alt_aa, precursor_charge, // use same charge state as target
-                                                               fragment_types, fragment_charges, enable_specific_losses, enable_unspecific_losses);  
+        std::vector<std::pair<double, std::string> >& ions = DecoyIonMap[pep.precursor_swath][pep.unmodified[k]];
+        std::vector<std::pair<std::string, double> >& transitions = DecoyPeptideMap[peptide.id];
 
         if (enable_ms2_precursors)
         {
           // Add precursor to theoretical transitions
-          DecoyIonMap[precursor_swath][alt_aa->toUnmodifiedString()].push_back(std::make_pair(Math::roundDecimal(precursor_mz, round_decPow), alt_aa->toString()));
-          DecoyPeptideMap[peptide.id].push_back(std::make_pair("MS2_Precursor_i0", Math::roundDecimal(precursor_mz, round_decPow)));
+          ions.push_back(std::make_pair(precursor_mz, pep.modified[k]));
+          transitions.push_back(std::make_pair("MS2_Precursor_i0", precursor_mz));
         }
 
         // Iterate over all theoretical transitions
-        for (boost::unordered_map<String, double>::iterator im_it = ionseries.begin(); im_it != ionseries.end(); ++im_it)
+        for (MRMIonSeries::IonSeries::const_iterator im_it = pep.ionseries[k].begin(); im_it != pep.ionseries[k].end(); ++im_it)
         {
           // Append transition to indices to find interfering transitions
-          DecoyIonMap[precursor_swath][alt_aa->toUnmodifiedString()].push_back(std::make_pair(Math::roundDecimal(im_it->second, round_decPow), alt_aa->toString()));
-          DecoyPeptideMap[decoy_peptide.id].push_back(std::make_pair(im_it->first, Math::roundDecimal(im_it->second, round_decPow)));
+          ions.push_back(std::make_pair(Math::roundDecimal(im_it->second, round_decPow), pep.modified[k]));
+          transitions.push_back(std::make_pair(im_it->first, Math::roundDecimal(im_it->second, round_decPow)));
         }
       }
     }
-    endProgress();
+    sortIonMap(DecoyIonMap);
   }
 
  void MRMAssay::generateTargetAssays_(const OpenMS::TargetedExperiment& exp,
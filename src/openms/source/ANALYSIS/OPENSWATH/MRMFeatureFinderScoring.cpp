@@ -49,6 +49,8 @@
 #include <boost/range/adaptor/map.hpp>
 #include <boost/foreach.hpp>
 
+#include <exception>
+
 #define run_identifier "unique_run_identifier"
 
 bool SortDoubleDoublePairFirst(const std::pair<double, double>& left, const std::pair<double, double>& right)
@@ -83,7 +85,8 @@ namespace OpenMS
 
   MRMFeatureFinderScoring::MRMFeatureFinderScoring() :
     DefaultParamHandler("MRMFeatureFinderScoring"),
-    ProgressLogger()
+    ProgressLogger(),
+    spectrum_cache_(new OpenSwath_Spectrum_Cache)
   {
     defaults_.setValue("stop_report_after_feature", -1, "Stop reporting after feature (ordered by quality; -1 means do not stop).");
     defaults_.setValue("rt_extraction_window", -1.0, "Only extract RT around this value (-1 means extract over the whole range, a value of 500 means to extract around +/- 500 s of the expected elution). For this to work, the TraML input file needs to contain normalized RT values.");
@@ -223,31 +226,145 @@ namespace OpenMS
     // Step 3
     //
     // Go through all transition groups: first create consensus features, then score them
-    MRMTransitionGroupPicker trgroup_picker;
     Param trgroup_picker_param = param_.copy("TransitionGroupPicker:", true);
     // If use_total_mi_score is defined, we need to instruct MRMTransitionGroupPicker to compute the score
     if (su_.use_total_mi_score_)
     {
       trgroup_picker_param.setValue("compute_total_mi", "true");
     }
-    trgroup_picker.setParameters(trgroup_picker_param);
 
-    Size progress = 0;
-    startProgress(0, transition_group_map.size(), "picking peaks");
+    // Collect the transition groups to be picked (in the order of the map, this
+    // determines the order of the output features)
+    std::vector<MRMTransitionGroupType*> transition_groups;
+    transition_groups.reserve(transition_group_map.size());
     for (TransitionGroupMapType::iterator trgroup_it = transition_group_map.begin(); trgroup_it != transition_group_map.end(); ++trgroup_it)
     {
-
-      setProgress(++progress);
       MRMTransitionGroupType& transition_group = trgroup_it->second;
       if (transition_group.getChromatograms().size() == 0 || transition_group.getTransitions().size() == 0)
       {
         continue;
       }
+      transition_groups.push_back(&transition_group);
+    }
 
-      trgroup_picker.pickTransitionGroup(transition_group);
-      scorePeakgroups(trgroup_it->second, trafo, swath_maps, output);
+    // The transition groups are picked and scored in parallel. Neither the
+    // picker nor the scorer (spectrum cache) are thread-safe, each thread
+    // thus uses its own instances and light clones of the spectrum maps.
+    // The features of each group are collected separately and appended in
+    // the order of the transition groups afterwards. Exceptions may not leave
+    // the parallel region, we rethrow the one of a failed thread setup or
+    // else the one of the first offending group.
+    std::vector<FeatureMap> group_features(transition_groups.size());
+    Size first_error = transition_groups.size();
+    std::exception_ptr error, setup_error;
+    Size progress = 0;
+    startProgress(0, transition_groups.size(), "picking peaks");
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      MRMTransitionGroupPicker thread_picker;
+      MRMFeatureFinderScoring thread_scorer;
+      thread_scorer.setLogType(ProgressLogger::NONE);
+      std::vector<OpenSwath::SwathMap> thread_swath_maps;
+      bool thread_ready = false;
+      try
+      {
+        thread_picker.setParameters(trgroup_picker_param);
+        thread_scorer.setParameters(param_);
+        thread_scorer.setStrictFlag(strict_);
+        if (ms1_map_)
+        {
+          thread_scorer.setMS1Map(ms1_map_->lightClone());
+        }
+        thread_scorer.prepareProteinPeptideMaps_(transition_exp);
+        thread_swath_maps = swath_maps;
+        for (Size i = 0; i < thread_swath_maps.size(); ++i)
+        {
+          if (thread_swath_maps[i].sptr)
+          {
+            thread_swath_maps[i].sptr = thread_swath_maps[i].sptr->lightClone();
+          }
+        }
+        thread_ready = true;
+      }
+      catch (...)
+      {
+#ifdef _OPENMP
+#pragma omp critical (MRMFeatureFinderScoring_HandleException)
+#endif
+        {
+          if (!setup_error)
+          {
+            setup_error = std::current_exception();
+          }
+        }
+      }
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)transition_groups.size(); ++i)
+      {
+        if (!thread_ready)
+        {
+          continue; // the setup error is rethrown below
+        }
+        try
+        {
+          thread_picker.pickTransitionGroup(*transition_groups[i]);
+          thread_scorer.scorePeakgroups(*transition_groups[i], trafo, thread_swath_maps, group_features[i]);
+        }
+        catch (...)
+        {
+#ifdef _OPENMP
+#pragma omp critical (MRMFeatureFinderScoring_HandleException)
+#endif
+          {
+            if (Size(i) < first_error)
+            {
+              first_error = i;
+              error = std::current_exception();
+            }
+          }
+        }
+
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+        ++progress;
+
+        IF_MASTERTHREAD
+        {
+          setProgress(progress);
+        }
+      }
+
+#ifdef _OPENMP
+#pragma omp critical (MRMFeatureFinderScoring_SpectrumCache)
+#endif
+      {
+        spectrum_cache_->hits += thread_scorer.getSpectrumCache().hits;
+        spectrum_cache_->misses += thread_scorer.getSpectrumCache().misses;
+      }
     }
     endProgress();
+    if (setup_error)
+    {
+      std::rethrow_exception(setup_error);
+    }
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+
+    for (Size i = 0; i < group_features.size(); ++i)
+    {
+      for (FeatureMap::ConstIterator feature_it = group_features[i].begin(); feature_it != group_features[i].end(); ++feature_it)
+      {
+        output.push_back(*feature_it);
+      }
+    }
 
     //output.sortByPosition(); // if the exact same order is needed
     return;
@@ -540,6 +657,7 @@ namespace OpenMS
 
     OpenSwathScoring scorer;
     scorer.initialize(rt_normalization_factor_, add_up_spectra_, spacing_for_spectra_resampling_, su_);
+    scorer.setSpectrumCache(spectrum_cache_);
 
     size_t feature_idx = 0;
     // Go through all peak groups (found MRM features) and score them
@@ -1054,6 +1172,9 @@ namespace OpenMS
     su_.use_ms1_fullscan         = param_.getValue("Scores:use_ms1_fullscan").toBool();
     su_.use_ms1_mi               = param_.getValue("Scores:use_ms1_mi").toBool();
     su_.use_uis_scores           = param_.getValue("Scores:use_uis_scores").toBool();
+
+    // cached spectra depend on add_up_spectra and the resampling spacing
+    spectrum_cache_->clear();
   }
 
   void MRMFeatureFinderScoring::mapExperimentToTransitionList(OpenSwath::SpectrumAccessPtr input,
@@ -1070,12 +1191,29 @@ namespace OpenMS
       chromatogram_map[input->getChromatogramNativeID(i)] = boost::numeric_cast<int>(i);
     }
 
+    // If the transitions are grouped by compound, the compound (and its
+    // transition group) only needs to be looked up once per compound
+    const bool grouped = transition_exp.hasCompoundTransitionIndex();
+    const std::vector<std::size_t>& offsets = transition_exp.compound_transition_offsets;
+    Size compound_idx = 0;
+    MRMTransitionGroupType* compound_group = nullptr;
+
     // Iterate through all transitions and store the transition with the
     // corresponding chromatogram in the corresponding transition group
     Size progress = 0;
     startProgress(0, nr_chromatograms, "Mapping transitions to chromatograms ");
     for (Size i = 0; i < transition_exp.getTransitions().size(); i++)
     {
+      bool in_compound = grouped && i < offsets.back();
+      if (in_compound)
+      {
+        while (i >= offsets[compound_idx + 1])
+        {
+          ++compound_idx;
+          compound_group = nullptr;
+        }
+      }
+
       // get the current transition and try to find the corresponding chromatogram
       const TransitionType* transition = &transition_exp.getTransitions()[i];
       if (chromatogram_map.find(transition->getNativeID()) == chromatogram_map.end())
@@ -1104,7 +1242,7 @@ namespace OpenMS
       // other way round.
       if (rt_extraction_window > 0)
       {
-        expected_rt = PeptideRefMap_[transition->getPeptideRef()]->rt;
+        expected_rt = in_compound ? transition_exp.getCompounds()[compound_idx].rt : PeptideRefMap_[transition->getPeptideRef()]->rt;
         double de_normalized_experimental_rt = trafo.apply(expected_rt);
         rt_max = de_normalized_experimental_rt + rt_extraction_window;
         rt_min = de_normalized_experimental_rt - rt_extraction_window;
@@ -1131,18 +1269,26 @@ namespace OpenMS
       chromatogram.setMetaValue("precursor_mz", transition->getPrecursorMZ());
       chromatogram.setNativeID(transition->getNativeID());
 
-      // Create new transition group if there is none for this peptide
-      if (transition_group_map.find(transition->getPeptideRef()) == transition_group_map.end())
+      MRMTransitionGroupType* transition_group = in_compound ? compound_group : nullptr;
+      if (transition_group == nullptr)
       {
-        MRMTransitionGroupType transition_group;
-        transition_group.setTransitionGroupID(transition->getPeptideRef());
-        transition_group_map[transition->getPeptideRef()] = transition_group;
+        // Create new transition group if there is none for this peptide
+        if (transition_group_map.find(transition->getPeptideRef()) == transition_group_map.end())
+        {
+          MRMTransitionGroupType new_transition_group;
+          new_transition_group.setTransitionGroupID(transition->getPeptideRef());
+          transition_group_map[transition->getPeptideRef()] = new_transition_group;
+        }
+        transition_group = &transition_group_map[transition->getPeptideRef()];
+        if (in_compound)
+        {
+          compound_group = transition_group;
+        }
       }
 
       // Now add the transition and the chromatogram to the group
-      MRMTransitionGroupType& transition_group = transition_group_map[transition->getPeptideRef()];
-      transition_group.addTransition(*transition, transition->getNativeID());
-      transition_group.addChromatogram(chromatogram, chromatogram.getNativeID());
+      transition_group->addTransition(*transition, transition->getNativeID());
+      transition_group->addChromatogram(chromatogram, chromatogram.getNativeID());
 
       setProgress(++progress);
     }
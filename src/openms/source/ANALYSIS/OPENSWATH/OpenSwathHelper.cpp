@@ -92,29 +92,113 @@ namespace OpenMS
                                                OpenSwath::LightTargetedExperiment& transition_exp_used, double min_upper_edge_dist,
                                                double lower, double upper)
   {
-    std::set<std::string> matching_compounds;
-    for (Size i = 0; i < targeted_exp.transitions.size(); i++)
+    std::vector<Size> transition_indices, compound_indices;
+    selectSwathTransitionIndices(targeted_exp, transition_indices, compound_indices, min_upper_edge_dist, lower, upper);
+    selectTransitions(targeted_exp, transition_indices, compound_indices, transition_exp_used);
+  }
+
+  void OpenSwathHelper::selectSwathTransitionIndices(const OpenSwath::LightTargetedExperiment& targeted_exp,
+                                                     std::vector<Size>& transition_indices, std::vector<Size>& compound_indices,
+                                                     double min_upper_edge_dist, double lower, double upper)
+  {
+    transition_indices.clear();
+    compound_indices.clear();
+    auto isSelected = [&](const OpenSwath::LightTransition& tr)
     {
-      const OpenSwath::LightTransition& tr = targeted_exp.transitions[i];
-      if (lower < tr.getPrecursorMZ() && tr.getPrecursorMZ() < upper &&
-          std::fabs(upper - tr.getPrecursorMZ()) >= min_upper_edge_dist)
+      return lower < tr.getPrecursorMZ() && tr.getPrecursorMZ() < upper &&
+             std::fabs(upper - tr.getPrecursorMZ()) >= min_upper_edge_dist;
+    };
+
+    // If the transitions are grouped by compound, we can walk through the
+    // compounds directly (without matching any reference strings).
+    if (targeted_exp.hasCompoundTransitionIndex())
+    {
+      const std::vector<std::size_t>& offsets = targeted_exp.compound_transition_offsets;
+      for (Size c = 0; c < targeted_exp.compounds.size(); c++)
       {
-        transition_exp_used.transitions.push_back(tr);
-        matching_compounds.insert(tr.getPeptideRef());
+        Size nr_selected = transition_indices.size();
+        for (Size i = offsets[c]; i < offsets[c + 1]; i++)
+        {
+          if (isSelected(targeted_exp.transitions[i]))
+          {
+            transition_indices.push_back(i);
+          }
+        }
+        if (transition_indices.size() > nr_selected)
+        {
+          compound_indices.push_back(c);
+        }
+      }
+      // transitions without compound
+      for (Size i = offsets.back(); i < targeted_exp.transitions.size(); i++)
+      {
+        if (isSelected(targeted_exp.transitions[i]))
+        {
+          transition_indices.push_back(i);
+        }
       }
     }
+    else
+    {
+      std::set<std::string> matching_compounds;
+      for (Size i = 0; i < targeted_exp.transitions.size(); i++)
+      {
+        if (isSelected(targeted_exp.transitions[i]))
+        {
+          transition_indices.push_back(i);
+          matching_compounds.insert(targeted_exp.transitions[i].getPeptideRef());
+        }
+      }
+      for (Size i = 0; i < targeted_exp.compounds.size(); i++)
+      {
+        if (matching_compounds.find(targeted_exp.compounds[i].id) != matching_compounds.end())
+        {
+          compound_indices.push_back(i);
+        }
+      }
+    }
+  }
+
+  void OpenSwathHelper::selectTransitions(const OpenSwath::LightTargetedExperiment& targeted_exp,
+                                          const std::vector<Size>& transition_indices, const std::vector<Size>& compound_indices,
+                                          OpenSwath::LightTargetedExperiment& transition_exp_used)
+  {
+    // the selection stays grouped by compound if the library is (and nothing is appended)
+    const bool keep_index = targeted_exp.hasCompoundTransitionIndex() &&
+      transition_exp_used.transitions.empty() && transition_exp_used.compounds.empty();
+
     std::set<std::string> matching_proteins;
-    for (Size i = 0; i < targeted_exp.compounds.size(); i++)
+    for (std::vector<Size>::const_iterator c = compound_indices.begin(); c != compound_indices.end(); ++c)
+    {
+      const OpenSwath::LightCompound& compound = targeted_exp.compounds[*c];
+      transition_exp_used.compounds.push_back(compound);
+      matching_proteins.insert(compound.protein_refs.begin(), compound.protein_refs.end());
+    }
+    for (std::vector<Size>::const_iterator i = transition_indices.begin(); i != transition_indices.end(); ++i)
     {
-      if (matching_compounds.find(targeted_exp.compounds[i].id) != matching_compounds.end())
+      transition_exp_used.transitions.push_back(targeted_exp.transitions[*i]);
+    }
+
+    if (keep_index)
+    {
+      const std::vector<std::size_t>& offsets = targeted_exp.compound_transition_offsets;
+      std::vector<std::size_t> used_offsets(1, 0);
+      Size k = 0;
+      for (std::vector<Size>::const_iterator c = compound_indices.begin(); c != compound_indices.end(); ++c)
       {
-        transition_exp_used.compounds.push_back( targeted_exp.compounds[i] );
-        for (Size j = 0; j < targeted_exp.compounds[i].protein_refs.size(); j++)
+        while (k < transition_indices.size() && transition_indices[k] < offsets[*c + 1])
         {
-          matching_proteins.insert(targeted_exp.compounds[i].protein_refs[j]);
+          ++k;
         }
+        used_offsets.push_back(k);
       }
+      transition_exp_used.setCompoundTransitionOffsets(used_offsets);
+    }
+    else
+    {
+      transition_exp_used.compound_transition_offsets.clear();
     }
+
     for (Size i = 0; i < targeted_exp.proteins.size(); i++)
     {
       if (matching_proteins.find(targeted_exp.proteins[i].id) != matching_proteins.end())
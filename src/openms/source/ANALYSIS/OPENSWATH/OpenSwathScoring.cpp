@@ -41,9 +41,12 @@
 
 // auxiliary
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/DataAccessHelper.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessIonMobilityIndexed.h>
 #include <OpenMS/MATH/STATISTICS/StatisticFunctions.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/SpectrumAddition.h>
 
+#include <limits>
+
 // basic file operations
 
 namespace OpenMS
@@ -72,9 +75,92 @@ namespace OpenMS
     this->su_ = su;
   }
 
+  OpenSwath_Spectrum_Cache::OpenSwath_Spectrum_Cache(Size capacity) :
+    hits(0),
+    misses(0),
+    capacity_(capacity)
+  {
+  }
+
+  OpenSwath::SpectrumPtr OpenSwath_Spectrum_Cache::get(const KeyType& key)
+  {
+    std::map<KeyType, EntryList::iterator>::const_iterator it = index_.find(key);
+    if (it == index_.end())
+    {
+      ++misses;
+      return OpenSwath::SpectrumPtr();
+    }
+    ++hits;
+    // mark as most recently used
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->second;
+  }
+
+  void OpenSwath_Spectrum_Cache::insert(const KeyType& key, const OpenSwath::SpectrumPtr& spectrum)
+  {
+    std::map<KeyType, EntryList::iterator>::iterator it = index_.find(key);
+    if (it != index_.end())
+    {
+      it->second->second = spectrum;
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return;
+    }
+    entries_.push_front(std::make_pair(key, spectrum));
+    index_[key] = entries_.begin();
+    evict_();
+  }
+
+  Size OpenSwath_Spectrum_Cache::size() const
+  {
+    return index_.size();
+  }
+
+  Size OpenSwath_Spectrum_Cache::getCapacity() const
+  {
+    return capacity_;
+  }
+
+  void OpenSwath_Spectrum_Cache::setCapacity(Size capacity)
+  {
+    capacity_ = capacity;
+    evict_();
+  }
+
+  void OpenSwath_Spectrum_Cache::clear()
+  {
+    index_.clear();
+    entries_.clear();
+    hits = 0;
+    misses = 0;
+  }
+
+  double OpenSwath_Spectrum_Cache::getHitRate() const
+  {
+    return (hits + misses) == 0 ? 0.0 : static_cast<double>(hits) / (hits + misses);
+  }
+
+  void OpenSwath_Spectrum_Cache::evict_()
+  {
+    while (index_.size() > capacity_)
+    {
+      index_.erase(entries_.back().first);
+      entries_.pop_back();
+    }
+  }
+
+  void OpenSwathScoring::setSpectrumCache(const boost::shared_ptr<OpenSwath_Spectrum_Cache>& cache)
+  {
+    spectrum_cache_ = cache;
+  }
+
+  const boost::shared_ptr<OpenSwath_Spectrum_Cache>& OpenSwathScoring::getSpectrumCache() const
+  {
+    return spectrum_cache_;
+  }
+
   void OpenSwathScoring::calculateDIAScores(OpenSwath::IMRMFeature* imrmfeature,
                                             const std::vector<TransitionType> & transitions,
-                                            std::vector<OpenSwath::SwathMap> swath_maps,
+                                            const std::vector<OpenSwath::SwathMap>& swath_maps,
                                             OpenSwath::SpectrumAccessPtr ms1_map,
                                             OpenMS::DIAScoring & diascoring,
                                             const CompoundType& compound,
@@ -187,7 +273,7 @@ namespace OpenMS
 
   void OpenSwathScoring::calculateDIAIdScores(OpenSwath::IMRMFeature* imrmfeature,
                                               const TransitionType & transition,
-                                              const std::vector<OpenSwath::SwathMap> swath_maps,
+                                              const std::vector<OpenSwath::SwathMap>& swath_maps,
                                               OpenMS::DIAScoring & diascoring,
                                               OpenSwath_Scores & scores,
                                               double drift_lower, double drift_upper)
@@ -413,7 +499,7 @@ namespace OpenMS
     return getAddedSpectra_(swath_map, RT, nr_spectra_to_add, drift_lower, drift_upper);
   }
 
-  OpenSwath::SpectrumPtr OpenSwathScoring::fetchSpectrumSwath(std::vector<OpenSwath::SwathMap> swath_maps,
+  OpenSwath::SpectrumPtr OpenSwathScoring::fetchSpectrumSwath(const std::vector<OpenSwath::SwathMap>& swath_maps,
                                                               double RT, int nr_spectra_to_add, const double drift_lower, const double drift_upper)
   {
     if (swath_maps.size() == 1)
@@ -424,10 +510,10 @@ namespace OpenMS
     {
       // multiple SWATH maps for a single precursor -> this is SONAR data
       std::vector<OpenSwath::SpectrumPtr> all_spectra;
+      all_spectra.reserve(swath_maps.size());
       for (size_t i = 0; i < swath_maps.size(); ++i)
       {
-        OpenSwath::SpectrumPtr spec = getAddedSpectra_(swath_maps[i].sptr, RT, nr_spectra_to_add, drift_lower, drift_upper);
-        all_spectra.push_back(spec);
+        all_spectra.push_back(getAddedSpectra_(swath_maps[i].sptr, RT, nr_spectra_to_add, drift_lower, drift_upper));
       }
       OpenSwath::SpectrumPtr spectrum_ = SpectrumAddition::addUpSpectra(all_spectra, spacing_for_spectra_resampling_, true);
       return spectrum_;
@@ -494,40 +580,69 @@ namespace OpenMS
       closest_idx--;
     }
 
-    if (nr_spectra_to_add == 1)
+    // the spectrum only depends on the map, the closest spectrum and the
+    // drift range: look it up in the cache (if any) before summing up again
+    OpenSwath_Spectrum_Cache::KeyType key;
+    if (spectrum_cache_)
     {
-      OpenSwath::SpectrumPtr spectrum_ = swath_map->getSpectrumById(closest_idx);
-      if (drift_upper > 0) 
+      // the drift range is irrelevant if no filtering by drift time is performed
+      key = drift_upper > 0 ?
+        std::make_tuple(swath_map, closest_idx, nr_spectra_to_add, drift_lower, drift_upper) :
+        std::make_tuple(swath_map, closest_idx, nr_spectra_to_add, 0.0, 0.0);
+      OpenSwath::SpectrumPtr cached = spectrum_cache_->get(key);
+      if (cached)
       {
-        spectrum_ = filterByDrift(spectrum_, drift_lower, drift_upper);
+        return cached;
       }
-      return spectrum_;
+    }
+
+    // For ion mobility indexed data, only the peaks within the drift range
+    // are retrieved instead of filtering the full spectrum
+    const SpectrumAccessIonMobilityIndexed* im_indexed = drift_upper > 0 ?
+      dynamic_cast<const SpectrumAccessIonMobilityIndexed*>(swath_map.get()) : nullptr;
+    auto fetchSpectrum = [&](int idx) -> OpenSwath::SpectrumPtr
+    {
+      if (drift_upper <= 0)
+      {
+        return swath_map->getSpectrumById(idx);
+      }
+      if (im_indexed != nullptr && im_indexed->hasIonMobilityIndex(idx))
+      {
+        return im_indexed->getSpectrumByIdAndWindow(idx, -std::numeric_limits<double>::max(),
+            std::numeric_limits<double>::max(), drift_lower, drift_upper);
+      }
+      return filterByDrift(swath_map->getSpectrumById(idx), drift_lower, drift_upper);
+    };
+
+    OpenSwath::SpectrumPtr spectrum_;
+    if (nr_spectra_to_add == 1)
+    {
+      spectrum_ = fetchSpectrum(closest_idx);
     }
     else
     {
       std::vector<OpenSwath::SpectrumPtr> all_spectra;
       // always add the spectrum 0, then add those right and left
-      all_spectra.push_back(swath_map->getSpectrumById(closest_idx));
+      all_spectra.push_back(fetchSpectrum(closest_idx));
       for (int i = 1; i <= nr_spectra_to_add / 2; i++) // cast to int is intended!
       {
         if (closest_idx - i >= 0)
         {
-          all_spectra.push_back(swath_map->getSpectrumById(closest_idx - i));
+          all_spectra.push_back(fetchSpectrum(closest_idx - i));
         }
         if (closest_idx + i < (int)swath_map->getNrSpectra())
         {
-          all_spectra.push_back(swath_map->getSpectrumById(closest_idx + i));
+          all_spectra.push_back(fetchSpectrum(closest_idx + i));
         }
       }
-      if (drift_upper > 0) 
-      {
-        std::vector<OpenSwath::SpectrumPtr> tmp;
-        for (const auto& s: all_spectra) tmp.push_back( filterByDrift(s, drift_lower, drift_upper) );
-        all_spectra.swap(tmp);
-      }
-      OpenSwath::SpectrumPtr spectrum_ = SpectrumAddition::addUpSpectra(all_spectra, spacing_for_spectra_resampling_, true);
-      return spectrum_;
+      spectrum_ = SpectrumAddition::addUpSpectra(all_spectra, spacing_for_spectra_resampling_, true);
+    }
+
+    if (spectrum_cache_)
+    {
+      spectrum_cache_->insert(key, spectrum_);
     }
+    return spectrum_;
   }
 
 }
@@ -34,6 +34,16 @@
 
 #include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathWorkflow.h>
 
+#include <OpenMS/SYSTEM/Profiler.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 // OpenSwathCalibrationWorkflow
 namespace OpenMS
 {
@@ -52,6 +62,7 @@ namespace OpenMS
     bool sonar,
     bool load_into_memory)
   {
+    OPENMS_PROFILE_PHASE("OpenSwathWorkflow: RT normalization");
     LOG_DEBUG << "performRTNormalization method starting" << std::endl;
     std::vector< OpenMS::MSChromatogram > irt_chromatograms;
     TransformationDescription trafo; // dummy
@@ -314,7 +325,7 @@ namespace OpenMS
           if (load_into_memory)
           {
             // This creates an InMemory object that keeps all data in memory
-            current_swath_map = boost::shared_ptr<SpectrumAccessOpenMSInMemory>( new SpectrumAccessOpenMSInMemory(*current_swath_map) );
+            current_swath_map = loadIntoMemory_(current_swath_map, cp);
           }
 
           prepareExtractionCoordinates_(tmp_out, coordinates, transition_exp_used, trafo_inverse, cp);
@@ -405,6 +416,63 @@ namespace OpenMS
 // OpenSwathWorkflow
 namespace OpenMS
 {
+  namespace
+  {
+    /// A SWATH window in OpenSwathWorkflow::performExtraction(), prepared by its first and released by its last batch
+    struct SwathWindowTasks
+    {
+      std::mutex mutex;
+      bool prepared = false;
+      /// Transitions and compounds of the library selected for the window (see OpenSwathHelper::selectSwathTransitionIndices)
+      std::vector<Size> transition_indices;
+      std::vector<Size> compound_indices;
+      OpenSwath::LightTargetedExperiment transition_exp_used_all;
+      OpenSwath::SpectrumAccessPtr swath_map;
+      int batch_size = 0;
+      Size nr_batches = 0;
+      Size nr_compounds = 0;
+      std::atomic<Size> open_batches{0};
+    };
+
+    /// Number of compounds in a batch of a window (the last one may be smaller)
+    Size batchCompounds(const SwathWindowTasks& window, Size batch)
+    {
+      return std::min(Size(window.batch_size), window.nr_compounds - batch * window.batch_size);
+    }
+
+    /// Bounds the number of SWATH windows held at the same time
+    class WindowLimit
+    {
+public:
+      explicit WindowLimit(Size max_windows) :
+        available_(std::max(Size(1), max_windows))
+      {
+      }
+
+      /// Blocks until a window may be prepared
+      void acquire()
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this]() { return available_ > 0; });
+        --available_;
+      }
+
+      /// A window was released
+      void release()
+      {
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          ++available_;
+        }
+        condition_.notify_one();
+      }
+
+private:
+      std::mutex mutex_;
+      std::condition_variable condition_;
+      Size available_;
+    };
+  }
 
   void OpenSwathWorkflow::performExtraction(
     const std::vector< OpenSwath::SwathMap > & swath_maps,
@@ -422,6 +490,7 @@ namespace OpenMS
     int ms1_isotopes,
     bool load_into_memory)
   {
+    OPENMS_PROFILE_PHASE("OpenSwathWorkflow: extraction and scoring");
     tsv_writer.writeHeader();
     osw_writer.writeHeader();
 
@@ -442,8 +511,11 @@ namespace OpenMS
     {
       ms1_cp.im_extraction_window = -1;
     }
-    MS1Extraction_(swath_maps, ms1_chromatograms, chromConsumer, ms1_cp,
-                   transition_exp, trafo_inverse, load_into_memory, ms1_only, ms1_isotopes);
+    {
+      OPENMS_PROFILE_PHASE("OpenSwathWorkflow: MS1 extraction");
+      MS1Extraction_(swath_maps, ms1_chromatograms, chromConsumer, ms1_cp,
+                     transition_exp, trafo_inverse, load_into_memory, ms1_only, ms1_isotopes);
+    }
 
     if (ms1_only && !use_ms1_traces_)
     {
@@ -451,16 +523,22 @@ namespace OpenMS
           "Error, you need to enable use_ms1_traces when run in MS1 mode." );
     }
 
-    // (ii) Precursor extraction only
-    if (ms1_only)
+    // (ii) Precursor extraction only (a single unit of work if checkpointing)
+    const Size nr_compounds_all = transition_exp.getCompounds().size();
+    if (ms1_only && !(osw_writer.isCheckpointing() && osw_writer.isCheckpointed(0, 0, nr_compounds_all, nr_compounds_all)))
     {
       FeatureMap featureFile;
       boost::shared_ptr<MSExperiment> empty_exp = boost::shared_ptr<MSExperiment>(new MSExperiment);
 
+      String osw_checkpoint;
+      if (osw_writer.isCheckpointing())
+      {
+        osw_checkpoint = osw_writer.prepareCheckpoint(0, 0, nr_compounds_all, nr_compounds_all);
+      }
       OpenSwath::LightTargetedExperiment transition_exp_used = transition_exp;
       scoreAllChromatograms_(std::vector<MSChromatogram>(), ms1_chromatograms, swath_maps, transition_exp_used, 
                             feature_finder_param, trafo,
-                            cp.rt_extraction_window, featureFile, tsv_writer, osw_writer, ms1_isotopes, true);
+                            cp.rt_extraction_window, featureFile, tsv_writer, osw_writer, ms1_isotopes, true, osw_checkpoint);
 
       // write features to output if so desired
       std::vector< OpenMS::MSChromatogram > chromatograms;
@@ -468,145 +546,216 @@ namespace OpenMS
     }
 
     // (iii) Perform extraction and scoring of fragment ion chromatograms (MS2)
-    // We set dynamic scheduling such that the maps are worked on in the order
-    // in which they were given to the program / acquired. This gives much
-    // better load balancing than static allocation.
-#ifdef _OPENMP
-    int total_nr_threads = omp_get_max_threads(); // store total number of threads we are allowed to use
-    if (threads_outer_loop_ > -1)
+    // The unit of work is one batch of compounds of one SWATH window. All
+    // threads take these tasks from a common queue, in the order in which the
+    // maps were given to the program / acquired. This balances the load
+    // across windows of different size without nested parallel regions.
+    // The first task of a window prepares it and the last one releases it,
+    // so only the windows currently worked on are held in memory (at most
+    // threads_outer_loop_ windows, if set).
+    std::vector<SwathWindowTasks> windows(swath_maps.size());
+    std::vector<std::pair<Size, Size> > tasks; // (window, batch)
     {
-      omp_set_nested(1);
-      omp_set_dynamic(0);
-      omp_set_num_threads(std::min(threads_outer_loop_, omp_get_max_threads()) ); // use at most threads_outer_loop_ threads here
-    }
-#pragma omp parallel for schedule(dynamic,1)
+      // select the transitions of each window (only their indices are kept,
+      // the first task of a window copies them out of the library)
+      std::vector<Size> nr_compounds(swath_maps.size(), 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
 #endif
-    for (SignedSize i = 0; i < boost::numeric_cast<SignedSize>(swath_maps.size()); ++i)
-    {
-      if (!swath_maps[i].ms1) // skip MS1
+      for (SignedSize i = 0; i < boost::numeric_cast<SignedSize>(swath_maps.size()); ++i)
       {
-
-        // Step 1: select which transitions to extract (proceed in batches)
-        OpenSwath::LightTargetedExperiment transition_exp_used_all;
-        OpenSwathHelper::selectSwathTransitions(transition_exp, transition_exp_used_all,
-            cp.min_upper_edge_dist, swath_maps[i].lower, swath_maps[i].upper);
-        if (transition_exp_used_all.getTransitions().size() > 0) // skip if no transitions found
+        if (!swath_maps[i].ms1) // skip MS1
         {
-
-          OpenSwath::SpectrumAccessPtr current_swath_map = swath_maps[i].sptr;
-          if (load_into_memory)
+          SwathWindowTasks& window = windows[i];
+          OpenSwathHelper::selectSwathTransitionIndices(transition_exp, window.transition_indices, window.compound_indices,
+              cp.min_upper_edge_dist, swath_maps[i].lower, swath_maps[i].upper);
+          if (window.transition_indices.size() > 0) // skip if no transitions found
           {
-            // This creates an InMemory object that keeps all data in memory
-            current_swath_map = boost::shared_ptr<SpectrumAccessOpenMSInMemory>( new SpectrumAccessOpenMSInMemory(*current_swath_map) );
+            nr_compounds[i] = window.compound_indices.size();
           }
+        }
+      }
 
-          int batch_size;
-          if (batchSize <= 0 || batchSize >= (int)transition_exp_used_all.getCompounds().size())
-          {
-            batch_size = transition_exp_used_all.getCompounds().size();
-          }
-          else
+      for (Size i = 0; i < swath_maps.size(); ++i)
+      {
+        if (nr_compounds[i] == 0)
+        {
+          this->setProgress(++progress);
+          continue;
+        }
+        SwathWindowTasks& window = windows[i];
+        if (batchSize <= 0 || batchSize >= (int)nr_compounds[i])
+        {
+          window.batch_size = nr_compounds[i];
+        }
+        else
+        {
+          window.batch_size = batchSize;
+        }
+        window.nr_batches = (nr_compounds[i] + window.batch_size - 1) / window.batch_size;
+        window.nr_compounds = nr_compounds[i];
+        Size open_batches = 0;
+        for (Size pep_idx = 0; pep_idx < window.nr_batches; ++pep_idx)
+        {
+          // skip the batches completed by a previous run
+          if (osw_writer.isCheckpointing() &&
+              osw_writer.isCheckpointed(i, pep_idx, window.batch_size, batchCompounds(window, pep_idx)))
           {
-            batch_size = batchSize;
+            continue;
           }
+          tasks.push_back(std::make_pair(i, pep_idx));
+          ++open_batches;
+        }
+        window.open_batches = open_batches;
+        if (open_batches == 0)
+        {
+          this->setProgress(++progress);
+        }
+      }
+    }
+    if (osw_writer.isCheckpointing() && osw_writer.getNumberOfCheckpoints() > 0)
+    {
+      std::cout << "Resuming from checkpoint: " << osw_writer.getNumberOfCheckpoints() << " batches were completed before, "
+                << tasks.size() << " batches remain." << std::endl;
+    }
 
-          SignedSize nr_batches = (transition_exp_used_all.getCompounds().size() / batch_size);
+    WindowLimit window_limit(threads_outer_loop_ > 0 ? Size(threads_outer_loop_) : swath_maps.size());
+    std::atomic<Size> next_task(0);
 #ifdef _OPENMP
-          // If we have a multiple of threads_outer_loop_ here, then use nested
-          // parallelization here. E.g. if we use 8 threads for the outer loop,
-          // but we have a total of 24 cores available, each of the 8 threads
-          // will then create a team of 3 threads to work on the batches
-          // individually.
-          //
-          // We should avoid oversubscribing the CPUs, therefore we use integer division.
-          // -- see https://docs.oracle.com/cd/E19059-01/stud.10/819-0501/2_nested.html
-          int outer_thread_nr = omp_get_thread_num();
-          omp_set_num_threads(std::max(1, total_nr_threads / threads_outer_loop_) );
-#pragma omp parallel for schedule(dynamic, 1)
+#pragma omp parallel
 #endif
-          for (SignedSize pep_idx = 0; pep_idx <= nr_batches; pep_idx++)
-          {
-            OpenSwath::SpectrumAccessPtr current_swath_map_inner = current_swath_map;
-
+    {
+      // Several threads may work on the same window. To ensure multi-threading
+      // safe access to the individual spectra, each of them needs a light clone
+      // of the spectrum access (if multiple threads share a single filestream
+      // and call seek on it, chaos will ensue).
+      bool clone_maps = false;
 #ifdef _OPENMP
-            // To ensure multi-threading safe access to the individual spectra, we
-            // need to use a light clone of the spectrum access (if multiple threads
-            // share a single filestream and call seek on it, chaos will ensue).
-            if (total_nr_threads / threads_outer_loop_ > 1)
+      clone_maps = omp_get_num_threads() > 1;
+#endif
+
+      // take the tasks strictly in order (a window is only prepared once all
+      // tasks of the previous windows have been started)
+      for (Size task = next_task++; task < tasks.size(); task = next_task++)
+      {
+        const Size i = tasks[task].first;
+        const Size pep_idx = tasks[task].second;
+        SwathWindowTasks& window = windows[i];
+
+        // Step 1: select which transitions to extract (the first task of a window)
+        OpenSwath::SpectrumAccessPtr current_swath_map;
+        {
+          std::lock_guard<std::mutex> lock(window.mutex);
+          if (!window.prepared)
+          {
+            window_limit.acquire();
+            OpenSwathHelper::selectTransitions(transition_exp, window.transition_indices, window.compound_indices,
+                window.transition_exp_used_all);
+            std::vector<Size>().swap(window.transition_indices);
+            std::vector<Size>().swap(window.compound_indices);
+            window.swath_map = swath_maps[i].sptr;
+            if (load_into_memory)
             {
-              current_swath_map_inner = current_swath_map->lightClone();
+              // This creates an InMemory object that keeps all data in memory
+              window.swath_map = loadIntoMemory_(window.swath_map, cp);
             }
+            window.prepared = true;
+          }
+          current_swath_map = clone_maps ? window.swath_map->lightClone() : window.swath_map;
+        }
+        const OpenSwath::LightTargetedExperiment& transition_exp_used_all = window.transition_exp_used_all;
 
+#ifdef _OPENMP
 #pragma omp critical (osw_write_stdout)
 #endif
-            {
-              std::cout << "Thread " <<
+        {
+          std::cout << "Thread " <<
 #ifdef _OPENMP
-              outer_thread_nr << "_" << omp_get_thread_num() << " " <<
+          omp_get_thread_num() << " " <<
 #else
-              "0" << 
+          "0" <<
 #endif
-              "will analyze " << transition_exp_used_all.getCompounds().size() <<  " compounds and "
-              << transition_exp_used_all.getTransitions().size() <<  " transitions "
-              "from SWATH " << i << " (batch " << pep_idx << " out of " << nr_batches << ")" << std::endl;
-            }
-
-            // Create the new, batch-size transition experiment
-            OpenSwath::LightTargetedExperiment transition_exp_used;
-            selectCompoundsForBatch_(transition_exp_used_all, transition_exp_used, batch_size, pep_idx);
-
-            // Step 2.1: extract these transitions
-            ChromatogramExtractor extractor;
-            std::vector< OpenSwath::ChromatogramPtr > chrom_list;
-            std::vector< ChromatogramExtractor::ExtractionCoordinates > coordinates;
-
-            // Step 2.2: prepare the extraction coordinates and extract chromatograms
-            // chrom_list contains one entry for each fragment ion (transition) in transition_exp_used
-            prepareExtractionCoordinates_(chrom_list, coordinates, transition_exp_used, trafo_inverse, cp);
-            extractor.extractChromatograms(current_swath_map_inner, chrom_list, coordinates, cp.mz_extraction_window,
-                cp.ppm, cp.im_extraction_window, cp.extraction_function);
+          "will analyze " << transition_exp_used_all.getCompounds().size() <<  " compounds and "
+          << transition_exp_used_all.getTransitions().size() <<  " transitions "
+          "from SWATH " << i << " (batch " << pep_idx << " out of " << window.nr_batches << ")" << std::endl;
+        }
 
-            // Step 2.3: convert chromatograms back to OpenMS::MSChromatogram and write to output
-            PeakMap chrom_exp;
-            extractor.return_chromatogram(chrom_list, coordinates, transition_exp_used,  SpectrumSettings(), 
-                                          chrom_exp.getChromatograms(), false, cp.im_extraction_window);
+        // Create the new, batch-size transition experiment
+        OpenSwath::LightTargetedExperiment transition_exp_used;
+        selectCompoundsForBatch_(transition_exp_used_all, transition_exp_used, window.batch_size, pep_idx);
 
+        // Step 2.1: extract these transitions
+        ChromatogramExtractor extractor;
+        std::vector< OpenSwath::ChromatogramPtr > chrom_list;
+        std::vector< ChromatogramExtractor::ExtractionCoordinates > coordinates;
 
-            // Step 3: score these extracted transitions
-            FeatureMap featureFile;
-            std::vector< OpenSwath::SwathMap > tmp = {swath_maps[i]};
-            tmp.back().sptr = current_swath_map_inner;
-            scoreAllChromatograms_(chrom_exp.getChromatograms(), ms1_chromatograms, tmp, transition_exp_used,
-                feature_finder_param, trafo, cp.rt_extraction_window, featureFile, tsv_writer, osw_writer, ms1_isotopes);
+        // Step 2.2: prepare the extraction coordinates and extract chromatograms
+        // chrom_list contains one entry for each fragment ion (transition) in transition_exp_used
+        prepareExtractionCoordinates_(chrom_list, coordinates, transition_exp_used, trafo_inverse, cp);
+        extractor.extractChromatograms(current_swath_map, chrom_list, coordinates, cp.mz_extraction_window,
+            cp.ppm, cp.im_extraction_window, cp.extraction_function);
 
-            // Step 4: write all chromatograms and features out into an output object / file
-            // (this needs to be done in a critical section since we only have one
-            // output file and one output map).
+        // Step 2.3: convert chromatograms back to OpenMS::MSChromatogram and write to output
+        PeakMap chrom_exp;
+        extractor.return_chromatogram(chrom_list, coordinates, transition_exp_used,  SpectrumSettings(),
+                                      chrom_exp.getChromatograms(), false, cp.im_extraction_window);
+
+        // Step 3: score these extracted transitions
+        FeatureMap featureFile;
+        std::vector< OpenSwath::SwathMap > tmp = {swath_maps[i]};
+        tmp.back().sptr = current_swath_map;
+        String osw_checkpoint;
+        if (osw_writer.isCheckpointing())
+        {
+          osw_checkpoint = osw_writer.prepareCheckpoint(i, pep_idx, window.batch_size, batchCompounds(window, pep_idx));
+        }
+        scoreAllChromatograms_(chrom_exp.getChromatograms(), ms1_chromatograms, tmp, transition_exp_used,
+            feature_finder_param, trafo, cp.rt_extraction_window, featureFile, tsv_writer, osw_writer, ms1_isotopes,
+            false, osw_checkpoint);
+        OPENMS_PROFILE_COUNTER("OpenSwathWorkflow: extracted chromatograms", chrom_list.size());
+        OPENMS_PROFILE_COUNTER("OpenSwathWorkflow: scored features", featureFile.size());
+        OPENMS_PROFILE_HISTOGRAM("OpenSwathWorkflow: chromatograms per batch", chrom_list.size());
+
+        // Step 4: write all chromatograms and features out into an output object / file
+        // (this needs to be done in a critical section since we only have one
+        // output file and one output map).
 #ifdef _OPENMP
 #pragma omp critical (osw_write_out)
 #endif
-            {
-              writeOutFeaturesAndChroms_(chrom_exp.getChromatograms(), featureFile, out_featureFile, store_features, chromConsumer);
-            }
-          }
+        {
+          writeOutFeaturesAndChroms_(chrom_exp.getChromatograms(), featureFile, out_featureFile, store_features, chromConsumer);
+        }
 
-        } // continue 2 (no continue due to OpenMP)
-      } // continue 1 (no continue due to OpenMP)
+        // Step 5: the last task of a window releases it
+        if (--window.open_batches == 0)
+        {
+          {
+            std::lock_guard<std::mutex> lock(window.mutex);
+            window.swath_map.reset();
+            window.transition_exp_used_all = OpenSwath::LightTargetedExperiment();
+          }
+          window_limit.release();
 
 #ifdef _OPENMP
 #pragma omp critical (progress)
 #endif
-        this->setProgress(++progress);
-
+          this->setProgress(++progress);
+        }
+      }
     }
     this->endProgress();
-    
-#ifdef _OPENMP
-    if (threads_outer_loop_ > -1)
+    logSpectrumCacheStatistics_();
+  }
+
+  void OpenSwathWorkflow::logSpectrumCacheStatistics_()
+  {
+    if (spectrum_cache_hits_ + spectrum_cache_misses_ > 0)
     {
-      omp_set_num_threads(total_nr_threads); // set number of available threads back to initial value
+      LOG_INFO << "Spectrum cache: " << spectrum_cache_hits_ << " hits, " << spectrum_cache_misses_ << " misses (hit rate "
+               << 100.0 * spectrum_cache_hits_ / (spectrum_cache_hits_ + spectrum_cache_misses_) << " %)" << std::endl;
     }
-#endif    
+    spectrum_cache_hits_ = 0;
+    spectrum_cache_misses_ = 0;
   }
 
   void OpenSwathWorkflow::writeOutFeaturesAndChroms_(
@@ -665,7 +814,7 @@ namespace OpenMS
           // This creates an InMemory object that keeps all data in memory
           // but provides the same access functionality to the raw data as
           // any object implementing ISpectrumAccess
-          ms1_map_ = boost::shared_ptr<SpectrumAccessOpenMSInMemory>( new SpectrumAccessOpenMSInMemory(*ms1_map_) );
+          ms1_map_ = loadIntoMemory_(ms1_map_, cp);
         }
 
         std::vector< OpenSwath::ChromatogramPtr > chrom_list;
@@ -719,7 +868,8 @@ namespace OpenMS
     OpenSwathTSVWriter & tsv_writer,
     OpenSwathOSWWriter & osw_writer,
     int nr_ms1_isotopes,
-    bool ms1only) const
+    bool ms1only,
+    const String& osw_checkpoint) const
   {
     TransformationDescription trafo_inv = trafo;
     trafo_inv.invert();
@@ -770,15 +920,36 @@ namespace OpenMS
     // Map peptide id to corresponding transitions
     typedef std::map<String, std::vector< const TransitionType* > > AssayMapT;
     AssayMapT assay_map;
-    // create an entry for each member (ensure there is one even if we don't
-    // have any transitions for it, e.g. in the case of ms1 only)
-    for (Size i = 0; i < transition_exp.getCompounds().size(); i++)
+    if (transition_exp.hasCompoundTransitionIndex())
     {
-      assay_map[transition_exp.getCompounds()[i].id] = std::vector< const TransitionType* >();
+      // transitions are grouped by compound: one map entry per compound
+      // (orphaned transitions are added below)
+      const std::vector<std::size_t>& offsets = transition_exp.compound_transition_offsets;
+      for (Size i = 0; i < transition_exp.getCompounds().size(); i++)
+      {
+        std::vector< const TransitionType* >& assay = assay_map[transition_exp.getCompounds()[i].id];
+        for (Size k = offsets[i]; k < offsets[i + 1]; k++)
+        {
+          assay.push_back(&transition_exp.getTransitions()[k]);
+        }
+      }
+      for (Size i = offsets.back(); i < transition_exp.getTransitions().size(); i++)
+      {
+        assay_map[transition_exp.getTransitions()[i].getPeptideRef()].push_back(&transition_exp.getTransitions()[i]);
+      }
     }
-    for (Size i = 0; i < transition_exp.getTransitions().size(); i++)
+    else
     {
-      assay_map[transition_exp.getTransitions()[i].getPeptideRef()].push_back(&transition_exp.getTransitions()[i]);
+      // create an entry for each member (ensure there is one even if we don't
+      // have any transitions for it, e.g. in the case of ms1 only)
+      for (Size i = 0; i < transition_exp.getCompounds().size(); i++)
+      {
+        assay_map[transition_exp.getCompounds()[i].id] = std::vector< const TransitionType* >();
+      }
+      for (Size i = 0; i < transition_exp.getTransitions().size(); i++)
+      {
+        assay_map[transition_exp.getTransitions()[i].getPeptideRef()].push_back(&transition_exp.getTransitions()[i]);
+      }
     }
 
     std::vector<String> to_tsv_output, to_osw_output;
@@ -879,6 +1050,16 @@ namespace OpenMS
       }
     }
 
+    // the hit rate is reported once per run (see logSpectrumCacheStatistics_)
+    const OpenSwath_Spectrum_Cache& spectrum_cache = featureFinder.getSpectrumCache();
+#ifdef _OPENMP
+#pragma omp critical (spectrum_cache_statistics)
+#endif
+    {
+      spectrum_cache_hits_ += spectrum_cache.hits;
+      spectrum_cache_misses_ += spectrum_cache.misses;
+    }
+
     // Only write at the very end since this is a step that needs a barrier
     if (tsv_writer.isActive())
     {
@@ -897,6 +1078,11 @@ namespace OpenMS
 #pragma omp critical (osw_write_tsv)
 #endif
       {
+        // record the unit of work in the same transaction as its features
+        if (!osw_checkpoint.empty())
+        {
+          to_osw_output.push_back(osw_checkpoint);
+        }
         osw_writer.writeLines(to_osw_output);
       }
     }
@@ -916,6 +1102,22 @@ namespace OpenMS
 
     // Create the new, batch-size transition experiment
     transition_exp_used.proteins = transition_exp_used_all.proteins;
+    if (transition_exp_used_all.hasCompoundTransitionIndex() && transition_exp_used.compounds.empty())
+    {
+      // the transitions of the batch are a contiguous range, no need to match compound ids
+      const std::vector<std::size_t>& offsets = transition_exp_used_all.compound_transition_offsets;
+      transition_exp_used.compounds.assign(
+          transition_exp_used_all.compounds.begin() + start, transition_exp_used_all.compounds.begin() + end);
+      transition_exp_used.transitions.assign(
+          transition_exp_used_all.transitions.begin() + offsets[start], transition_exp_used_all.transitions.begin() + offsets[end]);
+      std::vector<std::size_t> batch_offsets(end - start + 1);
+      for (size_t k = start; k <= end; k++)
+      {
+        batch_offsets[k - start] = offsets[k] - offsets[start];
+      }
+      transition_exp_used.setCompoundTransitionOffsets(batch_offsets);
+      return;
+    }
     transition_exp_used.compounds.insert(transition_exp_used.compounds.end(),
         transition_exp_used_all.compounds.begin() + start, transition_exp_used_all.compounds.begin() + end);
     copyBatchTransitions_(transition_exp_used.compounds, transition_exp_used_all.transitions, transition_exp_used.transitions);
@@ -940,6 +1142,15 @@ namespace OpenMS
     }
   }
 
+  OpenSwath::SpectrumAccessPtr OpenSwathWorkflowBase::loadIntoMemory_(const OpenSwath::SpectrumAccessPtr& map, const ChromExtractParams & cp)
+  {
+    if (cp.im_extraction_window > 0.0)
+    {
+      return boost::shared_ptr<SpectrumAccessIonMobilityIndexed>( new SpectrumAccessIonMobilityIndexed(*map) );
+    }
+    return boost::shared_ptr<SpectrumAccessOpenMSInMemory>( new SpectrumAccessOpenMSInMemory(*map) );
+  }
+
   void OpenSwathWorkflowBase::prepareExtractionCoordinates_(std::vector< OpenSwath::ChromatogramPtr > & chrom_list,
                                                             std::vector< ChromatogramExtractorAlgorithm::ExtractionCoordinates > & coordinates, 
                                                             const OpenSwath::LightTargetedExperiment & transition_exp_used, 
@@ -1072,7 +1283,7 @@ namespace OpenMS
               // clone or load them into memory if requested.
               if (load_into_memory)
               {
-                used_maps[i].sptr = boost::shared_ptr<SpectrumAccessOpenMSInMemory>( new SpectrumAccessOpenMSInMemory(*used_maps[i].sptr) );
+                used_maps[i].sptr = loadIntoMemory_(used_maps[i].sptr, cp);
               }
               else
               {
@@ -1144,6 +1355,7 @@ namespace OpenMS
         this->setProgress(++progress);
       }
       this->endProgress();
+      logSpectrumCacheStatistics_();
     }
 
 
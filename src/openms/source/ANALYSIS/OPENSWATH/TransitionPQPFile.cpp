@@ -34,6 +34,11 @@
 
 #include <OpenMS/ANALYSIS/OPENSWATH/TransitionPQPFile.h>
 
+#include <cstdio>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
 namespace OpenMS
 {
 
@@ -57,8 +62,220 @@ namespace OpenMS
     return(0);
   }
 
+  // Execute one or more SQL statements
+  static void executeSQL(sqlite3* db, const char* sql)
+  {
+    char *zErrMsg = nullptr;
+    if (sqlite3_exec(db, sql, callback, nullptr, &zErrMsg) != SQLITE_OK)
+    {
+      String error(zErrMsg);
+      sqlite3_free(zErrMsg);
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, error);
+    }
+  }
+
+  // Prepare a statement which is executed repeatedly (see executeStatement)
+  static sqlite3_stmt* prepareStatement(sqlite3* db, const char* sql)
+  {
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, sqlite3_errmsg(db));
+    }
+    return stmt;
+  }
+
+  // Execute a prepared statement with the current bindings and reset it (all parameters become NULL)
+  static void executeStatement(sqlite3* db, sqlite3_stmt* stmt)
+  {
+    if (sqlite3_step(stmt) != SQLITE_DONE)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, sqlite3_errmsg(db));
+    }
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+  }
+
+  // Owns the database and the prepared statements while a PQP file is
+  // written. Unless commit() was called, the open transaction is rolled back
+  // and the incomplete file is removed (e.g. if an exception is thrown).
+  class PQPWriteGuard
+  {
+public:
+    explicit PQPWriteGuard(const char* filename) :
+      db(nullptr),
+      filename_(filename),
+      committed_(false)
+    {
+    }
+
+    ~PQPWriteGuard()
+    {
+      for (std::vector<sqlite3_stmt*>::iterator it = statements_.begin(); it != statements_.end(); ++it)
+      {
+        sqlite3_finalize(*it);
+      }
+      if (db != nullptr)
+      {
+        if (!committed_ && !sqlite3_get_autocommit(db))
+        {
+          sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        }
+        sqlite3_close(db);
+      }
+      if (!committed_)
+      {
+        remove(filename_.c_str());
+      }
+    }
+
+    // Prepare a statement that is finalized together with the database
+    sqlite3_stmt* prepare(const char* sql)
+    {
+      statements_.push_back(prepareStatement(db, sql));
+      return statements_.back();
+    }
+
+    // Keep the output file (the transaction has to be ended by the caller)
+    void commit()
+    {
+      committed_ = true;
+    }
+
+    PQPWriteGuard(const PQPWriteGuard&) = delete;
+    PQPWriteGuard& operator=(const PQPWriteGuard&) = delete;
+
+    sqlite3* db;
+
+private:
+    std::string filename_;
+    bool committed_;
+    std::vector<sqlite3_stmt*> statements_;
+  };
+
+  // Create an empty PQP file (replacing any existing file) and return the opened database
+  static sqlite3* createPQPFile(const char* filename)
+  {
+    sqlite3 *db;
+    char *zErrMsg = nullptr;
+    int  rc;
+
+    // delete file if present
+    remove(filename);
+
+    // Open database
+    rc = sqlite3_open(filename, &db);
+    if ( rc )
+    {
+      fprintf(stderr, "Can't open database: %s\n", sqlite3_errmsg(db));
+    }
+
+    // Create SQL structure
+    const char* create_sql =
+      // protein table
+      // OpenSWATH proteomics workflows
+      "CREATE TABLE PROTEIN(" \
+      "ID INT PRIMARY KEY NOT NULL," \
+      "PROTEIN_ACCESSION TEXT NOT NULL," \
+      "DECOY INT NOT NULL);" \
+
+      // peptide_protein_mapping table
+      // OpenSWATH proteomics workflows
+      "CREATE TABLE PEPTIDE_PROTEIN_MAPPING(" \
+      "PEPTIDE_ID INT NOT NULL," \
+      "PROTEIN_ID INT NOT NULL);" \
+
+      // peptide table
+      // OpenSWATH proteomics workflows
+      "CREATE TABLE PEPTIDE(" \
+      "ID INT PRIMARY KEY NOT NULL," \
+      "UNMODIFIED_SEQUENCE TEXT NOT NULL," \
+      "MODIFIED_SEQUENCE TEXT NOT NULL," \
+      "DECOY INT NOT NULL);" \
+
+      // precursor_peptide_mapping table
+      // OpenSWATH proteomics workflows
+      "CREATE TABLE PRECURSOR_PEPTIDE_MAPPING(" \
+      "PRECURSOR_ID INT NOT NULL," \
+      "PEPTIDE_ID INT NOT NULL);" \
+
+      // compound table
+      // OpenSWATH metabolomics workflows
+      "CREATE TABLE COMPOUND(" \
+      "ID INT PRIMARY KEY NOT NULL," \
+      "COMPOUND_NAME TEXT NOT NULL," \
+      "SUM_FORMULA TEXT NOT NULL," \
+      "SMILES TEXT NOT NULL," \
+      "DECOY INT NOT NULL);" \
+
+      // precursor_compound_mapping table
+      // OpenSWATH metabolomics workflows
+      "CREATE TABLE PRECURSOR_COMPOUND_MAPPING(" \
+      "PRECURSOR_ID INT NOT NULL," \
+      "COMPOUND_ID INT NOT NULL);" \
+
+      // precursor table
+      "CREATE TABLE PRECURSOR(" \
+      "ID INT PRIMARY KEY NOT NULL," \
+      "TRAML_ID TEXT NULL," \
+      "GROUP_LABEL TEXT NULL," \
+      "PRECURSOR_MZ REAL NOT NULL," \
+      "CHARGE INT NULL," \
+      "LIBRARY_INTENSITY REAL NULL," \
+      "LIBRARY_RT REAL NULL," \
+      "DECOY INT NOT NULL);" \
+
+      // transition_precursor_mapping table
+      "CREATE TABLE TRANSITION_PRECURSOR_MAPPING(" \
+      "TRANSITION_ID INT NOT NULL," \
+      "PRECURSOR_ID INT NOT NULL);" \
+
+      // transition_peptide_mapping table
+      // IPF proteomics workflows
+      "CREATE TABLE TRANSITION_PEPTIDE_MAPPING(" \
+      "TRANSITION_ID INT NOT NULL," \
+      "PEPTIDE_ID INT NOT NULL);" \
+
+      // transition table
+      "CREATE TABLE TRANSITION(" \
+      "ID INT PRIMARY KEY NOT NULL," \
+      "TRAML_ID TEXT NULL," \
+      "PRODUCT_MZ REAL NOT NULL," \
+      "CHARGE INT NULL," \
+      "TYPE CHAR(1) NULL," \
+      "ORDINAL INT NULL," \
+      "DETECTING INT NOT NULL," \
+      "IDENTIFYING INT NOT NULL," \
+      "QUANTIFYING INT NOT NULL," \
+      "LIBRARY_INTENSITY REAL NULL," \
+      "DECOY INT NOT NULL);";
+
+    // Execute SQL create statement
+    rc = sqlite3_exec(db, create_sql, callback, nullptr, &zErrMsg);
+    if ( rc != SQLITE_OK )
+    {
+      String error(zErrMsg);
+      sqlite3_free(zErrMsg);
+      sqlite3_close(db);
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          error);
+    }
+
+    return db;
+  }
+
   void TransitionPQPFile::readPQPInput_(const char* filename, std::vector<TSVTransition>& transition_list, bool legacy_traml_id)
   {
+    readPQPInput_(filename, [&transition_list](std::vector<TSVTransition>& chunk)
+      {
+        transition_list.insert(transition_list.end(), chunk.begin(), chunk.end());
+      }, legacy_traml_id);
+  }
+
+  void TransitionPQPFile::readPQPInput_(const char* filename, const std::function<void(std::vector<TSVTransition>&)>& process_chunk,
+                                        bool legacy_traml_id, Size chunk_size)
+  {
+    std::vector<TSVTransition> transition_list;
     sqlite3 *db;
     sqlite3_stmt * cntstmt;
     sqlite3_stmt * stmt;
@@ -287,8 +504,17 @@ namespace OpenMS
       }
 
       transition_list.push_back(mytransition);
+      if (transition_list.size() >= chunk_size)
+      {
+        process_chunk(transition_list);
+        transition_list.clear();
+      }
       sqlite3_step( stmt );
     }
+    if (!transition_list.empty())
+    {
+      process_chunk(transition_list);
+    }
     endProgress();
 
     sqlite3_finalize(stmt);
@@ -302,104 +528,7 @@ namespace OpenMS
     char *zErrMsg = nullptr;
     int  rc;
 
-    // delete file if present
-    remove(filename);
-
-    // Open database
-    rc = sqlite3_open(filename, &db);
-    if ( rc )
-    {
-      fprintf(stderr, "Can't open database: %s\n", sqlite3_errmsg(db));
-    }
-
-    // Create SQL structure
-    const char* create_sql =
-      // protein table
-      // OpenSWATH proteomics workflows
-      "CREATE TABLE PROTEIN(" \
-      "ID INT PRIMARY KEY NOT NULL," \
-      "PROTEIN_ACCESSION TEXT NOT NULL," \
-      "DECOY INT NOT NULL);" \
-
-      // peptide_protein_mapping table
-      // OpenSWATH proteomics workflows
-      "CREATE TABLE PEPTIDE_PROTEIN_MAPPING(" \
-      "PEPTIDE_ID INT NOT NULL," \
-      "PROTEIN_ID INT NOT NULL);" \
-
-      // peptide table
-      // OpenSWATH proteomics workflows
-      "CREATE TABLE PEPTIDE(" \
-      "ID INT PRIMARY KEY NOT NULL," \
-      "UNMODIFIED_SEQUENCE TEXT NOT NULL," \
-      "MODIFIED_SEQUENCE TEXT NOT NULL," \
-      "DECOY INT NOT NULL);" \
-
-      // precursor_peptide_mapping table
-      // OpenSWATH proteomics workflows
-      "CREATE TABLE PRECURSOR_PEPTIDE_MAPPING(" \
-      "PRECURSOR_ID INT NOT NULL," \
-      "PEPTIDE_ID INT NOT NULL);" \
-
-      // compound table
-      // OpenSWATH metabolomics workflows
-      "CREATE TABLE COMPOUND(" \
-      "ID INT PRIMARY KEY NOT NULL," \
-      "COMPOUND_NAME TEXT NOT NULL," \
-      "SUM_FORMULA TEXT NOT NULL," \
-      "SMILES TEXT NOT NULL," \
-      "DECOY INT NOT NULL);" \
-
-      // precursor_compound_mapping table
-      // OpenSWATH metabolomics workflows
-      "CREATE TABLE PRECURSOR_COMPOUND_MAPPING(" \
-      "PRECURSOR_ID INT NOT NULL," \
-      "COMPOUND_ID INT NOT NULL);" \
-
-      // precursor table
-      "CREATE TABLE PRECURSOR(" \
-      "ID INT PRIMARY KEY NOT NULL," \
-      "TRAML_ID TEXT NULL," \
-      "GROUP_LABEL TEXT NULL," \
-      "PRECURSOR_MZ REAL NOT NULL," \
-      "CHARGE INT NULL," \
-      "LIBRARY_INTENSITY REAL NULL," \
-      "LIBRARY_RT REAL NULL," \
-      "DECOY INT NOT NULL);" \
-
-      // transition_precursor_mapping table
-      "CREATE TABLE TRANSITION_PRECURSOR_MAPPING(" \
-      "TRANSITION_ID INT NOT NULL," \
-      "PRECURSOR_ID INT NOT NULL);" \
-
-      // transition_peptide_mapping table
-      // IPF proteomics workflows
-      "CREATE TABLE TRANSITION_PEPTIDE_MAPPING(" \
-      "TRANSITION_ID INT NOT NULL," \
-      "PEPTIDE_ID INT NOT NULL);" \
-
-      // transition table
-      "CREATE TABLE TRANSITION(" \
-      "ID INT PRIMARY KEY NOT NULL," \
-      "TRAML_ID TEXT NULL," \
-      "PRODUCT_MZ REAL NOT NULL," \
-      "CHARGE INT NULL," \
-      "TYPE CHAR(1) NULL," \
-      "ORDINAL INT NULL," \
-      "DETECTING INT NOT NULL," \
-      "IDENTIFYING INT NOT NULL," \
-      "QUANTIFYING INT NOT NULL," \
-      "LIBRARY_INTENSITY REAL NULL," \
-      "DECOY INT NOT NULL);";
-
-    // Execute SQL create statement
-    rc = sqlite3_exec(db, create_sql, callback, nullptr, &zErrMsg);
-    if ( rc != SQLITE_OK )
-    {
-      sqlite3_free(zErrMsg);
-      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-          zErrMsg);
-    }
+    db = createPQPFile(filename);
 
     // Prepare insert statements
 
@@ -591,9 +720,10 @@ namespace OpenMS
     rc = sqlite3_exec(db, insert_protein_sql_str.c_str(), callback, nullptr, &zErrMsg);
     if ( rc != SQLITE_OK )
     {
+      String error(zErrMsg);
       sqlite3_free(zErrMsg);
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-          zErrMsg);
+          error);
     }
 
     // Execute SQL insert statement
@@ -601,9 +731,10 @@ namespace OpenMS
     rc = sqlite3_exec(db, insert_peptide_protein_mapping_str.c_str(), callback, nullptr, &zErrMsg);
     if ( rc != SQLITE_OK )
     {
+      String error(zErrMsg);
       sqlite3_free(zErrMsg);
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-          zErrMsg);
+          error);
     }
 
     // Execute SQL insert statement
@@ -611,9 +742,10 @@ namespace OpenMS
     rc = sqlite3_exec(db, insert_peptide_sql_str.c_str(), callback, nullptr, &zErrMsg);
     if ( rc != SQLITE_OK )
     {
+      String error(zErrMsg);
       sqlite3_free(zErrMsg);
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-          zErrMsg);
+          error);
     }
 
     // Execute SQL insert statement
@@ -621,9 +753,10 @@ namespace OpenMS
     rc = sqlite3_exec(db, insert_compound_sql_str.c_str(), callback, nullptr, &zErrMsg);
     if ( rc != SQLITE_OK )
     {
+      String error(zErrMsg);
       sqlite3_free(zErrMsg);
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-          zErrMsg);
+          error);
     }
 
     // Execute SQL insert statement
@@ -631,9 +764,10 @@ namespace OpenMS
     rc = sqlite3_exec(db, insert_precursor_peptide_mapping_str.c_str(), callback, nullptr, &zErrMsg);
     if ( rc != SQLITE_OK )
     {
+      String error(zErrMsg);
       sqlite3_free(zErrMsg);
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-          zErrMsg);
+          error);
     }
 
     // Execute SQL insert statement
@@ -641,9 +775,10 @@ namespace OpenMS
     rc = sqlite3_exec(db, insert_precursor_compound_mapping_str.c_str(), callback, nullptr, &zErrMsg);
     if ( rc != SQLITE_OK )
     {
+      String error(zErrMsg);
       sqlite3_free(zErrMsg);
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-          zErrMsg);
+          error);
     }
 
     // Execute SQL insert statement
@@ -651,9 +786,10 @@ namespace OpenMS
     rc = sqlite3_exec(db, insert_precursor_sql_str.c_str(), callback, nullptr, &zErrMsg);
     if ( rc != SQLITE_OK )
     {
+      String error(zErrMsg);
       sqlite3_free(zErrMsg);
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-          zErrMsg);
+          error);
     }
 
     // Execute SQL insert statement
@@ -661,9 +797,10 @@ namespace OpenMS
     rc = sqlite3_exec(db, insert_transition_sql_str.c_str(), callback, nullptr, &zErrMsg);
     if ( rc != SQLITE_OK )
     {
+      String error(zErrMsg);
       sqlite3_free(zErrMsg);
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-          zErrMsg);
+          error);
     }
 
     // Execute SQL insert statement
@@ -671,9 +808,10 @@ namespace OpenMS
     rc = sqlite3_exec(db, insert_transition_peptide_mapping_sql_str.c_str(), callback, nullptr, &zErrMsg);
     if ( rc != SQLITE_OK )
     {
+      String error(zErrMsg);
       sqlite3_free(zErrMsg);
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-          zErrMsg);
+          error);
     }
 
     // Execute SQL insert statement
@@ -681,9 +819,10 @@ namespace OpenMS
     rc = sqlite3_exec(db, insert_transition_precursor_mapping_sql_str.c_str(), callback, nullptr, &zErrMsg);
     if ( rc != SQLITE_OK )
     {
+      String error(zErrMsg);
       sqlite3_free(zErrMsg);
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-          zErrMsg);
+          error);
     }
 
     // Execute SQL update statement
@@ -691,9 +830,10 @@ namespace OpenMS
     rc = sqlite3_exec(db, update_decoys_sql_str.c_str(), callback, nullptr, &zErrMsg);
     if ( rc != SQLITE_OK )
     {
+      String error(zErrMsg);
       sqlite3_free(zErrMsg);
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-          zErrMsg);
+          error);
     }
 
     sqlite3_exec(db, "END TRANSACTION", nullptr, nullptr, &zErrMsg);
@@ -702,6 +842,227 @@ namespace OpenMS
 
   }
 
+  void TransitionPQPFile::streamTSVToPQP_(const char* tsv_filename, FileTypes::Type filetype, const char* pqp_filename, Size chunk_size)
+  {
+    // any error removes the incomplete output file
+    PQPWriteGuard guard(pqp_filename);
+    guard.db = createPQPFile(pqp_filename);
+    sqlite3* db = guard.db;
+
+    // Prepare insert statements
+    sqlite3_stmt* insert_protein = guard.prepare(
+      "INSERT INTO PROTEIN (ID, PROTEIN_ACCESSION, DECOY) VALUES (?, ?, 0);");
+    sqlite3_stmt* insert_peptide_protein_mapping = guard.prepare(
+      "INSERT INTO PEPTIDE_PROTEIN_MAPPING (PEPTIDE_ID, PROTEIN_ID) VALUES (?, ?);");
+    sqlite3_stmt* insert_peptide = guard.prepare(
+      "INSERT INTO PEPTIDE (ID, UNMODIFIED_SEQUENCE, MODIFIED_SEQUENCE, DECOY) VALUES (?, ?, ?, 0);");
+    sqlite3_stmt* insert_compound = guard.prepare(
+      "INSERT INTO COMPOUND (ID, COMPOUND_NAME, SUM_FORMULA, SMILES, DECOY) VALUES (?, ?, ?, ?, 0);");
+    sqlite3_stmt* insert_precursor_peptide_mapping = guard.prepare(
+      "INSERT INTO PRECURSOR_PEPTIDE_MAPPING (PRECURSOR_ID, PEPTIDE_ID) VALUES (?, ?);");
+    sqlite3_stmt* insert_precursor_compound_mapping = guard.prepare(
+      "INSERT INTO PRECURSOR_COMPOUND_MAPPING (PRECURSOR_ID, COMPOUND_ID) VALUES (?, ?);");
+    sqlite3_stmt* insert_precursor = guard.prepare(
+      "INSERT INTO PRECURSOR (ID, TRAML_ID, GROUP_LABEL, PRECURSOR_MZ, CHARGE, LIBRARY_INTENSITY, LIBRARY_RT, DECOY) VALUES (?, ?, ?, ?, ?, NULL, ?, ?);");
+    sqlite3_stmt* update_precursor_decoy = guard.prepare(
+      "UPDATE PRECURSOR SET DECOY = 1 WHERE ID = ?;");
+    sqlite3_stmt* insert_transition = guard.prepare(
+      "INSERT INTO TRANSITION (ID, TRAML_ID, PRODUCT_MZ, CHARGE, TYPE, ORDINAL, DETECTING, IDENTIFYING, QUANTIFYING, LIBRARY_INTENSITY, DECOY) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);");
+    sqlite3_stmt* insert_transition_precursor_mapping = guard.prepare(
+      "INSERT INTO TRANSITION_PRECURSOR_MAPPING (TRANSITION_ID, PRECURSOR_ID) VALUES (?, ?);");
+    sqlite3_stmt* insert_transition_peptide_mapping = guard.prepare(
+      "INSERT INTO TRANSITION_PEPTIDE_MAPPING (TRANSITION_ID, PEPTIDE_ID) VALUES (?, ?);");
+
+    // Index maps: only these (and not the transitions) are kept in memory.
+    // Identifiers are assigned in order of appearance in the input.
+    std::unordered_map<std::string, int> group_map, peptide_map, protein_map;
+    std::set<std::pair<int, int> > peptide_protein_map;
+    std::vector<char> precursor_decoy_known;
+    std::vector<char> precursor_is_peptide;
+    std::unordered_set<std::string> transition_names;
+    std::map<String, String> label_sequences;
+    int compound_id = 0;
+    int transition_id = 0;
+
+    auto getPeptideId = [&](const std::string& modified_sequence)
+    {
+      std::unordered_map<std::string, int>::const_iterator it = peptide_map.find(modified_sequence);
+      if (it != peptide_map.end())
+      {
+        return it->second;
+      }
+      int peptide_id = int(peptide_map.size());
+      peptide_map[modified_sequence] = peptide_id;
+      std::string unmodified_sequence = AASequence::fromString(modified_sequence).toUnmodifiedString();
+      sqlite3_bind_int(insert_peptide, 1, peptide_id);
+      sqlite3_bind_text(insert_peptide, 2, unmodified_sequence.c_str(), -1, SQLITE_TRANSIENT);
+      sqlite3_bind_text(insert_peptide, 3, modified_sequence.c_str(), -1, SQLITE_TRANSIENT);
+      executeStatement(db, insert_peptide);
+      return peptide_id;
+    };
+
+    auto getProteinId = [&](const std::string& protein_accession)
+    {
+      std::unordered_map<std::string, int>::const_iterator it = protein_map.find(protein_accession);
+      if (it != protein_map.end())
+      {
+        return it->second;
+      }
+      int protein_id = int(protein_map.size());
+      protein_map[protein_accession] = protein_id;
+      sqlite3_bind_int(insert_protein, 1, protein_id);
+      sqlite3_bind_text(insert_protein, 2, protein_accession.c_str(), -1, SQLITE_TRANSIENT);
+      executeStatement(db, insert_protein);
+      return protein_id;
+    };
+
+    executeSQL(db, "BEGIN TRANSACTION;");
+    readUnstructuredTSVInput_(tsv_filename, filetype, [&](std::vector<TSVTransition>& chunk)
+      {
+        resolveMixedSequenceGroups_(chunk, label_sequences);
+
+        for (std::vector<TSVTransition>::iterator tr_it = chunk.begin(); tr_it != chunk.end(); ++tr_it)
+        {
+          // OpenSWATH: Insert a precursor (peptide or compound) when it is seen first
+          int precursor_id;
+          std::unordered_map<std::string, int>::const_iterator group_it = group_map.find(tr_it->group_id);
+          if (group_it == group_map.end())
+          {
+            precursor_id = int(group_map.size());
+            group_map[tr_it->group_id] = precursor_id;
+
+            // the decoy status of a precursor is given by its first detecting transition
+            precursor_decoy_known.push_back(tr_it->detecting_transition);
+            precursor_is_peptide.push_back(tr_it->isPeptide());
+
+            sqlite3_bind_int(insert_precursor, 1, precursor_id);
+            sqlite3_bind_text(insert_precursor, 2, tr_it->group_id.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_double(insert_precursor, 4, tr_it->precursor);
+            sqlite3_bind_int(insert_precursor, 7, tr_it->detecting_transition && tr_it->decoy);
+
+            if (tr_it->isPeptide())
+            {
+              OpenMS::TargetedExperiment::Peptide peptide;
+              createPeptide_(tr_it, peptide);
+              int peptide_id = getPeptideId(TargetedExperimentHelper::getAASequence(peptide).toUniModString());
+
+              for (std::vector<String>::iterator it = peptide.protein_refs.begin(); it != peptide.protein_refs.end(); ++it)
+              {
+                std::pair<int, int> peptide_protein(peptide_id, getProteinId(*it));
+                if (peptide_protein_map.insert(peptide_protein).second)
+                {
+                  sqlite3_bind_int(insert_peptide_protein_mapping, 1, peptide_protein.first);
+                  sqlite3_bind_int(insert_peptide_protein_mapping, 2, peptide_protein.second);
+                  executeStatement(db, insert_peptide_protein_mapping);
+                }
+              }
+
+              String group_label = peptide.getPeptideGroupLabel();
+              sqlite3_bind_text(insert_precursor, 3, group_label.c_str(), -1, SQLITE_TRANSIENT);
+              sqlite3_bind_int(insert_precursor, 5, peptide.hasCharge() ? peptide.getChargeState() : 0);
+              sqlite3_bind_double(insert_precursor, 6, peptide.getRetentionTime());
+
+              sqlite3_bind_int(insert_precursor_peptide_mapping, 1, precursor_id);
+              sqlite3_bind_int(insert_precursor_peptide_mapping, 2, peptide_id);
+              executeStatement(db, insert_precursor_peptide_mapping);
+            }
+            else
+            {
+              OpenMS::TargetedExperiment::Compound compound;
+              createCompound_(tr_it, compound);
+
+              sqlite3_bind_int(insert_compound, 1, compound_id);
+              sqlite3_bind_text(insert_compound, 2, compound.id.c_str(), -1, SQLITE_TRANSIENT);
+              sqlite3_bind_text(insert_compound, 3, compound.molecular_formula.c_str(), -1, SQLITE_TRANSIENT);
+              sqlite3_bind_text(insert_compound, 4, compound.smiles_string.c_str(), -1, SQLITE_TRANSIENT);
+              executeStatement(db, insert_compound);
+
+              // group label and retention time stay NULL for compounds
+              if (compound.hasCharge())
+              {
+                sqlite3_bind_int(insert_precursor, 5, compound.getChargeState());
+              }
+
+              sqlite3_bind_int(insert_precursor_compound_mapping, 1, precursor_id);
+              sqlite3_bind_int(insert_precursor_compound_mapping, 2, compound_id);
+              executeStatement(db, insert_precursor_compound_mapping);
+              ++compound_id;
+            }
+            executeStatement(db, insert_precursor);
+          }
+          else
+          {
+            precursor_id = group_it->second;
+
+            // same check as TargetedExperiment::containsInvalidReferences: a
+            // transition of a peptide group cannot refer to a compound and vice versa
+            if (bool(precursor_is_peptide[precursor_id]) != tr_it->isPeptide())
+            {
+              throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+                  "Invalid input, transition group " + tr_it->group_id + " contains both peptide and compound transitions");
+            }
+            if (!precursor_decoy_known[precursor_id] && tr_it->detecting_transition)
+            {
+              precursor_decoy_known[precursor_id] = true;
+              if (tr_it->decoy)
+              {
+                sqlite3_bind_int(update_precursor_decoy, 1, precursor_id);
+                executeStatement(db, update_precursor_decoy);
+              }
+            }
+          }
+
+          // OpenSWATH: Insert transition data (transition identifiers need to be unique)
+          if (!transition_names.insert(tr_it->transition_name).second)
+          {
+            throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+                "Invalid input, contains duplicate transition identifier " + tr_it->transition_name);
+          }
+          sqlite3_bind_int(insert_transition, 1, transition_id);
+          sqlite3_bind_text(insert_transition, 2, tr_it->transition_name.c_str(), -1, SQLITE_TRANSIENT);
+          sqlite3_bind_double(insert_transition, 3, tr_it->product);
+          if (!tr_it->fragment_charge.empty() && tr_it->fragment_charge != "NA") // workaround for compounds with missing charge
+          {
+            sqlite3_bind_int(insert_transition, 4, tr_it->fragment_charge.toInt());
+          }
+          sqlite3_bind_text(insert_transition, 5, tr_it->fragment_type.c_str(), -1, SQLITE_TRANSIENT);
+          sqlite3_bind_int(insert_transition, 6, tr_it->fragment_nr);
+          sqlite3_bind_int(insert_transition, 7, tr_it->detecting_transition);
+          sqlite3_bind_int(insert_transition, 8, tr_it->identifying_transition);
+          sqlite3_bind_int(insert_transition, 9, tr_it->quantifying_transition);
+          sqlite3_bind_double(insert_transition, 10, tr_it->library_intensity);
+          sqlite3_bind_int(insert_transition, 11, tr_it->decoy);
+          executeStatement(db, insert_transition);
+
+          // OpenSWATH: Associate transitions with their precursors
+          sqlite3_bind_int(insert_transition_precursor_mapping, 1, transition_id);
+          sqlite3_bind_int(insert_transition_precursor_mapping, 2, precursor_id);
+          executeStatement(db, insert_transition_precursor_mapping);
+
+          // IPF: Generate transition-peptide mapping tables (one identification transition can map to multiple peptidoforms)
+          for (Size j = 0; j < tr_it->peptidoforms.size(); j++)
+          {
+            sqlite3_bind_int(insert_transition_peptide_mapping, 1, transition_id);
+            sqlite3_bind_int(insert_transition_peptide_mapping, 2, getPeptideId(tr_it->peptidoforms[j]));
+            executeStatement(db, insert_transition_peptide_mapping);
+          }
+
+          ++transition_id;
+        }
+
+        // commit after each chunk
+        executeSQL(db, "END TRANSACTION; BEGIN TRANSACTION;");
+      }, chunk_size);
+
+    // OpenSWATH: Propagate the decoy status to peptides, compounds and proteins
+    executeSQL(db,
+      "UPDATE PEPTIDE SET DECOY = 1 WHERE ID IN (SELECT PEPTIDE.ID FROM PRECURSOR JOIN PRECURSOR_PEPTIDE_MAPPING ON PRECURSOR.ID =  PRECURSOR_PEPTIDE_MAPPING.PRECURSOR_ID JOIN PEPTIDE ON PRECURSOR_PEPTIDE_MAPPING.PEPTIDE_ID = PEPTIDE.ID WHERE PRECURSOR.DECOY = 1); "
+      "UPDATE COMPOUND SET DECOY = 1 WHERE ID IN (SELECT COMPOUND.ID FROM PRECURSOR JOIN PRECURSOR_COMPOUND_MAPPING ON PRECURSOR.ID =  PRECURSOR_COMPOUND_MAPPING.PRECURSOR_ID JOIN COMPOUND ON PRECURSOR_COMPOUND_MAPPING.COMPOUND_ID = COMPOUND.ID WHERE PRECURSOR.DECOY = 1); "
+      "UPDATE PROTEIN SET DECOY = 1 WHERE ID IN (SELECT PROTEIN.ID FROM PEPTIDE JOIN PEPTIDE_PROTEIN_MAPPING ON PEPTIDE.ID =  PEPTIDE_PROTEIN_MAPPING.PEPTIDE_ID JOIN PROTEIN ON PEPTIDE_PROTEIN_MAPPING.PROTEIN_ID = PROTEIN.ID WHERE PEPTIDE.DECOY = 1); ");
+    executeSQL(db, "END TRANSACTION;");
+    guard.commit();
+  }
+
   // public methods
   void TransitionPQPFile::convertTargetedExperimentToPQP(const char* filename, OpenMS::TargetedExperiment& targeted_exp)
   {
@@ -722,9 +1083,18 @@ namespace OpenMS
 
   void TransitionPQPFile::convertPQPToTargetedExperiment(const char* filename, OpenSwath::LightTargetedExperiment& targeted_exp, bool legacy_traml_id)
   {
-    std::vector<TSVTransition> transition_list;
-    readPQPInput_(filename, transition_list, legacy_traml_id);
-    TSVToTargetedExperiment_(transition_list, targeted_exp);
+    // convert chunk by chunk, the full transition list is never kept in memory
+    LightConversionState state;
+    readPQPInput_(filename, [&](std::vector<TSVTransition>& chunk)
+      {
+        addToLightTargetedExperiment_(chunk, targeted_exp, state);
+      }, legacy_traml_id);
+    finishLightTargetedExperiment_(targeted_exp, state);
+  }
+
+  void TransitionPQPFile::convertTSVToPQP(const char* tsv_filename, FileTypes::Type filetype, const char* pqp_filename, Size chunk_size)
+  {
+    streamTSVToPQP_(tsv_filename, filetype, pqp_filename, chunk_size);
   }
 
 }
@@ -39,6 +39,8 @@
 #include <OpenMS/CHEMISTRY/ResidueDB.h>
 #include <OpenMS/CONCEPT/LogStream.h>
 
+#include <exception>
+
 namespace OpenMS
 {
 
@@ -214,13 +216,21 @@ namespace OpenMS
   }
 
   void TransitionTSVFile::readUnstructuredTSVInput_(const char* filename, FileTypes::Type filetype, std::vector<TSVTransition>& transition_list)
+  {
+    readUnstructuredTSVInput_(filename, filetype, [&transition_list](std::vector<TSVTransition>& chunk)
+      {
+        transition_list.insert(transition_list.end(), chunk.begin(), chunk.end());
+      });
+  }
+
+  void TransitionTSVFile::readUnstructuredTSVInput_(const char* filename, FileTypes::Type filetype,
+                                                    const std::function<void(std::vector<TSVTransition>&)>& process_chunk,
+                                                    Size chunk_size)
   {
     std::ifstream data(filename);
     std::string   line;
-    std::string   tmp;
 
     // read header
-    std::vector<std::string>   tmp_line;
     std::vector<std::string>   header;
     std::map<std::string, int> header_dict;
     char delimiter = ',';
@@ -252,228 +262,326 @@ namespace OpenMS
       getTSVHeader_(line, delimiter, header, header_dict);
     }
 
+    // determine the size of the file to report the progress
+    std::streampos data_start = data.tellg();
+    data.seekg(0, std::ios::end);
+    std::streampos data_end = data.tellg();
+    data.seekg(data_start);
+    Size bytes_read = 0;
+
     bool spectrast_legacy = false; // we will check below if SpectraST was run in legacy (<5.0) mode or if the RT normalization was forgotten.
     int cnt = 0;
-    while (std::getline(data, line))
-    {
-      line.push_back(delimiter); // avoid losing last column if it is empty
-      std::stringstream lineStream(line);
-
-      while (std::getline(lineStream, tmp, delimiter))
+    std::vector<std::string> lines;
+    std::vector<TSVTransition> chunk;
+    startProgress(0, data_end - data_start, "reading transition list");
+    while (true)
+    {
+      // Read the next chunk of lines (reading is serial, parsing is done in parallel below)
+      lines.clear();
+      while (lines.size() < chunk_size && std::getline(data, line))
       {
-        tmp_line.push_back(tmp);
+        bytes_read += line.size() + 1;
+        line.push_back(delimiter); // avoid losing last column if it is empty
+        lines.push_back(line);
       }
-      cnt++;
-
-#ifdef TRANSITIONTSVREADER_TESTING
-      for (Size i = 0; i < tmp_line.size(); i++)
+      if (lines.empty())
       {
-        std::cout << "line " << i << " " << tmp_line[i] << std::endl;
+        break;
       }
 
-      for (std::map<std::string, int>::iterator iter = header_dict.begin(); iter != header_dict.end(); ++iter)
-      {
-        std::cout << "header " << iter->first << " " << iter->second << std::endl;
-      }
+      // Parse the chunk in parallel, each line into its own slot so that the
+      // order of the transitions is preserved. Exceptions may not leave the
+      // parallel region, we thus rethrow the one of the first offending line.
+      std::vector<TSVTransition> parsed(lines.size());
+      std::vector<char> keep(lines.size(), 0);
+      std::vector<char> generate_group_id(lines.size(), 0);
+      Size first_error = lines.size();
+      std::exception_ptr error;
+      bool chunk_spectrast_legacy = false;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(||: chunk_spectrast_legacy)
 #endif
-
-      if (tmp_line.size() != header_dict.size())
+      for (SignedSize i = 0; i < (SignedSize)lines.size(); ++i)
       {
-        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-                                         "Error reading the file on line " + String(cnt) + ": length of the header and length of the line" +
-                                         " do not match: " + String(tmp_line.size()) + " != " + String(header_dict.size()));
-      }
-
-      TSVTransition mytransition;
-      bool skip_transition = false; // skip unannotated transitions in SpectraST MRM files
-
-      //// Required columns (they are guaranteed to be present, see getTSVHeader_)
-      // PrecursorMz
-      mytransition.precursor = String(tmp_line[header_dict["PrecursorMz"]]).toDouble();
-
-      // ProductMz
-      if (!extractName<double>(mytransition.product, "ProductMz", tmp_line, header_dict) &&
-          !extractName<double>(mytransition.product, "FragmentMz", tmp_line, header_dict)) // Spectronaut
-      {
-        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-                                         "Expected a header named ProductMz or FragmentMz but found none");
+        try
+        {
+          bool generate = false;
+          bool legacy = false;
+          keep[i] = parseTransition_(lines[i], cnt + int(i) + 1, delimiter, filetype, header_dict, parsed[i], generate, legacy);
+          generate_group_id[i] = generate;
+          chunk_spectrast_legacy = chunk_spectrast_legacy || legacy;
+        }
+        catch (...)
+        {
+#ifdef _OPENMP
+#pragma omp critical (TransitionTSVFile_HandleException)
+#endif
+          {
+            if (Size(i) < first_error)
+            {
+              first_error = i;
+              error = std::current_exception();
+            }
+          }
+        }
       }
-
-      // LibraryIntensity
-      if (!extractName<double>(mytransition.library_intensity, "LibraryIntensity", tmp_line, header_dict) &&
-          !extractName<double>(mytransition.library_intensity, "RelativeFragmentIntensity", tmp_line, header_dict)) // Spectronaut
+      if (error)
       {
-        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-                                         "Expected a header named LibraryIntensity or RelativeFragmentIntensity but found none");
+        std::rethrow_exception(error);
       }
-
-      //// Additional columns for both proteomics and metabolomics
-      // NormalizedRetentionTime
-      if (!extractName<double>(mytransition.rt_calibrated, "RetentionTimeCalculatorScore", tmp_line, header_dict) && // Skyline
-          !extractName<double>(mytransition.rt_calibrated, "iRT", tmp_line, header_dict) && // Spectronaut
-          !extractName<double>(mytransition.rt_calibrated, "NormalizedRetentionTime", tmp_line, header_dict) &&
-          !extractName<double>(mytransition.rt_calibrated, "RetentionTime", tmp_line, header_dict) &&
-          !extractName<double>(mytransition.rt_calibrated, "Tr_recalibrated", tmp_line, header_dict))
+      spectrast_legacy = spectrast_legacy || chunk_spectrast_legacy;
+      cnt += int(lines.size());
+
+      // Generate the missing group ids serially, parsing an AASequence
+      // accesses the (not thread-safe) residue and modification databases.
+      chunk.clear();
+      chunk.reserve(lines.size());
+      for (Size i = 0; i < lines.size(); ++i)
       {
-        if (header_dict.find("SpectraSTRetentionTime") != header_dict.end())
+        if (generate_group_id[i])
         {
-          spectrastRTExtract(tmp_line[header_dict["SpectraSTRetentionTime"]], mytransition.rt_calibrated, spectrast_legacy);
+          TSVTransition& mytransition = parsed[i];
+          if (FileTypes::typeToName(filetype) == "mrm")
+          {
+            // SpectraST: the sequence and charge were taken from SpectraSTFullPeptideName
+            AASequence peptide = AASequence::fromString(mytransition.FullPeptideName);
+            mytransition.FullPeptideName = peptide.toString();
+            mytransition.PeptideSequence = peptide.toUnmodifiedString();
+            mytransition.group_id = mytransition.FullPeptideName + String("_") + String(mytransition.precursor_charge);
+          }
+          else
+          {
+            mytransition.group_id = AASequence::fromString(mytransition.FullPeptideName).toString() + String("_") + String(mytransition.precursor_charge);
+          }
+          cleanupTransitions_(mytransition);
         }
-        else
+        if (keep[i])
         {
-          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-                                           "Expected a header named RetentionTime, NormalizedRetentionTime, iRT, RetentionTimeCalculatorScore, Tr_recalibrated or SpectraSTRetentionTime but found none");
+          chunk.push_back(std::move(parsed[i]));
         }
       }
+      process_chunk(chunk);
+      setProgress(bytes_read);
+    }
+    endProgress();
 
-      // PrecursorCharge
-      !extractName(mytransition.precursor_charge, "PrecursorCharge", tmp_line, header_dict) &&
-      !extractName(mytransition.precursor_charge, "Charge", tmp_line, header_dict); // charge is assumed to be the charge of the precursor
+    if (spectrast_legacy && retentionTimeInterpretation_ == "iRT")
+    {
+      std::cout << "Warning: SpectraST was not run in RT normalization mode but the converted list was interpreted to have iRT units. Check whether you need to adapt the parameter -algorithm:retentionTimeInterpretation. You can ignore this warning if you used a legacy SpectraST 4.0 file." << std::endl;
 
-      !extractName(mytransition.fragment_type, "FragmentType", tmp_line, header_dict) &&
-      !extractName(mytransition.fragment_type, "FragmentIonType", tmp_line, header_dict); // Skyline
+    }
+  }
 
-      !extractName(mytransition.fragment_charge, "FragmentCharge", tmp_line, header_dict) &&
-      !extractName(mytransition.fragment_charge, "ProductCharge", tmp_line, header_dict);
+  bool TransitionTSVFile::parseTransition_(const std::string& line, int line_nr, char delimiter, FileTypes::Type filetype,
+                                           const std::map<std::string, int>& header_dict, TSVTransition& mytransition,
+                                           bool& generate_group_id, bool& spectrast_legacy)
+  {
+    std::vector<std::string> tmp_line;
+    std::string tmp;
+    std::stringstream lineStream(line);
+    while (std::getline(lineStream, tmp, delimiter))
+    {
+      tmp_line.push_back(tmp);
+    }
 
-      !extractName<int>(mytransition.fragment_nr, "FragmentSeriesNumber", tmp_line, header_dict) &&
-      !extractName<int>(mytransition.fragment_nr, "FragmentNumber", tmp_line, header_dict) &&
-      !extractName<int>(mytransition.fragment_nr, "FragmentIonOrdinal", tmp_line, header_dict);
+#ifdef TRANSITIONTSVREADER_TESTING
+    for (Size i = 0; i < tmp_line.size(); i++)
+    {
+      std::cout << "line " << i << " " << tmp_line[i] << std::endl;
+    }
 
-      extractName<double>(mytransition.drift_time, "PrecursorIonMobility", tmp_line, header_dict);
-      extractName<double>(mytransition.fragment_mzdelta, "FragmentMzDelta", tmp_line, header_dict);
-      extractName<int>(mytransition.fragment_modification, "FragmentModification", tmp_line, header_dict);
+    for (std::map<std::string, int>::const_iterator iter = header_dict.begin(); iter != header_dict.end(); ++iter)
+    {
+      std::cout << "header " << iter->first << " " << iter->second << std::endl;
+    }
+#endif
 
-      //// Proteomics
-      !extractName(mytransition.ProteinName, "ProteinName", tmp_line, header_dict) &&
-      !extractName(mytransition.ProteinName, "ProteinId", tmp_line, header_dict); // Spectronaut
+    if (tmp_line.size() != header_dict.size())
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+                                       "Error reading the file on line " + String(line_nr) + ": length of the header and length of the line" +
+                                       " do not match: " + String(tmp_line.size()) + " != " + String(header_dict.size()));
+    }
 
-      extractName(mytransition.peptide_group_label, "PeptideGroupLabel", tmp_line, header_dict);
+    bool skip_transition = false; // skip unannotated transitions in SpectraST MRM files
 
-      extractName(mytransition.label_type, "LabelType", tmp_line, header_dict);
+    //// Required columns (they are guaranteed to be present, see getTSVHeader_)
+    // PrecursorMz
+    mytransition.precursor = String(tmp_line[header_dict.at("PrecursorMz")]).toDouble();
 
-      !extractName(mytransition.PeptideSequence, "PeptideSequence", tmp_line, header_dict) &&
-      !extractName(mytransition.PeptideSequence, "Sequence", tmp_line, header_dict) && // Skyline
-      !extractName(mytransition.PeptideSequence, "StrippedSequence", tmp_line, header_dict); // Spectronaut
+    // ProductMz
+    if (!extractName<double>(mytransition.product, "ProductMz", tmp_line, header_dict) &&
+        !extractName<double>(mytransition.product, "FragmentMz", tmp_line, header_dict)) // Spectronaut
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+                                       "Expected a header named ProductMz or FragmentMz but found none");
+    }
 
-      !extractName(mytransition.FullPeptideName, "FullUniModPeptideName", tmp_line, header_dict) &&
-      !extractName(mytransition.FullPeptideName, "FullPeptideName", tmp_line, header_dict) &&
-      !extractName(mytransition.FullPeptideName, "ModifiedSequence", tmp_line, header_dict) && // Spectronaut
-      !extractName(mytransition.FullPeptideName, "ModifiedPeptideSequence", tmp_line, header_dict);
+    // LibraryIntensity
+    if (!extractName<double>(mytransition.library_intensity, "LibraryIntensity", tmp_line, header_dict) &&
+        !extractName<double>(mytransition.library_intensity, "RelativeFragmentIntensity", tmp_line, header_dict)) // Spectronaut
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+                                       "Expected a header named LibraryIntensity or RelativeFragmentIntensity but found none");
+    }
 
-      //// IPF
-      String peptidoforms;
-      !extractName<bool>(mytransition.detecting_transition, "detecting_transition", tmp_line, header_dict) &&
-      !extractName<bool>(mytransition.detecting_transition, "DetectingTransition", tmp_line, header_dict);
-      !extractName<bool>(mytransition.identifying_transition, "identifying_transition", tmp_line, header_dict) &&
-      !extractName<bool>(mytransition.identifying_transition, "IdentifyingTransition", tmp_line, header_dict);
-      !extractName<bool>(mytransition.quantifying_transition, "quantifying_transition", tmp_line, header_dict) &&
-      !extractName<bool>(mytransition.quantifying_transition, "QuantifyingTransition", tmp_line, header_dict) &&
-      !extractName<bool>(mytransition.quantifying_transition, "Quantitative", tmp_line, header_dict); // Skyline
+    //// Additional columns for both proteomics and metabolomics
+    // NormalizedRetentionTime
+    if (!extractName<double>(mytransition.rt_calibrated, "RetentionTimeCalculatorScore", tmp_line, header_dict) && // Skyline
+        !extractName<double>(mytransition.rt_calibrated, "iRT", tmp_line, header_dict) && // Spectronaut
+        !extractName<double>(mytransition.rt_calibrated, "NormalizedRetentionTime", tmp_line, header_dict) &&
+        !extractName<double>(mytransition.rt_calibrated, "RetentionTime", tmp_line, header_dict) &&
+        !extractName<double>(mytransition.rt_calibrated, "Tr_recalibrated", tmp_line, header_dict))
+    {
+      if (header_dict.find("SpectraSTRetentionTime") != header_dict.end())
+      {
+        spectrastRTExtract(tmp_line[header_dict.at("SpectraSTRetentionTime")], mytransition.rt_calibrated, spectrast_legacy);
+      }
+      else
+      {
+        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+                                         "Expected a header named RetentionTime, NormalizedRetentionTime, iRT, RetentionTimeCalculatorScore, Tr_recalibrated or SpectraSTRetentionTime but found none");
+      }
+    }
 
-      extractName(peptidoforms, "Peptidoforms", tmp_line, header_dict);
-      peptidoforms.split('|', mytransition.peptidoforms);
+    // PrecursorCharge
+    !extractName(mytransition.precursor_charge, "PrecursorCharge", tmp_line, header_dict) &&
+    !extractName(mytransition.precursor_charge, "Charge", tmp_line, header_dict); // charge is assumed to be the charge of the precursor
 
-      //// Targeted Metabolomics
-      !extractName(mytransition.CompoundName, "CompoundName", tmp_line, header_dict) &&
-      !extractName(mytransition.CompoundName, "CompoundId", tmp_line, header_dict);
-      extractName(mytransition.SumFormula, "SumFormula", tmp_line, header_dict);
-      extractName(mytransition.SMILES, "SMILES", tmp_line, header_dict);
+    !extractName(mytransition.fragment_type, "FragmentType", tmp_line, header_dict) &&
+    !extractName(mytransition.fragment_type, "FragmentIonType", tmp_line, header_dict); // Skyline
 
-      //// Meta
-      extractName(mytransition.Annotation, "Annotation", tmp_line, header_dict);
-      // UniprotId
-      !extractName(mytransition.uniprot_id, "UniprotId", tmp_line, header_dict) &&
-      !extractName(mytransition.uniprot_id, "UniprotID", tmp_line, header_dict);
-      if (mytransition.uniprot_id == "NA") mytransition.uniprot_id = "";
+    !extractName(mytransition.fragment_charge, "FragmentCharge", tmp_line, header_dict) &&
+    !extractName(mytransition.fragment_charge, "ProductCharge", tmp_line, header_dict);
 
-      !extractName<double>(mytransition.CE, "CE", tmp_line, header_dict) &&
-      !extractName<double>(mytransition.CE, "CollisionEnergy", tmp_line, header_dict);
+    !extractName<int>(mytransition.fragment_nr, "FragmentSeriesNumber", tmp_line, header_dict) &&
+    !extractName<int>(mytransition.fragment_nr, "FragmentNumber", tmp_line, header_dict) &&
+    !extractName<int>(mytransition.fragment_nr, "FragmentIonOrdinal", tmp_line, header_dict);
 
-      // Decoy
-      !extractName<bool>(mytransition.decoy, "decoy", tmp_line, header_dict) &&
-      !extractName<bool>(mytransition.decoy, "Decoy", tmp_line, header_dict) &&
-      !extractName<bool>(mytransition.decoy, "IsDecoy", tmp_line, header_dict);
+    extractName<double>(mytransition.drift_time, "PrecursorIonMobility", tmp_line, header_dict);
+    extractName<double>(mytransition.fragment_mzdelta, "FragmentMzDelta", tmp_line, header_dict);
+    extractName<int>(mytransition.fragment_modification, "FragmentModification", tmp_line, header_dict);
 
-      if (header_dict.find("SpectraSTAnnotation") != header_dict.end())
-      {
-        skip_transition = spectrastAnnotationExtract(tmp_line[header_dict["SpectraSTAnnotation"]], mytransition);
-      }
+    //// Proteomics
+    !extractName(mytransition.ProteinName, "ProteinName", tmp_line, header_dict) &&
+    !extractName(mytransition.ProteinName, "ProteinId", tmp_line, header_dict); // Spectronaut
 
-      //// Generate Group IDs
-      // SpectraST
-      if (FileTypes::typeToName(filetype) == "mrm")
-      {
-        std::vector<String> substrings;
-        String(tmp_line[header_dict["SpectraSTFullPeptideName"]]).split("/", substrings);
-        AASequence peptide = AASequence::fromString(substrings[0]);
+    extractName(mytransition.peptide_group_label, "PeptideGroupLabel", tmp_line, header_dict);
 
-        mytransition.FullPeptideName = peptide.toString();
-        mytransition.PeptideSequence = peptide.toUnmodifiedString();
-        mytransition.precursor_charge = substrings[1];
+    extractName(mytransition.label_type, "LabelType", tmp_line, header_dict);
 
-        mytransition.transition_name = String(cnt);
+    !extractName(mytransition.PeptideSequence, "PeptideSequence", tmp_line, header_dict) &&
+    !extractName(mytransition.PeptideSequence, "Sequence", tmp_line, header_dict) && // Skyline
+    !extractName(mytransition.PeptideSequence, "StrippedSequence", tmp_line, header_dict); // Spectronaut
 
-        mytransition.group_id = mytransition.FullPeptideName + String("_") + String(mytransition.precursor_charge);
-      }
-      // Generate transition_group_id and transition_name if not defined
-      else
-      {
-        // Use TransitionId if available, else generate from attributes
-        if (!extractName(mytransition.transition_name, "transition_name", tmp_line, header_dict) &&
-            !extractName(mytransition.transition_name, "TransitionName", tmp_line, header_dict) &&
-            !extractName(mytransition.transition_name, "TransitionId", tmp_line, header_dict))
-        {
-          mytransition.transition_name = String(cnt);
-        }
+    !extractName(mytransition.FullPeptideName, "FullUniModPeptideName", tmp_line, header_dict) &&
+    !extractName(mytransition.FullPeptideName, "FullPeptideName", tmp_line, header_dict) &&
+    !extractName(mytransition.FullPeptideName, "ModifiedSequence", tmp_line, header_dict) && // Spectronaut
+    !extractName(mytransition.FullPeptideName, "ModifiedPeptideSequence", tmp_line, header_dict);
 
-        // Use TransitionGroupId if available, else generate from attributes
-        if (!extractName(mytransition.group_id, "transition_group_id", tmp_line, header_dict) &&
-            !extractName(mytransition.group_id, "TransitionGroupId", tmp_line, header_dict) &&
-            !extractName(mytransition.group_id, "TransitionGroupName", tmp_line, header_dict))
-        {
-          mytransition.group_id = AASequence::fromString(mytransition.FullPeptideName).toString() + String("_") + String(mytransition.precursor_charge);
-        }
-      }
+    //// IPF
+    String peptidoforms;
+    !extractName<bool>(mytransition.detecting_transition, "detecting_transition", tmp_line, header_dict) &&
+    !extractName<bool>(mytransition.detecting_transition, "DetectingTransition", tmp_line, header_dict);
+    !extractName<bool>(mytransition.identifying_transition, "identifying_transition", tmp_line, header_dict) &&
+    !extractName<bool>(mytransition.identifying_transition, "IdentifyingTransition", tmp_line, header_dict);
+    !extractName<bool>(mytransition.quantifying_transition, "quantifying_transition", tmp_line, header_dict) &&
+    !extractName<bool>(mytransition.quantifying_transition, "QuantifyingTransition", tmp_line, header_dict) &&
+    !extractName<bool>(mytransition.quantifying_transition, "Quantitative", tmp_line, header_dict); // Skyline
 
-      cleanupTransitions_(mytransition);
+    extractName(peptidoforms, "Peptidoforms", tmp_line, header_dict);
+    peptidoforms.split('|', mytransition.peptidoforms);
 
-      if (!skip_transition)
-      {
-        transition_list.push_back(mytransition);
-      }
+    //// Targeted Metabolomics
+    !extractName(mytransition.CompoundName, "CompoundName", tmp_line, header_dict) &&
+    !extractName(mytransition.CompoundName, "CompoundId", tmp_line, header_dict);
+    extractName(mytransition.SumFormula, "SumFormula", tmp_line, header_dict);
+    extractName(mytransition.SMILES, "SMILES", tmp_line, header_dict);
 
-#ifdef TRANSITIONTSVREADER_TESTING
-      std::cout << mytransition.precursor << std::endl;
-      std::cout << mytransition.product << std::endl;
-      std::cout << mytransition.rt_calibrated << std::endl;
-      std::cout << mytransition.transition_name << std::endl;
-      std::cout << mytransition.CE << std::endl;
-      std::cout << mytransition.library_intensity << std::endl;
-      std::cout << mytransition.group_id << std::endl;
-      std::cout << mytransition.decoy << std::endl;
-      std::cout << mytransition.PeptideSequence << std::endl;
-      std::cout << mytransition.ProteinName << std::endl;
-      std::cout << mytransition.Annotation << std::endl;
-      std::cout << mytransition.FullPeptideName << std::endl;
-      std::cout << mytransition.precursor_charge << std::endl;
-      std::cout << mytransition.peptide_group_label << std::endl;
-      std::cout << mytransition.fragment_charge << std::endl;
-      std::cout << mytransition.fragment_nr << std::endl;
-      std::cout << mytransition.fragment_mzdelta << std::endl;
-      std::cout << mytransition.fragment_modification << std::endl;
-      std::cout << mytransition.fragment_type << std::endl;
-      std::cout << mytransition.uniprot_id << std::endl;
-#endif
+    //// Meta
+    extractName(mytransition.Annotation, "Annotation", tmp_line, header_dict);
+    // UniprotId
+    !extractName(mytransition.uniprot_id, "UniprotId", tmp_line, header_dict) &&
+    !extractName(mytransition.uniprot_id, "UniprotID", tmp_line, header_dict);
+    if (mytransition.uniprot_id == "NA") mytransition.uniprot_id = "";
+
+    !extractName<double>(mytransition.CE, "CE", tmp_line, header_dict) &&
+    !extractName<double>(mytransition.CE, "CollisionEnergy", tmp_line, header_dict);
+
+    // Decoy
+    !extractName<bool>(mytransition.decoy, "decoy", tmp_line, header_dict) &&
+    !extractName<bool>(mytransition.decoy, "Decoy", tmp_line, header_dict) &&
+    !extractName<bool>(mytransition.decoy, "IsDecoy", tmp_line, header_dict);
 
-      tmp_line.clear();
+    if (header_dict.find("SpectraSTAnnotation") != header_dict.end())
+    {
+      skip_transition = spectrastAnnotationExtract(tmp_line[header_dict.at("SpectraSTAnnotation")], mytransition);
     }
 
-    if (spectrast_legacy && retentionTimeInterpretation_ == "iRT")
+    //// Generate Group IDs
+    generate_group_id = false;
+    // SpectraST
+    if (FileTypes::typeToName(filetype) == "mrm")
     {
-      std::cout << "Warning: SpectraST was not run in RT normalization mode but the converted list was interpreted to have iRT units. Check whether you need to adapt the parameter -algorithm:retentionTimeInterpretation. You can ignore this warning if you used a legacy SpectraST 4.0 file." << std::endl;
+      // the sequence itself is parsed later (see readUnstructuredTSVInput_)
+      std::vector<String> substrings;
+      String(tmp_line[header_dict.at("SpectraSTFullPeptideName")]).split("/", substrings);
+      mytransition.FullPeptideName = substrings[0];
+      mytransition.precursor_charge = substrings[1];
+
+      mytransition.transition_name = String(line_nr);
 
+      generate_group_id = true;
     }
+    // Generate transition_group_id and transition_name if not defined
+    else
+    {
+      // Use TransitionId if available, else generate from attributes
+      if (!extractName(mytransition.transition_name, "transition_name", tmp_line, header_dict) &&
+          !extractName(mytransition.transition_name, "TransitionName", tmp_line, header_dict) &&
+          !extractName(mytransition.transition_name, "TransitionId", tmp_line, header_dict))
+      {
+        mytransition.transition_name = String(line_nr);
+      }
+
+      // Use TransitionGroupId if available, else generate from attributes (see readUnstructuredTSVInput_)
+      if (!extractName(mytransition.group_id, "transition_group_id", tmp_line, header_dict) &&
+          !extractName(mytransition.group_id, "TransitionGroupId", tmp_line, header_dict) &&
+          !extractName(mytransition.group_id, "TransitionGroupName", tmp_line, header_dict))
+      {
+        generate_group_id = true;
+      }
+    }
+
+    if (!generate_group_id)
+    {
+      cleanupTransitions_(mytransition);
+    }
+
+#ifdef TRANSITIONTSVREADER_TESTING
+    std::cout << mytransition.precursor << std::endl;
+    std::cout << mytransition.product << std::endl;
+    std::cout << mytransition.rt_calibrated << std::endl;
+    std::cout << mytransition.transition_name << std::endl;
+    std::cout << mytransition.CE << std::endl;
+    std::cout << mytransition.library_intensity << std::endl;
+    std::cout << mytransition.group_id << std::endl;
+    std::cout << mytransition.decoy << std::endl;
+    std::cout << mytransition.PeptideSequence << std::endl;
+    std::cout << mytransition.ProteinName << std::endl;
+    std::cout << mytransition.Annotation << std::endl;
+    std::cout << mytransition.FullPeptideName << std::endl;
+    std::cout << mytransition.precursor_charge << std::endl;
+    std::cout << mytransition.peptide_group_label << std::endl;
+    std::cout << mytransition.fragment_charge << std::endl;
+    std::cout << mytransition.fragment_nr << std::endl;
+    std::cout << mytransition.fragment_mzdelta << std::endl;
+    std::cout << mytransition.fragment_modification << std::endl;
+    std::cout << mytransition.fragment_type << std::endl;
+    std::cout << mytransition.uniprot_id << std::endl;
+#endif
+
+    return !skip_transition;
   }
 
   void TransitionTSVFile::spectrastRTExtract(const String str_inp, double & value, bool & spectrast_legacy)
@@ -649,13 +757,17 @@ namespace OpenMS
 
   void TransitionTSVFile::TSVToTargetedExperiment_(std::vector<TSVTransition>& transition_list, OpenSwath::LightTargetedExperiment& exp)
   {
-    std::map<String, int> compound_map;
-    std::map<String, int> protein_map;
+    LightConversionState state;
+    addToLightTargetedExperiment_(transition_list, exp, state);
+    finishLightTargetedExperiment_(exp, state);
+  }
 
-    resolveMixedSequenceGroups_(transition_list);
+  void TransitionTSVFile::addToLightTargetedExperiment_(std::vector<TSVTransition>& transition_list,
+                                                        OpenSwath::LightTargetedExperiment& exp,
+                                                        LightConversionState& state)
+  {
+    resolveMixedSequenceGroups_(transition_list, state.label_sequences);
 
-    Size progress = 0;
-    startProgress(0, transition_list.size(), "conversion to internal data representation");
     for (std::vector<TSVTransition>::iterator tr_it = transition_list.begin(); tr_it != transition_list.end(); ++tr_it)
     {
       OpenSwath::LightTransition transition;
@@ -678,7 +790,12 @@ namespace OpenMS
       exp.transitions.push_back(transition);
 
       // check whether we need a new compound
-      if (compound_map.find(tr_it->group_id) == compound_map.end())
+      std::map<String, Size>::const_iterator compound_it = state.compound_map.find(tr_it->group_id);
+      if (compound_it != state.compound_map.end())
+      {
+        state.compound_indices.push_back(compound_it->second);
+      }
+      else
       {
         OpenSwath::LightCompound compound;
         if (tr_it->isPeptide())
@@ -693,69 +810,82 @@ namespace OpenMS
           createCompound_(tr_it, tramlcompound);
           OpenSwathDataAccessHelper::convertTargetedCompound(tramlcompound, compound);
         }
+        state.compound_indices.push_back(exp.compounds.size());
+        state.compound_map[compound.id] = exp.compounds.size();
         exp.compounds.push_back(compound);
-        compound_map[compound.id] = 0;
       }
 
       // check whether we need a new protein
-      if (tr_it->isPeptide() && protein_map.find(tr_it->ProteinName) == protein_map.end())
+      if (tr_it->isPeptide() && state.protein_map.find(tr_it->ProteinName) == state.protein_map.end())
       {
         OpenSwath::LightProtein protein;
         protein.id = tr_it->ProteinName;
         protein.sequence = "";
         exp.proteins.push_back(protein);
-        protein_map[tr_it->ProteinName] = 0;
+        state.protein_map[tr_it->ProteinName] = 0;
       }
-      setProgress(progress++);
     }
-    endProgress();
+  }
+
+  void TransitionTSVFile::finishLightTargetedExperiment_(OpenSwath::LightTargetedExperiment& exp, LightConversionState& state)
+  {
+    // store all transitions of a compound contiguously (unless the
+    // experiment already contained transitions we know nothing about)
+    if (state.compound_indices.size() == exp.transitions.size())
+    {
+      exp.groupTransitionsByCompound(state.compound_indices);
+    }
+    state = LightConversionState();
   }
 
   void TransitionTSVFile::resolveMixedSequenceGroups_(std::vector<TransitionTSVFile::TSVTransition>& transition_list)
   {
-    // Create temporary map by group label
-    std::map< String, std::vector<TSVTransition*> > label_transition_map;
+    std::map<String, String> label_sequences;
+    resolveMixedSequenceGroups_(transition_list, label_sequences);
+  }
+
+  void TransitionTSVFile::resolveMixedSequenceGroups_(std::vector<TransitionTSVFile::TSVTransition>& transition_list,
+                                                      std::map<String, String>& label_sequences)
+  {
+    // Iterate through all transitions and perform sanity check whether the
+    // peptide sequence is the same for all members of a group label (the
+    // first transition seen with a label determines its sequence)
     for (std::vector<TSVTransition>::iterator tr_it = transition_list.begin(); tr_it != transition_list.end(); ++tr_it)
     {
-      if (!tr_it->peptide_group_label.empty() )
+      if (tr_it->peptide_group_label.empty())
       {
-        label_transition_map[tr_it->peptide_group_label].push_back(& (*tr_it));
+        continue;
       }
-    }
 
-    // Iterate through all the group labels and perform sanity check whether the peptide sequence is the same for all of them
-    for (std::map< String, std::vector<TSVTransition*> >::iterator pep_it = label_transition_map.begin(); pep_it != label_transition_map.end(); ++pep_it)
-    {
-      String curr_sequence;
-      if (!pep_it->second.empty() )
-      { 
-        curr_sequence = (*pep_it->second.begin())->PeptideSequence;
+      std::map<String, String>::const_iterator label_it = label_sequences.find(tr_it->peptide_group_label);
+      if (label_it == label_sequences.end())
+      {
+        label_sequences[tr_it->peptide_group_label] = tr_it->PeptideSequence;
+        continue;
       }
 
-      for (std::vector<TSVTransition*>::iterator tr_it = pep_it->second.begin(); tr_it != pep_it->second.end(); ++tr_it)
+      // Sanity check: different peptide sequence in the same peptide label group means that something is probably wrong ...
+      const String& curr_sequence = label_it->second;
+      if (!curr_sequence.empty() && tr_it->PeptideSequence != curr_sequence)
       {
-        // Sanity check: different peptide sequence in the same peptide label group means that something is probably wrong ...
-        if (!curr_sequence.empty() && (*tr_it)->PeptideSequence != curr_sequence)
-        {
-
-          if (override_group_label_check_)
-          {
-            // We wont fix it but give out a warning
-            LOG_WARN << "Warning: Found multiple peptide sequences for peptide label group " << pep_it->first << 
-              //" found multiple peptide sequences: " << curr_sequence << " and " << (*tr_it)->PeptideSequence << 
-              ". Since 'override_group_label_check' is on, nothing will be changed." << std::endl;
-          }
-          else
-          {
-            // Lets fix it and inform the user
-            LOG_WARN << "Warning: Found multiple peptide sequences for peptide label group " << pep_it->first << 
-              //" found multiple peptide sequences: " << curr_sequence << " and " << (*tr_it)->PeptideSequence << 
-              ". This is most likely an error and to fix this, a new peptide label group will be inferred - " << 
-              "to override this decision, please use the override_group_label_check parameter." << std::endl;
-            (*tr_it)->peptide_group_label = (*tr_it)->group_id;
-          }
 
+        if (override_group_label_check_)
+        {
+          // We wont fix it but give out a warning
+          LOG_WARN << "Warning: Found multiple peptide sequences for peptide label group " << label_it->first <<
+            //" found multiple peptide sequences: " << curr_sequence << " and " << tr_it->PeptideSequence <<
+            ". Since 'override_group_label_check' is on, nothing will be changed." << std::endl;
         }
+        else
+        {
+          // Lets fix it and inform the user
+          LOG_WARN << "Warning: Found multiple peptide sequences for peptide label group " << label_it->first <<
+            //" found multiple peptide sequences: " << curr_sequence << " and " << tr_it->PeptideSequence <<
+            ". This is most likely an error and to fix this, a new peptide label group will be inferred - " <<
+            "to override this decision, please use the override_group_label_check parameter." << std::endl;
+          tr_it->peptide_group_label = tr_it->group_id;
+        }
+
       }
     }
 
@@ -1454,9 +1584,13 @@ namespace OpenMS
 
   void TransitionTSVFile::convertTSVToTargetedExperiment(const char* filename, FileTypes::Type filetype, OpenSwath::LightTargetedExperiment& targeted_exp)
   {
-    std::vector<TSVTransition> transition_list;
-    readUnstructuredTSVInput_(filename, filetype, transition_list);
-    TSVToTargetedExperiment_(transition_list, targeted_exp);
+    // convert chunk by chunk, the full transition list is never kept in memory
+    LightConversionState state;
+    readUnstructuredTSVInput_(filename, filetype, [&](std::vector<TSVTransition>& chunk)
+      {
+        addToLightTargetedExperiment_(chunk, targeted_exp, state);
+      });
+    finishLightTargetedExperiment_(targeted_exp, state);
   }
 
   void TransitionTSVFile::validateTargetedExperiment(const OpenMS::TargetedExperiment& targeted_exp)
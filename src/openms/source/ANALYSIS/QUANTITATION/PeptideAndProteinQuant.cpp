@@ -43,7 +43,7 @@ namespace OpenMS
 
   PeptideAndProteinQuant::PeptideAndProteinQuant() :
     DefaultParamHandler("PeptideAndProteinQuant"), stats_(), pep_quant_(),
-    prot_quant_()
+    prot_quant_(), pep_index_()
   {
     defaults_.setValue("top", 3, "Calculate protein abundance from this number of proteotypic peptides (most abundant first; '0' for all)");
     defaults_.setMinInt("top", 0);
@@ -71,6 +71,17 @@ namespace OpenMS
   }
 
 
+  PeptideAndProteinQuant::PeptideData& PeptideAndProteinQuant::getPeptideData_(
+    const AASequence& seq)
+  {
+    unordered_map<AASequence, PeptideData*>::iterator pos = pep_index_.find(seq);
+    if (pos != pep_index_.end()) return *pos->second;
+    PeptideData* data = &pep_quant_[seq];
+    pep_index_[seq] = data;
+    return *data;
+  }
+
+
   void PeptideAndProteinQuant::countPeptides_(vector<PeptideIdentification>&
                                               peptides)
   {
@@ -81,7 +92,7 @@ namespace OpenMS
       {
         pep_it->sort();
         const PeptideHit& hit = pep_it->getHits()[0];
-        PeptideData& data = pep_quant_[hit.getSequence()];
+        PeptideData& data = getPeptideData_(hit.getSequence());
         data.id_count++;
         data.abundances[hit.getCharge()]; // insert empty element for charge
         // add protein accessions:
@@ -113,16 +124,11 @@ namespace OpenMS
 
 
   void PeptideAndProteinQuant::quantifyFeature_(const FeatureHandle& feature,
-                                                const PeptideHit& hit)
+                                                SampleAbundances& abundances)
   {
-    if (hit == PeptideHit())
-    {
-      return; // annotation for the feature is ambiguous or missing
-    }
     stats_.quant_features++;
-    const AASequence& seq = hit.getSequence();
-    pep_quant_[seq].abundances[hit.getCharge()][feature.getMapIndex()] +=
-      feature.getIntensity(); // new map element is initialized with 0
+    abundances[feature.getMapIndex()] += feature.getIntensity(); // new map
+    // element is initialized with 0
   }
 
 
@@ -164,50 +170,64 @@ namespace OpenMS
         if (pos != pep_info.end()) // sequence found in protein inference data
         {
           q_it->second.accessions = pos->second; // replace accessions
-          filtered.insert(*q_it);
+          filtered.insert(filtered.end(), *q_it); // same order - use hint
         }
       }
-      pep_quant_ = filtered;
+      pep_quant_.swap(filtered);
     }
 
-    // now perform the actual peptide quantification:
+    // now perform the actual peptide quantification (peptides are independent
+    // of each other, so they can be processed in parallel):
+    bool filter_charge = (param_.getValue("filter_charge") == "true");
+    vector<PeptideData*> pep_data;
+    pep_data.reserve(pep_quant_.size());
     for (PeptideQuant::iterator q_it = pep_quant_.begin();
          q_it != pep_quant_.end(); ++q_it)
     {
-      if (param_.getValue("filter_charge") == "true")
+      pep_data.push_back(&(q_it->second));
+    }
+
+    Size quant_peptides = 0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 100) reduction(+: quant_peptides)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)pep_data.size(); ++i)
+    {
+      PeptideData& data = *pep_data[i];
+      if (filter_charge)
       {
         // find charge state with abundances for highest number of samples
         // (break ties by total abundance):
         IntList charges; // sorted charge states (best first)
-        orderBest_(q_it->second.abundances, charges);
+        orderBest_(data.abundances, charges);
         if (charges.empty()) continue; // only identified, not quantified
         Int best_charge = charges[0];
 
         // quantify according to the best charge state only:
-        for (SampleAbundances::iterator samp_it =
-               q_it->second.abundances[best_charge].begin(); samp_it !=
-             q_it->second.abundances[best_charge].end(); ++samp_it)
+        const SampleAbundances& best_ab = data.abundances[best_charge];
+        for (SampleAbundances::const_iterator samp_it = best_ab.begin();
+             samp_it != best_ab.end(); ++samp_it)
         {
-          q_it->second.total_abundances[samp_it->first] = samp_it->second;
+          data.total_abundances[samp_it->first] = samp_it->second;
         }
       }
       else
       {
         // sum up abundances over all charge states:
         for (map<Int, SampleAbundances>::iterator ab_it =
-               q_it->second.abundances.begin(); ab_it !=
-             q_it->second.abundances.end(); ++ab_it)
+               data.abundances.begin(); ab_it != data.abundances.end();
+             ++ab_it)
         {
           for (SampleAbundances::iterator samp_it = ab_it->second.begin();
                samp_it != ab_it->second.end(); ++samp_it)
           {
-            q_it->second.total_abundances[samp_it->first] += samp_it->second;
+            data.total_abundances[samp_it->first] += samp_it->second;
           }
         }
       }
-      if (!q_it->second.total_abundances.empty())
-        stats_.quant_peptides++;
+      if (!data.total_abundances.empty()) quant_peptides++;
     }
+    stats_.quant_peptides += quant_peptides;
 
     if ((stats_.n_samples > 1) &&
         (param_.getValue("consensus:normalize") == "true"))
@@ -257,24 +277,40 @@ namespace OpenMS
       scale_factors[med_it->first] = overall_median / med_it->second;
     }
 
+    // samples without a scale factor (not in any total abundances) are
+    // scaled by zero; lookups must not modify the map (parallel access):
+    auto getScaleFactor = [&scale_factors](UInt64 sample) -> double
+    {
+      SampleAbundances::const_iterator pos = scale_factors.find(sample);
+      return (pos != scale_factors.end()) ? pos->second : 0.0;
+    };
+
     // scale all abundance values:
+    vector<PeptideData*> pep_data;
+    pep_data.reserve(pep_quant_.size());
     for (PeptideQuant::iterator q_it = pep_quant_.begin();
          q_it != pep_quant_.end(); ++q_it)
     {
-      for (SampleAbundances::iterator tot_it =
-             q_it->second.total_abundances.begin(); tot_it !=
-           q_it->second.total_abundances.end(); ++tot_it)
+      pep_data.push_back(&(q_it->second));
+    }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 100)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)pep_data.size(); ++i)
+    {
+      PeptideData& data = *pep_data[i];
+      for (SampleAbundances::iterator tot_it = data.total_abundances.begin();
+           tot_it != data.total_abundances.end(); ++tot_it)
       {
-        tot_it->second *= scale_factors[tot_it->first];
+        tot_it->second *= getScaleFactor(tot_it->first);
       }
-      for (map<Int, SampleAbundances>::iterator ab_it =
-             q_it->second.abundances.begin(); ab_it !=
-           q_it->second.abundances.end(); ++ab_it)
+      for (map<Int, SampleAbundances>::iterator ab_it = data.abundances.begin();
+           ab_it != data.abundances.end(); ++ab_it)
       {
         for (SampleAbundances::iterator samp_it = ab_it->second.begin();
              samp_it != ab_it->second.end(); ++samp_it)
         {
-          samp_it->second *= scale_factors[samp_it->first];
+          samp_it->second *= getScaleFactor(samp_it->first);
         }
       }
     }
@@ -341,15 +377,17 @@ namespace OpenMS
                                        accession_to_leader);
       if (!accession.empty()) // proteotypic peptide
       {
-        prot_quant_[accession].id_count += pep_it->second.id_count;
+        ProteinData& prot_data = prot_quant_[accession];
+        prot_data.id_count += pep_it->second.id_count;
+        if (pep_it->second.total_abundances.empty()) continue;
+        // add up contributions of same peptide with different mods:
+        SampleAbundances& pep_abundances =
+          prot_data.abundances[pep_it->first.toUnmodifiedString()];
         for (SampleAbundances::const_iterator tot_it =
                pep_it->second.total_abundances.begin(); tot_it !=
              pep_it->second.total_abundances.end(); ++tot_it)
         {
-          // add up contributions of same peptide with different mods:
-          String raw_peptide = pep_it->first.toUnmodifiedString();
-          prot_quant_[accession].abundances[raw_peptide][tot_it->first] +=
-            tot_it->second;
+          pep_abundances[tot_it->first] += tot_it->second;
         }
       }
     }
@@ -359,12 +397,25 @@ namespace OpenMS
     bool include_all = param_.getValue("include_all") == "true";
     bool fix_peptides = param_.getValue("consensus:fix_peptides") == "true";
 
+    // proteins are independent of each other, so process them in parallel:
+    vector<ProteinData*> prot_data;
+    prot_data.reserve(prot_quant_.size());
     for (ProteinQuant::iterator prot_it = prot_quant_.begin();
          prot_it != prot_quant_.end(); ++prot_it)
     {
-      if ((top > 0) && (prot_it->second.abundances.size() < top))
+      prot_data.push_back(&(prot_it->second));
+    }
+
+    Size too_few_peptides = 0, quant_proteins = 0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 10) reduction(+: too_few_peptides, quant_proteins)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)prot_data.size(); ++i)
+    {
+      ProteinData& data = *prot_data[i];
+      if ((top > 0) && (data.abundances.size() < top))
       {
-        stats_.too_few_peptides++;
+        too_few_peptides++;
         if (!include_all)
           continue; // not enough proteotypic peptides
       }
@@ -374,8 +425,8 @@ namespace OpenMS
       {
         // consider all peptides that occur in every sample:
         for (map<String, SampleAbundances>::iterator ab_it =
-               prot_it->second.abundances.begin(); ab_it !=
-             prot_it->second.abundances.end(); ++ab_it)
+               data.abundances.begin(); ab_it !=
+             data.abundances.end(); ++ab_it)
         {
           if (ab_it->second.size() == stats_.n_samples)
           {
@@ -384,17 +435,17 @@ namespace OpenMS
         }
       }
       else if (fix_peptides && (top > 0) &&
-               (prot_it->second.abundances.size() > top))
+               (data.abundances.size() > top))
       {
-        orderBest_(prot_it->second.abundances, peptides);
+        orderBest_(data.abundances, peptides);
         peptides.resize(top);
       }
       else
       {
         // consider all peptides:
         for (map<String, SampleAbundances>::iterator ab_it =
-               prot_it->second.abundances.begin(); ab_it !=
-             prot_it->second.abundances.end(); ++ab_it)
+               data.abundances.begin(); ab_it !=
+             data.abundances.end(); ++ab_it)
         {
           peptides.push_back(ab_it->first);
         }
@@ -405,7 +456,7 @@ namespace OpenMS
       for (vector<String>::iterator pep_it = peptides.begin();
            pep_it != peptides.end(); ++pep_it)
       {
-        SampleAbundances& current_ab = prot_it->second.abundances[*pep_it];
+        SampleAbundances& current_ab = data.abundances[*pep_it];
         for (SampleAbundances::iterator samp_it = current_ab.begin();
              samp_it != current_ab.end(); ++samp_it)
         {
@@ -453,13 +504,15 @@ namespace OpenMS
         {
           result = Math::sum(ab_it->second.begin(), ab_it->second.end());
         }
-        prot_it->second.total_abundances[ab_it->first] = result;
+        data.total_abundances[ab_it->first] = result;
       }
 
       // update statistics:
-      if (prot_it->second.total_abundances.empty()) stats_.too_few_peptides++;
-      else stats_.quant_proteins++;
+      if (data.total_abundances.empty()) too_few_peptides++;
+      else quant_proteins++;
     }
+    stats_.too_few_peptides += too_few_peptides;
+    stats_.quant_proteins += quant_proteins;
   }
 
 
@@ -479,10 +532,14 @@ namespace OpenMS
       }
       countPeptides_(feat_it->getPeptideIdentifications());
       PeptideHit hit = getAnnotation_(feat_it->getPeptideIdentifications());
+      if (hit == PeptideHit()) continue; // annotation ambiguous or missing
+      SampleAbundances& abundances =
+        getPeptideData_(hit.getSequence()).abundances[hit.getCharge()];
       FeatureHandle handle(0, *feat_it);
-      quantifyFeature_(handle, hit); // updates "stats_.quant_features"
+      quantifyFeature_(handle, abundances); // updates "stats_.quant_features"
     }
     countPeptides_(features.getUnassignedPeptideIdentifications());
+    pep_index_.clear();
     stats_.total_peptides = pep_quant_.size();
     stats_.ambig_features = stats_.total_features - stats_.blank_features -
                             stats_.quant_features;
@@ -505,14 +562,19 @@ namespace OpenMS
       }
       countPeptides_(cons_it->getPeptideIdentifications());
       PeptideHit hit = getAnnotation_(cons_it->getPeptideIdentifications());
+      if (hit == PeptideHit()) continue; // annotation ambiguous or missing
+      // look up the peptide once for all features of the consensus feature:
+      SampleAbundances& abundances =
+        getPeptideData_(hit.getSequence()).abundances[hit.getCharge()];
       for (ConsensusFeature::HandleSetType::const_iterator feat_it =
              cons_it->getFeatures().begin(); feat_it !=
            cons_it->getFeatures().end(); ++feat_it)
       {
-        quantifyFeature_(*feat_it, hit); // updates "stats_.quant_features"
+        quantifyFeature_(*feat_it, abundances); // upd. "stats_.quant_features"
       }
     }
     countPeptides_(consensus.getUnassignedPeptideIdentifications());
+    pep_index_.clear();
     stats_.total_peptides = pep_quant_.size();
     stats_.ambig_features = stats_.total_features - stats_.blank_features -
                             stats_.quant_features;
@@ -546,8 +608,9 @@ namespace OpenMS
       stats_.quant_features++;
       const AASequence& seq = hit.getSequence();
       Size sample = identifiers[pep_it->getIdentifier()];
-      pep_quant_[seq].abundances[hit.getCharge()][sample] += 1;
+      getPeptideData_(seq).abundances[hit.getCharge()][sample] += 1;
     }
+    pep_index_.clear();
     stats_.total_peptides = pep_quant_.size();
   }
 
@@ -558,6 +621,7 @@ namespace OpenMS
     stats_ = Statistics();
     pep_quant_.clear();
     prot_quant_.clear();
+    pep_index_.clear();
   }
 
 
@@ -230,7 +230,8 @@ namespace OpenMS
 
   std::vector<OPXLDataStructs::AASeqWithMass> OPXLHelper::digestDatabase(vector<FASTAFile::FASTAEntry> fasta_db, EnzymaticDigestion digestor, Size min_peptide_length, StringList cross_link_residue1, StringList cross_link_residue2, std::vector<ResidueModification> fixed_modifications, std::vector<ResidueModification> variable_modifications, Size max_variable_mods_per_peptide)
   {
-    multimap<StringView, AASequence> processed_peptides;
+    // peptides (and all their modified variants) that were already added
+    set<StringView> processed_peptides;
     vector<OPXLDataStructs::AASeqWithMass> peptide_masses;
 
     bool n_term_linker = false;
@@ -267,15 +268,18 @@ namespace OpenMS
 
       for (vector<StringView>::iterator cit = current_digest.begin(); cit != current_digest.end(); ++cit)
       {
+        // create the peptide string only once, it is used several times below
+        const String current_peptide = cit->getString();
+
         // skip peptides with invalid AAs // TODO is this necessary?
-        if (cit->getString().has('B') || cit->getString().has('O') || cit->getString().has('U') || cit->getString().has('X') || cit->getString().has('Z')) continue;
+        if (current_peptide.find_first_of("BOUXZ") != std::string::npos) continue;
 
         OPXLDataStructs::PeptidePosition position = OPXLDataStructs::INTERNAL;
-        if (fasta_db[fasta_index].sequence.hasPrefix(cit->getString()))
+        if (fasta_db[fasta_index].sequence.hasPrefix(current_peptide))
         {
           position = OPXLDataStructs::N_TERM;
         }
-        else if (fasta_db[fasta_index].sequence.hasSuffix(cit->getString()))
+        else if (fasta_db[fasta_index].sequence.hasSuffix(current_peptide))
         {
           position = OPXLDataStructs::C_TERM;
         }
@@ -294,14 +298,14 @@ namespace OpenMS
         {
           for (String res : cross_link_residue1)
           {
-            if (res.size() == 1 && (cit->getString().find(res) < cit->getString().size()-1))
+            if (res.size() == 1 && (current_peptide.find(res) < current_peptide.size()-1))
             {
               skip = false;
             }
           }
           for (String res : cross_link_residue2)
           {
-            if (res.size() == 1 && (cit->getString().find(res) < cit->getString().size()-1))
+            if (res.size() == 1 && (current_peptide.find(res) < current_peptide.size()-1))
             {
               skip = false;
             }
@@ -322,7 +326,7 @@ namespace OpenMS
         vector<AASequence> all_modified_peptides;
 
         // generate all modified variants of a peptide
-        AASequence aas = AASequence::fromString(cit->getString());
+        AASequence aas = AASequence::fromString(current_peptide);
         ModifiedPeptideGenerator::applyFixedModifications(fixed_modifications.begin(), fixed_modifications.end(), aas);
         ModifiedPeptideGenerator::applyVariableModifications(variable_modifications.begin(), variable_modifications.end(), aas, max_variable_mods_per_peptide, all_modified_peptides);
 
@@ -334,9 +338,9 @@ namespace OpenMS
           pep_mass.peptide_seq = candidate;
           pep_mass.position = position;
 
-          processed_peptides.insert(pair<StringView, AASequence>(*cit, candidate));
           peptide_masses.push_back(pep_mass);
         }
+        processed_peptides.insert(*cit);
       }
     }
     sort(peptide_masses.begin(), peptide_masses.end(), OPXLDataStructs::AASeqWithMassComparator());
@@ -35,6 +35,7 @@
 #include <OpenMS/APPLICATIONS/TOPPBase.h>
 
 #include <OpenMS/SYSTEM/File.h>
+#include <OpenMS/SYSTEM/Profiler.h>
 #include <OpenMS/SYSTEM/StopWatch.h>
 #include <OpenMS/SYSTEM/SysInfo.h>
 #include <OpenMS/SYSTEM/UpdateCheck.h>
@@ -173,6 +174,9 @@ namespace OpenMS
     registerStringOption_("write_ini", "<file>", "", "Writes the default configuration file", false);
     registerStringOption_("write_ctd", "<out_dir>", "", "Writes the common tool description file(s) (Toolname(s).ctd) to <out_dir>", false, true);
     registerFlag_("no_progress", "Disables progress logging to command line", true);
+    registerStringOption_("profile", "<file>", "", "Writes a report of the processing phases (wall and CPU time, thread utilization, peak memory, I/O) to the given file (created only when specified)", false, true);
+    registerStringOption_("profile_format", "<format>", Profiler::NamesOfReportFormat[Profiler::JSON], "Format of the '-profile' report: 'json' (summary per phase) or 'chrome_trace' (timeline for chrome://tracing or Perfetto)", false, true);
+    setValidStrings_("profile_format", Profiler::NamesOfReportFormat, Profiler::SIZE_OF_REPORTFORMAT);
     registerFlag_("force", "Overwrite tool specific checks.", true);
     registerFlag_("test", "Enables the test mode (needed for internal use only)", true);
     registerFlag_("-help", "Shows options");
@@ -441,12 +445,29 @@ namespace OpenMS
     //----------------------------------------------------------
     //main
     //----------------------------------------------------------
+    String profile_file = getStringOption_("profile");
+    if (!profile_file.empty())
+    {
+      Profiler::getInstance().enable();
+    }
+
     StopWatch sw;
     sw.start();
-    result = main_(argc, argv);
+    {
+      Profiler::ScopedPhase tool_phase(tool_name_.c_str());
+      result = main_(argc, argv);
+    }
     sw.stop();
     LOG_INFO << this->tool_name_ << " took " << sw.toString() << "." << std::endl;
 
+    if (!profile_file.empty())
+    {
+      Profiler::getInstance().disable();
+      String format = getStringOption_("profile_format");
+      Profiler::getInstance().store(profile_file, format == Profiler::NamesOfReportFormat[Profiler::CHROME_TRACE] ? Profiler::CHROME_TRACE : Profiler::JSON);
+      writeDebug_("Profile written to '" + profile_file + "'", 1);
+    }
+
     // useful for benchmarking
     if (debug_level_ >= 1)
     {
@@ -0,0 +1,366 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CHEMISTRY/ChemistryDBSnapshot.h>
+
+#include <OpenMS/CHEMISTRY/ElementDB.h>
+#include <OpenMS/CHEMISTRY/EmpiricalFormula.h>
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/CONCEPT/VersionInfo.h>
+#include <OpenMS/DATASTRUCTURES/Param.h>
+#include <OpenMS/FORMAT/FileHandler.h>
+#include <OpenMS/FORMAT/ParamXMLFile.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+using namespace std;
+
+namespace OpenMS
+{
+  const Int ChemistryDBSnapshot::FORMAT_VERSION = 1;
+
+  ChemistryDBSnapshot::ChemistryDBSnapshot(const String& name, const StringList& source_files) :
+    name_(name),
+    source_files_(source_files),
+    path_(File::getOpenMSHomePath() + "/.OpenMS/cache/" + name + ".snapshot"),
+    header_(),
+    buffer_(),
+    file_(nullptr),
+    data_(nullptr),
+    data_end_(nullptr)
+  {
+  }
+
+  ChemistryDBSnapshot::~ChemistryDBSnapshot()
+  {
+    // destroying the file also unmaps it
+    delete file_;
+  }
+
+  bool ChemistryDBSnapshot::isEnabled()
+  {
+    return getenv("OPENMS_DISABLE_DB_SNAPSHOT") == nullptr;
+  }
+
+  const String& ChemistryDBSnapshot::getPath() const
+  {
+    return path_;
+  }
+
+  void ChemistryDBSnapshot::setPath(const String& path)
+  {
+    path_ = path;
+  }
+
+  const String& ChemistryDBSnapshot::getHeader_()
+  {
+    if (header_.empty())
+    {
+      // locate and checksum the sources first (File::find() throws if one is missing)
+      StringList files, checksums;
+      for (StringList::const_iterator it = source_files_.begin(); it != source_files_.end(); ++it)
+      {
+        files.push_back(File::find(*it));
+        checksums.push_back(FileHandler::computeFileHash(files.back()));
+      }
+
+      std::string data;
+      data.swap(buffer_);
+      write_("OpenMSDBSnapshot", 16);
+      writeInt(0x0102030405060708LL); // detects a different byte order
+      writeInt(FORMAT_VERSION);
+      writeString(VersionInfo::getVersion());
+      writeString(name_);
+      writeSize(files.size());
+      for (Size i = 0; i < files.size(); ++i)
+      {
+        writeString(files[i]);
+        writeString(checksums[i]);
+      }
+      header_ = buffer_;
+      buffer_.swap(data);
+    }
+    return header_;
+  }
+
+  bool ChemistryDBSnapshot::open()
+  {
+    if (!isEnabled() || !File::readable(path_))
+    {
+      return false;
+    }
+
+    try
+    {
+      getHeader_();
+    }
+    catch (Exception::BaseException&)
+    {
+      return false;
+    }
+
+    delete file_;
+    file_ = new QFile(path_.toQString());
+    data_ = nullptr;
+    data_end_ = nullptr;
+    if (!file_->open(QIODevice::ReadOnly) || file_->size() < (qint64)header_.size())
+    {
+      return false;
+    }
+    const uchar* map = file_->map(0, file_->size());
+    if (map == nullptr)
+    {
+      return false;
+    }
+    const char* begin = reinterpret_cast<const char*>(map);
+    if (memcmp(begin, header_.c_str(), header_.size()) != 0)
+    {
+      // written by another version or from different sources
+      return false;
+    }
+    data_ = begin + header_.size();
+    data_end_ = begin + file_->size();
+    return true;
+  }
+
+  bool ChemistryDBSnapshot::store()
+  {
+    if (!isEnabled())
+    {
+      return false;
+    }
+
+    try
+    {
+      getHeader_();
+      if (!QDir().mkpath(File::path(path_).toQString()))
+      {
+        return false;
+      }
+
+      // write to a temporary file first, other processes may read the snapshot at the same time
+      String tmp_path = path_ + "." + File::getUniqueName() + ".tmp";
+      ofstream out(tmp_path.c_str(), ios::out | ios::binary);
+      out.write(header_.c_str(), header_.size());
+      out.write(buffer_.data(), buffer_.size());
+      out.close();
+      if (!out)
+      {
+        std::remove(tmp_path.c_str());
+        return false;
+      }
+
+      // rename is atomic on POSIX systems, elsewhere an existing snapshot needs to be removed first
+      if (std::rename(tmp_path.c_str(), path_.c_str()) != 0 && !File::rename(tmp_path, path_, true, false))
+      {
+        std::remove(tmp_path.c_str());
+        return false;
+      }
+    }
+    catch (Exception::BaseException&)
+    {
+      return false;
+    }
+    return true;
+  }
+
+  void ChemistryDBSnapshot::write_(const void* data, Size size)
+  {
+    buffer_.append(static_cast<const char*>(data), size);
+  }
+
+  void ChemistryDBSnapshot::read_(void* data, Size size)
+  {
+    if (data_ == nullptr || Size(data_end_ - data_) < size)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, path_, "Unexpected end of snapshot.");
+    }
+    memcpy(data, data_, size);
+    data_ += size;
+  }
+
+  void ChemistryDBSnapshot::writeInt(Int64 value)
+  {
+    write_(&value, sizeof(value));
+  }
+
+  void ChemistryDBSnapshot::writeSize(Size value)
+  {
+    UInt64 size = value;
+    write_(&size, sizeof(size));
+  }
+
+  void ChemistryDBSnapshot::writeDouble(double value)
+  {
+    write_(&value, sizeof(value));
+  }
+
+  void ChemistryDBSnapshot::writeString(const String& value)
+  {
+    writeSize(value.size());
+    write_(value.c_str(), value.size());
+  }
+
+  void ChemistryDBSnapshot::writeStringSet(const set<String>& value)
+  {
+    writeSize(value.size());
+    for (set<String>::const_iterator it = value.begin(); it != value.end(); ++it)
+    {
+      writeString(*it);
+    }
+  }
+
+  void ChemistryDBSnapshot::writeFormula(const EmpiricalFormula& value)
+  {
+    writeInt(value.getCharge());
+    writeSize(distance(value.begin(), value.end()));
+    for (EmpiricalFormula::ConstIterator it = value.begin(); it != value.end(); ++it)
+    {
+      writeString(it->first->getSymbol());
+      writeInt(it->second);
+    }
+  }
+
+  Int64 ChemistryDBSnapshot::readInt()
+  {
+    Int64 value;
+    read_(&value, sizeof(value));
+    return value;
+  }
+
+  Size ChemistryDBSnapshot::readSize()
+  {
+    UInt64 value;
+    read_(&value, sizeof(value));
+    return value;
+  }
+
+  double ChemistryDBSnapshot::readDouble()
+  {
+    double value;
+    read_(&value, sizeof(value));
+    return value;
+  }
+
+  String ChemistryDBSnapshot::readString()
+  {
+    Size size = readSize();
+    if (data_ == nullptr || Size(data_end_ - data_) < size)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, path_, "Unexpected end of snapshot.");
+    }
+    String value(data_, data_ + size);
+    data_ += size;
+    return value;
+  }
+
+  set<String> ChemistryDBSnapshot::readStringSet()
+  {
+    set<String> value;
+    Size size = readSize();
+    for (Size i = 0; i < size; ++i)
+    {
+      value.insert(value.end(), readString());
+    }
+    return value;
+  }
+
+  EmpiricalFormula ChemistryDBSnapshot::readFormula()
+  {
+    EmpiricalFormula value;
+    SignedSize charge = readInt();
+    Size size = readSize();
+    for (Size i = 0; i < size; ++i)
+    {
+      String symbol = readString();
+      SignedSize count = readInt();
+      const Element* element = ElementDB::getInstance()->getElement(symbol);
+      if (element == nullptr)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, path_, "Unknown element '" + symbol + "' in snapshot.");
+      }
+      value += EmpiricalFormula(count, element);
+    }
+    value.setCharge(charge);
+    return value;
+  }
+
+  void ChemistryDBSnapshot::loadParamEntries(const String& name, const String& param_file, vector<pair<String, String> >& entries)
+  {
+    entries.clear();
+    ChemistryDBSnapshot snapshot(name, StringList(1, param_file));
+    if (snapshot.open())
+    {
+      try
+      {
+        Size size = snapshot.readSize();
+        for (Size i = 0; i < size; ++i)
+        {
+          String key = snapshot.readString();
+          entries.push_back(make_pair(key, snapshot.readString()));
+        }
+        return;
+      }
+      catch (Exception::ParseError&)
+      {
+        // broken snapshot: parse the file instead
+        entries.clear();
+      }
+    }
+
+    Param param;
+    ParamXMLFile().load(File::find(param_file), param);
+    for (Param::ParamIterator it = param.begin(); it != param.end(); ++it)
+    {
+      String value = it->value;
+      entries.push_back(make_pair(it.getName(), value));
+    }
+
+    snapshot.writeSize(entries.size());
+    for (vector<pair<String, String> >::const_iterator it = entries.begin(); it != entries.end(); ++it)
+    {
+      snapshot.writeString(it->first);
+      snapshot.writeString(it->second);
+    }
+    snapshot.store();
+  }
+
+} // namespace OpenMS
@@ -35,11 +35,8 @@
 #include <OpenMS/CHEMISTRY/ElementDB.h>
 #include <OpenMS/CHEMISTRY/Element.h>
 
-#include <OpenMS/DATASTRUCTURES/Param.h>
-
-#include <OpenMS/FORMAT/ParamXMLFile.h>
-
-#include <OpenMS/SYSTEM/File.h>
+#include <OpenMS/CHEMISTRY/ChemistryDBSnapshot.h>
+#include <OpenMS/CONCEPT/Exception.h>
 
 #include <iostream>
 
@@ -143,19 +140,20 @@ namespace OpenMS
 
   void ElementDB::readFromFile_(const String& file_name)
   {
-    String file = File::find(file_name);
-
-    // load elements into param object
-    Param param;
-    ParamXMLFile paramFile;
-    paramFile.load(file, param);
+    // load elements as (name, value) entries of the param file, from the snapshot if possible
+    vector<pair<String, String> > entries;
+    ChemistryDBSnapshot::loadParamEntries("ElementDB", file_name, entries);
+    if (entries.empty())
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, file_name, "No elements found.");
+    }
 
     UInt an(0);
     String name, symbol;
 
     // determine prefix
     vector<String> split;
-    param.begin().getName().split(':', split);
+    entries.front().first.split(':', split);
     String prefix("");
     for (Size i = 0; i < split.size() - 1; ++i)
     {
@@ -166,13 +164,13 @@ namespace OpenMS
     Map<UInt, double> Z_to_abundancy;
     Map<UInt, double> Z_to_mass;
 
-    for (Param::ParamIterator it = param.begin(); it != param.end(); ++it)
+    for (vector<pair<String, String> >::const_iterator it = entries.begin(); it != entries.end(); ++it)
     {
       // new element started?
-      if (!it.getName().hasPrefix(prefix))
+      if (!it->first.hasPrefix(prefix))
       {
         // update prefix
-        it.getName().split(':', split);
+        it->first.split(':', split);
         prefix = "";
         for (Size i = 0; i < split.size() - 1; ++i)
         {
@@ -227,9 +225,9 @@ namespace OpenMS
       }
 
       // top level: read the contents of the element section
-      it.getName().split(':', split);
+      it->first.split(':', split);
       String key = split[2];
-      String value = it->value;
+      String value = it->second;
       value.trim();
 
       // cout << "Key=" << key << endl;
@@ -0,0 +1,94 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CHEMISTRY/LightPeptide.h>
+
+#include <OpenMS/CHEMISTRY/Residue.h>
+#include <OpenMS/CHEMISTRY/ResidueDB.h>
+
+#include <limits>
+
+using namespace std;
+
+namespace OpenMS
+{
+  LightPeptide::MassTable::MassTable() :
+    internal_to_full_(Residue::getInternalToFull().getMonoWeight())
+  {
+    const ResidueDB* rdb = ResidueDB::getInstance();
+    const Residue* unknown = rdb->getResidue('X');
+    for (Size i = 0; i != 256; ++i)
+    {
+      const Residue* r = rdb->getResidue(static_cast<unsigned char>(i));
+      if (r == nullptr || r == unknown)
+      {
+        masses_[i] = numeric_limits<double>::quiet_NaN();
+      }
+      else
+      {
+        masses_[i] = r->getMonoWeight(Residue::Internal);
+      }
+    }
+  }
+
+  LightPeptide::LightPeptide() :
+    sequence_()
+  {
+  }
+
+  LightPeptide::LightPeptide(const StringView& sequence) :
+    sequence_(sequence)
+  {
+  }
+
+  const StringView& LightPeptide::getSequence() const
+  {
+    return sequence_;
+  }
+
+  Size LightPeptide::size() const
+  {
+    return sequence_.size();
+  }
+
+  double LightPeptide::getMonoWeight(const MassTable& masses) const
+  {
+    double mono_weight(masses.getInternalToFull());
+    for (const char* it = sequence_.begin(); it != sequence_.end(); ++it)
+    {
+      mono_weight += masses.getMass(*it);
+    }
+    return mono_weight;
+  }
+
+}
@@ -35,6 +35,7 @@
 
 #include <OpenMS/CHEMISTRY/ModificationsDB.h>
 
+#include <OpenMS/CHEMISTRY/ChemistryDBSnapshot.h>
 #include <OpenMS/FORMAT/UnimodXMLFile.h>
 #include <OpenMS/SYSTEM/File.h>
 #include <OpenMS/CHEMISTRY/ResidueDB.h>
@@ -53,19 +54,31 @@ namespace OpenMS
 
   ModificationsDB::ModificationsDB(OpenMS::String unimod_file, OpenMS::String psimod_file, OpenMS::String xlmod_file)
   {
-    if (!unimod_file.empty())
+    StringList source_files;
+    if (!unimod_file.empty()) source_files.push_back(unimod_file);
+    if (!psimod_file.empty()) source_files.push_back(psimod_file);
+    if (!xlmod_file.empty()) source_files.push_back(xlmod_file);
+
+    // the file names are part of the header, so a differently configured database never uses this snapshot
+    ChemistryDBSnapshot snapshot("ModificationsDB", source_files);
+    if (!readFromSnapshot_(snapshot))
     {
-      readFromUnimodXMLFile(unimod_file);
-    }
+      if (!unimod_file.empty())
+      {
+        readFromUnimodXMLFile(unimod_file);
+      }
 
-    if (!psimod_file.empty())
-    {
-      readFromOBOFile(psimod_file);
-    }
+      if (!psimod_file.empty())
+      {
+        readFromOBOFile(psimod_file);
+      }
 
-    if (!xlmod_file.empty())
-    {
-      readFromOBOFile(xlmod_file);
+      if (!xlmod_file.empty())
+      {
+        readFromOBOFile(xlmod_file);
+      }
+
+      writeToSnapshot_(snapshot);
     }
 
     is_instantiated_ = true;
@@ -108,13 +121,14 @@ namespace OpenMS
   {
     mods.clear();
 
-    if (!modification_names_.has(mod_name))
+    boost::unordered_map<String, set<const ResidueModification*> >::const_iterator name_it = modification_names_.find(mod_name);
+    if (name_it == modification_names_.end())
     {
       throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
                                        mod_name);
     }
 
-    const set<const ResidueModification*>& temp = modification_names_[mod_name];
+    const set<const ResidueModification*>& temp = name_it->second;
     for (set<const ResidueModification*>::const_iterator it = temp.begin();
          it != temp.end(); ++it)
     {
@@ -161,22 +175,23 @@ namespace OpenMS
 
   bool ModificationsDB::has(String modification) const
   {
-    return modification_names_.has(modification);
+    return modification_names_.find(modification) != modification_names_.end();
   }
 
   Size ModificationsDB::findModificationIndex(const String & mod_name) const
   {
-    if (!modification_names_.has(mod_name))
+    boost::unordered_map<String, set<const ResidueModification*> >::const_iterator name_it = modification_names_.find(mod_name);
+    if (name_it == modification_names_.end())
     {
       throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, mod_name);
     }
 
-    if (modification_names_[mod_name].size() > 1)
+    if (name_it->second.size() > 1)
     {
       throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "more than one element of name '" + mod_name + "' found!");
     }
 
-    const ResidueModification* mod = *modification_names_[mod_name].begin();
+    const ResidueModification* mod = *name_it->second.begin();
     for (Size i = 0; i != mods_.size(); ++i)
     {
       if (mods_[i] == mod)
@@ -604,6 +619,128 @@ namespace OpenMS
     }
   }
 
+  bool ModificationsDB::readFromSnapshot_(ChemistryDBSnapshot& snapshot)
+  {
+    if (!snapshot.open())
+    {
+      return false;
+    }
+
+    try
+    {
+      Size n_mods = snapshot.readSize();
+      for (Size i = 0; i < n_mods; ++i)
+      {
+        ResidueModification* mod = new ResidueModification();
+        mods_.push_back(mod);
+
+        mod->setId(snapshot.readString());
+        String full_id = snapshot.readString();
+        if (!full_id.empty()) mod->setFullId(full_id);
+        mod->setPSIMODAccession(snapshot.readString());
+        mod->setUniModRecordId(Int(snapshot.readInt()));
+        mod->setFullName(snapshot.readString());
+        mod->setName(snapshot.readString());
+        mod->setTermSpecificity(ResidueModification::TermSpecificity(snapshot.readInt()));
+        mod->setOrigin(char(snapshot.readInt()));
+        mod->setSourceClassification(ResidueModification::SourceClassification(snapshot.readInt()));
+        mod->setAverageMass(snapshot.readDouble());
+        mod->setMonoMass(snapshot.readDouble());
+        mod->setDiffAverageMass(snapshot.readDouble());
+        mod->setDiffMonoMass(snapshot.readDouble());
+        mod->setFormula(snapshot.readString());
+        mod->setDiffFormula(snapshot.readFormula());
+        mod->setSynonyms(snapshot.readStringSet());
+        mod->setNeutralLossDiffFormula(snapshot.readFormula());
+        mod->setNeutralLossMonoMass(snapshot.readDouble());
+        mod->setNeutralLossAverageMass(snapshot.readDouble());
+      }
+
+      Size n_names = snapshot.readSize();
+      for (Size i = 0; i < n_names; ++i)
+      {
+        set<const ResidueModification*>& mods = modification_names_[snapshot.readString()];
+        Size n_name_mods = snapshot.readSize();
+        for (Size j = 0; j < n_name_mods; ++j)
+        {
+          Size index = snapshot.readSize();
+          if (index >= mods_.size())
+          {
+            throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, snapshot.getPath(), "Invalid modification index.");
+          }
+          mods.insert(mods_[index]);
+        }
+      }
+    }
+    catch (Exception::BaseException&)
+    {
+      // unusable snapshot: start over from the source files
+      modification_names_.clear();
+      for (vector<ResidueModification*>::iterator it = mods_.begin(); it != mods_.end(); ++it)
+      {
+        delete *it;
+      }
+      mods_.clear();
+      return false;
+    }
+    return true;
+  }
+
+  void ModificationsDB::writeToSnapshot_(ChemistryDBSnapshot& snapshot) const
+  {
+    if (!ChemistryDBSnapshot::isEnabled())
+    {
+      return;
+    }
+
+    map<const ResidueModification*, Size> indices;
+    snapshot.writeSize(mods_.size());
+    for (Size i = 0; i < mods_.size(); ++i)
+    {
+      const ResidueModification* mod = mods_[i];
+      indices[mod] = i;
+
+      snapshot.writeString(mod->getId());
+      snapshot.writeString(mod->getFullId());
+      snapshot.writeString(mod->getPSIMODAccession());
+      snapshot.writeInt(mod->getUniModRecordId());
+      snapshot.writeString(mod->getFullName());
+      snapshot.writeString(mod->getName());
+      snapshot.writeInt(mod->getTermSpecificity());
+      snapshot.writeInt(mod->getOrigin());
+      snapshot.writeInt(mod->getSourceClassification());
+      snapshot.writeDouble(mod->getAverageMass());
+      snapshot.writeDouble(mod->getMonoMass());
+      snapshot.writeDouble(mod->getDiffAverageMass());
+      snapshot.writeDouble(mod->getDiffMonoMass());
+      snapshot.writeString(mod->getFormula());
+      snapshot.writeFormula(mod->getDiffFormula());
+      snapshot.writeStringSet(mod->getSynonyms());
+      snapshot.writeFormula(mod->getNeutralLossDiffFormula());
+      snapshot.writeDouble(mod->getNeutralLossMonoMass());
+      snapshot.writeDouble(mod->getNeutralLossAverageMass());
+    }
+
+    snapshot.writeSize(modification_names_.size());
+    for (boost::unordered_map<String, set<const ResidueModification*> >::const_iterator name_it = modification_names_.begin();
+         name_it != modification_names_.end(); ++name_it)
+    {
+      snapshot.writeString(name_it->first);
+      snapshot.writeSize(name_it->second.size());
+      for (set<const ResidueModification*>::const_iterator mod_it = name_it->second.begin(); mod_it != name_it->second.end(); ++mod_it)
+      {
+        map<const ResidueModification*, Size>::const_iterator index_it = indices.find(*mod_it);
+        if (index_it == indices.end())
+        {
+          return; // not owned by the database, do not store an incomplete snapshot
+        }
+        snapshot.writeSize(index_it->second);
+      }
+    }
+
+    snapshot.store();
+  }
+
   void ModificationsDB::getAllSearchModifications(vector<String>& modifications) const
   {
     modifications.clear();
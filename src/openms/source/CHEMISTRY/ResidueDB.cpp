@@ -34,6 +34,7 @@
 //
 
 #include <OpenMS/CHEMISTRY/ResidueDB.h>
+#include <OpenMS/CHEMISTRY/ChemistryDBSnapshot.h>
 #include <OpenMS/CHEMISTRY/ResidueModification.h>
 #include <OpenMS/CHEMISTRY/ModificationsDB.h>
 #include <OpenMS/CHEMISTRY/Residue.h>
@@ -53,7 +54,10 @@ namespace OpenMS
 {
   ResidueDB::ResidueDB()
   {
-    readResiduesFromFile_("CHEMISTRY/Residues.xml");
+    // the entries of the default residue file are cached in a snapshot
+    vector<pair<String, String> > entries;
+    ChemistryDBSnapshot::loadParamEntries("ResidueDB", "CHEMISTRY/Residues.xml", entries);
+    readResidues_(entries);
     buildResidueNames_();
   }
 
@@ -194,7 +198,18 @@ namespace OpenMS
     ParamXMLFile paramFile;
     paramFile.load(file, param);
 
-    if (!param.begin().getName().hasPrefix("Residues"))
+    vector<pair<String, String> > entries;
+    for (Param::ParamIterator it = param.begin(); it != param.end(); ++it)
+    {
+      String value = it->value;
+      entries.push_back(make_pair(it.getName(), value));
+    }
+    readResidues_(entries);
+  }
+
+  void ResidueDB::readResidues_(const vector<pair<String, String> >& entries)
+  {
+    if (entries.empty() || !entries.front().first.hasPrefix("Residues"))
     {
       throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "", "");
     }
@@ -202,15 +217,15 @@ namespace OpenMS
     try
     {
       vector<String> split;
-      param.begin().getName().split(':', split);
+      entries.front().first.split(':', split);
       String prefix = split[0] + split[1];
       Residue* res_ptr = nullptr;
 
       Map<String, String> values;
 
-      for (Param::ParamIterator it = param.begin(); it != param.end(); ++it)
+      for (vector<pair<String, String> >::const_iterator it = entries.begin(); it != entries.end(); ++it)
       {
-        it.getName().split(':', split);
+        it->first.split(':', split);
         if (prefix != split[0] + split[1])
         {
           // add residue
@@ -221,10 +236,7 @@ namespace OpenMS
           prefix = split[0] + split[1];
         }
 
-        String value = it->value;
-        String key = it.getName();
-        values[key] = value;
-
+        values[it->first] = it->second;
       }
 
       // add last residue
@@ -474,9 +486,14 @@ namespace OpenMS
     String id = mod.getId();
     if (id.empty()) id = mod.getFullId();
 
-    if (residue_mod_names_.has(res_name) && residue_mod_names_[res_name].has(id))
+    boost::unordered_map<String, boost::unordered_map<String, Residue*> >::const_iterator res_it = residue_mod_names_.find(res_name);
+    if (res_it != residue_mod_names_.end())
     {
-      return residue_mod_names_[res_name][id];
+      boost::unordered_map<String, Residue*>::const_iterator mod_it = res_it->second.find(id);
+      if (mod_it != res_it->second.end())
+      {
+        return mod_it->second;
+      }
     }
 
     Residue* res = new Residue(*residue_names_[res_name]);
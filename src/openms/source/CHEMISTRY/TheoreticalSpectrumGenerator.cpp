@@ -140,32 +140,49 @@ namespace OpenMS
 
     if (add_metainfo_)
     {
+      // swap instead of copy, the arrays are swapped back below
       if (spectrum.getIntegerDataArrays().size() > 0)
       {
-        charges = spectrum.getIntegerDataArrays()[0];
+        std::swap(charges, spectrum.getIntegerDataArrays()[0]);
       }
       if (spectrum.getStringDataArrays().size() > 0)
       {
-        ion_names = spectrum.getStringDataArrays()[0];
+        std::swap(ion_names, spectrum.getStringDataArrays()[0]);
       }
       ion_names.setName("IonNames");
       charges.setName("Charges");
     }
 
+    // reserve space for all fragment ions at once (not once per ion type and charge)
+    Size n_ion_types = Size(add_b_ions_) + Size(add_y_ions_) + Size(add_a_ions_) + Size(add_c_ions_) + Size(add_x_ions_) + Size(add_z_ions_);
+    Size n_charges = max_charge >= min_charge ? Size(max_charge - min_charge + 1) : 0;
+    Size peaks_per_ion = 1 + (add_isotopes_ ? Size(max_isotope_) : 0) + Size(add_losses_);
+    Size n_expected = spectrum.size() + n_ion_types * n_charges * peptide.size() * peaks_per_ion;
+    spectrum.reserve(n_expected);
+    if (add_metainfo_)
+    {
+      ion_names.reserve(n_expected);
+      charges.reserve(n_expected);
+    }
+
+    // prefix masses are computed once and shared by all ion types and charges
+    std::vector<double> prefix_masses;
+    getPrefixMasses(prefix_masses, peptide);
+
     for (Int z = min_charge; z <= max_charge; ++z)
     {
       if (add_b_ions_)
-        addPeaks_(spectrum, peptide, ion_names, charges, Residue::BIon, z);
+        addPeaks_(spectrum, peptide, prefix_masses, ion_names, charges, Residue::BIon, z);
       if (add_y_ions_)
-        addPeaks_(spectrum, peptide, ion_names, charges, Residue::YIon, z);
+        addPeaks_(spectrum, peptide, prefix_masses, ion_names, charges, Residue::YIon, z);
       if (add_a_ions_)
-        addPeaks_(spectrum, peptide, ion_names, charges, Residue::AIon, z);
+        addPeaks_(spectrum, peptide, prefix_masses, ion_names, charges, Residue::AIon, z);
       if (add_c_ions_)
-        addPeaks_(spectrum, peptide, ion_names, charges, Residue::CIon, z);
+        addPeaks_(spectrum, peptide, prefix_masses, ion_names, charges, Residue::CIon, z);
       if (add_x_ions_)
-        addPeaks_(spectrum, peptide, ion_names, charges, Residue::XIon, z);
+        addPeaks_(spectrum, peptide, prefix_masses, ion_names, charges, Residue::XIon, z);
       if (add_z_ions_)
-        addPeaks_(spectrum, peptide, ion_names, charges, Residue::ZIon, z);
+        addPeaks_(spectrum, peptide, prefix_masses, ion_names, charges, Residue::ZIon, z);
     }
 
     if (add_precursor_peaks_)
@@ -192,19 +209,19 @@ namespace OpenMS
     {
       if (spectrum.getIntegerDataArrays().size() > 0)
       {
-        spectrum.getIntegerDataArrays()[0] = charges;
+        std::swap(spectrum.getIntegerDataArrays()[0], charges);
       }
       else
       {
-        spectrum.getIntegerDataArrays().push_back(charges);
+        spectrum.getIntegerDataArrays().push_back(std::move(charges));
       }
       if (spectrum.getStringDataArrays().size() > 0)
       {
-        spectrum.getStringDataArrays()[0] = ion_names;
+        std::swap(spectrum.getStringDataArrays()[0], ion_names);
       }
       else
       {
-        spectrum.getStringDataArrays().push_back(ion_names);
+        spectrum.getStringDataArrays().push_back(std::move(ion_names));
       }
     }
 
@@ -212,6 +229,22 @@ namespace OpenMS
     return;
   }
 
+  void TheoreticalSpectrumGenerator::getPrefixMasses(std::vector<double> & prefix_masses, const AASequence & peptide)
+  {
+    prefix_masses.resize(peptide.size() + 1);
+    double mono_weight(0.0);
+    if (peptide.hasNTerminalModification())
+    {
+      mono_weight += peptide.getNTerminalModification()->getDiffMonoMass();
+    }
+    prefix_masses[0] = mono_weight;
+    for (Size i = 0; i < peptide.size(); ++i)
+    {
+      mono_weight += peptide[i].getMonoWeight(Residue::Internal); // standard internal residue including named modifications
+      prefix_masses[i + 1] = mono_weight;
+    }
+  }
+
   void TheoreticalSpectrumGenerator::addAbundantImmoniumIons_(PeakSpectrum & spectrum, const AASequence& peptide, DataArrays::StringDataArray& ion_names, DataArrays::IntegerDataArray& charges) const
   {
     Peak1D p;
@@ -433,61 +466,49 @@ namespace OpenMS
 
   }
 
-  void TheoreticalSpectrumGenerator::addPeaks_(PeakSpectrum & spectrum, const AASequence & peptide, DataArrays::StringDataArray& ion_names, DataArrays::IntegerDataArray& charges, Residue::ResidueType res_type, Int charge) const
+  void TheoreticalSpectrumGenerator::addPeaks_(PeakSpectrum & spectrum, const AASequence & peptide, const std::vector<double> & prefix_masses, DataArrays::StringDataArray& ion_names, DataArrays::IntegerDataArray& charges, Residue::ResidueType res_type, Int charge) const
   {
-    int f = 1 + int(add_isotopes_) + int(add_losses_);
-    spectrum.reserve(spectrum.size() + f * peptide.size());
-
     // Generate the ion peaks:
     // Does not generate peaks of full peptide (therefore "<").
     // They are added via precursor mass (and neutral losses).
     // Could be changed in the future.
 
     double intensity(1);
+    // note: the formulas are constant, but getMonoWeight() sums up their elements on every call
+    double ion_offset(0);
 
     switch (res_type)
     {
-      case Residue::AIon: intensity = a_intensity_; break;
-      case Residue::BIon: intensity = b_intensity_; break;
-      case Residue::CIon: if (peptide.size() < 2) throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 1); intensity = c_intensity_; break;
-      case Residue::XIon: if (peptide.size() < 2) throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 1); intensity = x_intensity_; break;
-      case Residue::YIon: intensity = y_intensity_; break;
-      case Residue::ZIon: intensity = z_intensity_; break;
+      case Residue::AIon: intensity = a_intensity_; ion_offset = Residue::getInternalToAIon().getMonoWeight(); break;
+      case Residue::BIon: intensity = b_intensity_; ion_offset = Residue::getInternalToBIon().getMonoWeight(); break;
+      case Residue::CIon: if (peptide.size() < 2) throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 1); intensity = c_intensity_; ion_offset = Residue::getInternalToCIon().getMonoWeight(); break;
+      case Residue::XIon: if (peptide.size() < 2) throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 1); intensity = x_intensity_; ion_offset = Residue::getInternalToXIon().getMonoWeight(); break;
+      case Residue::YIon: intensity = y_intensity_; ion_offset = Residue::getInternalToYIon().getMonoWeight(); break;
+      case Residue::ZIon: intensity = z_intensity_; ion_offset = Residue::getInternalToZIon().getMonoWeight(); break;
       default: break;
     }
 
-    double mono_weight(Constants::PROTON_MASS_U * charge);
+    const Size n = peptide.size();
+    const double charge_offset(Constants::PROTON_MASS_U * charge + ion_offset);
+    const String ion_letter(residueTypeToIonLetter_(res_type));
+    const String charge_suffix(charge, '+');
+
+    Peak1D p;
+    p.setIntensity(intensity);
 
     if (res_type == Residue::AIon || res_type == Residue::BIon || res_type == Residue::CIon)
     {
-      if (peptide.hasNTerminalModification())
-      {
-        mono_weight += peptide.getNTerminalModification()->getDiffMonoMass();
-      }
-
       if (!add_isotopes_) // add single peak
       {
-        Size i = add_first_prefix_ion_ ? 0 : 1;
-        if (i == 1) mono_weight += peptide[0].getMonoWeight(Residue::Internal);
-        for (; i < peptide.size() - 1; ++i)
+        Size i = add_first_prefix_ion_ ? 1 : 2;
+        for (; i < n; ++i)
         {
-          mono_weight += peptide[i].getMonoWeight(Residue::Internal); // standard internal residue including named modifications
-          double pos(mono_weight);
-          switch (res_type)
-          {
-          case Residue::AIon: pos = (pos + Residue::getInternalToAIon().getMonoWeight()) / charge; break;
-          case Residue::BIon: pos = (pos + Residue::getInternalToBIon().getMonoWeight()) / charge; break;
-          case Residue::CIon: pos = (pos + Residue::getInternalToCIon().getMonoWeight()) / charge; break;
-          default: break;
-          }
-          Peak1D p;
-          p.setMZ(pos);
-          p.setIntensity(intensity);
+          // prefix_masses[i] contains the first i residues and the N-terminal modification
+          p.setMZ((prefix_masses[i] + charge_offset) / charge);
           spectrum.push_back(p);
           if (add_metainfo_)
           {
-            String ion_name = String(residueTypeToIonLetter_(res_type)) + String(i + 1) + String(charge, '+');
-            ion_names.push_back(ion_name);
+            ion_names.push_back(ion_letter + String(i) + charge_suffix);
             charges.push_back(charge);
           }
         }
@@ -495,7 +516,7 @@ namespace OpenMS
       else // add isotope clusters (slow)
       {
         Size i = add_first_prefix_ion_ ? 1 : 2;
-        for (; i < peptide.size(); ++i)
+        for (; i < n; ++i)
         {
           const AASequence ion = peptide.getPrefix(i);
           addIsotopeCluster_(spectrum, ion, ion_names, charges, res_type, charge, intensity);
@@ -505,7 +526,7 @@ namespace OpenMS
       if (add_losses_) // add loss peaks (slow)
       {
         Size i = add_first_prefix_ion_ ? 1 : 2;
-        for (; i < peptide.size(); ++i)
+        for (; i < n; ++i)
         {
           const AASequence ion = peptide.getPrefix(i);
           addLosses_(spectrum, ion, ion_names, charges, intensity, res_type, charge);
@@ -514,41 +535,29 @@ namespace OpenMS
     }
     else // if (res_type == Residue::XIon || res_type == Residue::YIon || res_type == Residue::ZIon)
     {
-      if (peptide.hasCTerminalModification())
-      {
-        mono_weight += peptide.getCTerminalModification()->getDiffMonoMass();
-      }
-
       if (!add_isotopes_) // add single peak
       {
-        Size i = peptide.size() - 1;
+        double c_term_mod(0.0);
+        if (peptide.hasCTerminalModification())
+        {
+          c_term_mod = peptide.getCTerminalModification()->getDiffMonoMass();
+        }
 
-        for (; i > 0; --i)
+        for (Size i = n - 1; i > 0; --i)
         {
-          mono_weight += peptide[i].getMonoWeight(Residue::Internal); // standard internal residue including named modifications
-          double pos(mono_weight);
-          switch (res_type)
-          {
-          case Residue::XIon: pos = (pos + Residue::getInternalToXIon().getMonoWeight()) / charge; break;
-          case Residue::YIon: pos = (pos + Residue::getInternalToYIon().getMonoWeight()) / charge; break;
-          case Residue::ZIon: pos = (pos + Residue::getInternalToZIon().getMonoWeight()) / charge; break;
-          default: break;
-          }
-          Peak1D p;
-          p.setMZ(pos);
-          p.setIntensity(intensity);
+          // suffix of length n - i: total mass minus the mass of the first i residues
+          p.setMZ((prefix_masses[n] - prefix_masses[i] + c_term_mod + charge_offset) / charge);
           spectrum.push_back(p);
           if (add_metainfo_)
           {
-            String ion_name = String(residueTypeToIonLetter_(res_type)) + String(peptide.size() - i) + String(charge, '+');
-            ion_names.push_back(ion_name);
+            ion_names.push_back(ion_letter + String(n - i) + charge_suffix);
             charges.push_back(charge);
           }
         }
       }
       else // add isotope clusters
       {
-        for (Size i = 1; i < peptide.size(); ++i)
+        for (Size i = 1; i < n; ++i)
         {
           const AASequence ion = peptide.getSuffix(i);
           addIsotopeCluster_(spectrum, ion, ion_names, charges, res_type, charge, intensity);
@@ -557,7 +566,7 @@ namespace OpenMS
 
       if (add_losses_) // add loss peaks (slow)
       {
-        for (Size i = 1; i < peptide.size(); ++i)
+        for (Size i = 1; i < n; ++i)
         {
           const AASequence ion = peptide.getSuffix(i);
           addLosses_(spectrum, ion, ion_names, charges, intensity, res_type, charge);
@@ -4,6 +4,7 @@ set(directory source/CHEMISTRY)
 ### list all filenames of the directory here
 set(sources_list
 AASequence.cpp
+ChemistryDBSnapshot.cpp
 CrossLinksDB.cpp
 Element.cpp
 ElementDB.cpp
@@ -14,6 +15,7 @@ DigestionEnzyme.cpp
 DigestionEnzymeProtein.cpp
 DigestionEnzymeRNA.cpp
 DigestionEnzymeDB.cpp
+LightPeptide.cpp
 ModificationDefinition.cpp
 ModificationDefinitionsSet.cpp
 ModificationsDB.cpp
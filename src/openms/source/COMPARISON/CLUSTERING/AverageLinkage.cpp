@@ -165,4 +165,11 @@ namespace OpenMS
     endProgress();
   }
 
+  void AverageLinkage::clusterSparse(const SparseDistanceGraph & distances, std::vector<BinaryTreeNode> & cluster_tree, const float threshold /*=1*/) const
+  {
+    startProgress(0, 1, "clustering data");
+    agglomerateSparse_(distances, cluster_tree, threshold, SPARSE_AVERAGE);
+    endProgress();
+  }
+
 }
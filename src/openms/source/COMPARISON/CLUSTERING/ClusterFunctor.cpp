@@ -39,6 +39,11 @@
 #include <OpenMS/COMPARISON/CLUSTERING/AverageLinkage.h>
 #include <OpenMS/CONCEPT/Factory.h>
 
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <queue>
+
 using namespace std;
 
 namespace OpenMS
@@ -60,6 +65,179 @@ namespace OpenMS
     return *this;
   }
 
+  void ClusterFunctor::clusterSparse(const SparseDistanceGraph & /* distances */, std::vector<BinaryTreeNode> & /* cluster_tree */, const float /* threshold */) const
+  {
+    throw Exception::NotImplemented(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
+  }
+
+  namespace
+  {
+    // accumulated distances of the element pairs of two clusters that share an edge
+    struct SparseLink
+    {
+      double sum;
+      Size count;
+      float max;
+
+      SparseLink() :
+        sum(0.0), count(0), max(0.0f)
+      {
+      }
+
+      void add(const SparseLink & other)
+      {
+        sum += other.sum;
+        count += other.count;
+        max = std::max(max, other.max);
+      }
+    };
+
+    // distance of two clusters of the given sizes, element pairs without an edge have distance 1
+    float sparseLinkDistance(const SparseLink & link, Size size_a, Size size_b, bool average)
+    {
+      const double pairs = double(size_a) * double(size_b);
+      if (average)
+      {
+        return float((link.sum + (pairs - double(link.count))) / pairs);
+      }
+      return (double(link.count) < pairs) ? std::max(1.0f, link.max) : link.max;
+    }
+
+    // a possible merge of the clusters a and b, only valid as long as neither was merged since
+    struct SparseMergeCandidate
+    {
+      float distance;
+      Size a;
+      Size b;
+      Size version_a;
+      Size version_b;
+
+      bool operator>(const SparseMergeCandidate & rhs) const
+      {
+        if (distance != rhs.distance) return distance > rhs.distance;
+        if (a != rhs.a) return a > rhs.a;
+        return b > rhs.b;
+      }
+    };
+  }
+
+  void ClusterFunctor::agglomerateSparse_(const SparseDistanceGraph & distances, std::vector<BinaryTreeNode> & cluster_tree, const float threshold, SparseLinkage linkage)
+  {
+    const Size n = distances.dimensionsize();
+    // input MUST have >= 2 elements!
+    if (n < 2)
+    {
+      throw ClusterFunctor::InsufficientInput(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Distance graph to start from only contains one element");
+    }
+
+    cluster_tree.clear();
+    cluster_tree.reserve(n - 1);
+
+    // clusters are identified by the index of one of their elements, the
+    // neighbors of a cluster are all clusters it shares at least one edge with
+    typedef std::map<Size, SparseLink> NeighborMap;
+    std::vector<NeighborMap> neighbors(n);
+    for (std::vector<SparseDistanceGraph::Edge>::const_iterator it = distances.getEdges().begin(); it != distances.getEdges().end(); ++it)
+    {
+      SparseLink link;
+      link.sum = it->distance;
+      link.count = 1;
+      link.max = it->distance;
+      neighbors[it->first][it->second].add(link);
+      neighbors[it->second][it->first].add(link);
+    }
+
+    std::vector<Size> cluster_size(n, 1), representative(n), version(n, 0);
+    std::vector<bool> active(n, true);
+    for (Size i = 0; i < n; ++i)
+    {
+      representative[i] = i;
+    }
+
+    const bool average = (linkage == SPARSE_AVERAGE);
+    std::priority_queue<SparseMergeCandidate, std::vector<SparseMergeCandidate>, std::greater<SparseMergeCandidate> > candidates;
+    for (Size i = 0; i < n; ++i)
+    {
+      for (NeighborMap::const_iterator it = neighbors[i].upper_bound(i); it != neighbors[i].end(); ++it)
+      {
+        SparseMergeCandidate candidate;
+        candidate.distance = sparseLinkDistance(it->second, 1, 1, average);
+        candidate.a = i;
+        candidate.b = it->first;
+        candidate.version_a = candidate.version_b = 0;
+        if (candidate.distance < threshold)
+        {
+          candidates.push(candidate);
+        }
+      }
+    }
+
+    while (!candidates.empty())
+    {
+      const SparseMergeCandidate top = candidates.top();
+      candidates.pop();
+      if (!active[top.a] || !active[top.b] || version[top.a] != top.version_a || version[top.b] != top.version_b)
+      {
+        continue; // outdated
+      }
+
+      //grow the tree
+      cluster_tree.push_back(BinaryTreeNode(std::min(representative[top.a], representative[top.b]), std::max(representative[top.a], representative[top.b]), top.distance));
+
+      // the cluster with more neighbors absorbs the other one
+      Size keep = top.a, remove = top.b;
+      if (neighbors[remove].size() > neighbors[keep].size())
+      {
+        std::swap(keep, remove);
+      }
+      active[remove] = false;
+      cluster_size[keep] += cluster_size[remove];
+      representative[keep] = cluster_tree.back().left_child;
+      ++version[keep];
+
+      neighbors[keep].erase(remove);
+      for (NeighborMap::const_iterator it = neighbors[remove].begin(); it != neighbors[remove].end(); ++it)
+      {
+        if (it->first == keep) continue;
+        neighbors[keep][it->first].add(it->second);
+        neighbors[it->first].erase(remove);
+      }
+      NeighborMap().swap(neighbors[remove]);
+
+      // the size of the merged cluster changed, so did all its distances
+      for (NeighborMap::const_iterator it = neighbors[keep].begin(); it != neighbors[keep].end(); ++it)
+      {
+        neighbors[it->first][keep] = it->second;
+        SparseMergeCandidate candidate;
+        candidate.distance = sparseLinkDistance(it->second, cluster_size[keep], cluster_size[it->first], average);
+        candidate.a = keep;
+        candidate.b = it->first;
+        candidate.version_a = version[keep];
+        candidate.version_b = version[it->first];
+        if (candidate.distance < threshold)
+        {
+          candidates.push(candidate);
+        }
+      }
+    }
+
+    std::vector<Size> representatives;
+    for (Size i = 0; i < n; ++i)
+    {
+      if (active[i]) representatives.push_back(representative[i]);
+    }
+    fillDummyNodes_(representatives, n, cluster_tree);
+  }
+
+  void ClusterFunctor::fillDummyNodes_(std::vector<Size> representatives, Size n, std::vector<BinaryTreeNode> & cluster_tree)
+  {
+    std::sort(representatives.begin(), representatives.end());
+    for (Size i = 1; i < representatives.size() && cluster_tree.size() + 1 < n; ++i)
+    {
+      cluster_tree.push_back(BinaryTreeNode(representatives.front(), representatives[i], -1.0));
+    }
+  }
+
   void ClusterFunctor::registerChildren()
   {
     Factory<ClusterFunctor>::registerProduct(SingleLinkage::getProductName(), &SingleLinkage::create);
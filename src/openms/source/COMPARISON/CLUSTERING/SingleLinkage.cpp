@@ -201,4 +201,66 @@ namespace OpenMS
     endProgress();
   }
 
+  void SingleLinkage::clusterSparse(const SparseDistanceGraph & distances, std::vector<BinaryTreeNode> & cluster_tree, const float threshold /*=1*/) const
+  {
+    const Size n = distances.dimensionsize();
+    // input MUST have >= 2 elements!
+    if (n < 2)
+    {
+      throw ClusterFunctor::InsufficientInput(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Distance graph to start from only contains one element");
+    }
+
+    cluster_tree.clear();
+    cluster_tree.reserve(n - 1);
+
+    // Kruskal: the edges of the minimum spanning forest in order of ascending distance are the single linkage merges
+    std::vector<SparseDistanceGraph::Edge> edges(distances.getEdges());
+    std::sort(edges.begin(), edges.end());
+
+    // union-find, the root of each cluster is its lowest element index
+    std::vector<Size> parent(n);
+    for (Size i = 0; i < n; ++i)
+    {
+      parent[i] = i;
+    }
+
+    startProgress(0, n - 1, "clustering data");
+    for (std::vector<SparseDistanceGraph::Edge>::const_iterator it = edges.begin(); it != edges.end() && cluster_tree.size() + 1 < n; ++it)
+    {
+      if (it->distance >= threshold)
+      {
+        break;
+      }
+      Size a = it->first, b = it->second;
+      while (parent[a] != a)
+      {
+        a = parent[a] = parent[parent[a]];
+      }
+      while (parent[b] != b)
+      {
+        b = parent[b] = parent[parent[b]];
+      }
+      if (a == b)
+      {
+        continue;
+      }
+      if (b < a)
+      {
+        std::swap(a, b);
+      }
+      parent[b] = a;
+      cluster_tree.push_back(BinaryTreeNode(a, b, it->distance));
+      setProgress(cluster_tree.size());
+    }
+
+    std::vector<Size> representatives;
+    for (Size i = 0; i < n; ++i)
+    {
+      if (parent[i] == i) representatives.push_back(i);
+    }
+    fillDummyNodes_(representatives, n, cluster_tree);
+
+    endProgress();
+  }
+
 }
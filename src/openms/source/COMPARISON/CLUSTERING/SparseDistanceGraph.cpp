@@ -0,0 +1,118 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+//
+
+#include <OpenMS/COMPARISON/CLUSTERING/SparseDistanceGraph.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+
+#include <algorithm>
+
+namespace OpenMS
+{
+  SparseDistanceGraph::Edge::Edge(Size i, Size j, float d) :
+    first(std::min(i, j)),
+    second(std::max(i, j)),
+    distance(d)
+  {
+  }
+
+  bool SparseDistanceGraph::Edge::operator<(const Edge& rhs) const
+  {
+    if (distance != rhs.distance)
+    {
+      return distance < rhs.distance;
+    }
+    if (first != rhs.first)
+    {
+      return first < rhs.first;
+    }
+    return second < rhs.second;
+  }
+
+  SparseDistanceGraph::SparseDistanceGraph(Size dimensionsize) :
+    dimensionsize_(dimensionsize),
+    edges_()
+  {
+  }
+
+  SparseDistanceGraph::~SparseDistanceGraph()
+  {
+  }
+
+  Size SparseDistanceGraph::dimensionsize() const
+  {
+    return dimensionsize_;
+  }
+
+  Size SparseDistanceGraph::edgeCount() const
+  {
+    return edges_.size();
+  }
+
+  void SparseDistanceGraph::clear(Size dimensionsize)
+  {
+    dimensionsize_ = dimensionsize;
+    std::vector<Edge>().swap(edges_);
+  }
+
+  void SparseDistanceGraph::addEdge(Size i, Size j, float distance)
+  {
+    if (i >= dimensionsize_ || j >= dimensionsize_)
+    {
+      throw Exception::IndexOverflow(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, std::max(i, j), dimensionsize_);
+    }
+    if (i == j)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "An element cannot have a distance to itself.");
+    }
+    edges_.push_back(Edge(i, j, distance));
+  }
+
+  void SparseDistanceGraph::addEdges(const std::vector<Edge>& edges)
+  {
+    edges_.insert(edges_.end(), edges.begin(), edges.end());
+  }
+
+  const std::vector<SparseDistanceGraph::Edge>& SparseDistanceGraph::getEdges() const
+  {
+    return edges_;
+  }
+
+  void SparseDistanceGraph::sortEdges()
+  {
+    std::sort(edges_.begin(), edges_.end());
+  }
+
+}
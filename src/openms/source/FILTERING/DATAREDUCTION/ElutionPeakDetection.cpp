@@ -35,6 +35,7 @@
 
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
 #include <OpenMS/FILTERING/DATAREDUCTION/ElutionPeakDetection.h>
+#include <OpenMS/SYSTEM/Profiler.h>
 #include <OpenMS/FILTERING/SMOOTHING/SavitzkyGolayFilter.h>
 #include <OpenMS/MATH/STATISTICS/StatisticFunctions.h>
 
@@ -327,6 +328,7 @@ namespace OpenMS
 
   void ElutionPeakDetection::detectPeaks(std::vector<MassTrace>& mt_vec, std::vector<MassTrace>& single_mtraces)
   {
+    OPENMS_PROFILE_PHASE("ElutionPeakDetection");
     // make sure that single_mtraces is empty
     single_mtraces.clear();
 
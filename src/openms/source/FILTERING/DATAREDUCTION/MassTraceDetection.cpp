@@ -33,6 +33,7 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/FILTERING/DATAREDUCTION/MassTraceDetection.h>
+#include <OpenMS/SYSTEM/Profiler.h>
 
 #include <OpenMS/MATH/STATISTICS/StatisticFunctions.h>
 
@@ -189,6 +190,7 @@ namespace OpenMS
 
   void MassTraceDetection::run(const PeakMap& input_exp, std::vector<MassTrace>& found_masstraces)
   {
+    OPENMS_PROFILE_PHASE("MassTraceDetection");
     // make sure the output vector is empty
     found_masstraces.clear();
 
@@ -34,6 +34,10 @@
 
 #include <OpenMS/FILTERING/SMOOTHING/GaussFilter.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace OpenMS
 {
 
@@ -54,6 +58,141 @@ namespace OpenMS
   {
   }
 
+  void GaussFilter::filterExperiment(PeakMap& map)
+  {
+    const Size n_spectra = map.size();
+    const Size n_chromatograms = map.getChromatograms().size();
+    if (n_chromatograms > 0)
+    {
+      checkChromatogramParameters_();
+    }
+
+    Size progress = 0;
+    startProgress(0, n_spectra + n_chromatograms, "smoothing data");
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      // the kernel is recomputed for each data point in ppm mode: one copy per thread
+      GaussFilterAlgorithm gauss_algo(gauss_algo_);
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)(n_spectra + n_chromatograms); ++i)
+      {
+        if (i < (SignedSize)n_spectra)
+        {
+          filter_(map[i], gauss_algo);
+        }
+        else
+        {
+          filter_(map.getChromatogram(i - n_spectra), gauss_algo);
+        }
+
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+        ++progress;
+
+        IF_MASTERTHREAD
+        {
+          setProgress(progress);
+        }
+      }
+    }
+    endProgress();
+  }
+
+  void GaussFilter::checkChromatogramParameters_() const
+  {
+    if (param_.getValue("use_ppm_tolerance").toBool())
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
+        "GaussFilter: Cannot use ppm tolerance on chromatograms");
+    }
+  }
+
+  void GaussFilter::filter_(MSSpectrum& spectrum, GaussFilterAlgorithm& gauss_algo) const
+  {
+    // make sure the right data type is set
+    spectrum.setType(SpectrumSettings::PROFILE);
+    const Size data_size = spectrum.size();
+    std::vector<double> mz_in(data_size), int_in(data_size), int_out;
+
+    // copy spectrum to container
+    for (Size p = 0; p < data_size; ++p)
+    {
+      mz_in[p] = spectrum[p].getMZ();
+      int_in[p] = static_cast<double>(spectrum[p].getIntensity());
+    }
+
+    // apply filter
+    bool found_signal = gauss_algo.filter(mz_in, int_in, int_out);
+
+    // If all intensities are zero in the scan and the scan has a reasonable size, throw an exception.
+    // This is the case if the Gaussian filter is smaller than the spacing of raw data
+    if (!found_signal && data_size >= 3)
+    {
+      String error_message = "Found no signal. The Gaussian width is probably smaller than the spacing in your profile data. Try to use a bigger width.";
+      if (spectrum.getRT() > 0.0)
+      {
+        error_message += String(" The error occurred in the spectrum with retention time ") + spectrum.getRT() + ".";
+      }
+#ifdef _OPENMP
+#pragma omp critical (GaussFilter_log)
+#endif
+      LOG_ERROR << error_message << std::endl;
+    }
+    else
+    {
+      // copy the new data into the spectrum
+      for (Size p = 0; p < data_size; ++p)
+      {
+        spectrum[p].setIntensity(int_out[p]);
+      }
+    }
+  }
+
+  void GaussFilter::filter_(MSChromatogram& chromatogram, GaussFilterAlgorithm& gauss_algo) const
+  {
+    const Size data_size = chromatogram.size();
+    std::vector<double> rt_in(data_size), int_in(data_size), int_out;
+
+    // copy chromatogram to container
+    for (Size p = 0; p < data_size; ++p)
+    {
+      rt_in[p] = chromatogram[p].getRT();
+      int_in[p] = chromatogram[p].getIntensity();
+    }
+
+    // apply filter
+    bool found_signal = gauss_algo.filter(rt_in, int_in, int_out);
+
+    // If all intensities are zero in the scan and the scan has a reasonable size, throw an exception.
+    // This is the case if the Gaussian filter is smaller than the spacing of raw data
+    if (!found_signal && data_size >= 3)
+    {
+      String error_message = "Found no signal. The Gaussian width is probably smaller than the spacing in your chromatogram data. Try to use a bigger width.";
+      if (chromatogram.getMZ() > 0.0)
+      {
+        error_message += String(" The error occurred in the chromatogram with m/z time ") + chromatogram.getMZ() + ".";
+      }
+#ifdef _OPENMP
+#pragma omp critical (GaussFilter_log)
+#endif
+      LOG_ERROR << error_message << std::endl;
+    }
+    else
+    {
+      // copy the new data into the chromatogram
+      for (Size p = 0; p < data_size; ++p)
+      {
+        chromatogram[p].setIntensity(int_out[p]);
+      }
+    }
+  }
+
   void GaussFilter::updateMembers_()
   {
     gauss_algo_.initialize((double)param_.getValue("gaussian_width"), spacing_,
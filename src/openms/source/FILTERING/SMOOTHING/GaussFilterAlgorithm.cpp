@@ -51,6 +51,96 @@ namespace OpenMS
   {
   }
 
+  bool GaussFilterAlgorithm::filter(const std::vector<double>& mz, const std::vector<double>& intensity, std::vector<double>& intensity_out)
+  {
+    const Size n = mz.size();
+    intensity_out.resize(n);
+
+    bool found_signal = false;
+    std::vector<double> weights; // kernel values of the data points in the window
+    for (Size i = 0; i < n; ++i)
+    {
+      // if ppm tolerance is used, calculate a reasonable width value for this m/z
+      if (use_ppm_tolerance_)
+      {
+        initialize(mz[i] * ppm_tolerance_ * 10e-6, spacing_, ppm_tolerance_, use_ppm_tolerance_);
+      }
+
+      // window of data points inside the kernel
+      const Size middle = coeffs_.size();
+      const double start_pos = ((mz[i] - (middle * spacing_)) > mz[0]) ? (mz[i] - (middle * spacing_)) : mz[0];
+      const double end_pos = ((mz[i] + (middle * spacing_)) < mz[n - 1]) ? (mz[i] + (middle * spacing_)) : mz[n - 1];
+      Size first = i;
+      while (first > 0 && mz[first - 1] > start_pos)
+      {
+        --first;
+      }
+      Size last = i;
+      while (last + 1 < n && mz[last + 1] < end_pos)
+      {
+        ++last;
+      }
+
+      weights.resize(last - first + 1);
+      for (Size k = first; k <= last; ++k)
+      {
+        weights[k - first] = interpolateCoefficient_(fabs(mz[i] - mz[k]), middle);
+      }
+
+      // integrate (trapezoidal rule) from the middle to the start and from the middle to the end
+      double v = 0.;
+      double norm = 0.; // norm the gaussian kernel area to one
+      for (Size k = i; k > first; --k)
+      {
+        const double w_left = weights[k - 1 - first];
+        const double w_right = weights[k - first];
+        norm += fabs(mz[k - 1] - mz[k]) / 2. * (w_left + w_right);
+        v += fabs(mz[k - 1] - mz[k]) / 2. * (intensity[k - 1] * w_left + intensity[k] * w_right);
+      }
+      for (Size k = i; k < last; ++k)
+      {
+        const double w_left = weights[k - first];
+        const double w_right = weights[k + 1 - first];
+        norm += fabs(mz[k] - mz[k + 1]) / 2. * (w_left + w_right);
+        v += fabs(mz[k] - mz[k + 1]) / 2. * (intensity[k] * w_left + intensity[k + 1] * w_right);
+      }
+
+      const double new_int = (v > 0) ? v / norm : 0;
+      intensity_out[i] = new_int;
+      if (fabs(new_int) > 0) found_signal = true;
+    }
+    return found_signal;
+  }
+
+  double GaussFilterAlgorithm::interpolateCoefficient_(double distance, Size middle) const
+  {
+    // search for the corresponding data point in the gaussian (take the left most adjacent point)
+    SignedSize left_position = (SignedSize)floor(distance / spacing_);
+
+    // search for the true left adjacent data point (because of rounding errors)
+    for (SignedSize j = 0; j < 3; ++j)
+    {
+      if (((left_position - j) * spacing_ <= distance) && ((left_position - j + 1) * spacing_ >= distance))
+      {
+        left_position -= j;
+        break;
+      }
+
+      if (((left_position + j) * spacing_ < distance) && ((left_position + j + 1) * spacing_ < distance))
+      {
+        left_position += j;
+        break;
+      }
+    }
+
+    // interpolate between the left and right data points in the gaussian to get the true value at position distance
+    Size right_position = left_position + 1;
+    double d = fabs((left_position * spacing_) - distance) / spacing_;
+    // check if the right data point in the gaussian exists
+    return (right_position < middle) ? (1 - d) * coeffs_[left_position] + d * coeffs_[right_position]
+                                     : coeffs_[left_position];
+  }
+
   void GaussFilterAlgorithm::initialize(double gaussian_width, double spacing, double ppm_tolerance, bool use_ppm_tolerance)
   {
     spacing_ = spacing;
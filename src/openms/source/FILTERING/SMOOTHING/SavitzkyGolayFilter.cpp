@@ -38,6 +38,12 @@
 #include <Eigen/Core>
 #include <Eigen/SVD>
 
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace OpenMS
 {
   SavitzkyGolayFilter::SavitzkyGolayFilter() :
@@ -55,6 +61,98 @@ namespace OpenMS
   {
   }
 
+  void SavitzkyGolayFilter::filterExperiment(PeakMap& map)
+  {
+    const Size n_spectra = map.size();
+    const Size n_chromatograms = map.getChromatograms().size();
+
+    Size progress = 0;
+    startProgress(0, n_spectra + n_chromatograms, "smoothing data");
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)(n_spectra + n_chromatograms); ++i)
+    {
+      if (i < (SignedSize)n_spectra)
+      {
+        filter(map[i]);
+      }
+      else
+      {
+        filter(map.getChromatogram(i - n_spectra));
+      }
+
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+      ++progress;
+
+      IF_MASTERTHREAD
+      {
+        setProgress(progress);
+      }
+    }
+    endProgress();
+  }
+
+  void SavitzkyGolayFilter::smoothIntensities(const double* in, double* out, Size n) const
+  {
+    if (frame_size_ > n) { return; }
+
+    const Size mid = frame_size_ / 2;
+
+    // compute the transient on
+    for (Size i = 0; i <= mid; ++i)
+    {
+      const double* coeffs = &coeffs_[(i + 1) * frame_size_ - 1];
+      double help = 0;
+      for (Size j = 0; j < frame_size_; ++j)
+      {
+        help += in[j] * *(coeffs - j);
+      }
+      out[i] = std::max(0.0, help);
+    }
+
+    // compute the steady state output: all positions of a block are
+    // convolved at once (the sum of each position is accumulated in the
+    // same order as in the iterator version)
+    const double* coeffs = &coeffs_[mid * frame_size_];
+    const Size block_size = 256;
+    for (Size block_begin = mid + 1; block_begin < n - mid; block_begin += block_size)
+    {
+      const Size block_end = std::min(block_begin + block_size, n - mid);
+      double* block_out = out + block_begin;
+      const Size length = block_end - block_begin;
+      std::fill(block_out, block_out + length, 0.0);
+      for (Size j = 0; j < frame_size_; ++j)
+      {
+        const double coeff = coeffs[j];
+        const double* block_in = in + block_begin - mid + j;
+        for (Size k = 0; k < length; ++k)
+        {
+          block_out[k] += block_in[k] * coeff;
+        }
+      }
+      for (Size k = 0; k < length; ++k)
+      {
+        block_out[k] = std::max(0.0, block_out[k]);
+      }
+    }
+
+    // compute the transient off
+    const double* last_frame = in + n - frame_size_;
+    for (Size i = 0; i < mid; ++i)
+    {
+      const double* coeffs = &coeffs_[i * frame_size_];
+      double help = 0;
+      for (Size j = 0; j < frame_size_; ++j)
+      {
+        help += last_frame[j] * coeffs[j];
+      }
+      out[n - 1 - i] = std::max(0.0, help);
+    }
+  }
+
   void SavitzkyGolayFilter::updateMembers_()
   {
     frame_size_ = (UInt)param_.getValue("frame_length");
@@ -0,0 +1,137 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataPickingConsumer.h>
+
+#include <OpenMS/CONCEPT/LogStream.h>
+
+namespace OpenMS
+{
+
+  MSDataPickingConsumer::MSDataPickingConsumer(Interfaces::IMSDataConsumer* next_consumer, const PeakPickerHiRes& picker, Size batch_size, bool check_spectrum_type) :
+    next_consumer_(next_consumer),
+    picker_(picker),
+    batch_size_(std::max(batch_size, Size(1))),
+    check_spectrum_type_(check_spectrum_type)
+  {
+    // progress is reported by the reader, not per batch
+    picker_.setLogType(ProgressLogger::NONE);
+  }
+
+  MSDataPickingConsumer::~MSDataPickingConsumer()
+  {
+    // destructors must not throw - errors are only reported by an explicit flush()
+    try
+    {
+      flush();
+    }
+    catch (std::exception& e)
+    {
+      LOG_ERROR << "MSDataPickingConsumer: error while flushing remaining data: " << e.what() << std::endl;
+    }
+    catch (...)
+    {
+      LOG_ERROR << "MSDataPickingConsumer: unknown error while flushing remaining data" << std::endl;
+    }
+  }
+
+  void MSDataPickingConsumer::setExpectedSize(Size expectedSpectra, Size expectedChromatograms)
+  {
+    next_consumer_->setExpectedSize(expectedSpectra, expectedChromatograms);
+  }
+
+  void MSDataPickingConsumer::setExperimentalSettings(const ExperimentalSettings& exp)
+  {
+    next_consumer_->setExperimentalSettings(exp);
+  }
+
+  void MSDataPickingConsumer::consumeSpectrum(SpectrumType& s)
+  {
+    // keep the order of spectra and chromatograms
+    flushChromatograms_();
+
+    // throws for centroided spectra that are selected for picking (here, not in the parallel section)
+    picker_.isSelectedForPicking(s, check_spectrum_type_);
+
+    spectra_.push_back(s);
+    if (spectra_.size() >= batch_size_)
+    {
+      flushSpectra_();
+    }
+  }
+
+  void MSDataPickingConsumer::consumeChromatogram(ChromatogramType& c)
+  {
+    // keep the order of spectra and chromatograms
+    flushSpectra_();
+
+    chromatograms_.push_back(c);
+    if (chromatograms_.size() >= batch_size_)
+    {
+      flushChromatograms_();
+    }
+  }
+
+  void MSDataPickingConsumer::flush()
+  {
+    flushSpectra_();
+    flushChromatograms_();
+  }
+
+  void MSDataPickingConsumer::flushSpectra_()
+  {
+    if (spectra_.empty()) return;
+
+    // spectrum types were checked in consumeSpectrum()
+    picker_.pickSpectra(spectra_, false);
+    for (SpectrumType& s : spectra_)
+    {
+      next_consumer_->consumeSpectrum(s);
+    }
+    spectra_.clear();
+  }
+
+  void MSDataPickingConsumer::flushChromatograms_()
+  {
+    if (chromatograms_.empty()) return;
+
+    picker_.pickChromatograms(chromatograms_);
+    for (ChromatogramType& c : chromatograms_)
+    {
+      next_consumer_->consumeChromatogram(c);
+    }
+    chromatograms_.clear();
+  }
+
+} // namespace OpenMS
+
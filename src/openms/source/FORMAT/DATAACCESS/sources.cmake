@@ -9,6 +9,7 @@ set(sources_list
   MSDataAggregatingConsumer.cpp
   MSDataCachedConsumer.cpp
   MSDataChainingConsumer.cpp
+  MSDataPickingConsumer.cpp
   MSDataStoringConsumer.cpp
   MSDataSqlConsumer.cpp
   MSDataTransformingConsumer.cpp
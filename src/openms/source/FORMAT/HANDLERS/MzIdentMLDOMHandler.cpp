@@ -189,7 +189,7 @@ namespace OpenMS
         xercesc::DOMDocument* xmlDoc = mzid_parser_.getDocument();
 
         // Catch special case: Cross-Linking MS
-        DOMNodeList* additionalSearchParams = xmlDoc->getElementsByTagName(XMLString::transcode("AdditionalSearchParams"));
+        DOMNodeList* additionalSearchParams = xmlDoc->getElementsByTagName(sm_.convert("AdditionalSearchParams").c_str());
         const  XMLSize_t as_node_count = additionalSearchParams->getLength();
 
         for (XMLSize_t i = 0; i < as_node_count; ++i)
@@ -197,12 +197,12 @@ namespace OpenMS
           DOMNode* current_sp = additionalSearchParams->item(i);
 
           DOMElement* element_SearchParams = dynamic_cast<xercesc::DOMElement*>(current_sp);
-          String cross_linking_search = XMLString::transcode(element_SearchParams->getAttribute(XMLString::transcode("id")));
+          String cross_linking_search = sm_.convert(element_SearchParams->getAttribute(sm_.convert("id").c_str()));
           DOMElement* child = element_SearchParams->getFirstElementChild();
 
           while (child && !xl_ms_search_)
           {
-            String accession = XMLString::transcode(child->getAttribute(XMLString::transcode("accession")));
+            String accession = sm_.convert(child->getAttribute(sm_.convert("accession").c_str()));
             if (accession == "MS:1002494") // accession for "cross-linking search"
             {
               xl_ms_search_ = true;
@@ -217,40 +217,40 @@ namespace OpenMS
         }
 
         // 0. AnalysisSoftwareList {0,1}
-        DOMNodeList* analysisSoftwareElements = xmlDoc->getElementsByTagName(XMLString::transcode("AnalysisSoftware"));
+        DOMNodeList* analysisSoftwareElements = xmlDoc->getElementsByTagName(sm_.convert("AnalysisSoftware").c_str());
         parseAnalysisSoftwareList_(analysisSoftwareElements);
 
         // 1. DataCollection {1,1}
-        DOMNodeList* spectraDataElements = xmlDoc->getElementsByTagName(XMLString::transcode("SpectraData"));
+        DOMNodeList* spectraDataElements = xmlDoc->getElementsByTagName(sm_.convert("SpectraData").c_str());
         if (spectraDataElements->getLength() == 0) throw(runtime_error("No SpectraData nodes"));
         parseInputElements_(spectraDataElements);
 
         // 1.2. SearchDatabase {0,unbounded}
-        DOMNodeList* searchDatabaseElements = xmlDoc->getElementsByTagName(XMLString::transcode("SearchDatabase"));
+        DOMNodeList* searchDatabaseElements = xmlDoc->getElementsByTagName(sm_.convert("SearchDatabase").c_str());
         parseInputElements_(searchDatabaseElements);
 
         // 1.1 SourceFile {0,unbounded}
-        DOMNodeList* sourceFileElements = xmlDoc->getElementsByTagName(XMLString::transcode("SourceFile"));
+        DOMNodeList* sourceFileElements = xmlDoc->getElementsByTagName(sm_.convert("SourceFile").c_str());
         parseInputElements_(sourceFileElements);
 
         // 2. SpectrumIdentification  {1,unbounded} ! creates identification runs (or ProteinIdentifications)
-        DOMNodeList* spectrumIdentificationElements = xmlDoc->getElementsByTagName(XMLString::transcode("SpectrumIdentification"));
+        DOMNodeList* spectrumIdentificationElements = xmlDoc->getElementsByTagName(sm_.convert("SpectrumIdentification").c_str());
         if (spectrumIdentificationElements->getLength() == 0) throw(runtime_error("No SpectrumIdentification nodes"));
         parseSpectrumIdentificationElements_(spectrumIdentificationElements);
 
         // 3. AnalysisProtocolCollection {1,1} SpectrumIdentificationProtocol  {1,unbounded} ! identification run parameters
-        DOMNodeList* spectrumIdentificationProtocolElements = xmlDoc->getElementsByTagName(XMLString::transcode("SpectrumIdentificationProtocol"));
+        DOMNodeList* spectrumIdentificationProtocolElements = xmlDoc->getElementsByTagName(sm_.convert("SpectrumIdentificationProtocol").c_str());
         if (spectrumIdentificationProtocolElements->getLength() == 0) throw(runtime_error("No SpectrumIdentificationProtocol nodes"));
         parseSpectrumIdentificationProtocolElements_(spectrumIdentificationProtocolElements);
 
         // 4. SequenceCollection nodes {0,1} DBSequenceElement {1,unbounded} Peptide {0,unbounded} PeptideEvidence {0,unbounded}
-        DOMNodeList* dbSequenceElements = xmlDoc->getElementsByTagName(XMLString::transcode("DBSequence"));
+        DOMNodeList* dbSequenceElements = xmlDoc->getElementsByTagName(sm_.convert("DBSequence").c_str());
         parseDBSequenceElements_(dbSequenceElements);
 
-        DOMNodeList* peptideElements = xmlDoc->getElementsByTagName(XMLString::transcode("Peptide"));
+        DOMNodeList* peptideElements = xmlDoc->getElementsByTagName(sm_.convert("Peptide").c_str());
         parsePeptideElements_(peptideElements);
 
-        DOMNodeList* peptideEvidenceElements = xmlDoc->getElementsByTagName(XMLString::transcode("PeptideEvidence"));
+        DOMNodeList* peptideEvidenceElements = xmlDoc->getElementsByTagName(sm_.convert("PeptideEvidence").c_str());
         parsePeptideEvidenceElements_(peptideEvidenceElements);
 //          mzid_parser_.resetDocumentPool(); //segfault prone: do not use!
 
@@ -259,12 +259,12 @@ namespace OpenMS
         // 6. AnalysisCollection {1,1} - build final structures PeptideIdentification (and hits)
 
         // 6.1 SpectrumIdentificationList {0,1}
-        DOMNodeList* spectrumIdentificationListElements = xmlDoc->getElementsByTagName(XMLString::transcode("SpectrumIdentificationList"));
+        DOMNodeList* spectrumIdentificationListElements = xmlDoc->getElementsByTagName(sm_.convert("SpectrumIdentificationList").c_str());
         if (spectrumIdentificationListElements->getLength() == 0) throw(runtime_error("No SpectrumIdentificationList nodes"));
         parseSpectrumIdentificationListElements_(spectrumIdentificationListElements);
 
         // 6.2 ProteinDetection {0,1}
-        DOMNodeList* parseProteinDetectionListElements = xmlDoc->getElementsByTagName(XMLString::transcode("ProteinDetectionList"));
+        DOMNodeList* parseProteinDetectionListElements = xmlDoc->getElementsByTagName(sm_.convert("ProteinDetectionList").c_str());
         parseProteinDetectionListElements_(parseProteinDetectionListElements);
 
         for (vector<ProteinIdentification>::iterator it = pro_id_->begin(); it != pro_id_->end(); ++it)
@@ -471,23 +471,23 @@ namespace OpenMS
             current_cv->getNodeType() == DOMNode::ELEMENT_NODE) // is element - possibly not necessary after getElementsByTagName
         {
           DOMElement* element_param = dynamic_cast<xercesc::DOMElement*>(current_cv);
-          if ((std::string)XMLString::transcode(element_param->getTagName()) == "cvParam")
+          if ((std::string)sm_.convert(element_param->getTagName()) == "cvParam")
           {
             ret_cv.addCVTerm(parseCvParam_(element_param));
           }
-          else if ((std::string)XMLString::transcode(element_param->getTagName()) == "userParam")
+          else if ((std::string)sm_.convert(element_param->getTagName()) == "userParam")
           {
             ret_up.insert(parseUserParam_(element_param));
           }
-          else if ((std::string)XMLString::transcode(element_param->getTagName()) == "PeptideEvidence"
-                  || (std::string)XMLString::transcode(element_param->getTagName()) == "PeptideEvidenceRef"
-                  || (std::string)XMLString::transcode(element_param->getTagName()) == "SpectrumIdentificationItem")
+          else if ((std::string)sm_.convert(element_param->getTagName()) == "PeptideEvidence"
+                  || (std::string)sm_.convert(element_param->getTagName()) == "PeptideEvidenceRef"
+                  || (std::string)sm_.convert(element_param->getTagName()) == "SpectrumIdentificationItem")
           {
             //here it's okay to do nothing
           }
           else
           {
-            LOG_WARN << "Misplaced elements ignored in 'ParamGroup' in " << (std::string)XMLString::transcode(element_param->getTagName()) << endl;
+            LOG_WARN << "Misplaced elements ignored in 'ParamGroup' in " << (std::string)sm_.convert(element_param->getTagName()) << endl;
           }
         }
       }
@@ -499,14 +499,14 @@ namespace OpenMS
       if (param)
       {
         //      <cvParam accession="MS:1001469" name="taxonomy: scientific name" cvRef="PSI-MS"  value="Drosophila melanogaster"/>
-        String accession = XMLString::transcode(param->getAttribute(XMLString::transcode("accession")));
-        String name = XMLString::transcode(param->getAttribute(XMLString::transcode("name")));
-        String cvRef = XMLString::transcode(param->getAttribute(XMLString::transcode("cvRef")));
-        String value = XMLString::transcode(param->getAttribute(XMLString::transcode("value")));
+        String accession = sm_.convert(param->getAttribute(sm_.convert("accession").c_str()));
+        String name = sm_.convert(param->getAttribute(sm_.convert("name").c_str()));
+        String cvRef = sm_.convert(param->getAttribute(sm_.convert("cvRef").c_str()));
+        String value = sm_.convert(param->getAttribute(sm_.convert("value").c_str()));
 
-        String unitAcc = XMLString::transcode(param->getAttribute(XMLString::transcode("unitAccession")));
-        String unitName = XMLString::transcode(param->getAttribute(XMLString::transcode("unitName")));
-        String unitCvRef = XMLString::transcode(param->getAttribute(XMLString::transcode("unitCvRef")));
+        String unitAcc = sm_.convert(param->getAttribute(sm_.convert("unitAccession").c_str()));
+        String unitName = sm_.convert(param->getAttribute(sm_.convert("unitName").c_str()));
+        String unitCvRef = sm_.convert(param->getAttribute(sm_.convert("unitCvRef").c_str()));
 
         CVTerm::Unit u; // TODO @mths : make DataValue usage safe!
         if (!unitAcc.empty() && !unitName.empty())
@@ -532,12 +532,12 @@ namespace OpenMS
       if (param)
       {
         //      <userParam name="Mascot User Comment" value="Example Mascot MS-MS search for PSI mzIdentML"/>
-        String name = XMLString::transcode(param->getAttribute(XMLString::transcode("name")));
-        String value = XMLString::transcode(param->getAttribute(XMLString::transcode("value")));
-        String unitAcc = XMLString::transcode(param->getAttribute(XMLString::transcode("unitAccession")));
-        String unitName = XMLString::transcode(param->getAttribute(XMLString::transcode("unitName")));
-        String unitCvRef = XMLString::transcode(param->getAttribute(XMLString::transcode("unitCvRef")));
-        String type = XMLString::transcode(param->getAttribute(XMLString::transcode("type")));
+        String name = sm_.convert(param->getAttribute(sm_.convert("name").c_str()));
+        String value = sm_.convert(param->getAttribute(sm_.convert("value").c_str()));
+        String unitAcc = sm_.convert(param->getAttribute(sm_.convert("unitAccession").c_str()));
+        String unitName = sm_.convert(param->getAttribute(sm_.convert("unitName").c_str()));
+        String unitCvRef = sm_.convert(param->getAttribute(sm_.convert("unitCvRef").c_str()));
+        String type = sm_.convert(param->getAttribute(sm_.convert("type").c_str()));
         DataValue dv;
         dv.setUnit(unitAcc + ":" + unitName);
         if (type == "xsd:float" || type == "xsd:double")
@@ -586,17 +586,17 @@ namespace OpenMS
         {
           // Found element node: re-cast as element
           DOMElement* element_AnalysisSoftware = dynamic_cast<xercesc::DOMElement*>(current_as);
-          String id = XMLString::transcode(element_AnalysisSoftware->getAttribute(XMLString::transcode("id")));
+          String id = sm_.convert(element_AnalysisSoftware->getAttribute(sm_.convert("id").c_str()));
           DOMElement* child = element_AnalysisSoftware->getFirstElementChild();
           String swname, swversion;
           while (child)
           {
-            if ((std::string)XMLString::transcode(child->getTagName()) == "SoftwareName") //must have exactly one SoftwareName
+            if ((std::string)sm_.convert(child->getTagName()) == "SoftwareName") //must have exactly one SoftwareName
             {
               DOMNodeList* element_pg = child->getChildNodes();
 
               pair<CVTermList, map<String, DataValue> > swn = parseParamGroup_(element_pg);
-              swversion = XMLString::transcode(element_AnalysisSoftware->getAttribute(XMLString::transcode("version")));
+              swversion = sm_.convert(element_AnalysisSoftware->getAttribute(sm_.convert("version").c_str()));
               if (!swn.first.getCVTerms().empty())
               {
                 set<String> software_terms;
@@ -652,20 +652,20 @@ namespace OpenMS
         {
           // Found element node: re-cast as element
           DOMElement* element_dbs = dynamic_cast<xercesc::DOMElement*>(current_dbs);
-          String id = XMLString::transcode(element_dbs->getAttribute(XMLString::transcode("id")));
+          String id = sm_.convert(element_dbs->getAttribute(sm_.convert("id").c_str()));
           String seq = "";
-          String dbref = XMLString::transcode(element_dbs->getAttribute(XMLString::transcode("searchDatabase_ref")));
-          String acc = XMLString::transcode(element_dbs->getAttribute(XMLString::transcode("accession")));
+          String dbref = sm_.convert(element_dbs->getAttribute(sm_.convert("searchDatabase_ref").c_str()));
+          String acc = sm_.convert(element_dbs->getAttribute(sm_.convert("accession").c_str()));
           CVTermList cvs;
 
           DOMElement* child = element_dbs->getFirstElementChild();
           while (child)
           {
-            if ((std::string)XMLString::transcode(child->getTagName()) == "Seq")
+            if ((std::string)sm_.convert(child->getTagName()) == "Seq")
             {
-              seq = (std::string)XMLString::transcode(child->getTextContent());
+              seq = (std::string)sm_.convert(child->getTextContent());
             }
-            else if ((std::string)XMLString::transcode(child->getTagName()) == "cvParam")
+            else if ((std::string)sm_.convert(child->getTagName()) == "cvParam")
             {
               cvs.addCVTerm(parseCvParam_(child));
             }
@@ -691,7 +691,7 @@ namespace OpenMS
         {
           // Found element node: re-cast as element
           DOMElement* element_pep = dynamic_cast<xercesc::DOMElement*>(current_pep);
-          String id = XMLString::transcode(element_pep->getAttribute(XMLString::transcode("id")));
+          String id = sm_.convert(element_pep->getAttribute(sm_.convert("id").c_str()));
 
           //DOMNodeList* pep_sib = element_pep->getChildNodes();
           AASequence aas;
@@ -708,7 +708,7 @@ namespace OpenMS
               // situation. The "name" attribute, if present, may be parsable:
               //   The potentially ambiguous common identifier, such as a
               //   human-readable name for the instance.
-              String name = XMLString::transcode(element_pep->getAttribute(XMLString::transcode("name")));
+              String name = sm_.convert(element_pep->getAttribute(sm_.convert("name").c_str()));
               if (!name.empty()) aas = AASequence::fromString(name);
             }
           }
@@ -736,16 +736,16 @@ namespace OpenMS
 
 //          <PeptideEvidence peptide_ref="peptide_1_1" id="PE_1_1_HSP70_ECHGR_0" start="161" end="172" pre="K" post="I" isDecoy="false" dBSequence_ref="DBSeq_HSP70_ECHGR"/>
 
-          String id = XMLString::transcode(element_pev->getAttribute(XMLString::transcode("id")));
-          String peptide_ref = XMLString::transcode(element_pev->getAttribute(XMLString::transcode("peptide_ref")));
-          String dBSequence_ref = XMLString::transcode(element_pev->getAttribute(XMLString::transcode("dBSequence_ref")));
+          String id = sm_.convert(element_pev->getAttribute(sm_.convert("id").c_str()));
+          String peptide_ref = sm_.convert(element_pev->getAttribute(sm_.convert("peptide_ref").c_str()));
+          String dBSequence_ref = sm_.convert(element_pev->getAttribute(sm_.convert("dBSequence_ref").c_str()));
           //rest is optional !!
           int start = -1;
           int end = -1;
           try
           {
-            start = String(XMLString::transcode(element_pev->getAttribute(XMLString::transcode("start")))).toInt();
-            end = String(XMLString::transcode(element_pev->getAttribute(XMLString::transcode("end")))).toInt();
+            start = String(sm_.convert(element_pev->getAttribute(sm_.convert("start").c_str()))).toInt();
+            end = String(sm_.convert(element_pev->getAttribute(sm_.convert("end").c_str()))).toInt();
           }
           catch (...)
           {
@@ -755,13 +755,13 @@ namespace OpenMS
           char post = '-';
           try
           {
-            if (element_pev->hasAttribute(XMLString::transcode("pre")))
+            if (element_pev->hasAttribute(sm_.convert("pre").c_str()))
             {
-            pre = *XMLString::transcode(element_pev->getAttribute(XMLString::transcode("pre")));
+            pre = sm_.convert(element_pev->getAttribute(sm_.convert("pre").c_str()))[0];
             }
-            if (element_pev->hasAttribute(XMLString::transcode("post")))
+            if (element_pev->hasAttribute(sm_.convert("post").c_str()))
             {
-            post = *XMLString::transcode(element_pev->getAttribute(XMLString::transcode("post")));
+            post = sm_.convert(element_pev->getAttribute(sm_.convert("post").c_str()))[0];
           }
           }
           catch (...)
@@ -771,7 +771,7 @@ namespace OpenMS
           bool idec = false;
           try
           {
-            String d = *XMLString::transcode(element_pev->getAttribute(XMLString::transcode("isDecoy")));
+            String d = sm_.convert(element_pev->getAttribute(sm_.convert("isDecoy").c_str()))[0];
             if (d.hasPrefix('t') || d.hasPrefix('1'))
               idec = true;
           }
@@ -798,23 +798,23 @@ namespace OpenMS
         {
           // Found element node: re-cast as element
           DOMElement* element_si = dynamic_cast<xercesc::DOMElement*>(current_si);
-          String id = XMLString::transcode(element_si->getAttribute(XMLString::transcode("id")));
-          String spectrumIdentificationProtocol_ref = XMLString::transcode(element_si->getAttribute(XMLString::transcode("spectrumIdentificationProtocol_ref")));
-          String spectrumIdentificationList_ref = XMLString::transcode(element_si->getAttribute(XMLString::transcode("spectrumIdentificationList_ref")));
-          String spectrumIdentification_date = XMLString::transcode(element_si->getAttribute(XMLString::transcode("activityDate")));
+          String id = sm_.convert(element_si->getAttribute(sm_.convert("id").c_str()));
+          String spectrumIdentificationProtocol_ref = sm_.convert(element_si->getAttribute(sm_.convert("spectrumIdentificationProtocol_ref").c_str()));
+          String spectrumIdentificationList_ref = sm_.convert(element_si->getAttribute(sm_.convert("spectrumIdentificationList_ref").c_str()));
+          String spectrumIdentification_date = sm_.convert(element_si->getAttribute(sm_.convert("activityDate").c_str()));
 
           String searchDatabase_ref = "";
           String spectra_data_ref = "";
           DOMElement* child = element_si->getFirstElementChild();
           while (child)
           {
-            if ((std::string)XMLString::transcode(child->getTagName()) == "InputSpectra")
+            if ((std::string)sm_.convert(child->getTagName()) == "InputSpectra")
             {
-              spectra_data_ref = XMLString::transcode(child->getAttribute(XMLString::transcode("spectraData_ref")));
+              spectra_data_ref = sm_.convert(child->getAttribute(sm_.convert("spectraData_ref").c_str()));
             }
-            else if ((std::string)XMLString::transcode(child->getTagName()) == "SearchDatabaseRef")
+            else if ((std::string)sm_.convert(child->getTagName()) == "SearchDatabaseRef")
             {
-              searchDatabase_ref = XMLString::transcode(child->getAttribute(XMLString::transcode("searchDatabase_ref")));
+              searchDatabase_ref = sm_.convert(child->getAttribute(sm_.convert("searchDatabase_ref").c_str()));
             }
             child = child->getNextElementSibling();
           }
@@ -862,8 +862,8 @@ namespace OpenMS
         {
           // Found element node: re-cast as element
           DOMElement* element_sip = dynamic_cast<xercesc::DOMElement*>(current_sip);
-          String id = XMLString::transcode(element_sip->getAttribute(XMLString::transcode("id")));
-          String swr = XMLString::transcode(element_sip->getAttribute(XMLString::transcode("analysisSoftware_ref")));
+          String id = sm_.convert(element_sip->getAttribute(sm_.convert("id").c_str()));
+          String swr = sm_.convert(element_sip->getAttribute(sm_.convert("analysisSoftware_ref").c_str()));
 
           CVTerm searchtype;
           String enzymename;
@@ -877,25 +877,25 @@ namespace OpenMS
           DOMElement* child = element_sip->getFirstElementChild();
           while (child)
           {
-            if ((std::string)XMLString::transcode(child->getTagName()) == "SearchType")
+            if ((std::string)sm_.convert(child->getTagName()) == "SearchType")
             {
               searchtype = parseCvParam_(child->getFirstElementChild());
             }
-            else if ((std::string)XMLString::transcode(child->getTagName()) == "AdditionalSearchParams")
+            else if ((std::string)sm_.convert(child->getTagName()) == "AdditionalSearchParams")
             {
               pair<CVTermList, map<String, DataValue> > as_params = parseParamGroup_(child->getChildNodes());
               sp = findSearchParameters_(as_params); // this must be renamed!!
             }
-            else if ((std::string)XMLString::transcode(child->getTagName()) == "ModificationParams") // TODO @all where to store the specificities?
+            else if ((std::string)sm_.convert(child->getTagName()) == "ModificationParams") // TODO @all where to store the specificities?
             {
               vector<String> fix, var;
               DOMElement* sm = child->getFirstElementChild();
               while (sm)
               {
-                String residues = XMLString::transcode(sm->getAttribute(XMLString::transcode("residues")));
+                String residues = sm_.convert(sm->getAttribute(sm_.convert("residues").c_str()));
                 bool fixedMod = false;
                 XSValue::Status status;
-                XSValue* val = XSValue::getActualValue(sm->getAttribute(XMLString::transcode("fixedMod")), XSValue::dt_boolean, status);
+                XSValue* val = XSValue::getActualValue(sm->getAttribute(sm_.convert("fixedMod").c_str()), XSValue::dt_boolean, status);
                 if (status == XSValue::st_Init)
                 {
                   fixedMod = val->fData.fValue.f_bool;
@@ -905,11 +905,11 @@ namespace OpenMS
 //                double massDelta = 0;
 //                try
 //                {
-//                  massDelta = boost::lexical_cast<double>(XMLString::transcode(sm->getAttribute(XMLString::transcode("massDelta"))));
+//                  massDelta = boost::lexical_cast<double>(sm_.convert(sm->getAttribute(sm_.convert("massDelta").c_str())));
 //                }
 //                catch (...)
 //                {
-//                    LOG_ERROR << "Could not cast ModificationParam massDelta from " << XMLString::transcode(sm->getAttribute(XMLString::transcode("massDelta")));
+//                    LOG_ERROR << "Could not cast ModificationParam massDelta from " << sm_.convert(sm->getAttribute(sm_.convert("massDelta").c_str()));
 //                }
 
                 String mname;
@@ -917,16 +917,16 @@ namespace OpenMS
                 DOMElement* sub = sm->getFirstElementChild();
                 while (sub)
                 {
-                  if ((std::string)XMLString::transcode(sub->getTagName()) == "cvParam")
+                  if ((std::string)sm_.convert(sub->getTagName()) == "cvParam")
                   {
-                    mname = XMLString::transcode(sub->getAttribute(XMLString::transcode("name")));
+                    mname = sm_.convert(sub->getAttribute(sm_.convert("name").c_str()));
                    if (mname == "unknown modification")
                    {
                      // e.g. <cvParam cvRef="MS" accession="MS:1001460" name="unknown modification" value="N-Glycan"/>
-                     mname = XMLString::transcode(sub->getAttribute(XMLString::transcode("value")));
+                     mname = sm_.convert(sub->getAttribute(sm_.convert("value").c_str()));
                    }
                   }
-                  else if ((std::string)XMLString::transcode(sub->getTagName()) == "SpecificityRules")
+                  else if ((std::string)sm_.convert(sub->getTagName()) == "SpecificityRules")
                   {
                     specificity_rules.consumeCVTerms(parseParamGroup_(sub->getChildNodes()).first.getCVTerms());
                     // let's press them where all other SearchengineAdapters press them in
@@ -993,7 +993,7 @@ namespace OpenMS
               sp.fixed_modifications = fix;
               sp.variable_modifications = var;
             }
-            else if ((std::string)XMLString::transcode(child->getTagName()) == "Enzymes") // TODO @all : where store multiple enzymes for one identificationrun?
+            else if ((std::string)sm_.convert(child->getTagName()) == "Enzymes") // TODO @all : where store multiple enzymes for one identificationrun?
             {
               DOMElement* enzyme = child->getFirstElementChild(); //Enzyme elements
               while (enzyme)
@@ -1001,21 +1001,21 @@ namespace OpenMS
                 int missedCleavages = -1;
                 try
                 {
-                  missedCleavages = boost::lexical_cast<int>(std::string(XMLString::transcode(enzyme->getAttribute(XMLString::transcode("missedCleavages")))));
+                  missedCleavages = boost::lexical_cast<int>(std::string(sm_.convert(enzyme->getAttribute(sm_.convert("missedCleavages").c_str()))));
                 }
                 catch (exception& e)
                 {
-                  LOG_WARN << "Search engine enzyme settings for 'missedCleavages' unreadable: " << e.what()  << String(XMLString::transcode(enzyme->getAttribute(XMLString::transcode("missedCleavages")))) << endl;
+                  LOG_WARN << "Search engine enzyme settings for 'missedCleavages' unreadable: " << e.what()  << String(sm_.convert(enzyme->getAttribute(sm_.convert("missedCleavages").c_str()))) << endl;
                 }
                 sp.missed_cleavages = missedCleavages;
 
-//                String semiSpecific = XMLString::transcode(enzyme->getAttribute(XMLString::transcode("semiSpecific"))); //xsd:boolean
-//                String cTermGain = XMLString::transcode(enzyme->getAttribute(XMLString::transcode("cTermGain")));
-//                String nTermGain = XMLString::transcode(enzyme->getAttribute(XMLString::transcode("nTermGain")));
+//                String semiSpecific = sm_.convert(enzyme->getAttribute(sm_.convert("semiSpecific").c_str())); //xsd:boolean
+//                String cTermGain = sm_.convert(enzyme->getAttribute(sm_.convert("cTermGain").c_str()));
+//                String nTermGain = sm_.convert(enzyme->getAttribute(sm_.convert("nTermGain").c_str()));
 //                int minDistance = -1;
 //                try
 //                {
-//                  minDistance = String(XMLString::transcode(enzyme->getAttribute(XMLString::transcode("minDistance")))).toInt();
+//                  minDistance = String(sm_.convert(enzyme->getAttribute(sm_.convert("minDistance").c_str()))).toInt();
 //                }
 //                catch (...)
 //                {
@@ -1026,7 +1026,7 @@ namespace OpenMS
                 while (sub)
                 {
                   //SiteRegex unstorable just now
-                  if ((std::string)XMLString::transcode(sub->getTagName()) == "EnzymeName")
+                  if ((std::string)sm_.convert(sub->getTagName()) == "EnzymeName")
                   {
                     set<String> enzymes_terms;
                     cv_.getAllChildTerms(enzymes_terms, "MS:1001045"); // cleavage agent name
@@ -1052,7 +1052,7 @@ namespace OpenMS
                 enzyme = enzyme->getNextElementSibling();
               }
             }
-            else if ((std::string)XMLString::transcode(child->getTagName()) == "FragmentTolerance")
+            else if ((std::string)sm_.convert(child->getTagName()) == "FragmentTolerance")
             {
               pair<CVTermList, map<String, DataValue> > params = parseParamGroup_(child->getChildNodes());
               //+- take the numerically greater
@@ -1066,7 +1066,7 @@ namespace OpenMS
                 }
               }
             }
-            else if ((std::string)XMLString::transcode(child->getTagName()) == "ParentTolerance")
+            else if ((std::string)sm_.convert(child->getTagName()) == "ParentTolerance")
             {
               pair<CVTermList, map<String, DataValue> > params = parseParamGroup_(child->getChildNodes());
               //+- take the numerically greater
@@ -1081,7 +1081,7 @@ namespace OpenMS
 
               }
             }
-            else if ((std::string)XMLString::transcode(child->getTagName()) == "Threshold")
+            else if ((std::string)sm_.convert(child->getTagName()) == "Threshold")
             {
               pair<CVTermList, map<String, DataValue> > params = parseParamGroup_(child->getChildNodes());
               tcv = params.first;
@@ -1153,41 +1153,41 @@ namespace OpenMS
           // Found element node: re-cast as element
           DOMElement* element_in = dynamic_cast<xercesc::DOMElement*>(current_in);
 
-          String id = XMLString::transcode(element_in->getAttribute(XMLString::transcode("id")));
-          String location = XMLString::transcode(element_in->getAttribute(XMLString::transcode("location")));
+          String id = sm_.convert(element_in->getAttribute(sm_.convert("id").c_str()));
+          String location = sm_.convert(element_in->getAttribute(sm_.convert("location").c_str()));
 
-          if ((std::string)XMLString::transcode(element_in->getTagName()) == "SpectraData")
+          if ((std::string)sm_.convert(element_in->getTagName()) == "SpectraData")
           {
             //      <FileFormat> omitted for now, not reflectable by our member structures
             //      <SpectrumIDFormat> omitted for now, not reflectable by our member structures
             sd_map_.insert(make_pair(id, location));
           }
-          else if ((std::string)XMLString::transcode(element_in->getTagName()) == "SourceFile")
+          else if ((std::string)sm_.convert(element_in->getTagName()) == "SourceFile")
           {
             //      <FileFormat> omitted for now, not reflectable by our member structures
             sr_map_.insert(make_pair(id, location));
           }
-          else if ((std::string)XMLString::transcode(element_in->getTagName()) == "SearchDatabase")
+          else if ((std::string)sm_.convert(element_in->getTagName()) == "SearchDatabase")
           {
             //      <FileFormat> omitted for now, not reflectable by our member structures
             DateTime releaseDate;
-//            releaseDate.set(String(XMLString::transcode(element_in->getAttribute(XMLString::transcode("releaseDate")))));
-            String version = XMLString::transcode(element_in->getAttribute(XMLString::transcode("version")));
+//            releaseDate.set(String(sm_.convert(element_in->getAttribute(sm_.convert("releaseDate").c_str()))));
+            String version = sm_.convert(element_in->getAttribute(sm_.convert("version").c_str()));
             String dbname = "";
             DOMElement* element_dbn = element_in->getFirstElementChild();
             while (element_dbn)
             {
-              if ((std::string)XMLString::transcode(element_dbn->getTagName()) == "DatabaseName")
+              if ((std::string)sm_.convert(element_dbn->getTagName()) == "DatabaseName")
               {
                 DOMElement* databasename_param = element_dbn->getFirstElementChild();
                 while (databasename_param)
                 {
-                  if ((std::string)XMLString::transcode(databasename_param->getTagName()) == "userParam")
+                  if ((std::string)sm_.convert(databasename_param->getTagName()) == "userParam")
                   {
                     CVTerm param = parseCvParam_(databasename_param);
                     dbname = param.getValue();
                   }
-                  else if ((std::string)XMLString::transcode(databasename_param->getTagName()) == "cvParam")
+                  else if ((std::string)sm_.convert(databasename_param->getTagName()) == "cvParam")
                   {
                     pair<String, DataValue> param = parseUserParam_(databasename_param);
                     dbname = param.second.toString();
@@ -1221,129 +1221,131 @@ namespace OpenMS
         {
           // Found element node: re-cast as element
           DOMElement* element_lis = dynamic_cast<xercesc::DOMElement*>(current_lis);
-          String id = XMLString::transcode(element_lis->getAttribute(XMLString::transcode("id")));
-//          String name = XMLString::transcode(element_res->getAttribute(XMLString::transcode("name")));
+          String id = sm_.convert(element_lis->getAttribute(sm_.convert("id").c_str()));
+//          String name = sm_.convert(element_res->getAttribute(sm_.convert("name").c_str()));
 
           DOMElement* element_res = element_lis->getFirstElementChild();
           while (element_res)
           {
-            if ((std::string)XMLString::transcode(element_res->getTagName()) == "SpectrumIdentificationResult")
+            if ((std::string)sm_.convert(element_res->getTagName()) == "SpectrumIdentificationResult")
             {
-              String spectra_data_ref = XMLString::transcode(element_res->getAttribute(XMLString::transcode("spectraData_ref"))); //ref to the sourcefile, could be useful but now nowhere to store
-              String spectrumID = XMLString::transcode(element_res->getAttribute(XMLString::transcode("spectrumID")));
-              pair<CVTermList, map<String, DataValue> > params = parseParamGroup_(element_res->getChildNodes());
+              parseSpectrumIdentificationResultElement_(element_res, id);
+            }
+            element_res = element_res->getNextElementSibling();
+          }
+        }
+      }
+    }
 
-              if (xl_ms_search_) // XL-MS data has a different structure (up to 4 spectrum identification items for the same PSM)
-              {
-                std::multimap<String, int> xl_val_map;
-                std::set<String> xl_val_set;
-                int index_counter = 0;
-                DOMElement* sii = element_res->getFirstElementChild();
+    void MzIdentMLDOMHandler::parseSpectrumIdentificationResultElement_(DOMElement* element_res, const String& sil)
+    {
+      String spectra_data_ref = sm_.convert(element_res->getAttribute(sm_.convert("spectraData_ref").c_str())); //ref to the sourcefile, could be useful but now nowhere to store
+      String spectrumID = sm_.convert(element_res->getAttribute(sm_.convert("spectrumID").c_str()));
+      pair<CVTermList, map<String, DataValue> > params = parseParamGroup_(element_res->getChildNodes());
 
-                // loop over all SIIs of a spectrum and group together the SIIs belonging to the same cross-link spectrum match
-                while (sii)
-                {
-                  if ((std::string)XMLString::transcode(sii->getTagName()) == "SpectrumIdentificationItem")
-                  {
-                    DOMNodeList* sii_cvp = sii->getElementsByTagName(XMLString::transcode("cvParam"));
-                    const  XMLSize_t cv_count = sii_cvp->getLength();
-                    for (XMLSize_t i = 0; i < cv_count; ++i)
-                    {
-                      DOMElement* element_sii_cvp = dynamic_cast<xercesc::DOMElement*>(sii_cvp->item(i));
-                      if (String(XMLString::transcode(element_sii_cvp->getAttribute(XMLString::transcode("accession")))) == String("MS:1002511")) // cross-link spectrum identification item
-                      {
-                        String xl_val = XMLString::transcode(element_sii_cvp->getAttribute(XMLString::transcode("value")));
-                        xl_val_map.insert(make_pair(xl_val, index_counter));
-                        xl_val_set.insert(xl_val);
-                      }
-                    }
-                  }
-                  sii = sii->getNextElementSibling();
-                  ++index_counter;
-                }
+      if (xl_ms_search_) // XL-MS data has a different structure (up to 4 spectrum identification items for the same PSM)
+      {
+        std::multimap<String, int> xl_val_map;
+        std::set<String> xl_val_set;
+        int index_counter = 0;
+        DOMElement* sii = element_res->getFirstElementChild();
 
-                // fix for label-free mono-links
-                // those only have one SII and no "cross-link spectrum identification item" value
-                if (xl_val_set.empty())
-                {
-                  xl_val_set.insert("0");
-                  xl_val_map.insert(make_pair("0", 0));
-                }
-                for (set<String>::const_iterator set_it = xl_val_set.begin(); set_it != xl_val_set.end(); ++set_it)
-                {
-                  parseSpectrumIdentificationItemSetXLMS(set_it, xl_val_map, element_res, spectrumID);
-                }
-                pep_id_->back().setIdentifier(pro_id_->at(si_pro_map_[id]).getIdentifier());
-              }
-              else // general case
+        // loop over all SIIs of a spectrum and group together the SIIs belonging to the same cross-link spectrum match
+        while (sii)
+        {
+          if ((std::string)sm_.convert(sii->getTagName()) == "SpectrumIdentificationItem")
+          {
+            DOMNodeList* sii_cvp = sii->getElementsByTagName(sm_.convert("cvParam").c_str());
+            const  XMLSize_t cv_count = sii_cvp->getLength();
+            for (XMLSize_t i = 0; i < cv_count; ++i)
+            {
+              DOMElement* element_sii_cvp = dynamic_cast<xercesc::DOMElement*>(sii_cvp->item(i));
+              if (String(sm_.convert(element_sii_cvp->getAttribute(sm_.convert("accession").c_str()))) == String("MS:1002511")) // cross-link spectrum identification item
               {
-                pep_id_->push_back(PeptideIdentification());
-                pep_id_->back().setHigherScoreBetter(false); //either a q-value or an e-value, only if neither available there will be another
-                pep_id_->back().setMetaValue("spectrum_reference", spectrumID);  // SpectrumIdentificationResult attribute spectrumID is taken from the mz_file and should correspond to MSSpectrum.nativeID, thus spectrum_reference will serve as reference. As the format of the 'reference' widely varies from vendor to vendor, spectrum_reference as string will serve best, indices are not recommended.
+                String xl_val = sm_.convert(element_sii_cvp->getAttribute(sm_.convert("value").c_str()));
+                xl_val_map.insert(make_pair(xl_val, index_counter));
+                xl_val_set.insert(xl_val);
+              }
+            }
+          }
+          sii = sii->getNextElementSibling();
+          ++index_counter;
+        }
 
-                //fill pep_id_->back() with content
-                DOMElement* parent = dynamic_cast<xercesc::DOMElement*>(element_res->getParentNode());
-                String sil = XMLString::transcode(parent->getAttribute(XMLString::transcode("id")));
+        // fix for label-free mono-links
+        // those only have one SII and no "cross-link spectrum identification item" value
+        if (xl_val_set.empty())
+        {
+          xl_val_set.insert("0");
+          xl_val_map.insert(make_pair("0", 0));
+        }
+        for (set<String>::const_iterator set_it = xl_val_set.begin(); set_it != xl_val_set.end(); ++set_it)
+        {
+          parseSpectrumIdentificationItemSetXLMS(set_it, xl_val_map, element_res, spectrumID);
+        }
+        pep_id_->back().setIdentifier(pro_id_->at(si_pro_map_[sil]).getIdentifier());
+      }
+      else // general case
+      {
+        pep_id_->push_back(PeptideIdentification());
+        pep_id_->back().setHigherScoreBetter(false); //either a q-value or an e-value, only if neither available there will be another
+        pep_id_->back().setMetaValue("spectrum_reference", spectrumID);  // SpectrumIdentificationResult attribute spectrumID is taken from the mz_file and should correspond to MSSpectrum.nativeID, thus spectrum_reference will serve as reference. As the format of the 'reference' widely varies from vendor to vendor, spectrum_reference as string will serve best, indices are not recommended.
 
-                DOMElement* child = element_res->getFirstElementChild();
-                while (child)
-                {
-                  if ((std::string)XMLString::transcode(child->getTagName()) == "SpectrumIdentificationItem")
-                  {
-                    parseSpectrumIdentificationItemElement_(child, pep_id_->back(), sil);
-                  }
-                  child = child->getNextElementSibling();
-                }
+        //fill pep_id_->back() with content
+        DOMElement* child = element_res->getFirstElementChild();
+        while (child)
+        {
+          if ((std::string)sm_.convert(child->getTagName()) == "SpectrumIdentificationItem")
+          {
+            parseSpectrumIdentificationItemElement_(child, pep_id_->back(), sil);
+          }
+          child = child->getNextElementSibling();
+        }
 
-              } // end of "not-XLMS-results"
+      } // end of "not-XLMS-results"
 
-              // TODO @mths: setSignificanceThreshold, but from where?
+      // TODO @mths: setSignificanceThreshold, but from where?
 
-              pep_id_->back().setIdentifier(pro_id_->at(si_pro_map_[id]).getIdentifier());
+      pep_id_->back().setIdentifier(pro_id_->at(si_pro_map_[sil]).getIdentifier());
 
-              pep_id_->back().sortByRank();
+      pep_id_->back().sortByRank();
 
-              //adopt cv s
-              for (map<String, vector<CVTerm> >::const_iterator cvit =  params.first.getCVTerms().begin(); cvit != params.first.getCVTerms().end(); ++cvit)
-              {
-                // check for retention time or scan time entry
-                /* N.B.: MzIdentML does not impose the requirement to store
-                   'redundant' data (e.g. RT) as the identified spectrum is
-                   unambiguously referencable by the spectrumID (OpenMS
-                   internally spectrum_reference) and hence such data can be
-                   looked up in the mz file. For convenience, and as OpenMS
-                   relies on the smallest common denominator to reference a
-                   spectrum (RT/precursor MZ), we provide functionality to amend
-                   RT data to identifications and support reading such from mzid
-                */
-                if (cvit->first == "MS:1000894" || cvit->first == "MS:1000016") //TODO use subordinate terms which define units
-                {
-                  double rt = cvit->second.front().getValue().toString().toDouble();
-                  if (cvit->second.front().getUnit().accession == "UO:0000031")  // minutes
-                  {
-                    rt *= 60.0;
-                  }
-                  pep_id_->back().setRT(rt);
-                }
-                else
-                {
-                  pep_id_->back().setMetaValue(cvit->first, cvit->second.front().getValue()); // TODO? all DataValues - are there more then one, my guess is this is overdesigned
-                }
-              }
-              //adopt up s
-              for (map<String, DataValue>::const_iterator upit = params.second.begin(); upit != params.second.end(); ++upit)
-              {
-                pep_id_->back().setMetaValue(upit->first, upit->second);
-              }
-              if (pep_id_->back().getRT() != pep_id_->back().getRT())
-              {
-                LOG_WARN << "No retention time found for 'SpectrumIdentificationResult'" << endl;
-              }
-            }
-            element_res = element_res->getNextElementSibling();
+      //adopt cv s
+      for (map<String, vector<CVTerm> >::const_iterator cvit =  params.first.getCVTerms().begin(); cvit != params.first.getCVTerms().end(); ++cvit)
+      {
+        // check for retention time or scan time entry
+        /* N.B.: MzIdentML does not impose the requirement to store
+           'redundant' data (e.g. RT) as the identified spectrum is
+           unambiguously referencable by the spectrumID (OpenMS
+           internally spectrum_reference) and hence such data can be
+           looked up in the mz file. For convenience, and as OpenMS
+           relies on the smallest common denominator to reference a
+           spectrum (RT/precursor MZ), we provide functionality to amend
+           RT data to identifications and support reading such from mzid
+        */
+        if (cvit->first == "MS:1000894" || cvit->first == "MS:1000016") //TODO use subordinate terms which define units
+        {
+          double rt = cvit->second.front().getValue().toString().toDouble();
+          if (cvit->second.front().getUnit().accession == "UO:0000031")  // minutes
+          {
+            rt *= 60.0;
           }
+          pep_id_->back().setRT(rt);
+        }
+        else
+        {
+          pep_id_->back().setMetaValue(cvit->first, cvit->second.front().getValue()); // TODO? all DataValues - are there more then one, my guess is this is overdesigned
         }
       }
+      //adopt up s
+      for (map<String, DataValue>::const_iterator upit = params.second.begin(); upit != params.second.end(); ++upit)
+      {
+        pep_id_->back().setMetaValue(upit->first, upit->second);
+      }
+      if (pep_id_->back().getRT() != pep_id_->back().getRT())
+      {
+        LOG_WARN << "No retention time found for 'SpectrumIdentificationResult'" << endl;
+      }
     }
 
     void MzIdentMLDOMHandler::parseSpectrumIdentificationItemSetXLMS(set<String>::const_iterator set_it, std::multimap<String, int> xl_val_map, DOMElement* element_res, String spectrumID)
@@ -1351,10 +1353,10 @@ namespace OpenMS
       // each value in the set corresponds to one PeptideIdentification object
       std::pair <std::multimap<String, int>::iterator, std::multimap<String, int>::iterator> range;
       range = xl_val_map.equal_range(*set_it);
-      DOMNodeList* siis = element_res->getElementsByTagName(XMLString::transcode("SpectrumIdentificationItem"));
+      DOMNodeList* siis = element_res->getElementsByTagName(sm_.convert("SpectrumIdentificationItem").c_str());
 
       DOMElement* parent = dynamic_cast<xercesc::DOMElement*>(element_res->getParentNode());
-      String spectrumIdentificationList_ref = XMLString::transcode(parent->getAttribute(XMLString::transcode("id")));
+      String spectrumIdentificationList_ref = sm_.convert(parent->getAttribute(sm_.convert("id").c_str()));
 
       // initialize all needed values, extract them one by one in vectors, e.g. using max and min to determine which are heavy which light
       // get peptide id, that way determine donor, acceptor (alpha, beta)
@@ -1379,53 +1381,53 @@ namespace OpenMS
       {
         DOMElement* cl_sii = dynamic_cast<xercesc::DOMElement*>(siis->item(it->second));
         // Attributes
-        String peptide = XMLString::transcode(cl_sii->getAttribute(XMLString::transcode("peptide_ref")));
+        String peptide = sm_.convert(cl_sii->getAttribute(sm_.convert("peptide_ref").c_str()));
         peptides.push_back(peptide);
-        double exp_mz = String(XMLString::transcode(cl_sii->getAttribute(XMLString::transcode("experimentalMassToCharge")))).toDouble();
+        double exp_mz = String(sm_.convert(cl_sii->getAttribute(sm_.convert("experimentalMassToCharge").c_str()))).toDouble();
         exp_mzs.push_back(exp_mz);
 
         if (rank == 0)
         {
-          rank = String(XMLString::transcode(cl_sii->getAttribute(XMLString::transcode("rank")))).toInt();
+          rank = String(sm_.convert(cl_sii->getAttribute(sm_.convert("rank").c_str()))).toInt();
         }
         if (charge == 0)
         {
-          charge = String(XMLString::transcode(cl_sii->getAttribute(XMLString::transcode("chargeState")))).toInt();
+          charge = String(sm_.convert(cl_sii->getAttribute(sm_.convert("chargeState").c_str()))).toInt();
         }
 
         // CVs
-        DOMNodeList* sii_cvp = cl_sii->getElementsByTagName(XMLString::transcode("cvParam"));
+        DOMNodeList* sii_cvp = cl_sii->getElementsByTagName(sm_.convert("cvParam").c_str());
         const  XMLSize_t cv_count = sii_cvp->getLength();
         for (XMLSize_t i = 0; i < cv_count; ++i)
         {
           DOMElement* element_sii_cvp = dynamic_cast<xercesc::DOMElement*>(sii_cvp->item(i));
-          if (String(XMLString::transcode(element_sii_cvp->getAttribute(XMLString::transcode("accession")))) == String("MS:1002681")) // OpenXQuest:combined score
+          if (String(sm_.convert(element_sii_cvp->getAttribute(sm_.convert("accession").c_str()))) == String("MS:1002681")) // OpenXQuest:combined score
           {
-            score = String(XMLString::transcode(element_sii_cvp->getAttribute(XMLString::transcode("value")))).toDouble();
+            score = String(sm_.convert(element_sii_cvp->getAttribute(sm_.convert("value").c_str()))).toDouble();
           }
-          else if (String(XMLString::transcode(element_sii_cvp->getAttribute(XMLString::transcode("accession")))) == String("MS:1002682")) // OpenXQuest: xcorr common
+          else if (String(sm_.convert(element_sii_cvp->getAttribute(sm_.convert("accession").c_str()))) == String("MS:1002682")) // OpenXQuest: xcorr common
           {
-            xcorrx = String(XMLString::transcode(element_sii_cvp->getAttribute(XMLString::transcode("value")))).toDouble();
+            xcorrx = String(sm_.convert(element_sii_cvp->getAttribute(sm_.convert("value").c_str()))).toDouble();
           }
-          else if (String(XMLString::transcode(element_sii_cvp->getAttribute(XMLString::transcode("accession")))) == String("MS:1002683")) // OpenXQuest: xcorr xlink
+          else if (String(sm_.convert(element_sii_cvp->getAttribute(sm_.convert("accession").c_str()))) == String("MS:1002683")) // OpenXQuest: xcorr xlink
           {
-            xcorrc = String(XMLString::transcode(element_sii_cvp->getAttribute(XMLString::transcode("value")))).toDouble();
+            xcorrc = String(sm_.convert(element_sii_cvp->getAttribute(sm_.convert("value").c_str()))).toDouble();
           }
-          else if (String(XMLString::transcode(element_sii_cvp->getAttribute(XMLString::transcode("accession")))) == String("MS:1002684")) // OpenXQuest: match-odds
+          else if (String(sm_.convert(element_sii_cvp->getAttribute(sm_.convert("accession").c_str()))) == String("MS:1002684")) // OpenXQuest: match-odds
           {
-            matchodds = String(XMLString::transcode(element_sii_cvp->getAttribute(XMLString::transcode("value")))).toDouble();
+            matchodds = String(sm_.convert(element_sii_cvp->getAttribute(sm_.convert("value").c_str()))).toDouble();
           }
-          else if (String(XMLString::transcode(element_sii_cvp->getAttribute(XMLString::transcode("accession")))) == String("MS:1002685")) // OpenXQuest: intsum
+          else if (String(sm_.convert(element_sii_cvp->getAttribute(sm_.convert("accession").c_str()))) == String("MS:1002685")) // OpenXQuest: intsum
           {
-            intsum = String(XMLString::transcode(element_sii_cvp->getAttribute(XMLString::transcode("value")))).toDouble();
+            intsum = String(sm_.convert(element_sii_cvp->getAttribute(sm_.convert("value").c_str()))).toDouble();
           }
-          else if (String(XMLString::transcode(element_sii_cvp->getAttribute(XMLString::transcode("accession")))) == String("MS:1002686")) // OpenXQuest: wTIC
+          else if (String(sm_.convert(element_sii_cvp->getAttribute(sm_.convert("accession").c_str()))) == String("MS:1002686")) // OpenXQuest: wTIC
           {
-            wTIC = String(XMLString::transcode(element_sii_cvp->getAttribute(XMLString::transcode("value")))).toDouble();
+            wTIC = String(sm_.convert(element_sii_cvp->getAttribute(sm_.convert("value").c_str()))).toDouble();
           }
-          else if (String(XMLString::transcode(element_sii_cvp->getAttribute(XMLString::transcode("accession")))) == String("MS:1000894")) // retention time
+          else if (String(sm_.convert(element_sii_cvp->getAttribute(sm_.convert("accession").c_str()))) == String("MS:1000894")) // retention time
           {
-            double RT = String(XMLString::transcode(element_sii_cvp->getAttribute(XMLString::transcode("value")))).toDouble();
+            double RT = String(sm_.convert(element_sii_cvp->getAttribute(sm_.convert("value").c_str()))).toDouble();
             RTs.push_back(RT);
           }
         }
@@ -1435,14 +1437,14 @@ namespace OpenMS
         vector<String> userParamValues;
         vector<String> userParamUnits;
 
-        DOMNodeList* sii_up = cl_sii->getElementsByTagName(XMLString::transcode("userParam"));
+        DOMNodeList* sii_up = cl_sii->getElementsByTagName(sm_.convert("userParam").c_str());
         const  XMLSize_t up_count = sii_up->getLength();
         for (XMLSize_t i = 0; i < up_count; ++i)
         {
           DOMElement* element_sii_up = dynamic_cast<xercesc::DOMElement*>(sii_up->item(i));
-          userParamNames.push_back(String(XMLString::transcode(element_sii_up->getAttribute(XMLString::transcode("name")))));
-          userParamValues.push_back(String(XMLString::transcode(element_sii_up->getAttribute(XMLString::transcode("value")))));
-          userParamUnits.push_back(String(XMLString::transcode(element_sii_up->getAttribute(XMLString::transcode("unitName")))));
+          userParamNames.push_back(String(sm_.convert(element_sii_up->getAttribute(sm_.convert("name").c_str()))));
+          userParamValues.push_back(String(sm_.convert(element_sii_up->getAttribute(sm_.convert("value").c_str()))));
+          userParamUnits.push_back(String(sm_.convert(element_sii_up->getAttribute(sm_.convert("unitName").c_str()))));
         }
         userParamNameLists.push_back(userParamNames);
         userParamValueLists.push_back(userParamValues);
@@ -1451,17 +1453,17 @@ namespace OpenMS
         // Fragmentation, does not matter where to get them. Look for them as long as the vector is empty
         if (frag_annotations.empty())
         {
-          DOMNodeList* frag_element_list = cl_sii->getElementsByTagName(XMLString::transcode("Fragmentation"));
+          DOMNodeList* frag_element_list = cl_sii->getElementsByTagName(sm_.convert("Fragmentation").c_str());
 
           if (frag_element_list->getLength() > 0)
           {
             DOMElement* frag_element = dynamic_cast<xercesc::DOMElement*>(frag_element_list->item(0));
-            DOMNodeList* ion_types = frag_element->getElementsByTagName(XMLString::transcode("IonType"));
+            DOMNodeList* ion_types = frag_element->getElementsByTagName(sm_.convert("IonType").c_str());
             const  XMLSize_t ion_type_count = ion_types->getLength();
             for (XMLSize_t i = 0; i < ion_type_count; ++i)
             {
               DOMElement* ion_type_element = dynamic_cast<xercesc::DOMElement*>(ion_types->item(i));
-              int ion_charge = String(XMLString::transcode(ion_type_element ->getAttribute(XMLString::transcode("charge")))).toInt();
+              int ion_charge = String(sm_.convert(ion_type_element ->getAttribute(sm_.convert("charge").c_str()))).toInt();
               vector<String> indices;
               vector<String> positions;
               vector<String> intensities;
@@ -1470,129 +1472,129 @@ namespace OpenMS
               String frag_type;
               String loss = "";
 
-              String(XMLString::transcode(ion_type_element ->getAttribute(XMLString::transcode("index")))).split(" ", indices);
+              String(sm_.convert(ion_type_element ->getAttribute(sm_.convert("index").c_str()))).split(" ", indices);
 
-              DOMNodeList* frag_arrays = ion_type_element ->getElementsByTagName(XMLString::transcode("FragmentArray"));
+              DOMNodeList* frag_arrays = ion_type_element ->getElementsByTagName(sm_.convert("FragmentArray").c_str());
               const XMLSize_t frag_array_count = frag_arrays->getLength();
               for (XMLSize_t f = 0; f < frag_array_count; ++f)
               {
                 DOMElement* frag_array_element = dynamic_cast<xercesc::DOMElement*>(frag_arrays->item(f));
-                if ( String(XMLString::transcode(frag_array_element->getAttribute(XMLString::transcode("measure_ref")))) == "Measure_mz")
+                if ( String(sm_.convert(frag_array_element->getAttribute(sm_.convert("measure_ref").c_str()))) == "Measure_mz")
                 {
-                  String(XMLString::transcode(frag_array_element->getAttribute(XMLString::transcode("values")))).split(" ", positions);
+                  String(sm_.convert(frag_array_element->getAttribute(sm_.convert("values").c_str()))).split(" ", positions);
                 }
-                if ( String(XMLString::transcode(frag_array_element->getAttribute(XMLString::transcode("measure_ref")))) == "Measure_int")
+                if ( String(sm_.convert(frag_array_element->getAttribute(sm_.convert("measure_ref").c_str()))) == "Measure_int")
                 {
-                  String(XMLString::transcode(frag_array_element->getAttribute(XMLString::transcode("values")))).split(" ", intensities);
+                  String(sm_.convert(frag_array_element->getAttribute(sm_.convert("values").c_str()))).split(" ", intensities);
                 }
               }
 
-              DOMNodeList* userParams = ion_type_element->getElementsByTagName(XMLString::transcode("userParam"));
+              DOMNodeList* userParams = ion_type_element->getElementsByTagName(sm_.convert("userParam").c_str());
               const XMLSize_t userParam_count = userParams->getLength();
               for (XMLSize_t u = 0; u < userParam_count; ++u)
               {
                 DOMElement* userParam_element = dynamic_cast<xercesc::DOMElement*>(userParams->item(u));
-                if ( String(XMLString::transcode(userParam_element ->getAttribute(XMLString::transcode("name")))) == "cross-link_chain")
+                if ( String(sm_.convert(userParam_element ->getAttribute(sm_.convert("name").c_str()))) == "cross-link_chain")
                 {
-                  String(XMLString::transcode(userParam_element ->getAttribute(XMLString::transcode("value")))).split(" ", chains);
+                  String(sm_.convert(userParam_element ->getAttribute(sm_.convert("value").c_str()))).split(" ", chains);
                 }
-                if ( String(XMLString::transcode(userParam_element ->getAttribute(XMLString::transcode("name")))) == "cross-link_ioncategory")
+                if ( String(sm_.convert(userParam_element ->getAttribute(sm_.convert("name").c_str()))) == "cross-link_ioncategory")
                 {
-                  String(XMLString::transcode(userParam_element ->getAttribute(XMLString::transcode("value")))).split(" ", categories);
+                  String(sm_.convert(userParam_element ->getAttribute(sm_.convert("value").c_str()))).split(" ", categories);
                 }
               }
 
-              DOMNodeList* cvts = ion_type_element->getElementsByTagName(XMLString::transcode("cvParam"));
+              DOMNodeList* cvts = ion_type_element->getElementsByTagName(sm_.convert("cvParam").c_str());
               const XMLSize_t cvt_count = cvts->getLength();
               for (XMLSize_t cvt = 0; cvt < cvt_count; ++cvt)
               {
                 DOMElement* cvt_element = dynamic_cast<xercesc::DOMElement*>(cvts->item(cvt));
 
                 // Standard ions
-                if (String(XMLString::transcode(cvt_element->getAttribute(XMLString::transcode("accession")))) == "MS:1001229") // frag: a ion
+                if (String(sm_.convert(cvt_element->getAttribute(sm_.convert("accession").c_str()))) == "MS:1001229") // frag: a ion
                 {
                   frag_type = "a";
                 }
-                if (String(XMLString::transcode(cvt_element->getAttribute(XMLString::transcode("accession")))) == "MS:1001224") // frag: b ion
+                if (String(sm_.convert(cvt_element->getAttribute(sm_.convert("accession").c_str()))) == "MS:1001224") // frag: b ion
                 {
                   frag_type = "b";
                 }
-                if (String(XMLString::transcode(cvt_element->getAttribute(XMLString::transcode("accession")))) == "MS:1001231") // frag: c ion
+                if (String(sm_.convert(cvt_element->getAttribute(sm_.convert("accession").c_str()))) == "MS:1001231") // frag: c ion
                 {
                   frag_type = "c";
                 }
-                if (String(XMLString::transcode(cvt_element->getAttribute(XMLString::transcode("accession")))) == "MS:1001228") // frag: x ion
+                if (String(sm_.convert(cvt_element->getAttribute(sm_.convert("accession").c_str()))) == "MS:1001228") // frag: x ion
                 {
                   frag_type = "x";
                 }
-                if (String(XMLString::transcode(cvt_element->getAttribute(XMLString::transcode("accession")))) == "MS:1001220") // frag: y ion
+                if (String(sm_.convert(cvt_element->getAttribute(sm_.convert("accession").c_str()))) == "MS:1001220") // frag: y ion
                 {
                   frag_type = "y";
                 }
-                if (String(XMLString::transcode(cvt_element->getAttribute(XMLString::transcode("accession")))) == "MS:1001230") // frag: z ion
+                if (String(sm_.convert(cvt_element->getAttribute(sm_.convert("accession").c_str()))) == "MS:1001230") // frag: z ion
                 {
                   frag_type = "z";
                 }
 
                 // Ions with H2O losses
-                if (String(XMLString::transcode(cvt_element->getAttribute(XMLString::transcode("accession")))) == "MS:1001234") // frag: a ion - H2O
+                if (String(sm_.convert(cvt_element->getAttribute(sm_.convert("accession").c_str()))) == "MS:1001234") // frag: a ion - H2O
                 {
                   frag_type = "a";
                   loss = "-H2O";
                 }
-                if (String(XMLString::transcode(cvt_element->getAttribute(XMLString::transcode("accession")))) == "MS:1001222") // frag: b ion - H20
+                if (String(sm_.convert(cvt_element->getAttribute(sm_.convert("accession").c_str()))) == "MS:1001222") // frag: b ion - H20
                 {
                   frag_type = "b";
                   loss = "-H2O";
                 }
-                if (String(XMLString::transcode(cvt_element->getAttribute(XMLString::transcode("accession")))) == "MS:1001515") // frag: c ion - H20
+                if (String(sm_.convert(cvt_element->getAttribute(sm_.convert("accession").c_str()))) == "MS:1001515") // frag: c ion - H20
                 {
                   frag_type = "c";
                   loss = "-H2O";
                 }
-                if (String(XMLString::transcode(cvt_element->getAttribute(XMLString::transcode("accession")))) == "MS:1001519") // frag: x ion - H20
+                if (String(sm_.convert(cvt_element->getAttribute(sm_.convert("accession").c_str()))) == "MS:1001519") // frag: x ion - H20
                 {
                   frag_type = "x";
                   loss = "-H2O";
                 }
-                if (String(XMLString::transcode(cvt_element->getAttribute(XMLString::transcode("accession")))) == "MS:1001223") // frag: y ion - H20
+                if (String(sm_.convert(cvt_element->getAttribute(sm_.convert("accession").c_str()))) == "MS:1001223") // frag: y ion - H20
                 {
                   frag_type = "y";
                   loss = "-H2O";
                 }
-                if (String(XMLString::transcode(cvt_element->getAttribute(XMLString::transcode("accession")))) == "MS:1001517") // frag: z ion - H20
+                if (String(sm_.convert(cvt_element->getAttribute(sm_.convert("accession").c_str()))) == "MS:1001517") // frag: z ion - H20
                 {
                   frag_type = "z";
                   loss = "-H2O";
                 }
 
                 // Ions with NH3 losses
-                if (String(XMLString::transcode(cvt_element->getAttribute(XMLString::transcode("accession")))) == "MS:1001235") // frag: a ion - NH3
+                if (String(sm_.convert(cvt_element->getAttribute(sm_.convert("accession").c_str()))) == "MS:1001235") // frag: a ion - NH3
                 {
                   frag_type = "a";
                   loss = "-NH3";
                 }
-                if (String(XMLString::transcode(cvt_element->getAttribute(XMLString::transcode("accession")))) == "MS:1001232") // frag: b ion - NH3
+                if (String(sm_.convert(cvt_element->getAttribute(sm_.convert("accession").c_str()))) == "MS:1001232") // frag: b ion - NH3
                 {
                   frag_type = "b";
                   loss = "-NH3";
                 }
-                if (String(XMLString::transcode(cvt_element->getAttribute(XMLString::transcode("accession")))) == "MS:1001516") // frag: c ion - NH3
+                if (String(sm_.convert(cvt_element->getAttribute(sm_.convert("accession").c_str()))) == "MS:1001516") // frag: c ion - NH3
                 {
                   frag_type = "c";
                   loss = "-NH3";
                 }
-                if (String(XMLString::transcode(cvt_element->getAttribute(XMLString::transcode("accession")))) == "MS:1001520") // frag: x ion - NH3
+                if (String(sm_.convert(cvt_element->getAttribute(sm_.convert("accession").c_str()))) == "MS:1001520") // frag: x ion - NH3
                 {
                   frag_type = "x";
                   loss = "-NH3";
                 }
-                if (String(XMLString::transcode(cvt_element->getAttribute(XMLString::transcode("accession")))) == "MS:1001233") // frag: y ion - NH3
+                if (String(sm_.convert(cvt_element->getAttribute(sm_.convert("accession").c_str()))) == "MS:1001233") // frag: y ion - NH3
                 {
                   frag_type = "y";
                   loss = "-NH3";
                 }
-                if (String(XMLString::transcode(cvt_element->getAttribute(XMLString::transcode("accession")))) == "MS:1001518") // frag: z ion - NH3
+                if (String(sm_.convert(cvt_element->getAttribute(sm_.convert("accession").c_str()))) == "MS:1001518") // frag: z ion - NH3
                 {
                   frag_type = "z";
                   loss = "-NH3";
@@ -1962,39 +1964,39 @@ namespace OpenMS
       pep_id_->back().sortByRank();
     }
 
-    void MzIdentMLDOMHandler::parseSpectrumIdentificationItemElement_(DOMElement* spectrumIdentificationItemElement, PeptideIdentification& spectrum_identification, String& spectrumIdentificationList_ref)
+    void MzIdentMLDOMHandler::parseSpectrumIdentificationItemElement_(DOMElement* spectrumIdentificationItemElement, PeptideIdentification& spectrum_identification, const String& spectrumIdentificationList_ref)
     {
-      String id = XMLString::transcode(spectrumIdentificationItemElement->getAttribute(XMLString::transcode("id")));
-      String name = XMLString::transcode(spectrumIdentificationItemElement->getAttribute(XMLString::transcode("name")));
+      String id = sm_.convert(spectrumIdentificationItemElement->getAttribute(sm_.convert("id").c_str()));
+      String name = sm_.convert(spectrumIdentificationItemElement->getAttribute(sm_.convert("name").c_str()));
 
-      long double calculatedMassToCharge = String(XMLString::transcode(spectrumIdentificationItemElement->getAttribute(XMLString::transcode("calculatedMassToCharge")))).toDouble();
-//      long double calculatedPI = String(XMLString::transcode(spectrumIdentificationItemElement->getAttribute(XMLString::transcode("calculatedPI")))).toDouble();
+      long double calculatedMassToCharge = String(sm_.convert(spectrumIdentificationItemElement->getAttribute(sm_.convert("calculatedMassToCharge").c_str()))).toDouble();
+//      long double calculatedPI = String(sm_.convert(spectrumIdentificationItemElement->getAttribute(sm_.convert("calculatedPI").c_str()))).toDouble();
       int chargeState = 0;
       try
       {
-        chargeState = String(XMLString::transcode(spectrumIdentificationItemElement->getAttribute(XMLString::transcode("chargeState")))).toInt();
+        chargeState = String(sm_.convert(spectrumIdentificationItemElement->getAttribute(sm_.convert("chargeState").c_str()))).toInt();
       }
       catch (...)
       {
         LOG_WARN << "Found unreadable 'chargeState'." << endl;
       }
-      long double experimentalMassToCharge = String(XMLString::transcode(spectrumIdentificationItemElement->getAttribute(XMLString::transcode("experimentalMassToCharge")))).toDouble();
+      long double experimentalMassToCharge = String(sm_.convert(spectrumIdentificationItemElement->getAttribute(sm_.convert("experimentalMassToCharge").c_str()))).toDouble();
       int rank = 0;
       try
       {
-        rank = String(XMLString::transcode(spectrumIdentificationItemElement->getAttribute(XMLString::transcode("rank")))).toInt();
+        rank = String(sm_.convert(spectrumIdentificationItemElement->getAttribute(sm_.convert("rank").c_str()))).toInt();
       }
       catch (...)
       {
         LOG_WARN << "Found unreadable PSM rank." << endl;
       }
 
-      String peptide_ref = XMLString::transcode(spectrumIdentificationItemElement->getAttribute(XMLString::transcode("peptide_ref")));
-//      String sample_ref = XMLString::transcode(spectrumIdentificationItemElement->getAttribute(XMLString::transcode("sample_ref")));
-//      String massTable_ref = XMLString::transcode(spectrumIdentificationItemElement->getAttribute(XMLString::transcode("massTable_ref")));
+      String peptide_ref = sm_.convert(spectrumIdentificationItemElement->getAttribute(sm_.convert("peptide_ref").c_str()));
+//      String sample_ref = sm_.convert(spectrumIdentificationItemElement->getAttribute(sm_.convert("sample_ref").c_str()));
+//      String massTable_ref = sm_.convert(spectrumIdentificationItemElement->getAttribute(sm_.convert("massTable_ref").c_str()));
 
       XSValue::Status status;
-      XSValue* val = XSValue::getActualValue(spectrumIdentificationItemElement->getAttribute(XMLString::transcode("passThreshold")), XSValue::dt_boolean, status);
+      XSValue* val = XSValue::getActualValue(spectrumIdentificationItemElement->getAttribute(sm_.convert("passThreshold").c_str()), XSValue::dt_boolean, status);
       bool pass = false;
       if (status == XSValue::st_Init)
       {
@@ -2164,9 +2166,9 @@ namespace OpenMS
         //      DOMElement* child = spectrumIdentificationItemElement->getFirstElementChild();
         //      while ( child )
         //      {
-        //        if ((std::string)XMLString::transcode(child->getTagName()) == "PeptideEvidenceRef")
+        //        if ((std::string)sm_.convert(child->getTagName()) == "PeptideEvidenceRef")
         //        {
-        //          ref = XMLString::transcode(element_si->getAttribute(XMLString::transcode("peptideEvidence_ref")));
+        //          ref = sm_.convert(element_si->getAttribute(sm_.convert("peptideEvidence_ref").c_str()));
         //          //...
         //          spectrum_identification.getHits().back().setAABefore(char acid);
         //          spectrum_identification.getHits().back().setAAAfter (char acid);
@@ -2190,7 +2192,7 @@ namespace OpenMS
           // Found element node: re-cast as element
           DOMElement* element_pr = dynamic_cast<xercesc::DOMElement*>(current_pr);
 
-//          String id = XMLString::transcode(element_pr->getAttribute(XMLString::transcode("id")));
+//          String id = sm_.convert(element_pr->getAttribute(sm_.convert("id").c_str()));
 //          pair<CVTermList, map<String, DataValue> > params = parseParamGroup_(current_pr->getChildNodes());
 
           // TODO @mths : this needs to be a ProteinIdentification for the ProteinDetectionListElement which is not mandatory and used in downstream analysis ProteinInference etc.
@@ -2207,7 +2209,7 @@ namespace OpenMS
           DOMElement* child = element_pr->getFirstElementChild();
           while (child)
           {
-            if ((std::string)XMLString::transcode(child->getTagName()) == "ProteinAmbiguityGroup")
+            if ((std::string)sm_.convert(child->getTagName()) == "ProteinAmbiguityGroup")
             {
               parseProteinAmbiguityGroupElement_(child, pro_id_->back());
             }
@@ -2219,14 +2221,14 @@ namespace OpenMS
 
     void MzIdentMLDOMHandler::parseProteinAmbiguityGroupElement_(DOMElement* proteinAmbiguityGroupElement, ProteinIdentification& protein_identification)
     {
-//      String id = XMLString::transcode(proteinAmbiguityGroupElement->getAttribute(XMLString::transcode("id")));
+//      String id = sm_.convert(proteinAmbiguityGroupElement->getAttribute(sm_.convert("id").c_str()));
 //      pair<CVTermList, map<String, DataValue> > params = parseParamGroup_(proteinAmbiguityGroupElement->getChildNodes());
 
       //fill pro_id_->back() with content,
       DOMElement* child = proteinAmbiguityGroupElement->getFirstElementChild();
       while (child)
       {
-        if ((std::string)XMLString::transcode(child->getTagName()) == "ProteinDetectionHypothesis")
+        if ((std::string)sm_.convert(child->getTagName()) == "ProteinDetectionHypothesis")
         {
           parseProteinDetectionHypothesisElement_(child, protein_identification);
         }
@@ -2236,7 +2238,7 @@ namespace OpenMS
 
     void MzIdentMLDOMHandler::parseProteinDetectionHypothesisElement_(DOMElement* proteinDetectionHypothesisElement, ProteinIdentification& protein_identification)
     {
-      String dBSequence_ref = XMLString::transcode(proteinDetectionHypothesisElement->getAttribute(XMLString::transcode("dBSequence_ref")));
+      String dBSequence_ref = sm_.convert(proteinDetectionHypothesisElement->getAttribute(sm_.convert("dBSequence_ref").c_str()));
 
 //      pair<CVTermList, map<String, DataValue> > params = parseParamGroup_(proteinDetectionHypothesisElement->getChildNodes());
 
@@ -2262,14 +2264,14 @@ namespace OpenMS
             current_sib->getNodeType() == DOMNode::ELEMENT_NODE)
         {
           DOMElement* element_sib = dynamic_cast<xercesc::DOMElement*>(current_sib);
-          if ((std::string)XMLString::transcode(element_sib->getTagName()) == "PeptideSequence")
+          if ((std::string)sm_.convert(element_sib->getTagName()) == "PeptideSequence")
           {
             DOMNode* tn = element_sib->getFirstChild();
             if (tn->getNodeType() == DOMNode::TEXT_NODE)
             {
               DOMText* data = dynamic_cast<DOMText*>(tn);
               const XMLCh* val = data->getWholeText();
-              as = String(XMLString::transcode(val));
+              as = String(sm_.convert(val));
             }
             else
             {
@@ -2286,12 +2288,12 @@ namespace OpenMS
             current_sib->getNodeType() == DOMNode::ELEMENT_NODE)
         {
           DOMElement* element_sib = dynamic_cast<xercesc::DOMElement*>(current_sib);
-          if ((std::string)XMLString::transcode(element_sib->getTagName()) == "SubstitutionModification")
+          if ((std::string)sm_.convert(element_sib->getTagName()) == "SubstitutionModification")
           {
 
-            String location = XMLString::transcode(element_sib->getAttribute(XMLString::transcode("location")));
-            char originalResidue = std::string(XMLString::transcode(element_sib->getAttribute(XMLString::transcode("originalResidue"))))[0];
-            char replacementResidue = std::string(XMLString::transcode(element_sib->getAttribute(XMLString::transcode("replacementResidue"))))[0];
+            String location = sm_.convert(element_sib->getAttribute(sm_.convert("location").c_str()));
+            char originalResidue = std::string(sm_.convert(element_sib->getAttribute(sm_.convert("originalResidue").c_str())))[0];
+            char replacementResidue = std::string(sm_.convert(element_sib->getAttribute(sm_.convert("replacementResidue").c_str())))[0];
 
             if (!location.empty())
             {
@@ -2318,24 +2320,24 @@ namespace OpenMS
             current_sib->getNodeType() == DOMNode::ELEMENT_NODE)
         {
           DOMElement* element_sib = dynamic_cast<xercesc::DOMElement*>(current_sib);
-          if ((std::string)XMLString::transcode(element_sib->getTagName()) == "Modification")
+          if ((std::string)sm_.convert(element_sib->getTagName()) == "Modification")
           {
             SignedSize index = -2;
             try
             {
-              index = static_cast<SignedSize>(String(XMLString::transcode(element_sib->getAttribute(XMLString::transcode("location")))).toInt());
+              index = static_cast<SignedSize>(String(sm_.convert(element_sib->getAttribute(sm_.convert("location").c_str()))).toInt());
             }
             catch (...)
             {
               LOG_WARN << "Found unreadable modification location." << endl;
             }
 
-            //double monoisotopicMassDelta = XMLString::transcode(element_dbs->getAttribute(XMLString::transcode("monoisotopicMassDelta")));
+            //double monoisotopicMassDelta = sm_.convert(element_dbs->getAttribute(sm_.convert("monoisotopicMassDelta").c_str()));
 
             if (xl_ms_search_) // special case: XL-MS search results
             {
-              String pep_id = XMLString::transcode(peptide->getAttribute(XMLString::transcode("id")));
-              //DOMNodeList* cvParams = element_sib->getElementsByTagName(XMLString::transcode("cvParam"));
+              String pep_id = sm_.convert(peptide->getAttribute(sm_.convert("id").c_str()));
+              //DOMNodeList* cvParams = element_sib->getElementsByTagName(sm_.convert("cvParam").c_str());
               DOMElement* cvp = element_sib->getFirstElementChild();
               //for (XMLSize_t i = 0; i < cvParams.length(); ++i)
               bool donor_acceptor_found = false;
@@ -2343,23 +2345,23 @@ namespace OpenMS
 
               while (cvp)
               {
-                if (String(XMLString::transcode(cvp->getAttribute(XMLString::transcode("accession")))) == String("MS:1002509")) // cross-link donor
+                if (String(sm_.convert(cvp->getAttribute(sm_.convert("accession").c_str()))) == String("MS:1002509")) // cross-link donor
                 {
-                  String donor_val = XMLString::transcode(cvp->getAttribute(XMLString::transcode("value")));
+                  String donor_val = sm_.convert(cvp->getAttribute(sm_.convert("value").c_str()));
                   xl_id_donor_map_.insert(make_pair(pep_id, donor_val));
-                  String massdelta = XMLString::transcode(element_sib->getAttribute(XMLString::transcode("monoisotopicMassDelta")));
+                  String massdelta = sm_.convert(element_sib->getAttribute(sm_.convert("monoisotopicMassDelta").c_str()));
                   double monoisotopicMassDelta = massdelta.toDouble();
                   xl_mass_map_.insert(make_pair(pep_id, monoisotopicMassDelta));
                   xl_donor_pos_map_.insert(make_pair(donor_val, index-1));
 
                   DOMElement* cvp1 = element_sib->getFirstElementChild();
-                  String xl_mod_name = XMLString::transcode(cvp1->getAttribute(XMLString::transcode("name")));
+                  String xl_mod_name = sm_.convert(cvp1->getAttribute(sm_.convert("name").c_str()));
                   xl_mod_map_.insert(make_pair(pep_id, xl_mod_name));
                   donor_acceptor_found = true;
                 }
-                else if (String(XMLString::transcode(cvp->getAttribute(XMLString::transcode("accession")))) == String("MS:1002510")) // cross-link acceptor
+                else if (String(sm_.convert(cvp->getAttribute(sm_.convert("accession").c_str()))) == String("MS:1002510")) // cross-link acceptor
                 {
-                  String acceptor_val = XMLString::transcode(cvp->getAttribute(XMLString::transcode("value")));
+                  String acceptor_val = sm_.convert(cvp->getAttribute(sm_.convert("value").c_str()));
                   xl_id_acceptor_map_.insert(make_pair(pep_id, acceptor_val));
                   xl_acceptor_pos_map_.insert(make_pair(acceptor_val, index-1));
                   donor_acceptor_found = true;
@@ -2511,7 +2513,7 @@ namespace OpenMS
                     // try to parse information, give up if we cannot
                     try
                     {
-                      mod = String(XMLString::transcode(element_sib->getAttribute(XMLString::transcode("monoisotopicMassDelta"))));
+                      mod = String(sm_.convert(element_sib->getAttribute(sm_.convert("monoisotopicMassDelta").c_str())));
                       mass_delta = static_cast<double>(mod.toDouble());
                       has_mass_delta = true;
                     }
@@ -0,0 +1,323 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/HANDLERS/MzIdentMLStreamHandler.h>
+
+#include <xercesc/dom/DOMImplementationRegistry.hpp>
+#include <xercesc/dom/DOMNodeList.hpp>
+#include <xercesc/sax2/Attributes.hpp>
+
+#include <algorithm>
+
+using namespace std;
+using namespace xercesc;
+
+namespace OpenMS
+{
+  namespace Internal
+  {
+    namespace
+    {
+      /// Attribute values of the fragments are allocated on the heap of their
+      /// document and only freed with it, hence the record document is renewed
+      /// after this many records.
+      const Size RECORDS_PER_DOCUMENT = 1000;
+    }
+
+    MzIdentMLStreamHandler::MzIdentMLStreamHandler(vector<ProteinIdentification>& pro_id, MzIdentMLFile::PeptideIdentificationConsumer& consumer, Size batch_size, const String& filename, const String& version, const ProgressLogger& logger) :
+      XMLHandler(filename, version),
+      pro_id_(pro_id),
+      batch_(),
+      dom_handler_(pro_id, batch_, version, logger),
+      consumer_(consumer),
+      batch_size_(max(batch_size, Size(1))),
+      dom_impl_(DOMImplementationRegistry::getDOMImplementation(sm_.convert("XML 1.0").c_str())),
+      record_doc_(nullptr),
+      settings_doc_(nullptr),
+      fragment_root_(nullptr),
+      current_(nullptr),
+      text_(),
+      records_in_document_(0),
+      sil_id_(),
+      sil_count_(0),
+      settings_parsed_(false),
+      requires_dom_(false)
+    {
+      settings_doc_ = dom_impl_->createDocument();
+      settings_doc_->appendChild(settings_doc_->createElement(sm_.convert("MzIdentML").c_str()));
+      renewRecordDocument_();
+    }
+
+    MzIdentMLStreamHandler::~MzIdentMLStreamHandler()
+    {
+      // the documents have to be released before the DOM handler terminates Xerces
+      if (record_doc_ != nullptr)
+      {
+        record_doc_->release();
+      }
+      if (settings_doc_ != nullptr)
+      {
+        settings_doc_->release();
+      }
+    }
+
+    bool MzIdentMLStreamHandler::requiresDOM() const
+    {
+      return requires_dom_;
+    }
+
+    void MzIdentMLStreamHandler::renewRecordDocument_()
+    {
+      if (record_doc_ != nullptr)
+      {
+        record_doc_->release();
+      }
+      record_doc_ = dom_impl_->createDocument();
+      record_doc_->appendChild(record_doc_->createElement(sm_.convert("MzIdentML").c_str()));
+      records_in_document_ = 0;
+    }
+
+    void MzIdentMLStreamHandler::startElement(const XMLCh* const /*uri*/, const XMLCh* const /*local_name*/, const XMLCh* const qname, const xercesc::Attributes& attributes)
+    {
+      String tag = sm_.convert(qname);
+
+      // cross-linking MS: the peptides (which come first) have to be read with
+      // the complete document, nothing has been reported yet at this point
+      if (!settings_parsed_ && tag == "cvParam")
+      {
+        String accession;
+        optionalAttributeAsString_(accession, attributes, "accession");
+        if (accession == "MS:1002494" // cross-linking search
+           || accession == "MS:1002509" // cross-link donor
+           || accession == "MS:1002510") // cross-link acceptor
+        {
+          requires_dom_ = true;
+          throw EndParsingSoftly(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
+        }
+      }
+
+      xercesc::DOMDocument* doc = nullptr;
+      if (current_ != nullptr)
+      {
+        doc = current_->getOwnerDocument();
+      }
+      else if (tag == "AnalysisSoftware" || tag == "DBSequence" || tag == "Peptide" || tag == "PeptideEvidence"
+              || tag == "SpectrumIdentificationResult" || tag == "ProteinAmbiguityGroup")
+      {
+        doc = record_doc_;
+      }
+      else if (!settings_parsed_ && (tag == "SpectrumIdentification" || tag == "SpectrumIdentificationProtocol"
+                                     || tag == "SpectraData" || tag == "SearchDatabase" || tag == "SourceFile"))
+      {
+        doc = settings_doc_;
+      }
+      else
+      {
+        // structural elements are not recorded
+        if (tag == "AnalysisData" && !settings_parsed_)
+        {
+          parseSettings_();
+        }
+        else if (tag == "SpectrumIdentificationList")
+        {
+          sil_id_ = attributeAsString_(attributes, "id");
+          ++sil_count_;
+        }
+        return;
+      }
+
+      DOMElement* element = doc->createElement(qname);
+      for (XMLSize_t i = 0; i < attributes.getLength(); ++i)
+      {
+        element->setAttribute(attributes.getQName(i), attributes.getValue(i));
+      }
+      if (current_ != nullptr)
+      {
+        current_->appendChild(element);
+      }
+      else
+      {
+        doc->getDocumentElement()->appendChild(element);
+        fragment_root_ = element;
+      }
+      current_ = element;
+      text_.clear();
+    }
+
+    void MzIdentMLStreamHandler::characters(const XMLCh* const chars, const XMLSize_t length)
+    {
+      if (current_ != nullptr)
+      {
+        text_.append(chars, length);
+      }
+    }
+
+    void MzIdentMLStreamHandler::endElement(const XMLCh* const /*uri*/, const XMLCh* const /*local_name*/, const XMLCh* const /*qname*/)
+    {
+      if (current_ == nullptr)
+      {
+        return;
+      }
+
+      // only leaf elements (e.g. Seq, PeptideSequence) carry text in mzIdentML
+      if (!text_.empty() && current_->getFirstChild() == nullptr)
+      {
+        current_->appendChild(current_->getOwnerDocument()->createTextNode(text_.c_str()));
+      }
+      text_.clear();
+
+      if (current_ != fragment_root_)
+      {
+        current_ = dynamic_cast<DOMElement*>(current_->getParentNode());
+        return;
+      }
+
+      DOMElement* fragment = fragment_root_;
+      fragment_root_ = nullptr;
+      current_ = nullptr;
+      if (fragment->getOwnerDocument() == record_doc_)
+      {
+        parseRecord_(fragment);
+      }
+    }
+
+    void MzIdentMLStreamHandler::parseRecord_(DOMElement* record)
+    {
+      // the record is the only child of the root, i.e. this list contains just the record
+      DOMElement* root = record_doc_->getDocumentElement();
+      DOMNodeList* records = root->getChildNodes();
+
+      String tag = sm_.convert(record->getTagName());
+      if (tag == "SpectrumIdentificationResult")
+      {
+        if (!settings_parsed_)
+        {
+          parseSettings_();
+        }
+        dom_handler_.parseSpectrumIdentificationResultElement_(record, sil_id_);
+        if (batch_.size() >= batch_size_)
+        {
+          flush_();
+        }
+      }
+      else if (tag == "DBSequence")
+      {
+        dom_handler_.parseDBSequenceElements_(records);
+      }
+      else if (tag == "Peptide")
+      {
+        dom_handler_.parsePeptideElements_(records);
+      }
+      else if (tag == "PeptideEvidence")
+      {
+        dom_handler_.parsePeptideEvidenceElements_(records);
+      }
+      else if (tag == "AnalysisSoftware")
+      {
+        dom_handler_.parseAnalysisSoftwareList_(records);
+      }
+      else if (tag == "ProteinAmbiguityGroup" && !pro_id_.empty())
+      {
+        dom_handler_.parseProteinAmbiguityGroupElement_(record, pro_id_.back());
+      }
+
+      root->removeChild(record);
+      record->release();
+      if (++records_in_document_ >= RECORDS_PER_DOCUMENT)
+      {
+        renewRecordDocument_();
+      }
+    }
+
+    void MzIdentMLStreamHandler::parseSettings_()
+    {
+      settings_parsed_ = true;
+
+      // same order as MzIdentMLDOMHandler::readMzIdentMLFile
+      DOMNodeList* spectra_data = settings_doc_->getElementsByTagName(sm_.convert("SpectraData").c_str());
+      if (spectra_data->getLength() == 0)
+      {
+        fatalError(LOAD, "No SpectraData element found.");
+      }
+      dom_handler_.parseInputElements_(spectra_data);
+      dom_handler_.parseInputElements_(settings_doc_->getElementsByTagName(sm_.convert("SearchDatabase").c_str()));
+      dom_handler_.parseInputElements_(settings_doc_->getElementsByTagName(sm_.convert("SourceFile").c_str()));
+
+      DOMNodeList* identifications = settings_doc_->getElementsByTagName(sm_.convert("SpectrumIdentification").c_str());
+      if (identifications->getLength() == 0)
+      {
+        fatalError(LOAD, "No SpectrumIdentification element found.");
+      }
+      dom_handler_.parseSpectrumIdentificationElements_(identifications);
+
+      DOMNodeList* protocols = settings_doc_->getElementsByTagName(sm_.convert("SpectrumIdentificationProtocol").c_str());
+      if (protocols->getLength() == 0)
+      {
+        fatalError(LOAD, "No SpectrumIdentificationProtocol element found.");
+      }
+      dom_handler_.parseSpectrumIdentificationProtocolElements_(protocols);
+
+      settings_doc_->release();
+      settings_doc_ = nullptr;
+    }
+
+    void MzIdentMLStreamHandler::flush_()
+    {
+      if (!batch_.empty())
+      {
+        consumer_.consume(batch_);
+        batch_.clear();
+      }
+    }
+
+    void MzIdentMLStreamHandler::endDocument()
+    {
+      if (!settings_parsed_)
+      {
+        parseSettings_();
+      }
+      if (sil_count_ == 0)
+      {
+        fatalError(LOAD, "No SpectrumIdentificationList element found.");
+      }
+      flush_();
+
+      for (vector<ProteinIdentification>::iterator it = pro_id_.begin(); it != pro_id_.end(); ++it)
+      {
+        it->sort();
+      }
+    }
+
+  } // namespace Internal
+} // namespace OpenMS
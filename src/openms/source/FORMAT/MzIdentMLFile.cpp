@@ -38,12 +38,38 @@
 #include <OpenMS/FORMAT/CVMappingFile.h>
 #include <OpenMS/FORMAT/HANDLERS/MzIdentMLHandler.h>
 #include <OpenMS/FORMAT/HANDLERS/MzIdentMLDOMHandler.h>
+#include <OpenMS/FORMAT/HANDLERS/MzIdentMLStreamHandler.h>
 #include <OpenMS/SYSTEM/File.h>
 #include <OpenMS/FORMAT/FileHandler.h>
 
+#include <algorithm>
+#include <iterator>
+
 namespace OpenMS
 {
 
+  namespace
+  {
+    /// Appends the PeptideIdentifications streamed by MzIdentMLFile::transform to a vector
+    class PeptideIdentificationAppender :
+      public MzIdentMLFile::PeptideIdentificationConsumer
+    {
+public:
+      explicit PeptideIdentificationAppender(std::vector<PeptideIdentification>& peid) :
+        peid_(peid)
+      {
+      }
+
+      void consume(std::vector<PeptideIdentification>& batch) override
+      {
+        peid_.insert(peid_.end(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+      }
+
+private:
+      std::vector<PeptideIdentification>& peid_;
+    };
+  }
+
   MzIdentMLFile::MzIdentMLFile() :
     XMLFile("/SCHEMAS/mzIdentML1.1.0.xsd", "1.1.0")
   {
@@ -55,8 +81,34 @@ namespace OpenMS
 
   void MzIdentMLFile::load(const String& filename, std::vector<ProteinIdentification>& poid, std::vector<PeptideIdentification>& peid)
   {
+    PeptideIdentificationAppender appender(peid);
+    transform(filename, poid, appender);
+  }
+
+  void MzIdentMLFile::transform(const String& filename, std::vector<ProteinIdentification>& poid, PeptideIdentificationConsumer& consumer, Size batch_size)
+  {
+    {
+      Internal::MzIdentMLStreamHandler handler(poid, consumer, batch_size, filename, schema_version_, *this);
+      parse_(filename, &handler);
+      if (!handler.requiresDOM())
+      {
+        return;
+      }
+    }
+
+    // cross-linking MS data: streaming stopped before anything was reported
+    std::vector<PeptideIdentification> peid;
     Internal::MzIdentMLDOMHandler handler(poid, peid, schema_version_, *this);
     handler.readMzIdentMLFile(filename);
+
+    batch_size = std::max(batch_size, Size(1));
+    std::vector<PeptideIdentification> batch;
+    for (Size i = 0; i < peid.size(); i += batch_size)
+    {
+      std::vector<PeptideIdentification>::iterator last = peid.begin() + std::min(i + batch_size, peid.size());
+      batch.assign(std::make_move_iterator(peid.begin() + i), std::make_move_iterator(last));
+      consumer.consume(batch);
+    }
   }
 
   void MzIdentMLFile::store(const String& filename, const Identification& id) const
@@ -37,7 +37,7 @@
 namespace OpenMS
 {
   void MapConversion::convert(UInt64 const input_map_index,
-                              PeakMap& input_map,
+                              PeakMap const& input_map,
                               ConsensusMap& output_map,
                               Size n)
   {
@@ -46,17 +46,25 @@ namespace OpenMS
     // see @todo above
     output_map.setUniqueId();
 
-    input_map.updateRanges(1);
-    if (n > input_map.getSize())
+    // count the MS1 peaks (the ranges of the input map may not be up to date)
+    Size nr_peaks = 0;
+    for (PeakMap::ConstIterator spec = input_map.begin(); spec != input_map.end(); ++spec)
     {
-      n = input_map.getSize();
+      if (spec->getMSLevel() == 1)
+      {
+        nr_peaks += spec->size();
+      }
     }
-    output_map.reserve(n);
     std::vector<Peak2D> tmp;
-    tmp.reserve(input_map.getSize());
+    tmp.reserve(nr_peaks);
 
     // TODO Avoid tripling the memory consumption by this call
     input_map.get2DData(tmp);
+    if (n > tmp.size())
+    {
+      n = tmp.size();
+    }
+    output_map.reserve(n);
 
     std::partial_sort(tmp.begin(),
                       tmp.begin() + n,
@@ -68,6 +68,8 @@ namespace OpenMS
       defaults_.setValue("number_of_bins", 100, "Number of bins used for visualization. Only needed if each iteration step of the EM-Algorithm will be visualized", ListUtils::create<String>("advanced"));
       defaults_.setValue("incorrectly_assigned", "Gumbel", "for 'Gumbel', the Gumbel distribution is used to plot incorrectly assigned sequences. For 'Gauss', the Gauss distribution is used.", ListUtils::create<String>("advanced"));
       defaults_.setValue("max_nr_iterations", 1000, "Bounds the number of iterations for the EM algorithm when convergence is slow.", ListUtils::create<String>("advanced"));
+      defaults_.setValue("fit_subsample_size", 0, "If larger than zero, the EM algorithm is run on at most this many scores, which are taken as evenly spaced quantiles of the sorted score distribution (deterministic). Probabilities are still computed for all scores. Speeds up fitting of very large data sets.", ListUtils::create<String>("advanced"));
+      defaults_.setMinInt("fit_subsample_size", 0);
       defaults_.setValidStrings("incorrectly_assigned", ListUtils::create<String>("Gumbel,Gauss"));
       defaultsToParam_();
       getNegativeGnuplotFormula_ = &PosteriorErrorProbabilityModel::getGumbelGnuplotFormula;
@@ -90,7 +92,22 @@ namespace OpenMS
 
       smallest_score_ = search_engine_scores[0];
 
-      vector<double> x_scores{search_engine_scores};
+      // optionally fit on a deterministic subsample (evenly spaced quantiles, including the extremes)
+      vector<double> x_scores;
+      Size subsample_size = (Int)param_.getValue("fit_subsample_size");
+      if (subsample_size > 1 && subsample_size < search_engine_scores.size())
+      {
+        x_scores.reserve(subsample_size);
+        const double step = double(search_engine_scores.size() - 1) / (subsample_size - 1);
+        for (Size i = 0; i < subsample_size; ++i)
+        {
+          x_scores.push_back(search_engine_scores[Size(i * step + 0.5)]);
+        }
+      }
+      else
+      {
+        x_scores = search_engine_scores;
+      }
       for (double & d : x_scores) { d += fabs(smallest_score_) + 0.001; }
 
       negative_prior_ = 0.7;
@@ -116,7 +133,7 @@ namespace OpenMS
       correctly_assigned_fit_param_.sigma = incorrectly_assigned_fit_param_.sigma;
       correctly_assigned_fit_param_.A = 1.0   / sqrt(2 * Constants::PI * pow(correctly_assigned_fit_param_.sigma, 2));
 
-      vector<double> incorrect_density, correct_density;
+      vector<double> incorrect_density, correct_density, posteriors;
       fillDensities(x_scores, incorrect_density, correct_density);
 
       double maxlike = computeMaxLikelihood(incorrect_density, correct_density);
@@ -156,19 +173,36 @@ namespace OpenMS
       {
         //-------------------------------------------------------------
         // E-STEP
-        double one_minus_sum_posterior = one_minus_sum_post(incorrect_density, correct_density);
-        double sum_posterior = sum_post(incorrect_density, correct_density);
+        // posteriors are computed once per iteration; the sums below are
+        // equivalent to one_minus_sum_post(), sum_post(), sum_pos_x0() etc.
+        computePosteriors_(incorrect_density, correct_density, posteriors);
+        const Size n = x_scores.size();
+        const double* x = x_scores.data();
+        const double* post = posteriors.data();
+
+        double one_minus_sum_posterior(0), sum_posterior(0);
+        double sum_positive_x0(0), sum_negative_x0(0);
+        for (Size i = 0; i < n; ++i)
+        {
+          one_minus_sum_posterior += 1 - post[i];
+          sum_posterior += post[i];
+          sum_positive_x0 += (1 - post[i]) * x[i];
+          sum_negative_x0 += post[i] * x[i];
+        }
 
         // new mean
-        double sum_positive_x0 = sum_pos_x0(x_scores, incorrect_density, correct_density);
-        double sum_negative_x0 = sum_neg_x0(x_scores, incorrect_density, correct_density);
-
         double positive_mean = sum_positive_x0 / one_minus_sum_posterior;
         double negative_mean = sum_negative_x0 / sum_posterior;
 
-        //i new standard deviation
-        double sum_positive_sigma = sum_pos_sigma(x_scores, incorrect_density, correct_density, positive_mean);
-        double sum_negative_sigma = sum_neg_sigma(x_scores, incorrect_density, correct_density, negative_mean);
+        // new standard deviation
+        double sum_positive_sigma(0), sum_negative_sigma(0);
+        for (Size i = 0; i < n; ++i)
+        {
+          const double pos_diff = x[i] - positive_mean;
+          const double neg_diff = x[i] - negative_mean;
+          sum_positive_sigma += (1 - post[i]) * pos_diff * pos_diff;
+          sum_negative_sigma += post[i] * neg_diff * neg_diff;
+        }
 
         // update parameters
         correctly_assigned_fit_param_.x0 = positive_mean;
@@ -257,28 +291,62 @@ namespace OpenMS
 
       if (!return_value) return false;
 
-      probabilities = std::vector<double>(search_engine_scores);
-      for (double & p : probabilities) { p = computeProbability(p); }
+      computeProbabilities(search_engine_scores, probabilities);
 
       return true;
     }
 
-    void PosteriorErrorProbabilityModel::fillDensities(vector<double>& x_scores, vector<double>& incorrect_density, vector<double>& correct_density)
+    void PosteriorErrorProbabilityModel::computeProbabilities(const vector<double>& search_engine_scores, vector<double>& probabilities) const
     {
-      if (incorrect_density.size() != x_scores.size())
+      probabilities.resize(search_engine_scores.size());
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for (SignedSize i = 0; i < (SignedSize)search_engine_scores.size(); ++i)
       {
-        incorrect_density.resize(x_scores.size());
-        correct_density.resize(x_scores.size());
+        probabilities[i] = computeProbability(search_engine_scores[i]);
+      }
+    }
+
+    void PosteriorErrorProbabilityModel::fillDensities(vector<double>& x_scores, vector<double>& incorrect_density, vector<double>& correct_density)
+    {
+      const Size n = x_scores.size();
+      incorrect_density.resize(n);
+      correct_density.resize(n);
+
+      // Gaussian densities scaled to amplitude A (same as GaussFitResult::eval, but with the
+      // constants hoisted out of the loop so the compiler can vectorize it)
+      // TODO: incorrect is currently filled with gauss as fitting gumble is not supported
+      const double inc_A = incorrectly_assigned_fit_param_.A;
+      const double inc_x0 = incorrectly_assigned_fit_param_.x0;
+      const double inc_f = -0.5 / (incorrectly_assigned_fit_param_.sigma * incorrectly_assigned_fit_param_.sigma);
+      const double cor_A = correctly_assigned_fit_param_.A;
+      const double cor_x0 = correctly_assigned_fit_param_.x0;
+      const double cor_f = -0.5 / (correctly_assigned_fit_param_.sigma * correctly_assigned_fit_param_.sigma);
+
+      const double* x = x_scores.data();
+      double* incorrect = incorrect_density.data();
+      double* correct = correct_density.data();
+      for (Size i = 0; i < n; ++i)
+      {
+        const double inc_diff = x[i] - inc_x0;
+        const double cor_diff = x[i] - cor_x0;
+        incorrect[i] = inc_A * exp(inc_f * inc_diff * inc_diff);
+        correct[i] = cor_A * exp(cor_f * cor_diff * cor_diff);
       }
-      vector<double>::iterator incorrect(incorrect_density.begin());
-      vector<double>::iterator correct(correct_density.begin());
-      for (double const & score : x_scores)
+    }
+
+    void PosteriorErrorProbabilityModel::computePosteriors_(const vector<double>& incorrect_density, const vector<double>& correct_density, vector<double>& posteriors) const
+    {
+      const Size n = incorrect_density.size();
+      posteriors.resize(n);
+      const double* incorrect = incorrect_density.data();
+      const double* correct = correct_density.data();
+      double* post = posteriors.data();
+      for (Size i = 0; i < n; ++i)
       {
-        // TODO: incorrect is currently filled with gauss as fitting gumble is not supported
-        *incorrect = incorrectly_assigned_fit_param_.eval(score);
-        *correct = correctly_assigned_fit_param_.eval(score);
-        ++incorrect;
-        ++correct;
+        const double neg = negative_prior_ * incorrect[i];
+        post[i] = neg / (neg + (1 - negative_prior_) * correct[i]);
       }
     }
 
@@ -794,8 +862,14 @@ namespace OpenMS
 
         if (engine == search_engine)
         {
-          for (PeptideIdentification & pep : peptide_ids)
+          // every peptide identification is only touched by one thread
+          bool unable_to_fit(true), might_not_be_well_fit(true);
+#ifdef _OPENMP
+#pragma omp parallel for reduction(&&: unable_to_fit, might_not_be_well_fit)
+#endif
+          for (SignedSize pep_idx = 0; pep_idx < (SignedSize)peptide_ids.size(); ++pep_idx)
           {
+            PeptideIdentification & pep = peptide_ids[pep_idx];
             if (prot.getIdentifier() == pep.getIdentifier())
             {
               String score_type = pep.getScoreType() + "_score";
@@ -817,8 +891,8 @@ namespace OpenMS
                     score = PEP_model.computeProbability(score);
 
                     // invalid score? invalid fit!
-                    if ((score > 0.0) && (score < 1.0)) unable_to_fit_data = false; 
-                    if ((score > 0.2) && (score < 0.8)) data_might_not_be_well_fit = false;
+                    unable_to_fit = unable_to_fit && !((score > 0.0) && (score < 1.0));
+                    might_not_be_well_fit = might_not_be_well_fit && !((score > 0.2) && (score < 0.8));
                   }
                   hit.setScore(score);
                   if (prob_correct)
@@ -844,6 +918,8 @@ namespace OpenMS
               pep.setHigherScoreBetter(false);
             }
           }
+          unable_to_fit_data = unable_to_fit_data && unable_to_fit;
+          data_might_not_be_well_fit = data_might_not_be_well_fit && might_not_be_well_fit;
         }
       }
     }
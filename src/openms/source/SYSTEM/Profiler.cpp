@@ -0,0 +1,321 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/SYSTEM/Profiler.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/SYSTEM/SysInfo.h>
+
+#include <cmath>
+#include <fstream>
+
+namespace OpenMS
+{
+  namespace
+  {
+    /// nesting level of the phases of the calling thread
+    thread_local Size phase_depth = 0;
+
+    String quoted(const String& s)
+    {
+      String result = "\"";
+      for (String::const_iterator it = s.begin(); it != s.end(); ++it)
+      {
+        if (*it == '"' || *it == '\\')
+        {
+          result += '\\';
+        }
+        result += *it;
+      }
+      return result + "\"";
+    }
+  }
+
+  const std::string Profiler::NamesOfReportFormat[] = {"json", "chrome_trace"};
+
+  std::atomic<bool> Profiler::enabled_(false);
+
+  Profiler::ScopedPhase::ScopedPhase(const char* name) :
+    name_(name),
+    active_(Profiler::isEnabled()),
+    start_(0.0),
+    bytes_read_(0),
+    bytes_written_(0)
+  {
+    if (!active_)
+    {
+      return;
+    }
+    start_ = Profiler::getInstance().now_();
+    SysInfo::getProcessIOBytes(bytes_read_, bytes_written_);
+    ++phase_depth;
+    stop_watch_.start();
+  }
+
+  Profiler::ScopedPhase::~ScopedPhase()
+  {
+    if (!active_)
+    {
+      return;
+    }
+    stop_watch_.stop();
+    --phase_depth;
+
+    Profiler& profiler = Profiler::getInstance();
+    PhaseRecord phase;
+    phase.name = name_;
+    phase.thread = threadIndex_();
+    phase.depth = phase_depth;
+    phase.start = start_;
+    phase.wall_time = profiler.now_() - start_;
+    phase.cpu_time = stop_watch_.getCPUTime();
+    SysInfo::getProcessPeakMemoryConsumption(phase.peak_memory_kb);
+    size_t bytes_read(0), bytes_written(0);
+    if (SysInfo::getProcessIOBytes(bytes_read, bytes_written))
+    {
+      phase.bytes_read = bytes_read - bytes_read_;
+      phase.bytes_written = bytes_written - bytes_written_;
+    }
+    profiler.addPhase_(phase);
+  }
+
+  Profiler::Profiler() :
+    origin_(std::chrono::steady_clock::now())
+  {
+  }
+
+  Profiler& Profiler::getInstance()
+  {
+    static Profiler profiler;
+    return profiler;
+  }
+
+  void Profiler::enable()
+  {
+    clear();
+    enabled_ = true;
+  }
+
+  void Profiler::disable()
+  {
+    enabled_ = false;
+  }
+
+  void Profiler::clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    origin_ = std::chrono::steady_clock::now();
+    phases_.clear();
+    counters_.clear();
+    histograms_.clear();
+  }
+
+  double Profiler::now_() const
+  {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - origin_).count();
+  }
+
+  Size Profiler::threadIndex_()
+  {
+    static std::atomic<Size> thread_count(0);
+    thread_local Size index = thread_count++;
+    return index;
+  }
+
+  void Profiler::addPhase_(const PhaseRecord& phase)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    phases_.push_back(phase);
+  }
+
+  void Profiler::addCounter(const String& name, double value)
+  {
+    const double time = now_();
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::pair<double, double>& counter = counters_[name];
+    counter.first += value;
+    counter.second = time;
+  }
+
+  void Profiler::addHistogramValue(const String& name, double value)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Histogram& histogram = histograms_[name];
+    if (histogram.count == 0)
+    {
+      histogram.min = histogram.max = value;
+    }
+    histogram.min = std::min(histogram.min, value);
+    histogram.max = std::max(histogram.max, value);
+    histogram.sum += value;
+    ++histogram.count;
+    if (value > 0.0)
+    {
+      ++histogram.bins[Int(std::floor(std::log2(value)))];
+    }
+    else
+    {
+      ++histogram.non_positive;
+    }
+  }
+
+  std::vector<Profiler::PhaseRecord> Profiler::getPhases() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return phases_;
+  }
+
+  std::map<String, double> Profiler::getCounters() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::map<String, double> result;
+    for (std::map<String, std::pair<double, double> >::const_iterator it = counters_.begin(); it != counters_.end(); ++it)
+    {
+      result[it->first] = it->second.first;
+    }
+    return result;
+  }
+
+  std::map<String, Profiler::Histogram> Profiler::getHistograms() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return histograms_;
+  }
+
+  void Profiler::store(const String& filename, ReportFormat format) const
+  {
+    std::ofstream os(filename.c_str());
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (format == CHROME_TRACE)
+    {
+      storeChromeTrace_(os);
+    }
+    else
+    {
+      storeJSON_(os);
+    }
+  }
+
+  void Profiler::storeJSON_(std::ostream& os) const
+  {
+    // aggregate the phases by name, in order of first completion
+    std::vector<String> names;
+    std::map<String, PhaseRecord> totals;
+    std::map<String, Size> calls;
+    for (std::vector<PhaseRecord>::const_iterator it = phases_.begin(); it != phases_.end(); ++it)
+    {
+      if (calls.find(it->name) == calls.end())
+      {
+        names.push_back(it->name);
+        totals[it->name] = *it;
+        calls[it->name] = 1;
+        continue;
+      }
+      PhaseRecord& total = totals[it->name];
+      total.wall_time += it->wall_time;
+      total.cpu_time += it->cpu_time;
+      total.peak_memory_kb = std::max(total.peak_memory_kb, it->peak_memory_kb);
+      total.bytes_read += it->bytes_read;
+      total.bytes_written += it->bytes_written;
+      ++calls[it->name];
+    }
+
+    os << "{\n  \"phases\": [";
+    for (Size i = 0; i < names.size(); ++i)
+    {
+      const PhaseRecord& total = totals[names[i]];
+      os << (i == 0 ? "\n" : ",\n")
+         << "    {\"name\": " << quoted(total.name)
+         << ", \"calls\": " << calls[total.name]
+         << ", \"wall_time_s\": " << total.wall_time
+         << ", \"cpu_time_s\": " << total.cpu_time
+         << ", \"thread_utilization\": " << (total.wall_time > 0.0 ? total.cpu_time / total.wall_time : 0.0)
+         << ", \"peak_memory_kb\": " << total.peak_memory_kb
+         << ", \"bytes_read\": " << total.bytes_read
+         << ", \"bytes_written\": " << total.bytes_written << "}";
+    }
+    os << "\n  ],\n  \"counters\": {";
+    for (std::map<String, std::pair<double, double> >::const_iterator it = counters_.begin(); it != counters_.end(); ++it)
+    {
+      os << (it == counters_.begin() ? "\n" : ",\n") << "    " << quoted(it->first) << ": " << it->second.first;
+    }
+    os << "\n  },\n  \"histograms\": {";
+    for (std::map<String, Histogram>::const_iterator it = histograms_.begin(); it != histograms_.end(); ++it)
+    {
+      const Histogram& h = it->second;
+      os << (it == histograms_.begin() ? "\n" : ",\n") << "    " << quoted(it->first) << ": {"
+         << "\"count\": " << h.count << ", \"sum\": " << h.sum << ", \"mean\": " << (h.count ? h.sum / h.count : 0.0)
+         << ", \"min\": " << h.min << ", \"max\": " << h.max << ", \"non_positive\": " << h.non_positive << ", \"bins\": [";
+      for (std::map<Int, Size>::const_iterator bin = h.bins.begin(); bin != h.bins.end(); ++bin)
+      {
+        os << (bin == h.bins.begin() ? "" : ", ")
+           << "{\"lower\": " << std::pow(2.0, bin->first) << ", \"upper\": " << std::pow(2.0, bin->first + 1) << ", \"count\": " << bin->second << "}";
+      }
+      os << "]}";
+    }
+    os << "\n  }\n}\n";
+  }
+
+  void Profiler::storeChromeTrace_(std::ostream& os) const
+  {
+    // see the 'Trace Event Format' specification (complete events 'X' and counter events 'C', times in microseconds)
+    os << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    bool first = true;
+    for (std::vector<PhaseRecord>::const_iterator it = phases_.begin(); it != phases_.end(); ++it)
+    {
+      os << (first ? "\n" : ",\n")
+         << "  {\"name\": " << quoted(it->name) << ", \"cat\": \"phase\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << it->thread
+         << ", \"ts\": " << Int64(it->start * 1e6) << ", \"dur\": " << Int64(it->wall_time * 1e6)
+         << ", \"args\": {\"cpu_time_s\": " << it->cpu_time
+         << ", \"thread_utilization\": " << (it->wall_time > 0.0 ? it->cpu_time / it->wall_time : 0.0)
+         << ", \"peak_memory_kb\": " << it->peak_memory_kb
+         << ", \"bytes_read\": " << it->bytes_read
+         << ", \"bytes_written\": " << it->bytes_written << "}}";
+      first = false;
+    }
+    for (std::map<String, std::pair<double, double> >::const_iterator it = counters_.begin(); it != counters_.end(); ++it)
+    {
+      os << (first ? "\n" : ",\n")
+         << "  {\"name\": " << quoted(it->first) << ", \"ph\": \"C\", \"pid\": 1, \"ts\": " << Int64(it->second.second * 1e6)
+         << ", \"args\": {\"value\": " << it->second.first << "}}";
+      first = false;
+    }
+    os << "\n]}\n";
+  }
+
+} // namespace OpenMS
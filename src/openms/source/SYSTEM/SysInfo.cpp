@@ -40,9 +40,11 @@
 #elif __APPLE__
 #include <mach/mach.h>
 #include <mach/mach_init.h>
+#include <sys/resource.h>
 #else
 #include <cstdio>
 #include <unistd.h>
+#include <sys/resource.h>
 
 #define OMS_USELINUXMEMORYPLATFORM
 #endif
@@ -141,11 +143,61 @@ namespace OpenMS
     }
     mem_virtual = pmc.PeakWorkingSetSize / 1024; // byte to KB
     return true;
-#elif __APPLE__
-    //todo: find a good API to do this
-    return false;
+#else
+    // maximum resident set size
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+      return false;
+    }
+#ifdef __APPLE__
+    mem_virtual = usage.ru_maxrss / 1024; // byte to KB
 #else // Linux
-    //todo: find a good API to do this
+    mem_virtual = usage.ru_maxrss; // already in KB
+#endif
+    return true;
+#endif
+  }
+
+  bool SysInfo::getProcessIOBytes(size_t& bytes_read, size_t& bytes_written)
+  {
+    bytes_read = bytes_written = 0;
+#ifdef OPENMS_WINDOWSPLATFORM
+    IO_COUNTERS io;
+    if (!GetProcessIoCounters(GetCurrentProcess(), &io))
+    {
+      return false;
+    }
+    bytes_read = (size_t)io.ReadTransferCount;
+    bytes_written = (size_t)io.WriteTransferCount;
+    return true;
+#elif defined(OMS_USELINUXMEMORYPLATFORM)
+    // 'rchar' and 'wchar' count all bytes passed to read() and write() like
+    // calls, including those served from the page cache (see proc(5))
+    FILE *f = fopen("/proc/self/io", "r");
+    if (!f)
+    {
+      return false;
+    }
+    char key[32];
+    unsigned long long value;
+    int found = 0;
+    while (fscanf(f, "%31s %llu", key, &value) == 2)
+    {
+      if (String(key) == "rchar:")
+      {
+        bytes_read = (size_t)value;
+        ++found;
+      }
+      else if (String(key) == "wchar:")
+      {
+        bytes_written = (size_t)value;
+        ++found;
+      }
+    }
+    fclose(f);
+    return found == 2;
+#else
     return false;
 #endif
   }
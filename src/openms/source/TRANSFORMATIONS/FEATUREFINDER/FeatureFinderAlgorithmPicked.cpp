@@ -33,6 +33,7 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/FeatureFinderAlgorithmPicked.h>
+#include <OpenMS/SYSTEM/Profiler.h>
 
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/EGHTraceFitter.h>
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/GaussTraceFitter.h>
@@ -157,6 +158,7 @@ namespace OpenMS
 
   void FeatureFinderAlgorithmPicked::run()
   {
+    OPENMS_PROFILE_PHASE("FeatureFinderAlgorithmPicked");
     //-------------------------------------------------------------------------
     //General initialization
     //---------------------------------------------------------------------------
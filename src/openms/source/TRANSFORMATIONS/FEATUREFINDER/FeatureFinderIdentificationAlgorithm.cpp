@@ -33,6 +33,7 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/FeatureFinderIdentificationAlgorithm.h>
+#include <OpenMS/SYSTEM/Profiler.h>
 
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/EGHTraceFitter.h>
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/ElutionModelFitter.h>
@@ -170,6 +171,7 @@ namespace OpenMS
     FeatureMap& features
     )
   {
+    OPENMS_PROFILE_PHASE("FeatureFinderIdentificationAlgorithm");
     if ((svm_n_samples_ > 0) && (svm_n_samples_ < 2 * svm_n_parts_))
     {
       String msg = "Sample size of " + String(svm_n_samples_) +
@@ -33,6 +33,7 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/FeatureFinderMultiplexAlgorithm.h>
+#include <OpenMS/SYSTEM/Profiler.h>
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/MultiplexDeltaMassesGenerator.h>
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/MultiplexDeltaMasses.h>
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/MultiplexIsotopicPeakPattern.h>
@@ -658,6 +659,7 @@ namespace OpenMS
 
   void FeatureFinderMultiplexAlgorithm::run(MSExperiment& exp, bool progress)
   {
+    OPENMS_PROFILE_PHASE("FeatureFinderMultiplexAlgorithm");
     // parameter section: algorithm, get selected charge range
     String charge_string = param_.getValue("algorithm:charge");
     charge_min_ = charge_string.prefix(':').toInt();
@@ -41,6 +41,11 @@
 #include <OpenMS/MATH/MISC/SplineBisection.h>
 #include <OpenMS/MATH/MISC/CubicSpline2d.h>
 
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace std;
 
@@ -122,7 +127,7 @@ namespace OpenMS
 
     // signal-to-noise estimation
     SignalToNoiseEstimatorMedian<MSSpectrum > snt;
-    snt.setParameters(param_.copy("SignalToNoise:", true));
+    snt.setParameters(snt_param_);
 
     if (signal_to_noise_ > 0.0)
     {
@@ -415,9 +420,8 @@ namespace OpenMS
   }
 
   /**
-  * @brief Applies the peak-picking algorithm to a map (MSExperiment). This
-  * method picks peaks for each scan in the map consecutively. The resulting
-  * picked peaks are written to the output map.
+  * @brief Applies the peak-picking algorithm to a map (MSExperiment). The
+  * resulting picked peaks are written to the output map.
   *
   * @param input  input map in profile mode
   * @param output  output map with picked peaks
@@ -430,10 +434,27 @@ namespace OpenMS
     pickExperiment(input, output, boundaries_spec, boundaries_chrom, check_spectrum_type);
   }
 
+  bool PeakPickerHiRes::isSelectedForPicking(const MSSpectrum& spectrum, const bool check_spectrum_type) const
+  {
+    if (ms_levels_.empty()) // auto mode
+    {
+      return spectrum.getType() != SpectrumSettings::CENTROID;
+    }
+    if (!ListUtils::contains(ms_levels_, spectrum.getMSLevel())) // manual mode
+    {
+      return false;
+    }
+    // determine type of spectral data (profile or centroided)
+    if (spectrum.getType() == SpectrumSettings::CENTROID && check_spectrum_type)
+    {
+      throw OpenMS::Exception::IllegalArgument(__FILE__, __LINE__, __FUNCTION__, "Error: Centroided data provided but profile spectra expected.");
+    }
+    return true;
+  }
+
   /**
-  * @brief Applies the peak-picking algorithm to a map (MSExperiment). This
-  * method picks peaks for each scan in the map consecutively. The resulting
-  * picked peaks are written to the output map.
+  * @brief Applies the peak-picking algorithm to a map (MSExperiment). The
+  * resulting picked peaks are written to the output map.
   *
   * @param input  input map in profile mode
   * @param output  output map with picked peaks
@@ -455,70 +476,80 @@ namespace OpenMS
     // resize output with respect to input
     output.resize(input.size());
 
-    Size progress = 0;
-    startProgress(0, input.size() + input.getChromatograms().size(), "picking peaks");
+    // decide up front which spectra are picked (may throw, so not inside the parallel section)
+    std::vector<char> picked(input.size());
+    for (Size scan_idx = 0; scan_idx != input.size(); ++scan_idx)
+    {
+      picked[scan_idx] = isSelectedForPicking(input[scan_idx], check_spectrum_type);
+    }
 
-    if (input.getNrSpectra() > 0)
+    const Size n_spectra = input.size();
+    const Size n_chromatograms = input.getChromatograms().size();
+    std::vector<std::vector<PeakBoundary> > boundaries_s(n_spectra); // peak boundaries of each spectrum
+    std::vector<std::vector<PeakBoundary> > boundaries_c(n_chromatograms); // peak boundaries of each chromatogram
+    std::vector<MSChromatogram> chromatograms(n_chromatograms);
+
+    Size progress = 0;
+    startProgress(0, n_spectra + n_chromatograms, "picking peaks");
+
+    // spectra and chromatograms share one loop, so that maps with only few
+    // spectra but many chromatograms (SRM data) are processed in parallel as well
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)(n_spectra + n_chromatograms); ++i)
     {
-      for (Size scan_idx = 0; scan_idx != input.size(); ++scan_idx)
+      if (i < (SignedSize)n_spectra)
       {
-        if (ms_levels_.empty()) // auto mode
-        {
-          SpectrumSettings::SpectrumType spectrum_type = input[scan_idx].getType();
-          if (spectrum_type == SpectrumSettings::CENTROID)
-          {
-            output[scan_idx] = input[scan_idx];
-          }
-          else
-          {
-            std::vector<PeakBoundary> boundaries_s; // peak boundaries of a single spectrum
-
-            pick(input[scan_idx], output[scan_idx], boundaries_s);
-            boundaries_spec.push_back(boundaries_s);
-          }
-        }
-        else if (!ListUtils::contains(ms_levels_, input[scan_idx].getMSLevel())) // manual mode
+        if (picked[i])
         {
-          output[scan_idx] = input[scan_idx];
+          pick(input[i], output[i], boundaries_s[i]);
         }
         else
         {
-          std::vector<PeakBoundary> boundaries_s; // peak boundaries of a single spectrum
+          output[i] = input[i];
+        }
+      }
+      else
+      {
+        const Size chrom_idx = i - n_spectra;
+        pick(input.getChromatograms()[chrom_idx], chromatograms[chrom_idx], boundaries_c[chrom_idx]);
+      }
 
-                                                  // determine type of spectral data (profile or centroided)
-          SpectrumSettings::SpectrumType spectrum_type = input[scan_idx].getType();
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+      ++progress;
 
-          if (spectrum_type == SpectrumSettings::CENTROID && check_spectrum_type)
-          {
-            throw OpenMS::Exception::IllegalArgument(__FILE__, __LINE__, __FUNCTION__, "Error: Centroided data provided but profile spectra expected.");
-          }
-
-          pick(input[scan_idx], output[scan_idx], boundaries_s);
-          boundaries_spec.push_back(boundaries_s);
-        }
-        setProgress(++progress);
+      IF_MASTERTHREAD
+      {
+        setProgress(progress);
       }
     }
+    endProgress();
 
-
-    for (Size i = 0; i < input.getChromatograms().size(); ++i)
+    // boundaries are only reported for picked spectra, in input order
+    for (Size scan_idx = 0; scan_idx != n_spectra; ++scan_idx)
     {
-      MSChromatogram chromatogram;
-      std::vector<PeakBoundary> boundaries_c; // peak boundaries of a single chromatogram
-      pick(input.getChromatograms()[i], chromatogram, boundaries_c);
-      output.addChromatogram(chromatogram);
-      boundaries_chrom.push_back(boundaries_c);
-      setProgress(++progress);
+      if (picked[scan_idx])
+      {
+        boundaries_spec.push_back(std::vector<PeakBoundary>());
+        boundaries_spec.back().swap(boundaries_s[scan_idx]);
+      }
+    }
+    output.getChromatograms().swap(chromatograms);
+    for (Size chrom_idx = 0; chrom_idx != n_chromatograms; ++chrom_idx)
+    {
+      boundaries_chrom.push_back(std::vector<PeakBoundary>());
+      boundaries_chrom.back().swap(boundaries_c[chrom_idx]);
     }
-    endProgress();
 
     return;
   }
 
   /**
-  @brief Applies the peak-picking algorithm to a map (MSExperiment). This
-  method picks peaks for each scan in the map consecutively. The resulting
-  picked peaks are written to the output map.
+  @brief Applies the peak-picking algorithm to a map (MSExperiment). The
+  resulting picked peaks are written to the output map.
 
   Currently we have to give up const-correctness but we know that everything on disc is constant
   */
@@ -536,61 +567,93 @@ namespace OpenMS
     // resize output with respect to input
     output.resize(input.size());
 
-    if (input.getNrSpectra() > 0)
+    // Reading from disc is not thread-safe: read a batch serially, then pick it in parallel.
+    // The batch size bounds the number of profile spectra held in memory at the same time.
+    const Size batch_size = 1000;
+
+    std::vector<MSSpectrum> spectra;
+    for (Size batch_start = 0; batch_start < input.getNrSpectra(); batch_start += batch_size)
     {
-      for (Size scan_idx = 0; scan_idx != input.size(); ++scan_idx)
+      const Size batch_end = std::min(batch_start + batch_size, input.getNrSpectra());
+      spectra.resize(batch_end - batch_start);
+      for (Size scan_idx = batch_start; scan_idx != batch_end; ++scan_idx)
       {
-        if (ms_levels_.empty()) //auto mode
+        MSSpectrum& s = spectra[scan_idx - batch_start];
+        s = input[scan_idx];
+        if (isSelectedForPicking(s, false))
         {
-          MSSpectrum s = input[scan_idx];
           s.sortByPosition();
-
-          // determine type of spectral data (profile or centroided)
-          SpectrumSettings::SpectrumType spectrumType = s.getType();
-          if (spectrumType == SpectrumSettings::CENTROID)
-          {
-            output[scan_idx] = input[scan_idx];
-          }
-          else
-          {
-            pick(s, output[scan_idx]);
-          }
-        }
-        else if (!ListUtils::contains(ms_levels_, input[scan_idx].getMSLevel())) // manual mode
-        {
-          output[scan_idx] = input[scan_idx];
         }
-        else
-        {
-          MSSpectrum s = input[scan_idx];
-          s.sortByPosition();
+      }
 
-          // determine type of spectral data (profile or centroided)
-          SpectrumSettings::SpectrumType spectrum_type = s.getType();
+      pickSpectra(spectra, check_spectrum_type);
 
-          if (spectrum_type == SpectrumSettings::CENTROID && check_spectrum_type)
-          {
-            throw OpenMS::Exception::IllegalArgument(__FILE__, __LINE__, __FUNCTION__, "Error: Centroided data provided but profile spectra expected.");
-          }
-
-          pick(s, output[scan_idx]);
-        }
-        setProgress(++progress);
+      for (Size scan_idx = batch_start; scan_idx != batch_end; ++scan_idx)
+      {
+        output[scan_idx] = spectra[scan_idx - batch_start];
       }
+      progress += batch_end - batch_start;
+      setProgress(progress);
     }
 
-    for (Size i = 0; i < input.getNrChromatograms(); ++i)
+    std::vector<MSChromatogram> chromatograms;
+    for (Size batch_start = 0; batch_start < input.getNrChromatograms(); batch_start += batch_size)
     {
-      MSChromatogram chromatogram;
-      pick(input.getChromatogram(i), chromatogram);
-      output.addChromatogram(chromatogram);
-      setProgress(++progress);
+      const Size batch_end = std::min(batch_start + batch_size, input.getNrChromatograms());
+      chromatograms.resize(batch_end - batch_start);
+      for (Size chrom_idx = batch_start; chrom_idx != batch_end; ++chrom_idx)
+      {
+        chromatograms[chrom_idx - batch_start] = input.getChromatogram(chrom_idx);
+      }
+
+      pickChromatograms(chromatograms);
+
+      for (Size i = 0; i != chromatograms.size(); ++i)
+      {
+        output.addChromatogram(chromatograms[i]);
+      }
+      progress += batch_end - batch_start;
+      setProgress(progress);
     }
     endProgress();
 
     return;
   }
 
+  void PeakPickerHiRes::pickSpectra(std::vector<MSSpectrum>& spectra, const bool check_spectrum_type) const
+  {
+    // decide up front which spectra are picked (may throw, so not inside the parallel section)
+    std::vector<char> picked(spectra.size());
+    for (Size i = 0; i != spectra.size(); ++i)
+    {
+      picked[i] = isSelectedForPicking(spectra[i], check_spectrum_type);
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)spectra.size(); ++i)
+    {
+      if (!picked[i]) continue;
+      MSSpectrum picked_spectrum;
+      pick(spectra[i], picked_spectrum);
+      spectra[i] = picked_spectrum;
+    }
+  }
+
+  void PeakPickerHiRes::pickChromatograms(std::vector<MSChromatogram>& chromatograms) const
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)chromatograms.size(); ++i)
+    {
+      MSChromatogram picked_chromatogram;
+      pick(chromatograms[i], picked_chromatogram);
+      chromatograms[i] = picked_chromatogram;
+    }
+  }
+
   void PeakPickerHiRes::updateMembers_()
   {
     signal_to_noise_ = param_.getValue("signal_to_noise");
@@ -603,6 +666,7 @@ namespace OpenMS
     ms_levels_ = getParameters().getValue("ms_levels");
     report_FWHM_ = getParameters().getValue("report_FWHM").toBool();
     report_FWHM_as_ppm_ = getParameters().getValue("report_FWHM_unit")!="absolute";
+    snt_param_ = param_.copy("SignalToNoise:", true);
   }
 
 }
@@ -54,6 +54,8 @@
 
 namespace OpenMS
 {
+  class OnDiscSpectrumCache;
+
   /**
   @brief Class that stores the data for one layer
 
@@ -172,6 +174,7 @@ public:
       label(L_NONE),
       peptide_id_index(-1),
       peptide_hit_index(-1),
+      on_disc_cache(),
       features(new FeatureMapType()),
       consensus(new ConsensusMapType()),
       peaks(new ExperimentType()),
@@ -445,6 +448,9 @@ public:
     int peptide_id_index;
     int peptide_hit_index;
 
+    /// Loads the peaks of on-disk spectra into the peak data on demand (2D view, null if all peaks are in memory)
+    boost::shared_ptr<OnDiscSpectrumCache> on_disc_cache;
+
 private:
 
     /// Update current cached spectrum for easy retrieval
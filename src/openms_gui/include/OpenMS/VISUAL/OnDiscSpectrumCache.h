@@ -0,0 +1,191 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+// OpenMS_GUI config
+#include <OpenMS/VISUAL/OpenMS_GUIConfig.h>
+
+//OpenMS
+#include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/KERNEL/OnDiscMSExperiment.h>
+#include <OpenMS/INTERFACES/DataStructures.h>
+
+//QT
+#include <QtCore/QObject>
+
+//STL
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+namespace OpenMS
+{
+
+  /**
+      @brief Memory-bounded cache which loads the peaks of on-disk spectra in the background
+
+      TOPPView can keep the peak data of an indexed mzML file on disk (see the
+      'use_cached_ms1' preference), in which case the in-memory experiment of
+      the layer only contains the meta data of each spectrum. This class fills
+      the peaks of the spectra a view requests into that experiment:
+
+      - request() queues the spectra which are needed (e.g. the visible survey
+        scans) followed by the ones to prefetch. A background thread reads them
+        from its own handle to the file, so the layer's OnDiscMSExperiment can
+        still be used from the GUI thread.
+      - Once spectra are read, spectraLoaded() is emitted. transferLoaded()
+        (to be called from the GUI thread, like all functions except the
+        background reading) then moves their peaks into the experiment.
+      - Spectra are prefetched only as long as the whole request fits into the
+        limit (using the peak counts of spectra loaded before and an estimate
+        for the others). If the needed spectra alone exceed the limit, only an
+        evenly spaced subset of them is loaded.
+      - The spectra of the current request are pinned. If the total number of
+        loaded peaks exceeds the limit, the peaks of the least recently requested
+        other spectra are removed again (their meta data stays). Repeating the
+        same request (e.g. on every repaint) therefore never reloads spectra.
+
+      Only m/z and intensity are loaded, additional data arrays are not.
+
+      @ingroup Visual
+  */
+  class OPENMS_GUI_DLLAPI OnDiscSpectrumCache :
+    public QObject
+  {
+    Q_OBJECT
+
+public:
+    /**
+      @brief Constructor
+
+      @param on_disc The opened on-disk experiment (copied, i.e. a new file handle is opened)
+      @param peaks The in-memory experiment with the meta data of all spectra in @p on_disc (peaks are filled in)
+      @param max_peaks Maximum number of peaks loaded into @p peaks at the same time
+    */
+    OnDiscSpectrumCache(const OnDiscMSExperiment& on_disc, const boost::shared_ptr<PeakMap>& peaks, Size max_peaks);
+
+    /// Destructor (stops the background thread)
+    ~OnDiscSpectrumCache() override;
+
+    /**
+      @brief Requests spectra to be loaded (replaces all previous requests)
+
+      @param needed Indices of the spectra to load (first)
+      @param prefetch Indices of the spectra to load afterwards, if the limit permits
+    */
+    void request(const std::vector<Size>& needed, const std::vector<Size>& prefetch = std::vector<Size>());
+
+    /**
+      @brief Moves the peaks of all spectra read so far into the experiment
+
+      @return true if the experiment changed
+    */
+    bool transferLoaded();
+
+    /// Blocks until the background thread has read all requested spectra
+    void waitForRequests();
+
+    /// Returns if the peaks of spectrum @p index are loaded
+    bool isLoaded(Size index) const;
+
+    /// Returns the number of currently loaded peaks
+    Size getLoadedPeakCount() const;
+
+    /// Returns the maximum number of loaded peaks
+    Size getMaxPeakCount() const;
+
+signals:
+    /// Emitted (from the background thread) when requested spectra have been read
+    void spectraLoaded();
+
+protected:
+    /// Main loop of the background thread
+    void run_();
+
+    /// Removes the peaks of least recently requested, unpinned spectra until the limit is met
+    void evict_();
+
+    /// Own copy of the on-disk experiment (used by the background thread only)
+    OnDiscMSExperiment on_disc_;
+    /// The experiment to fill
+    boost::shared_ptr<PeakMap> peaks_;
+    /// Maximum number of loaded peaks
+    Size max_peaks_;
+
+    /// Whether the peaks of a spectrum are loaded
+    std::vector<bool> loaded_;
+    /// Number of peaks of each spectrum (0 if it was never loaded)
+    std::vector<Size> peak_counts_;
+    /// Loaded spectra, least recently requested first
+    std::list<Size> lru_;
+    /// Position of the loaded spectra in lru_
+    std::map<Size, std::list<Size>::iterator> lru_pos_;
+    /// Number of loaded peaks
+    Size loaded_peaks_;
+    /// The spectra of the last request (needed and prefetched) which must not be evicted
+    std::set<Size> pinned_;
+
+    /// Protects the members below (shared with the background thread)
+    std::mutex mutex_;
+    /// Signals new requests or stopping to the background thread
+    std::condition_variable work_condition_;
+    /// Signals an empty queue to waitForRequests()
+    std::condition_variable idle_condition_;
+    /// Spectra still to be read
+    std::deque<Size> queue_;
+    /// Whether the background thread is reading a spectrum
+    bool busy_;
+    /// Spectra read, but not transferred yet
+    std::vector<std::pair<Size, OpenMS::Interfaces::SpectrumPtr> > finished_;
+    /// Stop flag for the background thread
+    bool stop_;
+    /// The background thread
+    std::thread worker_;
+
+private:
+    /// Not implemented
+    OnDiscSpectrumCache(const OnDiscSpectrumCache&);
+    OnDiscSpectrumCache& operator=(const OnDiscSpectrumCache&);
+  };
+
+}
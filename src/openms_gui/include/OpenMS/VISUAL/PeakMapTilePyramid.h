@@ -0,0 +1,141 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+// OpenMS_GUI config
+#include <OpenMS/VISUAL/OpenMS_GUIConfig.h>
+
+//OpenMS
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+//STL
+#include <atomic>
+#include <vector>
+
+namespace OpenMS
+{
+
+  /**
+      @brief Multi-resolution raster of the maximum and summed MS1 peak intensities of a peak map
+
+      The RT x m/z plane spanned by the MS1 spectra is divided into equally
+      sized bins, each storing the maximum and the sum of the intensities of
+      the peaks it contains. Coarser levels are derived by merging 2x2 bins of
+      the next finer level until both dimensions are small.
+
+      Spectrum2DCanvas uses the pyramid to paint very dense peak maps: instead
+      of iterating over all visible peaks on every repaint, the bins of the
+      coarsest level which still resolves a single pixel are drawn.
+
+      @ingroup Visual
+  */
+  class OPENMS_GUI_DLLAPI PeakMapTilePyramid
+  {
+public:
+    /// One resolution level of the pyramid
+    struct OPENMS_GUI_DLLAPI Level
+    {
+      Size rt_bins; ///< number of bins in RT dimension
+      Size mz_bins; ///< number of bins in m/z dimension
+      double rt_bin_width; ///< width of a bin in RT (seconds)
+      double mz_bin_width; ///< width of a bin in m/z (Th)
+      std::vector<float> max_intensity; ///< maximum intensity per bin (row-major by RT bin), negative for empty bins
+      std::vector<float> sum_intensity; ///< summed intensity per bin (row-major by RT bin), zero for empty bins
+
+      /// Returns the maximum intensity of a bin (negative if no peak falls into the bin)
+      inline float getMaxIntensity(Size rt_bin, Size mz_bin) const
+      {
+        return max_intensity[rt_bin * mz_bins + mz_bin];
+      }
+
+      /// Returns the summed intensity of a bin (zero if no peak falls into the bin)
+      inline float getSumIntensity(Size rt_bin, Size mz_bin) const
+      {
+        return sum_intensity[rt_bin * mz_bins + mz_bin];
+      }
+    };
+
+    /// Default constructor (empty pyramid)
+    PeakMapTilePyramid();
+
+    /**
+      @brief Builds the pyramid from the MS1 spectra of @p map
+
+      @param map The peak map (RT sorted)
+      @param max_bins Maximum number of bins of the finest level
+      @param min_bins Levels are added until both dimensions have at most this number of bins
+      @param cancel If given, the build is aborted (leaving an empty pyramid) as soon as it is set, e.g. by another thread
+    */
+    void build(const MSExperiment& map, Size max_bins = 1 << 23, Size min_bins = 64, const std::atomic<bool>* cancel = nullptr);
+
+    /// Returns if the pyramid contains no levels
+    bool empty() const;
+
+    /// Removes all levels
+    void clear();
+
+    /// Returns the number of levels (level 0 is the finest)
+    Size getLevelCount() const;
+
+    /// Returns the level with index @p index
+    const Level& getLevel(Size index) const;
+
+    /// Returns the lower RT bound of the binned area
+    double getMinRT() const;
+
+    /// Returns the lower m/z bound of the binned area
+    double getMinMZ() const;
+
+    /**
+      @brief Returns the coarsest level whose bins are not larger than the given resolution
+
+      @param rt_resolution maximal RT width of a bin (e.g. the RT width of a pixel)
+      @param mz_resolution maximal m/z width of a bin (e.g. the m/z width of a pixel)
+      @return the level index or getLevelCount(), if even the finest level is too coarse
+    */
+    Size findLevel(double rt_resolution, double mz_resolution) const;
+
+protected:
+    /// Lower RT bound
+    double rt_min_;
+    /// Lower m/z bound
+    double mz_min_;
+    /// The levels, finest first
+    std::vector<Level> levels_;
+  };
+
+}
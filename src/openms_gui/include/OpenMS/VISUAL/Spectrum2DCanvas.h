@@ -40,9 +40,19 @@
 // OpenMS
 #include <OpenMS/VISUAL/SpectrumCanvas.h>
 #include <OpenMS/VISUAL/Spectrum1DCanvas.h>
+#include <OpenMS/VISUAL/PeakMapTilePyramid.h>
 #include <OpenMS/KERNEL/PeakIndex.h>
 
 // QT
+#include <QtCore/QFuture>
+
+// boost
+#include <boost/smart_ptr/owner_less.hpp>
+#include <boost/weak_ptr.hpp>
+
+// STL
+#include <atomic>
+
 class QPainter;
 class QMouseEvent;
 class QAction;
@@ -111,6 +121,8 @@ signals:
     void showSpectrumAs1D(std::vector<int, std::allocator<int> > indices);
     /// Requests to display all spectra in 3D plot
     void showCurrentPeaksAs3D();
+    /// Emitted when peaks of on-disk spectra have been loaded into a layer
+    void peakDataLoaded();
 
 public slots:
     // Docu in base class
@@ -140,6 +152,12 @@ protected slots:
     /// Reacts on changed layer parameters
     void currentLayerParametersChanged_();
 
+    /// Repaints once a tile pyramid has been built in the background
+    void tilePyramidFinished_();
+
+    /// Moves the peaks of on-disk spectra loaded in the background into the layers and repaints
+    void onDiscSpectraLoaded_();
+
 protected:
     // Docu in base class
     bool finishAdding_() override;
@@ -192,6 +210,45 @@ protected:
     */
     void paintMaximumIntensities_(Size layer_index, Size rt_pixel_count, Size mz_pixel_count, QPainter& p);
 
+    /**
+      @brief Paints maximum intensities from the precomputed tile pyramid of a peak layer.
+
+      Same result as paintMaximumIntensities_, but reads the bins of the
+      coarsest pyramid level that still resolves a pixel instead of all
+      visible peaks.
+
+      @param layer_index The index of the layer.
+      @param rt_pixel_count
+      @param mz_pixel_count
+      @param p The QPainter to paint on.
+      @return false if no suitable pyramid (level) is available (yet), nothing is painted in that case
+    */
+    bool paintMaximumIntensitiesFromTiles_(Size layer_index, Size rt_pixel_count, Size mz_pixel_count, QPainter& p);
+
+    /**
+      @brief Returns the tile pyramid of a peak layer
+
+      Starts building the pyramid in a background thread on first request for
+      layers with at least tile_pyramid_min_peaks_ peaks. The build reads the
+      (shared) layer data directly, i.e. nothing is copied on the GUI thread.
+      updateLayer() and pruneTilePyramids_() cancel a pending build and
+      discard its result.
+
+      @return the pyramid or a null pointer, if the layer is too small or the pyramid is not built yet
+    */
+    const PeakMapTilePyramid* getTilePyramid_(Size layer_index);
+
+    /// Discards (and cancels the builds of) the tile pyramids of data no longer shown in any layer
+    void pruneTilePyramids_();
+
+    /**
+      @brief Requests the peaks of the visible survey scans of a layer with on-disk data
+
+      The scans surrounding the visible area (half of its RT width on each side)
+      are prefetched. Does nothing for layers without an on-disk cache.
+    */
+    void requestOnDiscSpectra_(Size layer_index);
+
     /**
       @brief Paints the precursor peaks.
 
@@ -392,6 +449,24 @@ protected:
     double pen_size_max_; ///< maximum number of pixels for one data point
     double canvas_coverage_min_; ///< minimum coverage of the canvas required; if lower, points are upscaled in size
 
+    /// Key of the tile pyramids: the peak data of a layer (compared by identity, does not keep the data alive)
+    typedef boost::weak_ptr<const ExperimentType> TilePyramidKey;
+    /// Background build of a tile pyramid
+    struct TilePyramidBuild
+    {
+      QFuture<boost::shared_ptr<PeakMapTilePyramid> > result; ///< the pyramid (once finished)
+      boost::shared_ptr<std::atomic<bool> > cancel; ///< set to abort the build, e.g. when the data changed
+    };
+    /// Container of the tile pyramids
+    typedef std::map<TilePyramidKey, TilePyramidBuild, boost::owner_less<TilePyramidKey> > TilePyramidMap;
+    /// Tile pyramids of large peak layers, built in the background
+    TilePyramidMap tile_pyramids_;
+    Size tile_pyramid_min_peaks_; ///< minimum number of peaks of a layer to build a tile pyramid for it
+    double tile_pyramid_min_peaks_per_pixel_; ///< minimum number of visible peaks per pixel to paint from the tile pyramid
+
+    /// Maximum number of peaks of a layer with on-disk data kept in memory
+    Size on_disc_cache_max_peaks_;
+
   private:
     /// Default C'tor hidden
     Spectrum2DCanvas();
@@ -43,6 +43,7 @@
 
 #include <QtWidgets/QGraphicsScene>
 #include <QtCore/QProcess>
+#include <QtCore/QHash>
 
 namespace OpenMS
 {
@@ -93,11 +94,13 @@ public:
     struct TOPPProcess
     {
       /// Constructor
-      TOPPProcess(QProcess * p, const QString & cmd, const QStringList & arg, TOPPASToolVertex * const tool) :
+      TOPPProcess(QProcess * p, const QString & cmd, const QStringList & arg, TOPPASToolVertex * const tool, int num_threads = 1, Size mem = 0) :
         proc(p),
         command(cmd),
         args(arg),
-        tv(tool)
+        tv(tool),
+        threads(num_threads),
+        memory(mem)
       {
       }
 
@@ -109,6 +112,10 @@ public:
       QStringList args;
       /// The tool which is started (used to call its slots)
       TOPPASToolVertex * tv;
+      /// Number of threads the tool uses
+      int threads;
+      /// Estimated memory the tool requires (in MB)
+      Size memory;
     };
 
     /// The current action mode (creation of a new edge, or panning of the widget)
@@ -204,10 +211,39 @@ public:
     bool isPipelineRunning();
     /// Shows a dialog that allows to specify the output directory. If @p always_ask == false, the dialog won't be shown if a directory has been set, already.
     bool askForOutputDir(bool always_ask = true);
-    /// Enqueues the process, it will be run when the currently pending processes have finished
+    /// Enqueues the process, it will be run once enough threads and memory are available
     void enqueueProcess(const TOPPProcess & process);
-    /// Runs the next process in the queue, if any
+    /**
+      @brief Runs pending processes as long as the thread and memory budget permits
+
+      Of the pending processes which fit into the remaining budget, the one
+      with the longest chain of downstream tools (critical path) is started
+      first, i.e. smaller processes are started while a large one has to
+      wait for resources. A process exceeding the budget on its own is run
+      once no other process is running.
+    */
     void runNextProcess();
+    /**
+      @brief Returns whether @p process can be started next to the @p running processes
+
+      The threads (and estimated memory) of all running processes together
+      may not exceed @p allowed_threads (and @p allowed_memory, 0 = unlimited).
+      A process exceeding the budget on its own fits if no process is running.
+    */
+    static bool fitsResources(const TOPPProcess & process, const QList<TOPPProcess> & running, int allowed_threads, Size allowed_memory);
+    /**
+      @brief Selects the pending process to be started next (see runNextProcess())
+
+      @param pending The pending processes (in the order they were enqueued)
+      @param critical_path_lengths The critical path length of each pending process
+      @param running The running processes
+      @param allowed_threads The maximum number of threads of all running processes
+      @param allowed_memory The maximum memory (in MB) of all running processes (0 = unlimited)
+
+      @return The index of the process fitting into the budget with the longest critical path (the first one on ties), or -1 if none fits
+    */
+    static int selectNextProcess(const QList<TOPPProcess> & pending, const QList<int> & critical_path_lengths,
+                                 const QList<TOPPProcess> & running, int allowed_threads, Size allowed_memory);
     /// Resets the processes queue
     void resetProcessesQueue();
     /// Sets the clipboard content
@@ -240,8 +276,10 @@ public:
     QString getDescription() const;
     /// when description is updated by user, use this to update the description for later storage in file
     void setDescription(const QString & desc);
-    /// sets the maximum number of jobs
+    /// sets the maximum number of threads used by all running tools together
     void setAllowedThreads(int num_threads);
+    /// sets the maximum memory (in MB) estimated for all running tools together (0 = unlimited)
+    void setAllowedMemory(Size memory);
     /// returns the hovering edge
     TOPPASEdge* getHoveringEdge();
     /// Checks whether all output vertices are finished, and if yes, emits entirePipelineFinished() (called by finished output vertices)
@@ -275,8 +313,8 @@ public slots:
     void changedParameter(const bool invalidates_running_pipeline);
     /// Invoked by OutfilelistVertex of user changed the folder name
     void changedOutputFolder();
-    /// Called by a finished QProcess to indicate that we are free to start a new one
-    void processFinished();
+    /// Called by a finished QProcess to release its resources and start pending ones
+    void processFinished(QProcess * p);
     /// dirty solution: when using ExecutePipeline this slot is called when the pipeline crashes. This will quit the app
     void quitWithError();
 
@@ -355,12 +393,16 @@ protected:
     TOPPASScene * clipboard_;
     /// dry run mode (no tools are actually called)
     bool dry_run_;
-    /// currently running processes...
-    int threads_active_;
+    /// currently running processes (and the threads and memory they use)
+    QList<TOPPProcess> running_processes_;
     /// description text
     QString description_text_;
     /// maximum number of allowed threads
     int allowed_threads_;
+    /// maximum memory (in MB) of all running processes (0 = unlimited)
+    Size allowed_memory_;
+    /// length of the critical path (number of tools) starting at each vertex
+    QHash<const TOPPASVertex *, int> critical_path_lengths_;
     /// last node where 'resume' was started
     TOPPASToolVertex* resume_source_;
 
@@ -370,6 +412,8 @@ protected:
     bool isEdgeAllowed_(TOPPASVertex * u, TOPPASVertex * v);
     /// DFS helper method. Returns true, if a back edge has been discovered
     bool dfsVisit_(TOPPASVertex * vertex);
+    /// Returns the number of tools on the longest path from @p vertex (inclusive) to the end of the pipeline
+    int getCriticalPathLength_(const TOPPASVertex * vertex);
     /// Performs a sanity check of the pipeline and notifies user when it finds something strange. Returns if pipeline OK.
     /// if 'allowUserOverride' is true, some dialogs are shown which allow the user to ignore some warnings (e.g. disconnected nodes)
     bool sanityCheck_(bool allowUserOverride);
@@ -17,7 +17,9 @@ ListEditor.h
 MetaDataBrowser.h
 MultiGradient.h
 MultiGradientSelector.h
+OnDiscSpectrumCache.h
 ParamEditor.h
+PeakMapTilePyramid.h
 SpectraViewWidget.h
 SpectraIdentificationViewWidget.h
 Spectrum1DCanvas.h
@@ -1276,6 +1276,23 @@ namespace OpenMS
 
             // Load at least one spectrum into memory (TOPPView assumes that at least one spectrum is in memory)
             if (cache_ms1_on_disc && peak_map_sptr->getNrSpectra() > 0) peak_map_sptr->getSpectrum(0) = on_disc_peaks->getSpectrum(0);
+
+            // Load a sample of evenly spaced MS1 spectra to get meaningful m/z
+            // and intensity ranges (the 2D view loads the others on demand)
+            if (cache_ms1_on_disc)
+            {
+              std::vector<Size> ms1_indices;
+              for (Size k = 0; k < peak_map_sptr->getNrSpectra(); k++)
+              {
+                if (peak_map_sptr->getSpectrum(k).getMSLevel() == 1) ms1_indices.push_back(k);
+              }
+              const Size sample_size = std::min(ms1_indices.size(), Size(100));
+              for (Size k = 0; k < sample_size; k++)
+              {
+                Size idx = ms1_indices[k * ms1_indices.size() / sample_size];
+                peak_map_sptr->getSpectrum(idx) = on_disc_peaks->getSpectrum(idx);
+              }
+            }
           }
         }
 
@@ -0,0 +1,313 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/VISUAL/OnDiscSpectrumCache.h>
+
+#include <algorithm>
+
+using namespace std;
+
+namespace OpenMS
+{
+
+  OnDiscSpectrumCache::OnDiscSpectrumCache(const OnDiscMSExperiment& on_disc, const boost::shared_ptr<PeakMap>& peaks, Size max_peaks) :
+    QObject(),
+    on_disc_(on_disc),
+    peaks_(peaks),
+    max_peaks_(max_peaks),
+    loaded_(peaks->size(), false),
+    peak_counts_(peaks->size(), 0),
+    lru_(),
+    lru_pos_(),
+    loaded_peaks_(0),
+    pinned_(),
+    queue_(),
+    busy_(false),
+    finished_(),
+    stop_(false)
+  {
+    // spectra which are already in memory count as loaded
+    for (Size i = 0; i < peaks_->size(); ++i)
+    {
+      if (!(*peaks_)[i].empty())
+      {
+        loaded_[i] = true;
+        loaded_peaks_ += (*peaks_)[i].size();
+        peak_counts_[i] = (*peaks_)[i].size();
+        lru_pos_[i] = lru_.insert(lru_.end(), i);
+      }
+    }
+
+    worker_ = std::thread(&OnDiscSpectrumCache::run_, this);
+  }
+
+  OnDiscSpectrumCache::~OnDiscSpectrumCache()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    work_condition_.notify_all();
+    idle_condition_.notify_all();
+    worker_.join();
+  }
+
+  void OnDiscSpectrumCache::request(const vector<Size>& needed, const vector<Size>& prefetch)
+  {
+    // peaks of a spectrum: known if it was loaded before, otherwise estimated from the loaded ones
+    const double estimate = lru_.empty() ? 1000.0 : std::max(1.0, double(loaded_peaks_) / lru_.size());
+    auto peakCount = [&](Size index) { return peak_counts_[index] > 0 ? double(peak_counts_[index]) : estimate; };
+
+    double needed_peaks = 0.0;
+    for (vector<Size>::const_iterator it = needed.begin(); it != needed.end(); ++it)
+    {
+      if (*it < peak_counts_.size())
+      {
+        needed_peaks += peakCount(*it);
+      }
+    }
+
+    // too many peaks needed: take an evenly spaced subset
+    vector<Size> requested;
+    if (needed_peaks > max_peaks_)
+    {
+      Size max_spectra = std::max(Size(1), Size(needed.size() * (max_peaks_ / needed_peaks)));
+      double stride = double(needed.size()) / max_spectra;
+      for (Size k = 0; k < max_spectra; ++k)
+      {
+        requested.push_back(needed[Size(k * stride)]);
+      }
+    }
+    else
+    {
+      requested = needed;
+    }
+
+    // prefetch as long as the whole request fits into the limit (closest spectra first)
+    double requested_peaks = 0.0;
+    for (vector<Size>::const_iterator it = requested.begin(); it != requested.end(); ++it)
+    {
+      if (*it < peak_counts_.size())
+      {
+        requested_peaks += peakCount(*it);
+      }
+    }
+    for (Size k = 0; k < prefetch.size(); ++k)
+    {
+      if (prefetch[k] >= peak_counts_.size() || requested_peaks + peakCount(prefetch[k]) > max_peaks_)
+      {
+        break;
+      }
+      requested.push_back(prefetch[k]);
+      requested_peaks += peakCount(prefetch[k]);
+    }
+
+    // all spectra of the request are pinned: evicting (and re-requesting) them
+    // on every repaint of the same area would never settle
+    pinned_ = set<Size>(requested.begin(), requested.end());
+    evict_();
+
+    // mark as recently used and queue the ones not loaded yet
+    vector<Size> to_load;
+    for (vector<Size>::const_iterator it = requested.begin(); it != requested.end(); ++it)
+    {
+      if (*it >= loaded_.size())
+      {
+        continue;
+      }
+      if (loaded_[*it])
+      {
+        lru_.splice(lru_.end(), lru_, lru_pos_[*it]);
+      }
+      else
+      {
+        to_load.push_back(*it);
+      }
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      set<Size> read;
+      for (Size k = 0; k < finished_.size(); ++k)
+      {
+        read.insert(finished_[k].first);
+      }
+      queue_.clear();
+      for (vector<Size>::const_iterator it = to_load.begin(); it != to_load.end(); ++it)
+      {
+        if (read.find(*it) == read.end())
+        {
+          queue_.push_back(*it);
+        }
+      }
+    }
+    work_condition_.notify_all();
+  }
+
+  bool OnDiscSpectrumCache::transferLoaded()
+  {
+    vector<pair<Size, OpenMS::Interfaces::SpectrumPtr> > finished;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      finished.swap(finished_);
+    }
+
+    for (Size k = 0; k < finished.size(); ++k)
+    {
+      Size index = finished[k].first;
+      if (loaded_[index])
+      {
+        continue;
+      }
+
+      MSSpectrum& spectrum = (*peaks_)[index];
+      spectrum.clear(false);
+      const OpenMS::Interfaces::SpectrumPtr& sptr = finished[k].second;
+      if (sptr && sptr->getMZArray() && sptr->getIntensityArray())
+      {
+        const vector<double>& mz = sptr->getMZArray()->data;
+        const vector<double>& intensity = sptr->getIntensityArray()->data;
+        spectrum.reserve(mz.size());
+        for (Size p = 0; p < mz.size() && p < intensity.size(); ++p)
+        {
+          Peak1D peak;
+          peak.setMZ(mz[p]);
+          peak.setIntensity(intensity[p]);
+          spectrum.push_back(peak);
+        }
+        spectrum.sortByPosition();
+      }
+      spectrum.updateRanges();
+
+      loaded_[index] = true;
+      loaded_peaks_ += spectrum.size();
+      peak_counts_[index] = spectrum.size();
+      lru_pos_[index] = lru_.insert(lru_.end(), index);
+    }
+    evict_();
+
+    return !finished.empty();
+  }
+
+  void OnDiscSpectrumCache::evict_()
+  {
+    list<Size>::iterator it = lru_.begin();
+    while (it != lru_.end() && loaded_peaks_ > max_peaks_)
+    {
+      if (pinned_.find(*it) != pinned_.end())
+      {
+        ++it;
+        continue;
+      }
+      MSSpectrum& spectrum = (*peaks_)[*it];
+      loaded_peaks_ -= spectrum.size();
+      spectrum.clear(false);
+      loaded_[*it] = false;
+      lru_pos_.erase(*it);
+      it = lru_.erase(it);
+    }
+  }
+
+  void OnDiscSpectrumCache::waitForRequests()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_condition_.wait(lock, [this]() { return stop_ || (queue_.empty() && !busy_); });
+  }
+
+  bool OnDiscSpectrumCache::isLoaded(Size index) const
+  {
+    return index < loaded_.size() && loaded_[index];
+  }
+
+  Size OnDiscSpectrumCache::getLoadedPeakCount() const
+  {
+    return loaded_peaks_;
+  }
+
+  Size OnDiscSpectrumCache::getMaxPeakCount() const
+  {
+    return max_peaks_;
+  }
+
+  void OnDiscSpectrumCache::run_()
+  {
+    Size read_count = 0;
+    while (true)
+    {
+      Size index;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        busy_ = false;
+        if (queue_.empty())
+        {
+          idle_condition_.notify_all();
+        }
+        work_condition_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+        if (stop_)
+        {
+          return;
+        }
+        index = queue_.front();
+        queue_.pop_front();
+        busy_ = true;
+      }
+
+      // read the raw data only (the meta data is already in memory)
+      OpenMS::Interfaces::SpectrumPtr spectrum;
+      try
+      {
+        spectrum = on_disc_.getSpectrumById(index);
+      }
+      catch (...)
+      {
+        // unreadable spectrum: shown without peaks
+      }
+
+      bool done;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished_.push_back(make_pair(index, spectrum));
+        done = queue_.empty();
+      }
+
+      // notify when all requested spectra are read and regularly in between
+      if (done || ++read_count % 100 == 0)
+      {
+        emit spectraLoaded();
+      }
+    }
+  }
+
+}
@@ -0,0 +1,188 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/VISUAL/PeakMapTilePyramid.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace OpenMS
+{
+
+  PeakMapTilePyramid::PeakMapTilePyramid() :
+    rt_min_(0.0),
+    mz_min_(0.0),
+    levels_()
+  {
+  }
+
+  void PeakMapTilePyramid::build(const MSExperiment& map, Size max_bins, Size min_bins, const std::atomic<bool>* cancel)
+  {
+    clear();
+
+    // determine the binned area from the (non-empty) MS1 spectra
+    vector<Size> ms1_indices;
+    double rt_max(0.0), mz_max(0.0);
+    for (Size i = 0; i < map.size(); ++i)
+    {
+      const MSSpectrum& spec = map[i];
+      if (spec.getMSLevel() != 1 || spec.empty())
+      {
+        continue;
+      }
+      if (ms1_indices.empty())
+      {
+        rt_min_ = spec.getRT();
+        mz_min_ = spec.front().getMZ();
+        mz_max = spec.back().getMZ();
+      }
+      rt_max = spec.getRT();
+      mz_min_ = std::min(mz_min_, spec.front().getMZ());
+      mz_max = std::max(mz_max, spec.back().getMZ());
+      ms1_indices.push_back(i);
+    }
+    if (ms1_indices.empty() || max_bins == 0)
+    {
+      return;
+    }
+
+    // finest level: at most one RT bin per scan, the remaining bins go to m/z
+    Level level;
+    level.rt_bins = std::max(Size(1), std::min(ms1_indices.size(), Size(std::sqrt(double(max_bins)))));
+    level.mz_bins = std::max(Size(1), max_bins / level.rt_bins);
+    // a degenerate range (e.g. a single scan) is put into a single bin
+    level.rt_bin_width = rt_max > rt_min_ ? (rt_max - rt_min_) / level.rt_bins : 1.0;
+    level.mz_bin_width = mz_max > mz_min_ ? (mz_max - mz_min_) / level.mz_bins : 1.0;
+    level.max_intensity.assign(level.rt_bins * level.mz_bins, -1.0f);
+    level.sum_intensity.assign(level.rt_bins * level.mz_bins, 0.0f);
+
+    for (Size i = 0; i < ms1_indices.size(); ++i)
+    {
+      if (cancel != nullptr && *cancel)
+      {
+        clear();
+        return;
+      }
+      const MSSpectrum& spec = map[ms1_indices[i]];
+      Size rt_bin = std::min(Size((spec.getRT() - rt_min_) / level.rt_bin_width), level.rt_bins - 1);
+      float* max_row = &level.max_intensity[rt_bin * level.mz_bins];
+      float* sum_row = &level.sum_intensity[rt_bin * level.mz_bins];
+      for (MSSpectrum::ConstIterator it = spec.begin(); it != spec.end(); ++it)
+      {
+        Size mz_bin = std::min(Size((it->getMZ() - mz_min_) / level.mz_bin_width), level.mz_bins - 1);
+        max_row[mz_bin] = std::max(max_row[mz_bin], it->getIntensity());
+        sum_row[mz_bin] += it->getIntensity();
+      }
+    }
+    levels_.push_back(level);
+
+    // coarser levels: merge 2x2 bins of the previous level
+    while (levels_.back().rt_bins > min_bins || levels_.back().mz_bins > min_bins)
+    {
+      if (cancel != nullptr && *cancel)
+      {
+        clear();
+        return;
+      }
+      const Level& fine = levels_.back();
+      Level coarse;
+      coarse.rt_bins = (fine.rt_bins + 1) / 2;
+      coarse.mz_bins = (fine.mz_bins + 1) / 2;
+      coarse.rt_bin_width = fine.rt_bin_width * 2.0;
+      coarse.mz_bin_width = fine.mz_bin_width * 2.0;
+      coarse.max_intensity.assign(coarse.rt_bins * coarse.mz_bins, -1.0f);
+      coarse.sum_intensity.assign(coarse.rt_bins * coarse.mz_bins, 0.0f);
+      for (Size rt = 0; rt < fine.rt_bins; ++rt)
+      {
+        float* max_row = &coarse.max_intensity[(rt / 2) * coarse.mz_bins];
+        float* sum_row = &coarse.sum_intensity[(rt / 2) * coarse.mz_bins];
+        for (Size mz = 0; mz < fine.mz_bins; ++mz)
+        {
+          max_row[mz / 2] = std::max(max_row[mz / 2], fine.getMaxIntensity(rt, mz));
+          sum_row[mz / 2] += fine.getSumIntensity(rt, mz);
+        }
+      }
+      levels_.push_back(coarse);
+    }
+  }
+
+  bool PeakMapTilePyramid::empty() const
+  {
+    return levels_.empty();
+  }
+
+  void PeakMapTilePyramid::clear()
+  {
+    rt_min_ = 0.0;
+    mz_min_ = 0.0;
+    levels_.clear();
+  }
+
+  Size PeakMapTilePyramid::getLevelCount() const
+  {
+    return levels_.size();
+  }
+
+  const PeakMapTilePyramid::Level& PeakMapTilePyramid::getLevel(Size index) const
+  {
+    return levels_[index];
+  }
+
+  double PeakMapTilePyramid::getMinRT() const
+  {
+    return rt_min_;
+  }
+
+  double PeakMapTilePyramid::getMinMZ() const
+  {
+    return mz_min_;
+  }
+
+  Size PeakMapTilePyramid::findLevel(double rt_resolution, double mz_resolution) const
+  {
+    for (Size i = levels_.size(); i > 0; --i)
+    {
+      const Level& level = levels_[i - 1];
+      if (level.rt_bin_width <= rt_resolution && level.mz_bin_width <= mz_resolution)
+      {
+        return i - 1;
+      }
+    }
+    return levels_.size();
+  }
+
+}
@@ -44,11 +44,13 @@
 #include <OpenMS/VISUAL/DIALOGS/Spectrum2DPrefDialog.h>
 #include <OpenMS/VISUAL/ColorSelector.h>
 #include <OpenMS/VISUAL/MultiGradientSelector.h>
+#include <OpenMS/VISUAL/OnDiscSpectrumCache.h>
 #include <OpenMS/VISUAL/DIALOGS/FeatureEditDialog.h>
 #include <OpenMS/SYSTEM/FileWatcher.h>
 #include <OpenMS/MATH/MISC/MathFunctions.h>
 //STL
 #include <algorithm>
+#include <set>
 
 //QT
 #include <QMouseEvent>
@@ -60,6 +62,8 @@
 #include <QtWidgets/QComboBox>
 #include <QtWidgets/QFileDialog>
 #include <QtWidgets/QMessageBox>
+#include <QtCore/QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
 
 //boost
 #include <boost/math/special_functions/fpclassify.hpp>
@@ -88,7 +92,11 @@ namespace OpenMS
     measurement_start_(),
     pen_size_min_(1),
     pen_size_max_(20),
-    canvas_coverage_min_(0.2)
+    canvas_coverage_min_(0.2),
+    tile_pyramids_(),
+    tile_pyramid_min_peaks_(10000000),
+    tile_pyramid_min_peaks_per_pixel_(4.0),
+    on_disc_cache_max_peaks_(20000000)
   {
     //Parameter handling
     defaults_.setValue("background_color", "#ffffff", "Background color.");
@@ -123,6 +131,11 @@ namespace OpenMS
 
   Spectrum2DCanvas::~Spectrum2DCanvas()
   {
+    // pending builds keep their data alive, stop them early
+    for (TilePyramidMap::iterator it = tile_pyramids_.begin(); it != tile_pyramids_.end(); ++it)
+    {
+      *it->second.cancel = true;
+    }
   }
 
   void Spectrum2DCanvas::highlightPeak_(QPainter & painter, const PeakIndex & peak)
@@ -340,6 +353,9 @@ namespace OpenMS
         return;
       }
 
+      // peaks of on-disk data are loaded in the background (painted once available)
+      requestOnDiscSpectra_(layer_index);
+
       //determine number of pixels for each dimension
       Size rt_pixel_count = image_height;
       Size mz_pixel_count = image_width;
@@ -395,7 +411,13 @@ namespace OpenMS
         // Also, we cannot upscale in this mode (since we operate on the buffer directly, i.e. '1 data point == 1 pixel'
         if (!has_low_pixel_coverage && (n_peaks_in_scan > mz_pixel_count || n_ms1_scans > rt_pixel_count))
         {
-          paintMaximumIntensities_(layer_index, rt_pixel_count, mz_pixel_count, painter);
+          // very dense: read the precomputed tiles (if available) instead of all visible peaks
+          double peaks_per_pixel = ratio_data2pixel_rt * ratio_data2pixel_mz;
+          if (peaks_per_pixel < tile_pyramid_min_peaks_per_pixel_ ||
+              !paintMaximumIntensitiesFromTiles_(layer_index, rt_pixel_count, mz_pixel_count, painter))
+          {
+            paintMaximumIntensities_(layer_index, rt_pixel_count, mz_pixel_count, painter);
+          }
         }
         else
         { // this is slower to paint, but allows scaling points
@@ -726,6 +748,249 @@ namespace OpenMS
     }
   }
 
+  bool Spectrum2DCanvas::paintMaximumIntensitiesFromTiles_(Size layer_index, Size rt_pixel_count, Size mz_pixel_count, QPainter & painter)
+  {
+    const LayerData & layer = getLayer(layer_index);
+
+    // the pyramid contains all peaks, i.e. cannot be used with data filters
+    if (layer.filters.isActive() && layer.filters.size() > 0)
+    {
+      return false;
+    }
+
+    const PeakMapTilePyramid * pyramid = getTilePyramid_(layer_index);
+    if (pyramid == nullptr)
+    {
+      return false;
+    }
+
+    const double rt_min = visible_area_.minPosition()[1];
+    const double rt_max = visible_area_.maxPosition()[1];
+    const double mz_min = visible_area_.minPosition()[0];
+    const double mz_max = visible_area_.maxPosition()[0];
+
+    // coarsest level which still has at least one bin per pixel
+    Size level_index = pyramid->findLevel((rt_max - rt_min) / rt_pixel_count, (mz_max - mz_min) / mz_pixel_count);
+    if (level_index == pyramid->getLevelCount())
+    {
+      return false;
+    }
+    const PeakMapTilePyramid::Level & level = pyramid->getLevel(level_index);
+
+    //set painter to black (we operate directly on the pixels for all colored data)
+    painter.setPen(Qt::black);
+    //temporary variables
+    Int image_width = buffer_.width();
+    Int image_height = buffer_.height();
+    double snap_factor = snap_factors_[layer_index];
+
+    // visible bins
+    Size rt_bin_begin = Size(std::max(0.0, std::floor((rt_min - pyramid->getMinRT()) / level.rt_bin_width)));
+    Size rt_bin_end = Size(std::max(0.0, std::ceil((rt_max - pyramid->getMinRT()) / level.rt_bin_width)));
+    Size mz_bin_begin = Size(std::max(0.0, std::floor((mz_min - pyramid->getMinMZ()) / level.mz_bin_width)));
+    Size mz_bin_end = Size(std::max(0.0, std::ceil((mz_max - pyramid->getMinMZ()) / level.mz_bin_width)));
+    rt_bin_end = std::min(rt_bin_end, level.rt_bins);
+    mz_bin_end = std::min(mz_bin_end, level.mz_bins);
+
+    // several bins may fall onto the same pixel: collect the maximum per pixel first
+    vector<float> pixel_max(image_width * image_height, -1.0f);
+    for (Size rt_bin = rt_bin_begin; rt_bin < rt_bin_end; ++rt_bin)
+    {
+      double rt = pyramid->getMinRT() + (rt_bin + 0.5) * level.rt_bin_width;
+      for (Size mz_bin = mz_bin_begin; mz_bin < mz_bin_end; ++mz_bin)
+      {
+        float max = level.getMaxIntensity(rt_bin, mz_bin);
+        if (max < 0.0)
+        {
+          continue;
+        }
+
+        QPoint pos;
+        dataToWidget_(pyramid->getMinMZ() + (mz_bin + 0.5) * level.mz_bin_width, rt, pos);
+        if (pos.x() >= 0 && pos.y() >= 0 && pos.x() < image_width && pos.y() < image_height)
+        {
+          float& pixel = pixel_max[pos.y() * image_width + pos.x()];
+          pixel = std::max(pixel, max);
+        }
+      }
+    }
+
+    //draw to buffer
+    for (Int y = 0; y < image_height; ++y)
+    {
+      for (Int x = 0; x < image_width; ++x)
+      {
+        float max = pixel_max[y * image_width + x];
+        if (max >= 0.0)
+        {
+          buffer_.setPixel(x, y, heightColor_(max, layer.gradient, snap_factor).rgb());
+        }
+      }
+    }
+    return true;
+  }
+
+  const PeakMapTilePyramid * Spectrum2DCanvas::getTilePyramid_(Size layer_index)
+  {
+    const LayerData & layer = getLayer(layer_index);
+    const TilePyramidKey key(layer.getPeakData());
+
+    TilePyramidMap::const_iterator it = tile_pyramids_.find(key);
+    if (it == tile_pyramids_.end())
+    {
+      // the peaks of on-disk data change while browsing
+      if (layer.getPeakData()->getSize() < tile_pyramid_min_peaks_ || layer.on_disc_cache)
+      {
+        return nullptr;
+      }
+
+      // build in the background directly from the shared layer data (MS2
+      // spectra are skipped by the build); if the data changes, updateLayer()
+      // cancels the build and its result is dropped
+      LayerData::ConstExperimentSharedPtrType data = layer.getPeakData();
+      TilePyramidBuild build;
+      build.cancel.reset(new std::atomic<bool>(false));
+      boost::shared_ptr<std::atomic<bool> > cancel = build.cancel;
+      build.result = QtConcurrent::run([data, cancel]()
+        {
+          boost::shared_ptr<PeakMapTilePyramid> pyramid(new PeakMapTilePyramid());
+          pyramid->build(*data, 1 << 23, 64, cancel.get());
+          return pyramid;
+        });
+      tile_pyramids_[key] = build;
+
+      QFutureWatcher<boost::shared_ptr<PeakMapTilePyramid> > * watcher = new QFutureWatcher<boost::shared_ptr<PeakMapTilePyramid> >(this);
+      connect(watcher, SIGNAL(finished()), this, SLOT(tilePyramidFinished_()));
+      connect(watcher, SIGNAL(finished()), watcher, SLOT(deleteLater()));
+      watcher->setFuture(build.result);
+      return nullptr;
+    }
+
+    if (!it->second.result.isFinished())
+    {
+      return nullptr;
+    }
+    return it->second.result.result().get();
+  }
+
+  void Spectrum2DCanvas::pruneTilePyramids_()
+  {
+    // keys are compared by identity (not by address), so data that was
+    // deleted and data allocated at the same address later are distinct
+    std::set<TilePyramidKey, boost::owner_less<TilePyramidKey> > shown;
+    for (Size i = 0; i < getLayerCount(); ++i)
+    {
+      shown.insert(TilePyramidKey(getLayer(i).getPeakData()));
+    }
+    for (TilePyramidMap::iterator it = tile_pyramids_.begin(); it != tile_pyramids_.end(); )
+    {
+      if (it->first.expired() || shown.find(it->first) == shown.end())
+      {
+        *it->second.cancel = true;
+        tile_pyramids_.erase(it++);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+
+  void Spectrum2DCanvas::tilePyramidFinished_()
+  {
+    update_buffer_ = true;
+    update_(OPENMS_PRETTY_FUNCTION);
+  }
+
+  void Spectrum2DCanvas::requestOnDiscSpectra_(Size layer_index)
+  {
+    const LayerData & layer = getLayer(layer_index);
+    if (!layer.on_disc_cache)
+    {
+      return;
+    }
+
+    const ExperimentType & peak_map = *layer.getPeakData();
+    const double rt_min = visible_area_.minPosition()[1];
+    const double rt_max = visible_area_.maxPosition()[1];
+    const double rt_margin = (rt_max - rt_min) / 2;
+
+    std::vector<Size> needed, before, after;
+    for (ExperimentType::ConstIterator it = peak_map.RTBegin(rt_min - rt_margin); it != peak_map.RTEnd(rt_max + rt_margin); ++it)
+    {
+      if (it->getMSLevel() != 1)
+      {
+        continue;
+      }
+      Size index = std::distance(peak_map.begin(), it);
+      if (it->getRT() < rt_min)
+      {
+        before.push_back(index);
+      }
+      else if (it->getRT() > rt_max)
+      {
+        after.push_back(index);
+      }
+      else
+      {
+        needed.push_back(index);
+      }
+    }
+
+    // prefetch alternately from both sides, closest scans first
+    std::vector<Size> prefetch;
+    std::vector<Size>::reverse_iterator b_it = before.rbegin();
+    std::vector<Size>::iterator a_it = after.begin();
+    while (b_it != before.rend() || a_it != after.end())
+    {
+      if (a_it != after.end())
+      {
+        prefetch.push_back(*a_it++);
+      }
+      if (b_it != before.rend())
+      {
+        prefetch.push_back(*b_it++);
+      }
+    }
+
+    layer.on_disc_cache->request(needed, prefetch);
+  }
+
+  void Spectrum2DCanvas::onDiscSpectraLoaded_()
+  {
+    bool changed = false;
+    for (Size i = 0; i < getLayerCount(); ++i)
+    {
+      if (getLayer(i).on_disc_cache && getLayer(i).on_disc_cache->transferLoaded())
+      {
+        changed = true;
+      }
+    }
+    if (!changed)
+    {
+      return;
+    }
+
+    // peaks may have been removed from memory again
+    const LayerData & current = getCurrentLayer();
+    if (current.type == LayerData::DT_PEAK && current.on_disc_cache)
+    {
+      const ExperimentType & peak_map = *current.getPeakData();
+      if (selected_peak_.isValid() && (selected_peak_.spectrum >= peak_map.size() || selected_peak_.peak >= peak_map[selected_peak_.spectrum].size()))
+      {
+        selected_peak_.clear();
+      }
+      if (measurement_start_.isValid() && (measurement_start_.spectrum >= peak_map.size() || measurement_start_.peak >= peak_map[measurement_start_.spectrum].size()))
+      {
+        measurement_start_.clear();
+      }
+    }
+
+    update_buffer_ = true;
+    update_(OPENMS_PRETTY_FUNCTION);
+    emit peakDataLoaded();
+  }
+
   void Spectrum2DCanvas::paintFeatureData_(Size layer_index, QPainter& painter)
   {
     const LayerData& layer = getLayer(layer_index);
@@ -1245,6 +1510,23 @@ namespace OpenMS
       {
         setLayerFlag(LayerData::P_PRECURSORS, true); // show precursors if no MS1 data is contained
       }
+
+      // survey scans kept on disk: load their peaks on demand
+      LayerData & layer = getCurrentLayer_();
+      if (!layer.getOnDiscPeakData()->empty() && layer.getOnDiscPeakData()->getNrSpectra() == layer.getPeakData()->size())
+      {
+        const ExperimentType & peak_map = *layer.getPeakData();
+        for (ExperimentType::ConstIterator it = peak_map.begin(); it != peak_map.end(); ++it)
+        {
+          if (it->getMSLevel() == 1 && it->empty())
+          {
+            layer.on_disc_cache = boost::shared_ptr<OnDiscSpectrumCache>(
+              new OnDiscSpectrumCache(*layer.getOnDiscPeakData(), layer.getPeakDataMuteable(), on_disc_cache_max_peaks_));
+            connect(layer.on_disc_cache.get(), SIGNAL(spectraLoaded()), this, SLOT(onDiscSpectraLoaded_()));
+            break;
+          }
+        }
+      }
     }
     else if (layers_.back().type == LayerData::DT_FEATURE)  // feature data
     {
@@ -1339,6 +1621,7 @@ namespace OpenMS
 
     // remove the data
     layers_.erase(layers_.begin() + layer_index);
+    pruneTilePyramids_();
 
     // update visible area and boundaries
     DRange<3> old_data_range = overall_data_range_;
@@ -2828,6 +3111,16 @@ namespace OpenMS
 
   void Spectrum2DCanvas::updateLayer(Size i)
   {
+    // the data might have been changed in place: cancel a pending build and
+    // rebuild the tile pyramid on demand
+    TilePyramidMap::iterator pyramid_it = tile_pyramids_.find(TilePyramidKey(getLayer(i).getPeakData()));
+    if (pyramid_it != tile_pyramids_.end())
+    {
+      *pyramid_it->second.cancel = true;
+      tile_pyramids_.erase(pyramid_it);
+    }
+    pruneTilePyramids_();
+
     //update nearest peak
     selected_peak_.clear();
     recalculateRanges_(0, 1, 2);
@@ -103,6 +103,7 @@ namespace OpenMS
     connect(canvas(), SIGNAL(showProjectionInfo(int, double, double)), this, SLOT(projectionInfo(int, double, double)));
     connect(canvas(), SIGNAL(toggleProjections()), this, SLOT(toggleProjections()));
     connect(canvas(), SIGNAL(visibleAreaChanged(DRange<2>)), this, SLOT(autoUpdateProjections()));
+    connect(canvas(), SIGNAL(peakDataLoaded()), this, SLOT(autoUpdateProjections()));
     // delegate signals from canvas
     connect(canvas(), SIGNAL(showSpectrumAs1D(int)), this, SIGNAL(showSpectrumAs1D(int)));
     connect(canvas(), SIGNAL(showSpectrumAs1D(std::vector<int, std::allocator<int> >)), this, SIGNAL(showSpectrumAs1D(std::vector<int, std::allocator<int> >)));
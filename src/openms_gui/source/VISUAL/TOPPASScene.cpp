@@ -59,6 +59,8 @@
 #include <QtCore/QTextStream>
 #include <QtWidgets/QMessageBox>
 
+#include <algorithm>
+
 namespace OpenMS
 {
 
@@ -86,8 +88,10 @@ namespace OpenMS
     user_specified_out_dir_(false),
     clipboard_(nullptr),
     dry_run_(true),
-    threads_active_(0),
+    running_processes_(),
     allowed_threads_(1),
+    allowed_memory_(0),
+    critical_path_lengths_(),
     resume_source_(nullptr)
   {
     /*	ATTENTION!
@@ -673,6 +677,7 @@ namespace OpenMS
 
       // reset processes
       topp_processes_queue_.clear();
+      critical_path_lengths_.clear();
 
       // start at input nodes
       for (VertexIterator it = verticesBegin(); it != verticesEnd(); ++it)
@@ -1664,9 +1669,17 @@ namespace OpenMS
     }
   }
 
-  void TOPPASScene::processFinished()
+  void TOPPASScene::processFinished(QProcess* p)
   {
-    --threads_active_;
+    // release the resources of the process
+    for (int i = 0; i < running_processes_.size(); ++i)
+    {
+      if (running_processes_[i].proc == p)
+      {
+        running_processes_.removeAt(i);
+        break;
+      }
+    }
     // try to run next in line
     runNextProcess();
   }
@@ -1912,6 +1925,7 @@ namespace OpenMS
             if (askForOutputDir(false))
             {
               setPipelineRunning();
+              critical_path_lengths_.clear();
               resume_source_ = ttv;
               resetDownstream(ttv);
               ttv->run();
@@ -2004,11 +2018,23 @@ namespace OpenMS
 
     used = true;
 
-    while (!topp_processes_queue_.empty() && threads_active_ < allowed_threads_)
+    while (!topp_processes_queue_.empty())
     {
-      ++threads_active_; // will be decreased, once the tool finishes
-      TOPPProcess tp = topp_processes_queue_.first();
-      topp_processes_queue_.pop_front();
+      QList<int> critical_path_lengths;
+      for (int i = 0; i < topp_processes_queue_.size(); ++i)
+      {
+        critical_path_lengths << getCriticalPathLength_(topp_processes_queue_[i].tv);
+      }
+      int next = selectNextProcess(topp_processes_queue_, critical_path_lengths, running_processes_, allowed_threads_, allowed_memory_);
+      if (next == -1)
+      {
+        break; // wait for running processes to finish
+      }
+
+      TOPPProcess tp = topp_processes_queue_.takeAt(next);
+      // resources will be released, once the tool finishes
+      // (which may happen right away for a dry run)
+      running_processes_ << tp;
       FakeProcess* p = qobject_cast<FakeProcess*>(tp.proc);
       if (p)
       {
@@ -2025,6 +2051,70 @@ namespace OpenMS
     checkIfWeAreDone();
   }
 
+  bool TOPPASScene::fitsResources(const TOPPProcess& process, const QList<TOPPProcess>& running, int allowed_threads, Size allowed_memory)
+  {
+    // a process exceeding the budget on its own is run alone
+    if (running.empty())
+    {
+      return true;
+    }
+    int threads_active = 0;
+    Size memory_active = 0;
+    for (QList<TOPPProcess>::const_iterator it = running.begin(); it != running.end(); ++it)
+    {
+      threads_active += it->threads;
+      memory_active += it->memory;
+    }
+    if (threads_active + process.threads > allowed_threads)
+    {
+      return false;
+    }
+    if (allowed_memory > 0 && memory_active + process.memory > allowed_memory)
+    {
+      return false;
+    }
+    return true;
+  }
+
+  int TOPPASScene::selectNextProcess(const QList<TOPPProcess>& pending, const QList<int>& critical_path_lengths,
+                                     const QList<TOPPProcess>& running, int allowed_threads, Size allowed_memory)
+  {
+    // among the processes which fit into the budget, pick the one with the
+    // longest critical path (the first one enqueued on ties)
+    int next = -1;
+    int next_length = -1;
+    for (int i = 0; i < pending.size(); ++i)
+    {
+      if (critical_path_lengths[i] > next_length && fitsResources(pending[i], running, allowed_threads, allowed_memory))
+      {
+        next = i;
+        next_length = critical_path_lengths[i];
+      }
+    }
+    return next;
+  }
+
+  int TOPPASScene::getCriticalPathLength_(const TOPPASVertex* vertex)
+  {
+    QHash<const TOPPASVertex*, int>::const_iterator it = critical_path_lengths_.find(vertex);
+    if (it != critical_path_lengths_.end())
+    {
+      return it.value();
+    }
+
+    int length = 0;
+    for (TOPPASVertex::ConstEdgeIterator e_it = vertex->outEdgesBegin(); e_it != vertex->outEdgesEnd(); ++e_it)
+    {
+      length = std::max(length, getCriticalPathLength_((*e_it)->getTargetVertex()));
+    }
+    if (qobject_cast<const TOPPASToolVertex*>(vertex))
+    {
+      ++length;
+    }
+    critical_path_lengths_[vertex] = length;
+    return length;
+  }
+
   bool TOPPASScene::sanityCheck_(bool allowUserOverride)
   {
     QStringList strange_vertices;
@@ -2349,6 +2439,11 @@ namespace OpenMS
     allowed_threads_ = num_jobs;
   }
 
+  void TOPPASScene::setAllowedMemory(Size memory)
+  {
+    allowed_memory_ = memory;
+  }
+
   bool TOPPASScene::isGUIMode() const
   {
     return gui_;
@@ -52,6 +52,8 @@
 
 #include <QSvgRenderer>
 
+#include <algorithm>
+
 namespace OpenMS
 {
 
@@ -598,6 +600,9 @@ namespace OpenMS
       // we might need to modify input/output file parameters before storing to INI
       Param param_tmp = param_;
 
+      // the size of the input serves as (rough) estimate of the memory required
+      qint64 input_bytes = 0;
+
       /// INCOMING EDGES
       for (RoundPackageConstIt ite = pkg[round].begin();
            ite != pkg[round].end();
@@ -625,6 +630,10 @@ namespace OpenMS
           args << "-" + param_name.toQString();
 
         const QStringList& file_list = ite->second.filenames.get();
+        foreach(const QString& file, file_list)
+        {
+          input_bytes += QFileInfo(file).size();
+        }
 
         if (store_to_ini)
         {
@@ -731,7 +740,9 @@ namespace OpenMS
         }
       }
       toolScheduledSlot();
-      ts->enqueueProcess(TOPPASScene::TOPPProcess(p, File::findExecutable(name_).toQString(), args, this));
+      int threads = param_tmp.exists("threads") ? std::max(1, (int)param_tmp.getValue("threads")) : 1;
+      Size memory = Size((input_bytes + (1 << 20) - 1) >> 20);
+      ts->enqueueProcess(TOPPASScene::TOPPProcess(p, File::findExecutable(name_).toQString(), args, this, threads, memory));
     }
 
     // run pending processes
@@ -798,13 +809,12 @@ namespace OpenMS
 
     //clean up
     QProcess* p = qobject_cast<QProcess*>(QObject::sender());
+    ts->processFinished(p);
     if (p)
     {
       delete p;
     }
 
-    ts->processFinished();
-
     __DEBUG_END_METHOD__
   }
 
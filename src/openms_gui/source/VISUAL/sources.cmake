@@ -17,10 +17,13 @@ ListEditor.cpp
 MetaDataBrowser.cpp
 MultiGradient.cpp
 MultiGradientSelector.cpp
+OnDiscSpectrumCache.cpp
 
 ParamEditor.cpp
 ParamEditor.ui
 
+PeakMapTilePyramid.cpp
+
 SpectraIdentificationViewWidget.cpp
 SpectraViewWidget.cpp
 Spectrum1DCanvas.cpp
@@ -37,6 +37,9 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <boost/shared_ptr.hpp>
 
 #include <OpenMS/OPENSWATHALGO/OpenSwathAlgoConfig.h>
@@ -205,7 +208,11 @@ public:
 
   struct LightTargetedExperiment
   {
-    LightTargetedExperiment() : compound_reference_map_dirty_(true) {}
+    LightTargetedExperiment() :
+      compound_transition_index_valid_(false),
+      indexed_transitions_(0),
+      compound_reference_map_dirty_(true)
+    {}
 
     typedef LightTransition Transition;
     typedef LightCompound Peptide;
@@ -215,6 +222,142 @@ public:
     std::vector<LightTransition> transitions;
     std::vector<LightCompound> compounds;
     std::vector<LightProtein> proteins;
+
+    /**
+      @brief Compound to transition offset table
+
+      If present (see hasCompoundTransitionIndex()), the transitions of
+      compound i are stored contiguously in transitions[k] with
+      compound_transition_offsets[i] <= k < compound_transition_offsets[i + 1].
+      Transitions that do not belong to any compound are stored after the
+      transitions of the last compound.
+
+      This allows to iterate over the transitions of a compound (and to
+      select contiguous subsets of compounds) without building a map of
+      reference strings. The table is created by groupTransitionsByCompound()
+      and carried over to selections of compounds by
+      setCompoundTransitionOffsets(). A table that is assigned directly is
+      only used after it was checked by validateCompoundTransitionIndex().
+
+      The light TSV and PQP readers (TransitionTSVFile, TransitionPQPFile)
+      group the transitions while loading: transitions of a compound that are
+      interleaved with those of other compounds in the input are moved next to
+      the first transition of their compound (the order within a compound is
+      kept).
+    */
+    std::vector<std::size_t> compound_transition_offsets;
+
+    /**
+      @brief Whether the compound to transition offset table is present and up to date
+
+      Returns the state established by groupTransitionsByCompound(),
+      setCompoundTransitionOffsets() or validateCompoundTransitionIndex(),
+      without looking at the transitions again (this is called for every
+      batch of compounds, see OpenSwathWorkflow). Adding or removing
+      transitions or compounds disables the table. Reordering or changing
+      transitions or compounds in place is not detected: call
+      validateCompoundTransitionIndex() or groupTransitionsByCompound()
+      after such changes.
+    */
+    bool hasCompoundTransitionIndex() const
+    {
+      return compound_transition_index_valid_ &&
+        indexed_transitions_ == transitions.size() &&
+        compound_transition_offsets.size() == compounds.size() + 1;
+    }
+
+    /**
+      @brief Checks the compound to transition offset table against the data
+
+      Checks that each transition in the range of compound i refers to
+      compound i and that no transition after the last compound refers to
+      any compound. The result is stored and returned by
+      hasCompoundTransitionIndex() until the next change of the table.
+
+      @return Whether the table is valid
+    */
+    bool validateCompoundTransitionIndex()
+    {
+      compound_transition_index_valid_ = checkCompoundTransitionIndex_();
+      indexed_transitions_ = transitions.size();
+      return compound_transition_index_valid_;
+    }
+
+    /**
+      @brief Sets the compound to transition offset table of transitions which are grouped by compound
+
+      Used when selecting from an experiment which has a valid table (see
+      hasCompoundTransitionIndex()): the selection is grouped by construction
+      and does not need to be checked again.
+
+      @param offsets The offsets (compounds.size() + 1 entries, see compound_transition_offsets)
+    */
+    void setCompoundTransitionOffsets(const std::vector<std::size_t>& offsets)
+    {
+      compound_transition_offsets = offsets;
+      compound_transition_index_valid_ = true;
+      indexed_transitions_ = transitions.size();
+    }
+
+    /**
+      @brief Group the transitions by compound and create the compound to transition offset table
+
+      Transitions are (stably) reordered such that all transitions of a
+      compound are stored contiguously, in the order of the compounds.
+
+      @param compound_indices The index of the compound of each transition
+        (any value >= compounds.size() marks a transition without compound)
+    */
+    void groupTransitionsByCompound(const std::vector<std::size_t>& compound_indices)
+    {
+      // counting sort by compound index (orphaned transitions go last)
+      std::size_t nr_compounds = compounds.size();
+      compound_transition_offsets.assign(nr_compounds + 2, 0);
+      for (std::size_t i = 0; i < transitions.size(); i++)
+      {
+        std::size_t c = compound_indices[i] < nr_compounds ? compound_indices[i] : nr_compounds;
+        ++compound_transition_offsets[c + 1];
+      }
+      for (std::size_t c = 0; c <= nr_compounds; c++)
+      {
+        compound_transition_offsets[c + 1] += compound_transition_offsets[c];
+      }
+
+      std::vector<LightTransition> grouped(transitions.size());
+      std::vector<std::size_t> next(compound_transition_offsets.begin(), compound_transition_offsets.end() - 1);
+      for (std::size_t i = 0; i < transitions.size(); i++)
+      {
+        std::size_t c = compound_indices[i] < nr_compounds ? compound_indices[i] : nr_compounds;
+        std::swap(grouped[next[c]++], transitions[i]);
+      }
+      transitions.swap(grouped);
+      compound_transition_offsets.pop_back();
+      compound_transition_index_valid_ = true;
+      indexed_transitions_ = transitions.size();
+    }
+
+    /// Group the transitions by compound (using their compound reference) and create the compound to transition offset table
+    void groupTransitionsByCompound()
+    {
+      std::unordered_map<std::string, std::size_t> compound_index;
+      compound_index.reserve(compounds.size());
+      for (std::size_t c = 0; c < compounds.size(); c++)
+      {
+        compound_index.emplace(compounds[c].id, c);
+      }
+
+      std::vector<std::size_t> compound_indices(transitions.size(), compounds.size());
+      for (std::size_t i = 0; i < transitions.size(); i++)
+      {
+        std::unordered_map<std::string, std::size_t>::const_iterator it = compound_index.find(transitions[i].peptide_ref);
+        if (it != compound_index.end())
+        {
+          compound_indices[i] = it->second;
+        }
+      }
+      groupTransitionsByCompound(compound_indices);
+    }
+
     std::vector<LightTransition> & getTransitions()
     {
       return transitions;
@@ -262,6 +405,46 @@ public:
 
   private:
 
+    bool checkCompoundTransitionIndex_() const
+    {
+      if (compound_transition_offsets.size() != compounds.size() + 1 ||
+          compound_transition_offsets.back() > transitions.size())
+      {
+        return false;
+      }
+      for (std::size_t c = 0; c < compounds.size(); c++)
+      {
+        if (compound_transition_offsets[c] > compound_transition_offsets[c + 1])
+        {
+          return false;
+        }
+        for (std::size_t i = compound_transition_offsets[c]; i < compound_transition_offsets[c + 1]; i++)
+        {
+          if (transitions[i].peptide_ref != compounds[c].id)
+          {
+            return false;
+          }
+        }
+      }
+      if (compound_transition_offsets.back() < transitions.size())
+      {
+        std::unordered_set<std::string> compound_ids;
+        compound_ids.reserve(compounds.size());
+        for (std::size_t c = 0; c < compounds.size(); c++)
+        {
+          compound_ids.insert(compounds[c].id);
+        }
+        for (std::size_t i = compound_transition_offsets.back(); i < transitions.size(); i++)
+        {
+          if (compound_ids.find(transitions[i].peptide_ref) != compound_ids.end())
+          {
+            return false;
+          }
+        }
+      }
+      return true;
+    }
+
     void createPeptideReferenceMap_()
     {
       for (size_t i = 0; i < getCompounds().size(); i++)
@@ -271,6 +454,10 @@ public:
       compound_reference_map_dirty_ = false;
     }
 
+    // State of the compound to transition offset table (see hasCompoundTransitionIndex())
+    bool compound_transition_index_valid_;
+    std::size_t indexed_transitions_;
+
     // Map of compounds (peptides or metabolites)
     bool compound_reference_map_dirty_;
     std::map<std::string, LightCompound*> compound_reference_map_;
@@ -1,4 +1,7 @@
+from libcpp.vector cimport vector as libcpp_vector
+from libcpp cimport bool
 from MSSpectrum cimport *
+from MSChromatogram cimport *
 from MSExperiment cimport *
 from ChromatogramPeak cimport *
 from Peak1D cimport *
@@ -24,6 +27,10 @@ cdef extern from "<OpenMS/TRANSFORMATIONS/RAW2PEAK/PeakPickerHiRes.h>" namespace
                             MSExperiment & output
                            ) nogil except +
 
+        void pickSpectra(libcpp_vector[MSSpectrum] & spectra, bool check_spectrum_type) nogil except +
+        void pickChromatograms(libcpp_vector[MSChromatogram] & chromatograms) nogil except +
+        bool isSelectedForPicking(MSSpectrum & spectrum, bool check_spectrum_type) nogil except +
+
 cdef extern from "<OpenMS/TRANSFORMATIONS/RAW2PEAK/PeakPickerHiRes.h>" namespace "OpenMS::PeakPickerHiRes":
     
     cdef cppclass PeakBoundary "OpenMS::PeakPickerHiRes::PeakBoundary":
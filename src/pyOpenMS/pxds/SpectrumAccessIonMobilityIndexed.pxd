@@ -0,0 +1,28 @@
+from Types cimport *
+from smart_ptr cimport shared_ptr
+from OpenSwathDataStructures cimport *
+from ISpectrumAccess cimport *
+
+from SpectrumAccessOpenMS cimport *
+from SpectrumAccessOpenMSCached cimport *
+from SpectrumAccessOpenMSInMemory cimport *
+
+cdef extern from "<OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessIonMobilityIndexed.h>" namespace "OpenMS":
+    
+    cdef cppclass SpectrumAccessIonMobilityIndexed(ISpectrumAccess) :
+        # wrap-inherits:
+        #  ISpectrumAccess
+
+        SpectrumAccessIonMobilityIndexed() # wrap-pass-constructor
+
+        SpectrumAccessIonMobilityIndexed(SpectrumAccessOpenMS) nogil except +
+        SpectrumAccessIonMobilityIndexed(SpectrumAccessOpenMSCached) nogil except +
+        SpectrumAccessIonMobilityIndexed(SpectrumAccessOpenMSInMemory) nogil except +
+        SpectrumAccessIonMobilityIndexed(SpectrumAccessOpenMS, Size block_size) nogil except +
+        SpectrumAccessIonMobilityIndexed(SpectrumAccessIonMobilityIndexed) nogil except +
+
+        bool hasIonMobilityIndex(int id_) nogil except +
+        Size getNrPeaks(int id_) nogil except +
+        double integrateWindow(int id_, double mz_start, double mz_end, double im_start, double im_end) nogil except +
+        shared_ptr[OSSpectrum] getSpectrumByIdAndWindow(int id_, double mz_start, double mz_end, double im_start, double im_end) nogil except +
+
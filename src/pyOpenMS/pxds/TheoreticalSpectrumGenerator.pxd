@@ -15,3 +15,8 @@ cdef extern from "<OpenMS/CHEMISTRY/TheoreticalSpectrumGenerator.h>" namespace "
         TheoreticalSpectrumGenerator() nogil except +
         TheoreticalSpectrumGenerator(TheoreticalSpectrumGenerator) nogil except +
         void getSpectrum(MSSpectrum &spec, AASequence &peptide, Int min_charge, Int max_charge) nogil except +
+
+## wrap static methods
+cdef extern from "<OpenMS/CHEMISTRY/TheoreticalSpectrumGenerator.h>" namespace "OpenMS::TheoreticalSpectrumGenerator":
+
+    void getPrefixMasses(libcpp_vector[double] & prefix_masses, AASequence & peptide) nogil except + # wrap-attach:TheoreticalSpectrumGenerator
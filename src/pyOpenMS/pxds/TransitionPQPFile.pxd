@@ -14,6 +14,7 @@ cdef extern from "<OpenMS/ANALYSIS/OPENSWATH/TransitionPQPFile.h>" namespace "Op
         void convertTargetedExperimentToPQP(char * filename, TargetedExperiment & targeted_exp) nogil except +
         void convertPQPToTargetedExperiment(char * filename, TargetedExperiment & targeted_exp, bool legacy_traml_id) nogil except +
         void convertPQPToTargetedExperiment(char * filename, LightTargetedExperiment & targeted_exp, bool legacy_traml_id) nogil except +
+        void convertTSVToPQP(char * tsv_filename, FileType filetype, char * pqp_filename) nogil except +
 
         # inherited from TransitionTSVFile
         # due to issues with Cython and overloaded inheritance
@@ -0,0 +1,10 @@
+set(BENCHMARK_executables
+  Base64_benchmark
+  ChromatogramExtractor_benchmark
+  FeatureFinderMetabo_benchmark
+  FeatureGroupingAlgorithmQT_benchmark
+  MzMLFile_benchmark
+  PeakPickerHiRes_benchmark
+  PeptideIndexing_benchmark
+  TheoreticalSpectrumGenerator_benchmark
+)
@@ -0,0 +1,99 @@
+# --------------------------------------------------------------------------
+#                   OpenMS -- Open-Source Mass Spectrometry
+# --------------------------------------------------------------------------
+# Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+# ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+#
+# This software is released under a three-clause BSD license:
+#  * Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#  * Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#  * Neither the name of any author or any participating institution
+#    may be used to endorse or promote products derived from this software
+#    without specific prior written permission.
+# For a full list of authors, refer to the file AUTHORS.
+# --------------------------------------------------------------------------
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+# INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+# OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+# WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+# OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+# ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+# --------------------------------------------------------------------------
+# $Maintainer: agent $
+# $Authors: agent $
+# --------------------------------------------------------------------------
+
+
+#------------------------------------------------------------------------------
+# Runs every benchmark case of one executable in its own process and merges
+# the JSON results into a single file (as written by --benchmark_out).
+#
+# The peak memory reported by the benchmarks is the high-water mark of the
+# process, running all cases in the same process would report the maximum
+# of all previous cases.
+#
+# Usage:
+#   cmake -D BENCHMARK=<executable> -D OUTPUT=<file.json> -P run_benchmark.cmake
+
+if (NOT BENCHMARK OR NOT OUTPUT)
+  message(FATAL_ERROR "run_benchmark.cmake: BENCHMARK and OUTPUT need to be set.")
+endif()
+
+execute_process(COMMAND ${BENCHMARK} --benchmark_list_tests=true
+                OUTPUT_VARIABLE _cases
+                RESULT_VARIABLE _result)
+if (NOT _result EQUAL 0)
+  message(FATAL_ERROR "Listing the cases of ${BENCHMARK} failed.")
+endif()
+string(REGEX REPLACE "\n$" "" _cases "${_cases}")
+string(REPLACE "\n" ";" _cases "${_cases}")
+
+set(_header)
+set(_entries)
+set(_index 0)
+foreach(_case ${_cases})
+  # match exactly this case
+  string(REGEX REPLACE "([][.*+?^$(){}|\\\\])" "\\\\\\1" _filter "${_case}")
+  set(_case_output "${OUTPUT}.${_index}")
+  execute_process(COMMAND ${BENCHMARK} "--benchmark_filter=^${_filter}$"
+                          "--benchmark_out=${_case_output}" --benchmark_out_format=json
+                  RESULT_VARIABLE _result)
+  if (NOT _result EQUAL 0)
+    message(FATAL_ERROR "Running ${_case} of ${BENCHMARK} failed.")
+  endif()
+
+  # split into the header (context) and the entries of the "benchmarks" array
+  file(READ "${_case_output}" _json)
+  file(REMOVE "${_case_output}")
+  string(FIND "${_json}" "\"benchmarks\": [" _begin)
+  string(FIND "${_json}" "]" _end REVERSE)
+  if (_begin EQUAL -1 OR _end EQUAL -1)
+    message(FATAL_ERROR "Unexpected output of ${_case} in ${_case_output}.")
+  endif()
+  math(EXPR _begin "${_begin} + 15")
+  math(EXPR _length "${_end} - ${_begin}")
+  string(SUBSTRING "${_json}" ${_begin} ${_length} _case_entries)
+  string(STRIP "${_case_entries}" _case_entries)
+  if (NOT _header)
+    string(SUBSTRING "${_json}" 0 ${_begin} _header)
+  endif()
+  if (_case_entries)
+    if (_entries)
+      set(_entries "${_entries},\n    ${_case_entries}")
+    else()
+      set(_entries "    ${_case_entries}")
+    endif()
+  endif()
+  math(EXPR _index "${_index} + 1")
+endforeach()
+
+file(WRITE "${OUTPUT}" "${_header}\n${_entries}\n  ]\n}\n")
@@ -0,0 +1,100 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include "BenchmarkData.h"
+
+#include <OpenMS/FORMAT/Base64.h>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+
+using namespace OpenMS;
+
+namespace
+{
+  /// m/z-like (sorted) data, which is what the mzML writer encodes
+  std::vector<double> createData(Size n)
+  {
+    boost::random::mt19937 rng(0);
+    boost::random::uniform_real_distribution<double> step(0.0, 0.01);
+    std::vector<double> data(n);
+    double mz = 400.0;
+    for (Size i = 0; i < n; ++i)
+    {
+      mz += step(rng);
+      data[i] = mz;
+    }
+    return data;
+  }
+}
+
+/// Encodes 64 bit floats (arguments: number of values, zlib compression)
+static void BM_Base64_encode(benchmark::State& state)
+{
+  std::vector<double> data = createData(state.range(0));
+  const bool zlib = state.range(1) != 0;
+
+  for (auto _ : state)
+  {
+    String out;
+    Base64::encode(data, Base64::BYTEORDER_LITTLEENDIAN, out, zlib);
+    benchmark::DoNotOptimize(out.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(double));
+  BenchmarkData::reportPeakMemory(state);
+}
+BENCHMARK(BM_Base64_encode)->Args({100000, 0})->Args({100000, 1})->Args({1000000, 0})->Args({1000000, 1});
+
+/// Decodes 64 bit floats (arguments: number of values, zlib compression)
+static void BM_Base64_decode(benchmark::State& state)
+{
+  std::vector<double> data = createData(state.range(0));
+  const bool zlib = state.range(1) != 0;
+  String encoded;
+  Base64::encode(data, Base64::BYTEORDER_LITTLEENDIAN, encoded, zlib);
+
+  for (auto _ : state)
+  {
+    std::vector<double> out;
+    Base64::decode(encoded, Base64::BYTEORDER_LITTLEENDIAN, out, zlib);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(double));
+  BenchmarkData::reportPeakMemory(state);
+}
+BENCHMARK(BM_Base64_decode)->Args({100000, 0})->Args({100000, 1})->Args({1000000, 0})->Args({1000000, 1});
+
+BENCHMARK_MAIN();
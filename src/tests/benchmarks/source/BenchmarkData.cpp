@@ -0,0 +1,375 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include "BenchmarkData.h"
+
+#include <OpenMS/CONCEPT/Constants.h>
+#include <OpenMS/SYSTEM/SysInfo.h>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/discrete_distribution.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace OpenMS
+{
+  namespace
+  {
+    typedef boost::random::mt19937 Generator;
+
+    double uniform(Generator& rng, double min, double max)
+    {
+      return boost::random::uniform_real_distribution<double>(min, max)(rng);
+    }
+
+    /// Relative isotope intensities (Poisson approximation of averagine)
+    std::vector<double> isotopePattern(double mass, Size peaks)
+    {
+      const double lambda = mass / 1800.0;
+      std::vector<double> pattern(peaks);
+      double p = std::exp(-lambda);
+      for (Size k = 0; k < peaks; ++k)
+      {
+        pattern[k] = p;
+        p *= lambda / (k + 1);
+      }
+      double max_p = *std::max_element(pattern.begin(), pattern.end());
+      for (Size k = 0; k < peaks; ++k)
+      {
+        pattern[k] /= max_p;
+      }
+      return pattern;
+    }
+
+    /// Analyte with Gaussian elution profile
+    struct Analyte
+    {
+      double mz;
+      double rt;
+      double intensity;
+      Int charge;
+    };
+
+    void addSignal(MSSpectrum& spectrum, const std::vector<Analyte>& analytes, const std::vector<std::vector<double> >& patterns,
+                   double rt, double rt_sigma, Generator& rng)
+    {
+      boost::random::normal_distribution<double> mz_error(0.0, 1e-6); // 1 ppm
+      for (Size a = 0; a < analytes.size(); ++a)
+      {
+        const double d = (rt - analytes[a].rt) / rt_sigma;
+        if (std::fabs(d) > 4.0)
+        {
+          continue;
+        }
+        const double elution = analytes[a].intensity * std::exp(-0.5 * d * d);
+        for (Size k = 0; k < patterns[a].size(); ++k)
+        {
+          Peak1D p;
+          const double mz = analytes[a].mz + k * Constants::C13C12_MASSDIFF_U / analytes[a].charge;
+          p.setMZ(mz * (1.0 + mz_error(rng)));
+          p.setIntensity(elution * patterns[a][k]);
+          spectrum.push_back(p);
+        }
+      }
+    }
+
+    void addNoise(MSSpectrum& spectrum, Size peaks, double min_mz, double max_mz, Generator& rng)
+    {
+      for (Size i = 0; i < peaks; ++i)
+      {
+        Peak1D p;
+        p.setMZ(uniform(rng, min_mz, max_mz));
+        p.setIntensity(uniform(rng, 100.0, 1000.0));
+        spectrum.push_back(p);
+      }
+    }
+  }
+
+  PeakMap BenchmarkData::profileExperiment(Size spectra, Size peaks_per_spectrum, UInt seed)
+  {
+    const double min_mz = 400.0, max_mz = 1600.0, spacing = 0.005;
+    const double sigma = 0.025 / 2.3548; // FWHM -> standard deviation
+    const Size points = Size((max_mz - min_mz) / spacing);
+    const SignedSize half_width = SignedSize(4.0 * sigma / spacing) + 1;
+
+    Generator rng(seed);
+    PeakMap exp;
+    std::vector<double> intensities(points);
+    for (Size s = 0; s < spectra; ++s)
+    {
+      for (Size i = 0; i < points; ++i)
+      {
+        intensities[i] = uniform(rng, 0.0, 10.0);
+      }
+      for (Size k = 0; k < peaks_per_spectrum; ++k)
+      {
+        const double mz = uniform(rng, min_mz + 1.0, max_mz - 1.0);
+        const double height = uniform(rng, 1e3, 1e6);
+        const SignedSize center = SignedSize((mz - min_mz) / spacing);
+        for (SignedSize i = center - half_width; i <= center + half_width; ++i)
+        {
+          const double d = (min_mz + i * spacing - mz) / sigma;
+          intensities[i] += height * std::exp(-0.5 * d * d);
+        }
+      }
+
+      MSSpectrum spectrum;
+      spectrum.setMSLevel(1);
+      spectrum.setRT(double(s));
+      spectrum.setNativeID(String("spectrum=") + s);
+      spectrum.setType(SpectrumSettings::PROFILE);
+      spectrum.resize(points);
+      for (Size i = 0; i < points; ++i)
+      {
+        spectrum[i].setMZ(min_mz + i * spacing);
+        spectrum[i].setIntensity(intensities[i]);
+      }
+      exp.addSpectrum(spectrum);
+    }
+    exp.updateRanges();
+    return exp;
+  }
+
+  PeakMap BenchmarkData::centroidedExperiment(Size spectra, Size compounds, UInt seed)
+  {
+    Generator rng(seed);
+    boost::random::uniform_int_distribution<Int> charge(1, 3);
+
+    std::vector<Analyte> analytes(compounds);
+    std::vector<std::vector<double> > patterns(compounds);
+    for (Size a = 0; a < compounds; ++a)
+    {
+      analytes[a].charge = charge(rng);
+      analytes[a].mz = uniform(rng, 200.0, 1200.0);
+      analytes[a].rt = uniform(rng, 20.0, std::max(21.0, spectra - 20.0));
+      analytes[a].intensity = std::pow(10.0, uniform(rng, 4.0, 7.0));
+      patterns[a] = isotopePattern(analytes[a].mz * analytes[a].charge, 4);
+    }
+
+    PeakMap exp;
+    for (Size s = 0; s < spectra; ++s)
+    {
+      MSSpectrum spectrum;
+      spectrum.setMSLevel(1);
+      spectrum.setRT(double(s));
+      spectrum.setNativeID(String("spectrum=") + s);
+      spectrum.setType(SpectrumSettings::CENTROID);
+      addSignal(spectrum, analytes, patterns, double(s), 10.0, rng);
+      addNoise(spectrum, 200, 200.0, 1300.0, rng);
+      spectrum.sortByPosition();
+      exp.addSpectrum(spectrum);
+    }
+    exp.updateRanges();
+    return exp;
+  }
+
+  PeakMap BenchmarkData::swathMap(Size spectra, Size fragments, std::vector<ChromatogramExtractorAlgorithm::ExtractionCoordinates>& coordinates, UInt seed)
+  {
+    const double cycle_time = 3.0;
+    Generator rng(seed);
+
+    std::vector<Analyte> analytes(fragments);
+    std::vector<std::vector<double> > patterns(fragments, std::vector<double>(1, 1.0));
+    coordinates.clear();
+    for (Size f = 0; f < fragments; ++f)
+    {
+      analytes[f].charge = 1;
+      analytes[f].mz = uniform(rng, 200.0, 1500.0);
+      analytes[f].rt = uniform(rng, 0.0, spectra * cycle_time);
+      analytes[f].intensity = std::pow(10.0, uniform(rng, 3.0, 6.0));
+
+      ChromatogramExtractorAlgorithm::ExtractionCoordinates coord;
+      coord.mz = analytes[f].mz;
+      coord.mz_precursor = 412.5;
+      coord.rt_start = analytes[f].rt - 30.0;
+      coord.rt_end = analytes[f].rt + 30.0;
+      coord.id = String("fragment_") + f;
+      coordinates.push_back(coord);
+    }
+    std::sort(coordinates.begin(), coordinates.end(), ChromatogramExtractorAlgorithm::ExtractionCoordinates::SortExtractionCoordinatesByMZ);
+
+    Precursor window;
+    window.setMZ(412.5);
+    window.setIsolationWindowLowerOffset(12.5);
+    window.setIsolationWindowUpperOffset(12.5);
+
+    PeakMap exp;
+    for (Size s = 0; s < spectra; ++s)
+    {
+      MSSpectrum spectrum;
+      spectrum.setMSLevel(2);
+      spectrum.setRT(s * cycle_time);
+      spectrum.setNativeID(String("spectrum=") + s);
+      spectrum.setType(SpectrumSettings::CENTROID);
+      spectrum.getPrecursors().push_back(window);
+      addSignal(spectrum, analytes, patterns, s * cycle_time, 10.0, rng);
+      addNoise(spectrum, 300, 200.0, 1500.0, rng);
+      spectrum.sortByPosition();
+      exp.addSpectrum(spectrum);
+    }
+    exp.updateRanges();
+    return exp;
+  }
+
+  std::vector<FeatureMap> BenchmarkData::featureMaps(Size maps, Size features, UInt seed)
+  {
+    Generator rng(seed);
+    boost::random::uniform_int_distribution<Int> charge(1, 3);
+
+    const Size shared = features - features / 10;
+    std::vector<Analyte> analytes(shared);
+    for (Size a = 0; a < shared; ++a)
+    {
+      analytes[a].charge = charge(rng);
+      analytes[a].mz = uniform(rng, 200.0, 1200.0);
+      analytes[a].rt = uniform(rng, 100.0, 3000.0);
+      analytes[a].intensity = std::pow(10.0, uniform(rng, 4.0, 7.0));
+    }
+
+    std::vector<FeatureMap> result(maps);
+    for (Size m = 0; m < maps; ++m)
+    {
+      FeatureMap& map = result[m];
+      for (Size f = 0; f < features; ++f)
+      {
+        Analyte analyte;
+        if (f < shared)
+        {
+          analyte = analytes[f];
+          analyte.rt += uniform(rng, -5.0, 5.0);
+          analyte.mz *= 1.0 + uniform(rng, -5e-6, 5e-6);
+        }
+        else
+        {
+          analyte.charge = charge(rng);
+          analyte.mz = uniform(rng, 200.0, 1200.0);
+          analyte.rt = uniform(rng, 100.0, 3000.0);
+          analyte.intensity = std::pow(10.0, uniform(rng, 4.0, 7.0));
+        }
+        Feature feature;
+        feature.setRT(analyte.rt);
+        feature.setMZ(analyte.mz);
+        feature.setCharge(analyte.charge);
+        feature.setIntensity(analyte.intensity * uniform(rng, 0.5, 2.0));
+        feature.setOverallQuality(1.0);
+        feature.setUniqueId();
+        map.push_back(feature);
+      }
+      map.setUniqueId();
+      map.updateRanges();
+    }
+    return result;
+  }
+
+  std::vector<FASTAFile::FASTAEntry> BenchmarkData::proteinDatabase(Size proteins, UInt seed)
+  {
+    // amino acid frequencies in UniProtKB/Swiss-Prot (in percent)
+    const char amino_acids[] = "ARNDCQEGHILKMFPSTWYV";
+    const double frequencies[] = {8.25, 5.53, 4.06, 5.45, 1.37, 3.93, 6.75, 7.07, 2.27, 5.96,
+                                  9.66, 5.84, 2.42, 3.86, 4.70, 6.56, 5.34, 1.08, 2.92, 6.87};
+    boost::random::discrete_distribution<Size> residue(frequencies, frequencies + 20);
+    boost::random::uniform_int_distribution<Size> length(100, 800);
+
+    Generator rng(seed);
+    std::vector<FASTAFile::FASTAEntry> result;
+    result.reserve(proteins);
+    for (Size p = 0; p < proteins; ++p)
+    {
+      const Size n = length(rng);
+      String sequence(n, 'M');
+      for (Size i = 1; i < n; ++i)
+      {
+        sequence[i] = amino_acids[residue(rng)];
+      }
+      result.push_back(FASTAFile::FASTAEntry(String("PROT_") + p, "synthetic protein", sequence));
+    }
+    return result;
+  }
+
+  std::vector<PeptideIdentification> BenchmarkData::peptideIdentifications(const std::vector<FASTAFile::FASTAEntry>& proteins, Size peptides, UInt seed)
+  {
+    std::vector<PeptideIdentification> result;
+    if (proteins.empty())
+    {
+      return result;
+    }
+
+    Generator rng(seed);
+    boost::random::uniform_int_distribution<Size> protein(0, proteins.size() - 1);
+    result.reserve(peptides);
+    for (Size attempt = 0; result.size() < peptides && attempt < 100 * peptides; ++attempt)
+    {
+      // tryptic cleavage sites of a random protein
+      const String& sequence = proteins[protein(rng)].sequence;
+      std::vector<Size> sites(1, 0);
+      for (Size i = 0; i + 1 < sequence.size(); ++i)
+      {
+        if ((sequence[i] == 'K' || sequence[i] == 'R') && sequence[i + 1] != 'P')
+        {
+          sites.push_back(i + 1);
+        }
+      }
+      sites.push_back(sequence.size());
+
+      // a random fully tryptic peptide without missed cleavages
+      const Size k = boost::random::uniform_int_distribution<Size>(0, sites.size() - 2)(rng);
+      const Size peptide_length = sites[k + 1] - sites[k];
+      if (peptide_length < 7 || peptide_length > 30)
+      {
+        continue;
+      }
+
+      PeptideHit hit;
+      hit.setSequence(AASequence::fromString(sequence.substr(sites[k], peptide_length)));
+      PeptideIdentification id;
+      id.insertHit(hit);
+      result.push_back(id);
+    }
+    return result;
+  }
+
+  void BenchmarkData::reportPeakMemory(benchmark::State& state)
+  {
+    size_t peak_kb = 0;
+    if (SysInfo::getProcessPeakMemoryConsumption(peak_kb))
+    {
+      state.counters["peak_memory_kb"] = benchmark::Counter(double(peak_kb));
+    }
+  }
+
+} // namespace OpenMS
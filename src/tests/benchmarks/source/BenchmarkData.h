@@ -0,0 +1,116 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/KERNEL/StandardTypes.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/KERNEL/FeatureMap.h>
+#include <OpenMS/FORMAT/FASTAFile.h>
+#include <OpenMS/METADATA/PeptideIdentification.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/ChromatogramExtractorAlgorithm.h>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Synthetic, reproducible input data for the benchmarks
+
+    All generators are deterministic for a given @p seed, so that benchmark
+    results of different builds are computed on identical data.
+  */
+  class BenchmarkData
+  {
+public:
+    /**
+      @brief MS1 profile spectra
+
+      Each spectrum covers 400-1600 m/z with a sampling distance of 0.005
+      (240,000 data points) and contains @p peaks_per_spectrum Gaussian peaks
+      of 0.025 FWHM on a low noise level.
+    */
+    static PeakMap profileExperiment(Size spectra, Size peaks_per_spectrum, UInt seed = 0);
+
+    /**
+      @brief MS1 centroided LC-MS map containing @p compounds compounds
+
+      Every compound has a Gaussian elution profile (10 s standard deviation)
+      and an isotope pattern of up to four peaks for charge 1 to 3. The
+      spectra are 1 s apart and contain random noise peaks in addition.
+    */
+    static PeakMap centroidedExperiment(Size spectra, Size compounds, UInt seed = 0);
+
+    /**
+      @brief SWATH map (centroided MS2 spectra of one isolation window)
+
+      @p fragments fragment ions (200-1500 m/z) elute with a Gaussian profile,
+      the remaining peaks of each spectrum are noise. The extraction
+      coordinates of the fragments (RT window of 60 s) are returned in
+      @p coordinates, sorted by m/z.
+    */
+    static PeakMap swathMap(Size spectra, Size fragments, std::vector<ChromatogramExtractorAlgorithm::ExtractionCoordinates>& coordinates, UInt seed = 0);
+
+    /**
+      @brief Feature maps for linking
+
+      @p maps maps of @p features features each. The features are drawn from
+      a common set of analytes with a RT shift of up to 5 s and a m/z error of
+      up to 5 ppm; 10 % of the features of every map are unique to it.
+    */
+    static std::vector<FeatureMap> featureMaps(Size maps, Size features, UInt seed = 0);
+
+    /**
+      @brief Protein database
+
+      @p proteins random protein sequences with amino acid frequencies as
+      found in UniProt and lengths between 100 and 800 residues.
+    */
+    static std::vector<FASTAFile::FASTAEntry> proteinDatabase(Size proteins, UInt seed = 0);
+
+    /**
+      @brief Tryptic peptides (7-30 residues) drawn from @p proteins
+
+      Each PeptideIdentification contains one PeptideHit without protein
+      references.
+    */
+    static std::vector<PeptideIdentification> peptideIdentifications(const std::vector<FASTAFile::FASTAEntry>& proteins, Size peptides, UInt seed = 0);
+
+    /// Adds the peak memory consumption of the process (in KB) as counter "peak_memory_kb" to @p state (a high-water mark, see README.md)
+    static void reportPeakMemory(benchmark::State& state);
+  };
+
+} // namespace OpenMS
@@ -0,0 +1,64 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include "BenchmarkData.h"
+
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SimpleOpenMSSpectraAccessFactory.h>
+
+using namespace OpenMS;
+
+/// Extracts fragment ion chromatograms from a SWATH map (arguments: number of spectra, number of fragments)
+static void BM_ChromatogramExtractor_extractChromatograms(benchmark::State& state)
+{
+  std::vector<ChromatogramExtractorAlgorithm::ExtractionCoordinates> coordinates;
+  boost::shared_ptr<PeakMap> swath(new PeakMap(BenchmarkData::swathMap(state.range(0), state.range(1), coordinates)));
+  OpenSwath::SpectrumAccessPtr swath_ptr = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(swath);
+  ChromatogramExtractorAlgorithm extractor;
+
+  for (auto _ : state)
+  {
+    std::vector<OpenSwath::ChromatogramPtr> output;
+    for (Size i = 0; i < coordinates.size(); ++i)
+    {
+      output.push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+    }
+    extractor.extractChromatograms(swath_ptr, output, coordinates, 50.0, true, -1, "tophat");
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetItemsProcessed(state.iterations() * coordinates.size());
+  BenchmarkData::reportPeakMemory(state);
+}
+BENCHMARK(BM_ChromatogramExtractor_extractChromatograms)->Args({1000, 1000})->Args({1000, 10000})->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,75 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include "BenchmarkData.h"
+
+#include <OpenMS/FILTERING/DATAREDUCTION/MassTraceDetection.h>
+#include <OpenMS/FILTERING/DATAREDUCTION/ElutionPeakDetection.h>
+#include <OpenMS/FILTERING/DATAREDUCTION/FeatureFindingMetabo.h>
+
+using namespace OpenMS;
+
+/// Mass trace detection, elution peak detection and feature assembly as run by FeatureFinderMetabo
+/// (arguments: number of spectra, number of compounds)
+static void BM_FeatureFinderMetabo(benchmark::State& state)
+{
+  const PeakMap input = BenchmarkData::centroidedExperiment(state.range(0), state.range(1));
+  MassTraceDetection mtd;
+  mtd.setLogType(ProgressLogger::NONE);
+  ElutionPeakDetection epd;
+  FeatureFindingMetabo ffm;
+  ffm.setLogType(ProgressLogger::NONE);
+
+  Size peaks = 0;
+  for (Size i = 0; i < input.size(); ++i)
+  {
+    peaks += input[i].size();
+  }
+
+  for (auto _ : state)
+  {
+    std::vector<MassTrace> mass_traces, split_traces;
+    mtd.run(input, mass_traces);
+    epd.detectPeaks(mass_traces, split_traces);
+    FeatureMap features;
+    std::vector<std::vector<MSChromatogram> > chromatograms;
+    ffm.run(split_traces, features, chromatograms);
+    benchmark::DoNotOptimize(features.size());
+  }
+  state.SetItemsProcessed(state.iterations() * peaks);
+  BenchmarkData::reportPeakMemory(state);
+}
+BENCHMARK(BM_FeatureFinderMetabo)->Args({600, 1000})->Args({600, 5000})->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,65 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include "BenchmarkData.h"
+
+#include <OpenMS/ANALYSIS/MAPMATCHING/FeatureGroupingAlgorithmQT.h>
+#include <OpenMS/KERNEL/ConsensusMap.h>
+
+using namespace OpenMS;
+
+/// Links features across maps (arguments: number of maps, features per map)
+static void BM_FeatureGroupingAlgorithmQT_group(benchmark::State& state)
+{
+  const std::vector<FeatureMap> maps = BenchmarkData::featureMaps(state.range(0), state.range(1));
+  FeatureGroupingAlgorithmQT algorithm;
+
+  for (auto _ : state)
+  {
+    ConsensusMap consensus;
+    for (Size i = 0; i < maps.size(); ++i)
+    {
+      ConsensusMap::ColumnHeader& header = consensus.getColumnHeaders()[i];
+      header.size = maps[i].size();
+      header.unique_id = maps[i].getUniqueId();
+    }
+    algorithm.group(maps, consensus);
+    benchmark::DoNotOptimize(consensus.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+  BenchmarkData::reportPeakMemory(state);
+}
+BENCHMARK(BM_FeatureGroupingAlgorithmQT_group)->Args({3, 5000})->Args({10, 5000})->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,80 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include "BenchmarkData.h"
+
+#include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <fstream>
+
+using namespace OpenMS;
+
+/// Loads an mzML file of profile spectra (argument: number of spectra)
+static void BM_MzMLFile_load(benchmark::State& state)
+{
+  const String filename = File::getTemporaryFile();
+  MzMLFile().store(filename, BenchmarkData::profileExperiment(state.range(0), 500));
+  const std::streamoff file_size = std::ifstream(filename.c_str(), std::ios::binary | std::ios::ate).tellg();
+
+  for (auto _ : state)
+  {
+    PeakMap exp;
+    MzMLFile().load(filename, exp);
+    benchmark::DoNotOptimize(exp.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * file_size);
+  BenchmarkData::reportPeakMemory(state);
+}
+BENCHMARK(BM_MzMLFile_load)->Arg(10)->Arg(50)->Unit(benchmark::kMillisecond);
+
+/// Stores an mzML file of profile spectra (argument: number of spectra)
+static void BM_MzMLFile_store(benchmark::State& state)
+{
+  const String filename = File::getTemporaryFile();
+  const PeakMap exp = BenchmarkData::profileExperiment(state.range(0), 500);
+
+  for (auto _ : state)
+  {
+    MzMLFile().store(filename, exp);
+  }
+  const std::streamoff file_size = std::ifstream(filename.c_str(), std::ios::binary | std::ios::ate).tellg();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * file_size);
+  BenchmarkData::reportPeakMemory(state);
+}
+BENCHMARK(BM_MzMLFile_store)->Arg(10)->Arg(50)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
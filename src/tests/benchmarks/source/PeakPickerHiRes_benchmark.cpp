@@ -0,0 +1,66 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include "BenchmarkData.h"
+
+#include <OpenMS/TRANSFORMATIONS/RAW2PEAK/PeakPickerHiRes.h>
+
+using namespace OpenMS;
+
+/// Centroids profile spectra (arguments: number of spectra, peaks per spectrum)
+static void BM_PeakPickerHiRes_pickExperiment(benchmark::State& state)
+{
+  const PeakMap input = BenchmarkData::profileExperiment(state.range(0), state.range(1));
+  PeakPickerHiRes picker;
+  picker.setLogType(ProgressLogger::NONE);
+
+  Size data_points = 0;
+  for (Size i = 0; i < input.size(); ++i)
+  {
+    data_points += input[i].size();
+  }
+
+  for (auto _ : state)
+  {
+    PeakMap output;
+    picker.pickExperiment(input, output);
+    benchmark::DoNotOptimize(output.size());
+  }
+  state.SetItemsProcessed(state.iterations() * data_points);
+  state.SetBytesProcessed(state.iterations() * data_points * sizeof(Peak1D));
+  BenchmarkData::reportPeakMemory(state);
+}
+BENCHMARK(BM_PeakPickerHiRes_pickExperiment)->Args({20, 500})->Args({20, 5000})->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,67 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include "BenchmarkData.h"
+
+#include <OpenMS/ANALYSIS/ID/PeptideIndexing.h>
+#include <OpenMS/METADATA/ProteinIdentification.h>
+
+using namespace OpenMS;
+
+/// Maps peptides to a protein database (arguments: number of proteins, number of peptides)
+static void BM_PeptideIndexing_run(benchmark::State& state)
+{
+  std::vector<FASTAFile::FASTAEntry> proteins = BenchmarkData::proteinDatabase(state.range(0));
+  const std::vector<PeptideIdentification> peptides = BenchmarkData::peptideIdentifications(proteins, state.range(1));
+  PeptideIndexing indexer;
+  indexer.setLogType(ProgressLogger::NONE);
+
+  for (auto _ : state)
+  {
+    // the identifications are annotated in place
+    state.PauseTiming();
+    std::vector<ProteinIdentification> prot_ids(1);
+    prot_ids[0].setSearchEngine("synthetic");
+    std::vector<PeptideIdentification> pep_ids = peptides;
+    state.ResumeTiming();
+
+    indexer.run(proteins, prot_ids, pep_ids);
+    benchmark::DoNotOptimize(prot_ids[0].getHits().size());
+  }
+  state.SetItemsProcessed(state.iterations() * peptides.size());
+  BenchmarkData::reportPeakMemory(state);
+}
+BENCHMARK(BM_PeptideIndexing_run)->Args({5000, 10000})->Args({20000, 50000})->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,101 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include "BenchmarkData.h"
+
+#include <OpenMS/CHEMISTRY/ProteaseDigestion.h>
+#include <OpenMS/CHEMISTRY/TheoreticalSpectrumGenerator.h>
+
+using namespace OpenMS;
+
+/// Tryptic digest of a protein database (argument: number of proteins)
+static void BM_ProteaseDigestion_digest(benchmark::State& state)
+{
+  std::vector<AASequence> proteins;
+  for (const FASTAFile::FASTAEntry& entry : BenchmarkData::proteinDatabase(state.range(0)))
+  {
+    proteins.push_back(AASequence::fromString(entry.sequence));
+  }
+  ProteaseDigestion digestion;
+  digestion.setEnzyme("Trypsin");
+  digestion.setMissedCleavages(1);
+
+  for (auto _ : state)
+  {
+    Size peptides = 0;
+    std::vector<AASequence> digest;
+    for (const AASequence& protein : proteins)
+    {
+      digestion.digest(protein, digest, 7, 30);
+      peptides += digest.size();
+    }
+    benchmark::DoNotOptimize(peptides);
+  }
+  state.SetItemsProcessed(state.iterations() * proteins.size());
+  BenchmarkData::reportPeakMemory(state);
+}
+BENCHMARK(BM_ProteaseDigestion_digest)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+/// Theoretical b/y ion spectra of tryptic peptides (arguments: number of proteins, maximal fragment charge)
+static void BM_TheoreticalSpectrumGenerator_getSpectrum(benchmark::State& state)
+{
+  ProteaseDigestion digestion;
+  digestion.setEnzyme("Trypsin");
+  std::vector<AASequence> peptides;
+  for (const FASTAFile::FASTAEntry& entry : BenchmarkData::proteinDatabase(state.range(0)))
+  {
+    std::vector<AASequence> digest;
+    digestion.digest(AASequence::fromString(entry.sequence), digest, 7, 30);
+    peptides.insert(peptides.end(), digest.begin(), digest.end());
+  }
+  TheoreticalSpectrumGenerator generator;
+  const Int max_charge = Int(state.range(1));
+
+  for (auto _ : state)
+  {
+    Size peaks = 0;
+    for (const AASequence& peptide : peptides)
+    {
+      PeakSpectrum spectrum;
+      generator.getSpectrum(spectrum, peptide, 1, max_charge);
+      peaks += spectrum.size();
+    }
+    benchmark::DoNotOptimize(peaks);
+  }
+  state.SetItemsProcessed(state.iterations() * peptides.size());
+  BenchmarkData::reportPeakMemory(state);
+}
+BENCHMARK(BM_TheoreticalSpectrumGenerator_getSpectrum)->Args({1000, 1})->Args({1000, 2})->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -111,6 +111,7 @@ set(system_executables_list
   File_test
   FileWatcher_test
   JavaInfo_test
+  Profiler_test
   StopWatch_test
   SysInfo_test
 )
@@ -241,6 +242,8 @@ set(format_executables_list
   MSDataChainingConsumer_test
   MSDataStoringConsumer_test
   MSDataAggregatingConsumer_test
+  MSDataPickingConsumer_test
+  SpectrumAccessIonMobilityIndexed_test
   SpectrumAccessQuadMZTransforming_test
   SpectrumAccessSqMass_test
 )
@@ -349,6 +352,7 @@ set(comparison_executables_list
   PeakAlignment_test
   PeakSpectrumCompareFunctor_test
   SingleLinkage_test
+  SparseDistanceGraph_test
   SpectraSTSimilarityScore_test
   SpectrumAlignmentScore_test
   SpectrumAlignment_test
@@ -361,6 +365,7 @@ set(comparison_executables_list
 set(chemistry_executables_list
   AAIndex_test
   AASequence_test
+  ChemistryDBSnapshot_test
   CoarseIsotopeDistribution_test
   DigestionEnzymeProtein_test
   ElementDB_test
@@ -369,6 +374,7 @@ set(chemistry_executables_list
   EnzymaticDigestionLogModel_test
   EnzymaticDigestion_test
   IsotopeDistribution_test
+  LightPeptide_test
   ModificationDefinition_test
   ModificationDefinitionsSet_test
   ModificationsDB_test
@@ -610,6 +616,7 @@ if(NOT DISABLE_OPENSWATH)
     ChromatogramExtractorAlgorithm_test
     OpenSwathHelper_test
     OpenSwathScoring_test
+    OpenSwathOSWWriter_test
     PeakIntegrator_test
     PeakPickerMRM_test
     MRMTransitionGroupPicker_test
@@ -1224,6 +1224,19 @@ START_SECTION([EXTRA] testing terminal modifications)
 }
 END_SECTION
 
+START_SECTION([EXTRA] std::hash<AASequence>)
+{
+  std::hash<AASequence> hasher;
+  // equal sequences must have equal hashes, regardless of notation
+  TEST_EQUAL(hasher(AASequence::fromString("PEPTM(Oxidation)IDE")), hasher(AASequence::fromString("PEPTM(UniMod:35)IDE")))
+  TEST_EQUAL(hasher(AASequence::fromString("(UniMod:1009)CFPIANGER.")), hasher(AASequence::fromString("(UniMod:1009).CFPIANGER.")))
+  // different sequences should (in these cases) have different hashes
+  TEST_NOT_EQUAL(hasher(AASequence::fromString("PEPTMIDE")), hasher(AASequence::fromString("PEPTM(Oxidation)IDE")))
+  TEST_NOT_EQUAL(hasher(AASequence::fromString("PEPTIDE")), hasher(AASequence::fromString("EDITPEP")))
+  TEST_NOT_EQUAL(hasher(AASequence::fromString("PEPTIDE")), hasher(AASequence::fromString("(Acetyl)PEPTIDE")))
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -38,6 +38,7 @@
 ///////////////////////////
 #include <OpenMS/COMPARISON/CLUSTERING/AverageLinkage.h>
 #include <OpenMS/COMPARISON/CLUSTERING/ClusterAnalyzer.h>
+#include <OpenMS/COMPARISON/CLUSTERING/SparseDistanceGraph.h>
 #include <OpenMS/DATASTRUCTURES/DistanceMatrix.h>
 #include <vector>
 //#include <iostream>
@@ -146,6 +147,49 @@ START_SECTION((void operator()(DistanceMatrix< float > &original_distance, std::
 }
 END_SECTION
 
+START_SECTION((void clusterSparse(const SparseDistanceGraph &distances, std::vector<BinaryTreeNode>& cluster_tree, const float threshold=1) const))
+{
+	AverageLinkage linkage;
+	// pairs without an edge have distance 1 in the sparse graph
+	float values[6][6] = {{0}, {0.5f}, {0.8f, 0.3f}, {0.6f, 1.0f, 0.8f}, {0.8f, 0.8f, 1.0f, 0.4f}, {0.7f, 1.0f, 0.9f, 0.8f, 1.0f}};
+	DistanceMatrix<float> matrix(6,666);
+	SparseDistanceGraph graph(6);
+	for (Size i = 1; i < 6; ++i)
+	{
+		for (Size j = 0; j < i; ++j)
+		{
+			matrix.setValue(i, j, values[i][j]);
+			if (values[i][j] < 1.0f)
+			{
+				graph.addEdge(j, i, values[i][j]);
+			}
+		}
+	}
+
+	for (Size t = 0; t < 2; ++t)
+	{
+		float th(t == 0 ? 1.0f : 0.7f);
+		DistanceMatrix<float> copy(matrix);
+		vector< BinaryTreeNode > tree;
+		vector< BinaryTreeNode > result;
+		linkage(copy,tree,th);
+		linkage.clusterSparse(graph,result,th);
+		TEST_EQUAL(tree.size(), result.size());
+		ABORT_IF(tree.size() != result.size());
+		for (Size i = 0; i < result.size(); ++i)
+		{
+				TEST_EQUAL(tree[i].left_child, result[i].left_child);
+				TEST_EQUAL(tree[i].right_child, result[i].right_child);
+				TOLERANCE_ABSOLUTE(0.0001);
+				TEST_REAL_SIMILAR(tree[i].distance, result[i].distance);
+		}
+	}
+
+	vector< BinaryTreeNode > result;
+	TEST_EXCEPTION(ClusterFunctor::InsufficientInput, linkage.clusterSparse(SparseDistanceGraph(1),result));
+}
+END_SECTION
+
 START_SECTION((static const String getProductName()))
 {
 	AverageLinkage al5;
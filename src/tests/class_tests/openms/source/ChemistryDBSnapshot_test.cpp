@@ -0,0 +1,249 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/CHEMISTRY/ChemistryDBSnapshot.h>
+#include <OpenMS/CHEMISTRY/EmpiricalFormula.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <QtCore/QDir>
+
+#include <cstdlib>
+#include <fstream>
+
+using namespace OpenMS;
+using namespace std;
+
+///////////////////////////
+
+START_TEST(ChemistryDBSnapshot, "$Id$")
+
+/////////////////////////////////////////////////////////////
+
+// snapshots at the default location (including the ones of the chemistry
+// databases) are written to a temporary OpenMS home, not to the user's cache
+String home_dir;
+NEW_TMP_FILE(home_dir);
+QDir().mkpath(home_dir.toQString());
+#ifdef OPENMS_WINDOWSPLATFORM
+_putenv_s("OPENMS_HOME_PATH", home_dir.c_str());
+#else
+setenv("OPENMS_HOME_PATH", home_dir.c_str(), 1);
+#endif
+
+// a source file the test snapshot is built from
+String source_file;
+NEW_TMP_FILE(source_file);
+{
+  ofstream out(source_file.c_str());
+  out << "first version" << endl;
+}
+String snapshot_file;
+NEW_TMP_FILE(snapshot_file);
+
+ChemistryDBSnapshot* ptr = nullptr;
+ChemistryDBSnapshot* null_ptr = nullptr;
+START_SECTION((ChemistryDBSnapshot(const String& name, const StringList& source_files)))
+{
+  ptr = new ChemistryDBSnapshot("Test", StringList(1, source_file));
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->getPath(), home_dir + "/.OpenMS/cache/Test.snapshot")
+}
+END_SECTION
+
+START_SECTION((~ChemistryDBSnapshot()))
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((void setPath(const String& path)))
+{
+  ChemistryDBSnapshot snapshot("Test", StringList(1, source_file));
+  snapshot.setPath(snapshot_file);
+  TEST_EQUAL(snapshot.getPath(), snapshot_file)
+}
+END_SECTION
+
+START_SECTION((bool store()))
+{
+  ChemistryDBSnapshot snapshot("Test", StringList(1, source_file));
+  snapshot.setPath(snapshot_file);
+  snapshot.writeInt(-42);
+  snapshot.writeSize(12345);
+  snapshot.writeDouble(3.14159);
+  snapshot.writeString("");
+  snapshot.writeString("Oxidation (M)");
+  set<String> synonyms;
+  synonyms.insert("Ox");
+  synonyms.insert("oxidized");
+  snapshot.writeStringSet(synonyms);
+  EmpiricalFormula formula("C2H3(13)C1O1");
+  formula.setCharge(2);
+  snapshot.writeFormula(formula);
+  snapshot.writeFormula(EmpiricalFormula());
+  TEST_EQUAL(snapshot.store(), true)
+}
+END_SECTION
+
+START_SECTION((bool open()))
+{
+  ChemistryDBSnapshot snapshot("Test", StringList(1, source_file));
+  snapshot.setPath(snapshot_file);
+  TEST_EQUAL(snapshot.open(), true)
+
+  // different name
+  ChemistryDBSnapshot other_name("Other", StringList(1, source_file));
+  other_name.setPath(snapshot_file);
+  TEST_EQUAL(other_name.open(), false)
+
+  // different sources
+  ChemistryDBSnapshot other_sources("Test", StringList());
+  other_sources.setPath(snapshot_file);
+  TEST_EQUAL(other_sources.open(), false)
+
+  // missing snapshot
+  String missing_file;
+  NEW_TMP_FILE(missing_file);
+  ChemistryDBSnapshot missing("Test", StringList(1, source_file));
+  missing.setPath(missing_file);
+  TEST_EQUAL(missing.open(), false)
+}
+END_SECTION
+
+START_SECTION((Int64 readInt()))
+{
+  ChemistryDBSnapshot snapshot("Test", StringList(1, source_file));
+  snapshot.setPath(snapshot_file);
+  TEST_EQUAL(snapshot.open(), true)
+  TEST_EQUAL(snapshot.readInt(), -42)
+  TEST_EQUAL(snapshot.readSize(), 12345)
+  TEST_REAL_SIMILAR(snapshot.readDouble(), 3.14159)
+  TEST_STRING_EQUAL(snapshot.readString(), "")
+  TEST_STRING_EQUAL(snapshot.readString(), "Oxidation (M)")
+  set<String> synonyms = snapshot.readStringSet();
+  TEST_EQUAL(synonyms.size(), 2)
+  TEST_EQUAL(synonyms.count("Ox"), 1)
+  TEST_EQUAL(synonyms.count("oxidized"), 1)
+  EmpiricalFormula formula("C2H3(13)C1O1");
+  formula.setCharge(2);
+  EmpiricalFormula read_formula = snapshot.readFormula();
+  TEST_EQUAL(read_formula == formula, true)
+  TEST_EQUAL(read_formula.getCharge(), 2)
+  TEST_EQUAL(snapshot.readFormula().isEmpty(), true)
+
+  // nothing left
+  TEST_EXCEPTION(Exception::ParseError, snapshot.readInt())
+  TEST_EXCEPTION(Exception::ParseError, snapshot.readString())
+}
+END_SECTION
+
+START_SECTION((Size readSize()))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((double readDouble()))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((String readString()))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((std::set<String> readStringSet()))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((EmpiricalFormula readFormula()))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION([EXTRA] changed source file invalidates the snapshot)
+{
+  {
+    ofstream out(source_file.c_str());
+    out << "second version" << endl;
+  }
+  ChemistryDBSnapshot snapshot("Test", StringList(1, source_file));
+  snapshot.setPath(snapshot_file);
+  TEST_EQUAL(snapshot.open(), false)
+  TEST_EXCEPTION(Exception::ParseError, snapshot.readInt())
+}
+END_SECTION
+
+START_SECTION((static void loadParamEntries(const String& name, const String& param_file, std::vector<std::pair<String, String> >& entries)))
+{
+  // the entries are the same, whether read from the file or from the snapshot
+  vector<pair<String, String> > entries, entries_snapshot;
+  ChemistryDBSnapshot::loadParamEntries("ChemistryDBSnapshot_test", "CHEMISTRY/Residues.xml", entries);
+  ChemistryDBSnapshot::loadParamEntries("ChemistryDBSnapshot_test", "CHEMISTRY/Residues.xml", entries_snapshot);
+  TEST_NOT_EQUAL(entries.size(), 0)
+  TEST_EQUAL(entries == entries_snapshot, true)
+  TEST_EQUAL(File::exists(home_dir + "/.OpenMS/cache/ChemistryDBSnapshot_test.snapshot"), ChemistryDBSnapshot::isEnabled())
+  TEST_EQUAL(entries[0].first.hasPrefix("Residues:"), true)
+  TEST_EXCEPTION(Exception::FileNotFound, ChemistryDBSnapshot::loadParamEntries("ChemistryDBSnapshot_test", "CHEMISTRY/does_not_exist.xml", entries))
+}
+END_SECTION
+
+START_SECTION((static bool isEnabled()))
+{
+  NOT_TESTABLE // depends on the environment
+}
+END_SECTION
+
+START_SECTION((const String& getPath() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+File::removeDirRecursively(home_dir);
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -38,6 +38,7 @@
 #include <OpenMS/test_config.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SimpleOpenMSSpectraAccessFactory.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessIonMobilityIndexed.h>
 
 using namespace OpenMS;
 using namespace std;
@@ -257,6 +258,32 @@ START_SECTION([EXTRA] void extractChromatograms(const OpenSwath::SpectrumAccessP
     TEST_REAL_SIMILAR(max_value, 313 + 314 + 315)
     TEST_REAL_SIMILAR(foundat, 3)
   }
+
+  // ion mobility indexed access gives the same result for all IM windows
+  {
+    OpenSwath::SpectrumAccessPtr indexed_ptr(new SpectrumAccessIonMobilityIndexed(*expptr, 4));
+    for (double im_window : {15.0, 30.0, 1000.0})
+    {
+      std::vector< OpenSwath::ChromatogramPtr > out_exp, out_exp_indexed;
+      for (int i = 0; i < 2; i++)
+      {
+        out_exp.push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+        out_exp_indexed.push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+      }
+
+      extractor.extractChromatograms(expptr, out_exp, coordinates, extract_window, false, im_window, "tophat");
+      extractor.extractChromatograms(indexed_ptr, out_exp_indexed, coordinates, extract_window, false, im_window, "tophat");
+      for (Size k = 0; k < out_exp.size(); k++)
+      {
+        TEST_EQUAL(out_exp_indexed[k]->getTimeArray()->data.size(), out_exp[k]->getTimeArray()->data.size())
+        for (Size i = 0; i < out_exp[k]->getTimeArray()->data.size(); i++)
+        {
+          TEST_REAL_SIMILAR(out_exp_indexed[k]->getTimeArray()->data[i], out_exp[k]->getTimeArray()->data[i])
+          TEST_REAL_SIMILAR(out_exp_indexed[k]->getIntensityArray()->data[i], out_exp[k]->getIntensityArray()->data[i])
+        }
+      }
+    }
+  }
 }
 END_SECTION
 
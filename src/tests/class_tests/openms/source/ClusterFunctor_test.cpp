@@ -80,6 +80,12 @@ START_SECTION((virtual void operator()(DistanceMatrix< float > &original_distanc
 }
 END_SECTION
 
+START_SECTION((virtual void clusterSparse(const SparseDistanceGraph &distances, std::vector<BinaryTreeNode>& cluster_tree, const float threshold=1) const))
+{
+  NOT_TESTABLE // see the derived classes
+}
+END_SECTION
+
 START_SECTION((static void registerChildren()))
 {
   ClusterFunctor* cfp = Factory<ClusterFunctor>::create("AverageLinkage");
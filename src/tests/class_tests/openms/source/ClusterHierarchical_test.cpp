@@ -240,6 +240,94 @@ START_SECTION((template <typename Data, typename SimilarityComparator> void clus
 }
 END_SECTION
 
+START_SECTION((template <typename Data, typename SimilarityComparator> static void computeSparseDistances(const std::vector<Data>& data, const std::vector<double>& precursor_mz, double precursor_mz_tolerance, const SimilarityComparator& comparator, SparseDistanceGraph& distances, float max_distance=1)))
+{
+ vector<Size> d(6,0);
+ for (Size i = 0; i<d.size(); ++i)
+ {
+  d[i]=i;
+ }
+ // elements 0-2 and 3-5 are 10 Th apart
+ vector<double> mz;
+ mz.push_back(500.0); mz.push_back(500.5); mz.push_back(501.0);
+ mz.push_back(511.0); mz.push_back(510.5); mz.push_back(510.0);
+ LowlevelComparator lc;
+ SparseDistanceGraph graph;
+
+ ClusterHierarchical::computeSparseDistances(d, mz, 1.0, lc, graph);
+ TEST_EQUAL(graph.dimensionsize(), 6)
+ TEST_EQUAL(graph.edgeCount(), 6)
+ ABORT_IF(graph.edgeCount() != 6)
+ // sorted by distance
+ TEST_EQUAL(graph.getEdges()[0].first, 1)
+ TEST_EQUAL(graph.getEdges()[0].second, 2)
+ TEST_REAL_SIMILAR(graph.getEdges()[0].distance, 0.3)
+ TEST_EQUAL(graph.getEdges()[3].first, 0)
+ TEST_EQUAL(graph.getEdges()[3].second, 2)
+ TEST_REAL_SIMILAR(graph.getEdges()[3].distance, 0.8)
+ TEST_EQUAL(graph.getEdges()[5].first, 4)
+ TEST_EQUAL(graph.getEdges()[5].second, 5)
+
+ ClusterHierarchical::computeSparseDistances(d, mz, 0.5, lc, graph);
+ TEST_EQUAL(graph.edgeCount(), 4)
+
+ ClusterHierarchical::computeSparseDistances(d, mz, 100.0, lc, graph, 0.75f);
+ TEST_EQUAL(graph.edgeCount(), 5)
+
+ mz.pop_back();
+ TEST_EXCEPTION(Exception::InvalidSize, ClusterHierarchical::computeSparseDistances(d, mz, 1.0, lc, graph))
+}
+END_SECTION
+
+START_SECTION((template <typename Data, typename SimilarityComparator> void clusterSparse(const std::vector<Data>& data, const std::vector<double>& precursor_mz, double precursor_mz_tolerance, const SimilarityComparator& comparator, const ClusterFunctor& clusterer, std::vector<BinaryTreeNode>& cluster_tree, SparseDistanceGraph& distances, float max_distance=1)))
+{
+ vector<Size> d(6,0);
+ for (Size i = 0; i<d.size(); ++i)
+ {
+  d[i]=i;
+ }
+ vector<double> mz(6, 500.0);
+ ClusterHierarchical ch;
+ LowlevelComparator lc;
+ SingleLinkage sl;
+ vector< BinaryTreeNode > result;
+ vector< BinaryTreeNode > tree;
+ tree.push_back(BinaryTreeNode(1,2,0.3f));
+ tree.push_back(BinaryTreeNode(3,4,0.4f));
+ tree.push_back(BinaryTreeNode(0,1,0.5f));
+ tree.push_back(BinaryTreeNode(0,3,0.6f));
+ tree.push_back(BinaryTreeNode(0,5,0.7f));
+ SparseDistanceGraph graph;
+
+ // all pairs pass the prefilter: same result as cluster()
+ ch.clusterSparse(d, mz, 0.1, lc, sl, result, graph);
+ TEST_EQUAL(graph.edgeCount(), 15)
+ TEST_EQUAL(tree.size(), result.size());
+ for (Size i = 0; i < tree.size(); ++i)
+ {
+   TOLERANCE_ABSOLUTE(0.0001);
+   TEST_EQUAL(tree[i].left_child, result[i].left_child);
+   TEST_EQUAL(tree[i].right_child, result[i].right_child);
+   TEST_REAL_SIMILAR(tree[i].distance, result[i].distance);
+ }
+
+ // element 5 is separated by the prefilter
+ mz[5] = 600.0;
+ graph.clear();
+ ch.clusterSparse(d, mz, 0.1, lc, sl, result, graph);
+ TEST_EQUAL(graph.edgeCount(), 10)
+ tree.back().distance = -1.0f;
+ TEST_EQUAL(tree.size(), result.size());
+ for (Size i = 0; i < tree.size(); ++i)
+ {
+   TOLERANCE_ABSOLUTE(0.0001);
+   TEST_EQUAL(tree[i].left_child, result[i].left_child);
+   TEST_EQUAL(tree[i].right_child, result[i].right_child);
+   TEST_REAL_SIMILAR(tree[i].distance, result[i].distance);
+ }
+}
+END_SECTION
+
 START_SECTION((void cluster(std::vector<PeakSpectrum>& data, const BinnedSpectrumCompareFunctor& comparator, double sz, UInt sp, const ClusterFunctor& clusterer, std::vector<BinaryTreeNode>& cluster_tree, DistanceMatrix<float>& original_distance)))
 {
 
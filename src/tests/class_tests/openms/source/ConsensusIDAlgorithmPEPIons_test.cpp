@@ -70,6 +70,53 @@ START_SECTION(void apply(std::vector<PeptideIdentification>& ids))
 }
 END_SECTION
 
+START_SECTION([EXTRA] similarity based on shared fragment ions)
+{
+  // "PEPTIDER" and "PEPTLDER" are isobaric - all fragment ions are shared,
+  // but the b and y ions of the full sequence coincide, so 15 of 16 count:
+  PeptideIdentification temp;
+  temp.setScoreType("Posterior Error Probability");
+  temp.setHigherScoreBetter(false);
+  vector<PeptideIdentification> ids(2, temp);
+  vector<PeptideHit> hits(1);
+  hits[0].setSequence(AASequence::fromString("PEPTIDER"));
+  hits[0].setScore(0.1);
+  ids[0].setHits(hits);
+  hits[0].setSequence(AASequence::fromString("PEPTLDER"));
+  hits[0].setScore(0.2);
+  ids[1].setHits(hits);
+  vector<PeptideIdentification> ids_copy = ids;
+
+  ConsensusIDAlgorithmPEPIons consensus;
+  consensus.apply(ids);
+  TEST_EQUAL(ids.size(), 1);
+  TEST_EQUAL(ids[0].getHits().size(), 2);
+  double sim = 15.0 / 16.0;
+  for (Size i = 0; i < ids[0].getHits().size(); ++i)
+  {
+    const PeptideHit& hit = ids[0].getHits()[i];
+    double pep = (hit.getSequence().toString() == "PEPTIDER") ? 0.1 : 0.2;
+    TEST_REAL_SIMILAR(hit.getMetaValue("consensus_support"), sim);
+    TEST_REAL_SIMILAR(hit.getScore(),
+                      (pep + sim * (0.3 - pep)) / ((1 + sim) * (1 + sim)));
+  }
+
+  // too few shared ions - the hits don't support each other:
+  Param param = consensus.getParameters();
+  param.setValue("min_shared", 16);
+  consensus.setParameters(param);
+  consensus.apply(ids_copy);
+  TEST_EQUAL(ids_copy[0].getHits().size(), 2);
+  for (Size i = 0; i < ids_copy[0].getHits().size(); ++i)
+  {
+    const PeptideHit& hit = ids_copy[0].getHits()[i];
+    double pep = (hit.getSequence().toString() == "PEPTIDER") ? 0.1 : 0.2;
+    TEST_REAL_SIMILAR(hit.getMetaValue("consensus_support"), 0.0);
+    TEST_REAL_SIMILAR(hit.getScore(), pep);
+  }
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
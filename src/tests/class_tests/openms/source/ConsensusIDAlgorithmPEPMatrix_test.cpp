@@ -70,6 +70,67 @@ START_SECTION(void apply(std::vector<PeptideIdentification>& ids))
 }
 END_SECTION
 
+START_SECTION(void apply(const std::vector<std::vector<PeptideIdentification>*>& ids_list, const std::vector<Size>& number_of_runs))
+{
+  // batch processing is implemented in the base classes (ConsensusIDAlgorithm,
+  // ConsensusIDAlgorithmSimilarity) - this also covers the other algorithms.
+  // create two spectra with three ID runs each:
+  PeptideIdentification temp;
+  temp.setScoreType("Posterior Error Probability");
+  temp.setHigherScoreBetter(false);
+  vector<vector<PeptideIdentification> > spectra(2, vector<PeptideIdentification>(3, temp));
+  const char* sequences[2][3][3] = {{{"PEPTIDER", "PEPTLDER", "DFPIANGER"},
+                                     {"PEPTIDEK", "PEPTIDER", "DFPLANGER"},
+                                     {"PEPTLDER", "EDITPEPR", "DFPIANGER"}},
+                                    {{"DFPIANGER", "PEPTIDER", "NGERPIDFA"},
+                                     {"DFPLANGER", "PEPTM(Oxidation)IDER", "AAAAAAR"},
+                                     {"PEPTIDER", "DFPIANGER", "EDITPEPR"}}};
+  for (Size i = 0; i < 2; ++i)
+  {
+    for (Size j = 0; j < 3; ++j)
+    {
+      vector<PeptideHit> hits(3);
+      for (Size k = 0; k < 3; ++k)
+      {
+        hits[k].setSequence(AASequence::fromString(sequences[i][j][k]));
+        hits[k].setScore(0.1 * (k + 1) + 0.05 * j);
+      }
+      spectra[i][j].setHits(hits);
+    }
+  }
+
+  // results must be the same as for individual processing:
+  vector<vector<PeptideIdentification> > expected = spectra;
+  ConsensusIDAlgorithmPEPMatrix single;
+  for (Size i = 0; i < expected.size(); ++i)
+  {
+    single.apply(expected[i]);
+  }
+
+  ConsensusIDAlgorithmPEPMatrix batch;
+  vector<vector<PeptideIdentification>*> ids_list;
+  ids_list.push_back(&spectra[0]);
+  ids_list.push_back(&spectra[1]);
+  batch.apply(ids_list);
+
+  for (Size i = 0; i < spectra.size(); ++i)
+  {
+    TEST_EQUAL(spectra[i].size(), 1);
+    TEST_EQUAL(spectra[i][0].getHits().size(), expected[i][0].getHits().size());
+    for (Size k = 0; k < spectra[i][0].getHits().size(); ++k)
+    {
+      const PeptideHit& hit = spectra[i][0].getHits()[k];
+      const PeptideHit& exp_hit = expected[i][0].getHits()[k];
+      TEST_EQUAL(hit.getSequence(), exp_hit.getSequence());
+      TEST_REAL_SIMILAR(hit.getScore(), exp_hit.getScore());
+      TEST_REAL_SIMILAR(hit.getMetaValue("consensus_support"), exp_hit.getMetaValue("consensus_support"));
+    }
+  }
+
+  TEST_EXCEPTION(Exception::InvalidSize, batch.apply(ids_list, vector<Size>(1, 3)));
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
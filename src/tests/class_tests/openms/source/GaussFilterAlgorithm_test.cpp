@@ -187,6 +187,50 @@ START_SECTION((bool filter(OpenMS::Interfaces::ChromatogramPtr chromatogram)))
   TEST_REAL_SIMILAR(chromatogram->getIntensityArray()->data[8],0.000881793)
 END_SECTION 
 
+START_SECTION((bool filter(const std::vector<double>& mz, const std::vector<double>& intensity, std::vector<double>& intensity_out)))
+{
+  // non-uniform spacing with a few gaps larger than the kernel
+  std::vector<double> mz, intensity;
+  double pos = 500.0;
+  for (Size i = 0; i < 300; ++i)
+  {
+    pos += 0.002 + 0.001 * (i % 7) + ((i % 50) == 49 ? 1.0 : 0.0);
+    mz.push_back(pos);
+    intensity.push_back((i % 11 == 0) ? 0.0 : 50.0 + 40.0 * std::sin(0.2 * i));
+  }
+
+  for (Size ppm = 0; ppm < 2; ++ppm)
+  {
+    GaussFilterAlgorithm gauss;
+    gauss.initialize(0.05, 0.001, 10.0, ppm == 1);
+
+    std::vector<double> mz_ref(mz.size()), intensity_ref(mz.size());
+    bool found_ref = gauss.filter(mz.begin(), mz.end(), intensity.begin(), mz_ref.begin(), intensity_ref.begin());
+
+    std::vector<double> intensity_out;
+    bool found = gauss.filter(mz, intensity, intensity_out);
+    TEST_EQUAL(found, found_ref)
+    TEST_EQUAL(intensity_out.size(), intensity.size())
+    for (Size i = 0; i < intensity_out.size(); ++i)
+    {
+      TEST_REAL_SIMILAR(intensity_out[i], intensity_ref[i])
+    }
+  }
+
+  // no data, no signal
+  GaussFilterAlgorithm gauss;
+  gauss.initialize(0.2, 0.01, 1.0, false);
+  std::vector<double> empty, empty_out(3, 1.0);
+  TEST_EQUAL(gauss.filter(empty, empty, empty_out), false)
+  TEST_EQUAL(empty_out.size(), 0)
+
+  // only zero intensities, no signal
+  std::vector<double> zeros(mz.size(), 0.0), zeros_out;
+  TEST_EQUAL(gauss.filter(mz, zeros, zeros_out), false)
+  TEST_EQUAL(zeros_out.size(), mz.size())
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -197,6 +197,83 @@ START_SECTION((template <typename PeakType> void filterExperiment(MSExperiment<P
 
 END_SECTION
 
+START_SECTION([EXTRA] parallel filterExperiment equals filtering each spectrum and chromatogram)
+{
+  // the profile of the filterExperiment test, scaled and shifted per spectrum,
+  // once as spectra and once as chromatograms
+  PeakMap exp;
+  for (Size s = 0; s < 12; ++s)
+  {
+    MSSpectrum spectrum;
+    MSChromatogram chromatogram;
+    for (Size i = 0; i < 9; ++i)
+    {
+      double intensity = (i == 3) ? 1.0 : (i == 4) ? 0.8 : (i == 5) ? 1.2 : 0.0;
+      spectrum.push_back(Peak1D(500.0 + 10.0 * s + 0.03 * i, (s + 1) * intensity));
+      chromatogram.push_back(ChromatogramPeak(10.0 * s + 0.03 * i, (s + 1) * intensity));
+    }
+    exp.addSpectrum(spectrum);
+    exp.addChromatogram(chromatogram);
+  }
+
+  GaussFilter gauss;
+  Param param;
+  param.setValue("gaussian_width", 0.2);
+  gauss.setParameters(param);
+
+  PeakMap reference = exp;
+  for (Size s = 0; s < reference.size(); ++s)
+  {
+    gauss.filter(reference[s]);
+  }
+  for (Size c = 0; c < reference.getNrChromatograms(); ++c)
+  {
+    gauss.filter(reference.getChromatogram(c));
+  }
+
+  PeakMap filtered = exp;
+  gauss.filterExperiment(filtered);
+  TEST_REAL_SIMILAR(filtered[0][4].getIntensity(), 0.8963)
+  for (Size s = 0; s < filtered.size(); ++s)
+  {
+    TEST_EQUAL(filtered[s].size(), 9)
+    for (Size i = 0; i < filtered[s].size(); ++i)
+    {
+      TEST_EQUAL(filtered[s][i].getIntensity(), reference[s][i].getIntensity())
+      TEST_EQUAL(filtered.getChromatogram(s)[i].getIntensity(), reference.getChromatogram(s)[i].getIntensity())
+    }
+  }
+
+  // ppm mode: chromatograms are rejected before anything is smoothed
+  param.setValue("use_ppm_tolerance", "true");
+  param.setValue("ppm_tolerance", 40.0);
+  gauss.setParameters(param);
+  PeakMap unchanged = exp;
+  TEST_EXCEPTION(Exception::IllegalArgument, gauss.filterExperiment(unchanged))
+  for (Size i = 0; i < unchanged[0].size(); ++i)
+  {
+    TEST_EQUAL(unchanged[0][i].getIntensity(), exp[0][i].getIntensity())
+  }
+
+  // ppm mode on spectra only (each thread uses its own kernel)
+  PeakMap spectra_only = exp;
+  spectra_only.setChromatograms(std::vector<MSChromatogram>());
+  PeakMap spectra_reference = spectra_only;
+  for (Size s = 0; s < spectra_reference.size(); ++s)
+  {
+    gauss.filter(spectra_reference[s]);
+  }
+  gauss.filterExperiment(spectra_only);
+  for (Size s = 0; s < spectra_only.size(); ++s)
+  {
+    for (Size i = 0; i < spectra_only[s].size(); ++i)
+    {
+      TEST_EQUAL(spectra_only[s][i].getIntensity(), spectra_reference[s][i].getIntensity())
+    }
+  }
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
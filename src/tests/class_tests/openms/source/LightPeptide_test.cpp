@@ -0,0 +1,107 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/CHEMISTRY/LightPeptide.h>
+#include <OpenMS/CHEMISTRY/AASequence.h>
+
+#include <cmath>
+
+using namespace OpenMS;
+using namespace std;
+
+///////////////////////////
+
+START_TEST(LightPeptide, "$Id$")
+
+/////////////////////////////////////////////////////////////
+
+LightPeptide* ptr = nullptr;
+LightPeptide* null_ptr = nullptr;
+START_SECTION(LightPeptide())
+{
+  ptr = new LightPeptide();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->size(), 0)
+}
+END_SECTION
+
+START_SECTION(~LightPeptide())
+{
+  delete ptr;
+}
+END_SECTION
+
+// protein sequence the views refer to
+String protein("MKWVTFISLLFLFSSAYSRGVFRRDTHKSEIAHRFKDLGEENFK");
+
+START_SECTION(explicit LightPeptide(const StringView& sequence))
+{
+  LightPeptide pep(StringView(protein).substr(2, 16));
+  TEST_EQUAL(pep.size(), 16)
+  TEST_EQUAL(pep.getSequence().getString(), "WVTFISLLFLFSSAYS")
+}
+END_SECTION
+
+START_SECTION(const StringView& getSequence() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(Size size() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+LightPeptide::MassTable masses;
+
+START_SECTION(double getMonoWeight(const MassTable& masses) const)
+{
+  LightPeptide pep(StringView(protein).substr(0, 18));
+  TEST_REAL_SIMILAR(pep.getMonoWeight(masses), AASequence::fromString("MKWVTFISLLFLFSSAYS").getMonoWeight())
+
+  // unknown residues have no mass
+  String unknown("PEPXIDE");
+  TEST_EQUAL(std::isnan(LightPeptide(StringView(unknown)).getMonoWeight(masses)), true)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
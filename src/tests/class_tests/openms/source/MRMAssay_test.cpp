@@ -120,6 +120,7 @@ START_SECTION(std::vector<std::string> MRMAssay::getMatchingPeptidoforms_(const
   ions.push_back(std::make_pair(100.10, "PEPT(UniMod:21)IDEK"));
   ions.push_back(std::make_pair(100.12, "PEPTIDEK"));
   ions.push_back(std::make_pair(100.11, "PEPTIDEK"));
+  std::sort(ions.begin(), ions.end());
 
   std::vector<std::string> isoforms1 = mrma.getMatchingPeptidoforms_test(100.06, ions, 0.03);
   std::vector<std::string> isoforms2 = mrma.getMatchingPeptidoforms_test(100.06, ions, 0.06);
@@ -129,6 +130,14 @@ START_SECTION(std::vector<std::string> MRMAssay::getMatchingPeptidoforms_(const
   TEST_EQUAL(isoforms2.size(), 2)
   TEST_EQUAL(isoforms2[0], "PEPT(UniMod:21)IDEK")
   TEST_EQUAL(isoforms2[1], "PEPTIDEK")
+
+  // window boundaries are inclusive, ions outside the vector range
+  std::vector<std::string> isoforms3 = mrma.getMatchingPeptidoforms_test(100.10, ions, 0.0);
+  TEST_EQUAL(isoforms3.size(), 1)
+  TEST_EQUAL(isoforms3[0], "PEPT(UniMod:21)IDEK")
+  TEST_EQUAL(mrma.getMatchingPeptidoforms_test(99.0, ions, 0.5).size(), 0)
+  TEST_EQUAL(mrma.getMatchingPeptidoforms_test(101.0, ions, 0.5).size(), 0)
+  TEST_EQUAL(mrma.getMatchingPeptidoforms_test(100.0, ions, 1.0).size(), 2)
 }
 
 END_SECTION
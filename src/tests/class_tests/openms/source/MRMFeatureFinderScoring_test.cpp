@@ -45,6 +45,10 @@
 
 ///////////////////////////
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace OpenMS;
 using namespace std;
 
@@ -314,6 +318,83 @@ START_SECTION(void pickExperiment(OpenSwath::SpectrumAccessPtr input, FeatureMap
 }
 END_SECTION
 
+START_SECTION(([EXTRA] parallel pickExperiment gives the serial result in the same order))
+{
+  // six copies of the two transition groups of the generic input (3 features each)
+  boost::shared_ptr<PeakMap> exp(new PeakMap);
+  OpenSwath::LightTargetedExperiment transitions;
+  {
+    PeakMap input;
+    MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("OpenSwath_generic_input.mzML"), input);
+    TargetedExperiment transition_exp_;
+    TraMLFile().load(OPENMS_GET_TEST_DATA_PATH("OpenSwath_generic_input.TraML"), transition_exp_);
+    OpenSwath::LightTargetedExperiment input_transitions;
+    OpenSwathDataAccessHelper::convertTargetedExp(transition_exp_, input_transitions);
+    transitions.proteins = input_transitions.proteins;
+    for (Size c = 0; c < 6; ++c)
+    {
+      const String suffix = "_" + String(c);
+      for (Size i = 0; i < input.getNrChromatograms(); ++i)
+      {
+        MSChromatogram chromatogram = input.getChromatogram(i);
+        chromatogram.setNativeID(chromatogram.getNativeID() + suffix);
+        exp->addChromatogram(chromatogram);
+      }
+      for (Size i = 0; i < input_transitions.transitions.size(); ++i)
+      {
+        OpenSwath::LightTransition transition = input_transitions.transitions[i];
+        transition.transition_name += suffix;
+        transition.peptide_ref += suffix;
+        transitions.transitions.push_back(transition);
+      }
+      for (Size i = 0; i < input_transitions.compounds.size(); ++i)
+      {
+        OpenSwath::LightCompound compound = input_transitions.compounds[i];
+        compound.id += suffix;
+        transitions.compounds.push_back(compound);
+      }
+    }
+  }
+  OpenSwath::SpectrumAccessPtr chromatogram_ptr = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(exp);
+  std::vector< OpenSwath::SwathMap > swath_maps(1);
+  swath_maps[0].sptr = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(boost::shared_ptr<PeakMap>(new PeakMap));
+
+  FeatureMap serial, parallel;
+  TransformationDescription trafo;
+  {
+#ifdef _OPENMP
+    const int max_threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+#endif
+    MRMFeatureFinderScoring ff;
+    TransitionGroupMapType transition_group_map;
+    ff.pickExperiment(chromatogram_ptr, serial, transitions, trafo, swath_maps, transition_group_map);
+#ifdef _OPENMP
+    omp_set_num_threads(4);
+#endif
+    MRMFeatureFinderScoring ff_parallel;
+    TransitionGroupMapType transition_group_map_parallel;
+    ff_parallel.pickExperiment(chromatogram_ptr, parallel, transitions, trafo, swath_maps, transition_group_map_parallel);
+#ifdef _OPENMP
+    omp_set_num_threads(max_threads);
+#endif
+    TEST_EQUAL(transition_group_map.size(), 12)
+  }
+
+  TEST_EQUAL(serial.size(), 18)
+  TEST_EQUAL(parallel.size(), serial.size())
+  for (Size i = 0; i < std::min(serial.size(), parallel.size()); ++i)
+  {
+    TEST_STRING_EQUAL(parallel[i].getMetaValue("PeptideRef").toString(), serial[i].getMetaValue("PeptideRef").toString())
+    TEST_EQUAL(parallel[i].getRT(), serial[i].getRT())
+    TEST_EQUAL(parallel[i].getIntensity(), serial[i].getIntensity())
+    TEST_EQUAL((double)parallel[i].getMetaValue("total_xic"), (double)serial[i].getMetaValue("total_xic"))
+    TEST_EQUAL((double)parallel[i].getMetaValue("var_xcorr_coelution"), (double)serial[i].getMetaValue("var_xcorr_coelution"))
+    TEST_EQUAL(parallel[i].getSubordinates().size(), serial[i].getSubordinates().size())
+  }
+}
+END_SECTION
+
 START_SECTION(void mapExperimentToTransitionList(OpenSwath::SpectrumAccessPtr input, OpenSwath::LightTargetedExperiment &transition_exp, TransitionGroupMapType &transition_group_map, TransformationDescription trafo, double rt_extraction_window))
 {
   MRMFeatureFinderScoring ff;
@@ -0,0 +1,170 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataPickingConsumer.h>
+
+///////////////////////////
+
+#include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataStoringConsumer.h>
+
+START_TEST(MSDataPickingConsumer, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+using namespace OpenMS;
+
+MSDataPickingConsumer* pick_consumer_ptr = nullptr;
+MSDataPickingConsumer* pick_consumer_nullPointer = nullptr;
+
+START_SECTION((MSDataPickingConsumer(Interfaces::IMSDataConsumer* next_consumer, const PeakPickerHiRes& picker, Size batch_size = 1000, bool check_spectrum_type = true)))
+{
+  MSDataStoringConsumer storage;
+  pick_consumer_ptr = new MSDataPickingConsumer(&storage, PeakPickerHiRes());
+  TEST_NOT_EQUAL(pick_consumer_ptr, pick_consumer_nullPointer)
+  delete pick_consumer_ptr;
+}
+END_SECTION
+
+START_SECTION((~MSDataPickingConsumer()))
+{
+  // flushes remaining data to the next consumer
+  MSDataStoringConsumer storage;
+  pick_consumer_ptr = new MSDataPickingConsumer(&storage, PeakPickerHiRes(), 10);
+  MSSpectrum s;
+  s.setType(SpectrumSettings::PROFILE);
+  pick_consumer_ptr->consumeSpectrum(s);
+  TEST_EQUAL(storage.getData().getNrSpectra(), 0)
+  delete pick_consumer_ptr;
+  TEST_EQUAL(storage.getData().getNrSpectra(), 1)
+  TEST_EQUAL(storage.getData()[0].getType(), SpectrumSettings::CENTROID)
+}
+END_SECTION
+
+START_SECTION((void consumeSpectrum(SpectrumType & s)))
+{
+  PeakMap input;
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("PeakPickerHiRes_spectrum_selection.mzML"), input);
+
+  PeakPickerHiRes pp;
+  Param pp_param = pp.getParameters();
+  pp_param.setValue("ms_levels", ListUtils::create<Int>("2"));
+  pp.setParameters(pp_param);
+
+  PeakMap expected;
+  pp.pickExperiment(input, expected);
+
+  // small batches, so that several batches (and a partial last one) are processed
+  MSDataStoringConsumer storage;
+  MSDataPickingConsumer pick_consumer(&storage, pp, 2);
+  for (Size i = 0; i < input.size(); ++i)
+  {
+    pick_consumer.consumeSpectrum(input[i]);
+  }
+  pick_consumer.flush();
+
+  ABORT_IF(storage.getData().size() != expected.size())
+  for (Size i = 0; i < expected.size(); ++i)
+  {
+    TEST_EQUAL(storage.getData()[i] == expected[i], true)
+  }
+
+  // centroided spectra selected for picking are rejected
+  MSSpectrum centroid;
+  centroid.setType(SpectrumSettings::CENTROID);
+  centroid.setMSLevel(2);
+  TEST_EXCEPTION(Exception::IllegalArgument, pick_consumer.consumeSpectrum(centroid))
+}
+END_SECTION
+
+START_SECTION((void consumeChromatogram(ChromatogramType & c)))
+{
+  MSChromatogram chrom;
+  for (Size i = 0; i < 50; ++i)
+  {
+    ChromatogramPeak p;
+    p.setRT(i);
+    p.setIntensity(100.0 - (i - 25.0) * (i - 25.0) / 10.0);
+    chrom.push_back(p);
+  }
+  MSChromatogram expected;
+  PeakPickerHiRes().pick(chrom, expected);
+
+  MSDataStoringConsumer storage;
+  MSDataPickingConsumer pick_consumer(&storage, PeakPickerHiRes(), 2);
+  MSSpectrum s;
+  s.setType(SpectrumSettings::PROFILE);
+  pick_consumer.consumeSpectrum(s);
+  for (Size i = 0; i < 3; ++i)
+  {
+    pick_consumer.consumeChromatogram(chrom);
+  }
+  // spectrum is passed on before the first chromatogram
+  TEST_EQUAL(storage.getData().getNrSpectra(), 1)
+  pick_consumer.flush();
+
+  TEST_EQUAL(storage.getData().getNrChromatograms(), 3)
+  for (Size i = 0; i < storage.getData().getNrChromatograms(); ++i)
+  {
+    TEST_EQUAL(storage.getData().getChromatograms()[i] == expected, true)
+  }
+}
+END_SECTION
+
+START_SECTION((void flush()))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((void setExpectedSize(Size expectedSpectra, Size expectedChromatograms)))
+{
+  NOT_TESTABLE // passed on to the next consumer
+}
+END_SECTION
+
+START_SECTION((void setExperimentalSettings(const ExperimentalSettings& exp)))
+{
+  NOT_TESTABLE // passed on to the next consumer
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
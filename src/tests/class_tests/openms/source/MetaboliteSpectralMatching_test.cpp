@@ -67,15 +67,112 @@ START_SECTION((virtual ~MetaboliteSpectralMatching()))
 }
 END_SECTION
 
-START_SECTION((double computeHyperScore(MSSpectrum, MSSpectrum, const double &, const double &)))
+START_SECTION((double computeHyperScore(const MSSpectrum&, const MSSpectrum&, const double&, const double&) const))
 {
-  // TODO
+  MetaboliteSpectralMatching msm;
+  Param p(msm.getParameters());
+  p.setValue("mass_error_unit", "Da");
+  msm.setParameters(p);
+
+  MSSpectrum exp_spec, db_spec;
+  const double mzs[] = {100.0, 150.0, 200.0, 250.0, 300.0};
+  for (Size i = 0; i < 5; ++i)
+  {
+    exp_spec.push_back(Peak1D(mzs[i], 10.0));
+    // slightly shifted, plus a closer and a farther peak around 200
+    db_spec.push_back(Peak1D(mzs[i] + 0.01, 2.0));
+  }
+  db_spec.push_back(Peak1D(200.005, 3.0));
+  db_spec.push_back(Peak1D(199.98, 100.0));
+  db_spec.sortByPosition();
+
+  // 5 matches, the nearest peak is used for 200: 4 * 20 + 30
+  TEST_REAL_SIMILAR(msm.computeHyperScore(exp_spec, db_spec, 0.05, 0.0), std::log(110.0) + std::log(120.0))
+
+  // the lower bound skips observed fragments
+  TEST_REAL_SIMILAR(msm.computeHyperScore(exp_spec, db_spec, 0.05, 180.0), std::log(70.0) + std::log(6.0))
+
+  // too few matched ions
+  TEST_REAL_SIMILAR(msm.computeHyperScore(exp_spec, db_spec, 0.05, 260.0), 0.0)
+
+  // fragment tolerance too small
+  TEST_REAL_SIMILAR(msm.computeHyperScore(exp_spec, db_spec, 0.001, 0.0), 0.0)
+
+  // ppm tolerance: 50 ppm are 0.005 Da at 100 m/z and 0.015 Da at 300 m/z
+  p.setValue("mass_error_unit", "ppm");
+  msm.setParameters(p);
+  TEST_REAL_SIMILAR(msm.computeHyperScore(exp_spec, db_spec, 50.0, 0.0), std::log(70.0) + std::log(6.0))
 }
 END_SECTION
 
-START_SECTION((void run(PeakMap &, MzTab &)))
+START_SECTION((void run(PeakMap &, PeakMap &, MzTab &)))
 {
-  // TODO
+  // spectral library: three compounds with well separated fragments
+  PeakMap spec_db;
+  const double prec_mzs[] = {300.1, 180.05, 250.2};
+  const char* names[] = {"C", "A", "B"};
+  for (Size s = 0; s < 3; ++s)
+  {
+    MSSpectrum spec;
+    spec.setMSLevel(2);
+    Precursor prec;
+    prec.setMZ(prec_mzs[s]);
+    prec.setCharge(1);
+    spec.setPrecursors(std::vector<Precursor>(1, prec));
+    for (Size i = 0; i < 4; ++i)
+    {
+      spec.push_back(Peak1D(50.0 + 30.0 * i + 7.0 * s, 100.0 - 10.0 * i));
+    }
+    spec.setMetaValue("Massbank_Accession_ID", String("ACC_") + names[s]);
+    spec.setMetaValue("HMDB_ID", String("HMDB_") + names[s]);
+    spec.setMetaValue("Sum_Formula", "C1");
+    spec.setMetaValue("Metabolite_Name", names[s]);
+    spec.setMetaValue("Inchi_String", "");
+    spec.setMetaValue("SMILES_String", "");
+    spec.setMetaValue("Precursor_Ion", "[M+H]+");
+    spec_db.addSpectrum(spec);
+  }
+
+  // queries: the fragments of "B" and of "A" with matching precursors
+  PeakMap msexp;
+  const Size query_lib[] = {2, 1};
+  for (Size q = 0; q < 2; ++q)
+  {
+    MSSpectrum spec;
+    spec.setMSLevel(2);
+    spec.setRT(100.0 + 100.0 * q);
+    Precursor prec;
+    prec.setMZ(prec_mzs[query_lib[q]] + 0.001);
+    spec.setPrecursors(std::vector<Precursor>(1, prec));
+    for (Size i = 0; i < 4; ++i)
+    {
+      spec.push_back(Peak1D(50.0 + 30.0 * i + 7.0 * query_lib[q], 50.0));
+    }
+    msexp.addSpectrum(spec);
+  }
+
+  MetaboliteSpectralMatching msm;
+  Param p(msm.getParameters());
+  p.setValue("mass_error_unit", "Da");
+  p.setValue("prec_mass_error_value", 0.01);
+  p.setValue("frag_mass_error_value", 0.01);
+  p.setValue("report_mode", "best");
+  msm.setParameters(p);
+
+  MzTab mztab;
+  msm.run(msexp, spec_db, mztab);
+
+  // library is sorted by precursor m/z
+  TEST_EQUAL(spec_db[0].getMetaValue("Metabolite_Name"), "A")
+
+  MzTabSmallMoleculeSectionRows rows = mztab.getSmallMoleculeSectionRows();
+  TEST_EQUAL(rows.size(), 2)
+  ABORT_IF(rows.size() != 2)
+  // results are reported in the order of the query spectra
+  TEST_EQUAL(rows[0].description.get(), "B")
+  TEST_EQUAL(rows[1].description.get(), "A")
+  TEST_REAL_SIMILAR(rows[0].exp_mass_to_charge.get(), 250.2)
+  TEST_REAL_SIMILAR(rows[1].exp_mass_to_charge.get(), 180.05)
 }
 END_SECTION
 
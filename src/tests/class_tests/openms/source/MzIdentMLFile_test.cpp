@@ -45,6 +45,21 @@
 using namespace OpenMS;
 using namespace std;
 
+// collects the streamed PeptideIdentifications and records the batch sizes
+class TestConsumer :
+  public MzIdentMLFile::PeptideIdentificationConsumer
+{
+public:
+  void consume(vector<PeptideIdentification>& batch) override
+  {
+    batch_sizes.push_back(batch.size());
+    peptide_ids.insert(peptide_ids.end(), batch.begin(), batch.end());
+  }
+
+  vector<Size> batch_sizes;
+  vector<PeptideIdentification> peptide_ids;
+};
+
 START_TEST(MzIdentMLFile, "$Id")
 
 /////////////////////////////////////////////////////////////
@@ -128,6 +143,59 @@ START_SECTION(void load(const String& filename, std::vector<ProteinIdentificatio
 }
 END_SECTION
 
+START_SECTION(void transform(const String& filename, std::vector<ProteinIdentification>& poid, PeptideIdentificationConsumer& consumer, Size batch_size = 10000))
+{
+  vector<ProteinIdentification> protein_ids, protein_ids2;
+  vector<PeptideIdentification> peptide_ids;
+  MzIdentMLFile().load(OPENMS_GET_TEST_DATA_PATH("MzIdentMLFile_msgf_mini.mzid"), protein_ids, peptide_ids);
+
+  // one PeptideIdentification per batch
+  TestConsumer consumer;
+  MzIdentMLFile().transform(OPENMS_GET_TEST_DATA_PATH("MzIdentMLFile_msgf_mini.mzid"), protein_ids2, consumer, 1);
+  TEST_EQUAL(consumer.batch_sizes.size(), 5)
+  TEST_EQUAL(consumer.batch_sizes[0], 1)
+  TEST_EQUAL(consumer.batch_sizes[4], 1)
+  TEST_EQUAL(protein_ids2.size(), protein_ids.size())
+  ABORT_IF(protein_ids2.size() != 2)
+  TEST_EQUAL(protein_ids2[0].getHits().size(), 2)
+  TEST_EQUAL(protein_ids2[1].getHits().size(), 1)
+  TEST_EQUAL(protein_ids2[0].getSearchEngine(), "MS-GF+")
+  TEST_EQUAL(protein_ids2[0].getSearchParameters().db, "database.fasta")
+  TEST_EQUAL(protein_ids2[0].getHits()[1].getAccession(), "sp|P0A786|PYRB_ECOLI")
+  ABORT_IF(consumer.peptide_ids.size() != peptide_ids.size())
+  for (Size i = 0; i < peptide_ids.size(); ++i)
+  {
+    TEST_EQUAL(consumer.peptide_ids[i].getMetaValue("spectrum_reference"), peptide_ids[i].getMetaValue("spectrum_reference"))
+    TEST_EQUAL(consumer.peptide_ids[i].getHits().size(), peptide_ids[i].getHits().size())
+    TEST_EQUAL(consumer.peptide_ids[i].getHits()[0].getSequence(), peptide_ids[i].getHits()[0].getSequence())
+    TEST_EQUAL(consumer.peptide_ids[i].getHits()[0].getPeptideEvidences().size(), peptide_ids[i].getHits()[0].getPeptideEvidences().size())
+  }
+
+  // the remainder forms the last batch
+  TestConsumer consumer2;
+  protein_ids2.clear();
+  MzIdentMLFile().transform(OPENMS_GET_TEST_DATA_PATH("MzIdentMLFile_msgf_mini.mzid"), protein_ids2, consumer2, 3);
+  TEST_EQUAL(consumer2.batch_sizes.size(), 2)
+  TEST_EQUAL(consumer2.batch_sizes[0], 3)
+  TEST_EQUAL(consumer2.batch_sizes[1], 2)
+
+  // cross-linking MS files are read with DOM, but reported in batches as well
+  TestConsumer consumer3;
+  protein_ids.clear();
+  peptide_ids.clear();
+  protein_ids2.clear();
+  MzIdentMLFile().load(OPENMS_GET_TEST_DATA_PATH("MzIdentML_XLMS_labelled.mzid"), protein_ids, peptide_ids);
+  MzIdentMLFile().transform(OPENMS_GET_TEST_DATA_PATH("MzIdentML_XLMS_labelled.mzid"), protein_ids2, consumer3, 2);
+  TEST_EQUAL(protein_ids2.size(), protein_ids.size())
+  TEST_EQUAL(consumer3.peptide_ids.size(), peptide_ids.size())
+  TEST_EQUAL(consumer3.batch_sizes.size(), (peptide_ids.size() + 1) / 2)
+  ABORT_IF(consumer3.peptide_ids.size() < 2)
+  TEST_EQUAL(consumer3.peptide_ids[1].getHits()[1].getMetaValue("xl_term_spec"), "N_TERM")
+
+  TEST_EXCEPTION(Exception::FileNotFound, MzIdentMLFile().transform("this_file_does_not_exist.mzid", protein_ids2, consumer3))
+}
+END_SECTION
+
 START_SECTION(void store(String filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids) )
 {
   //store and load data from various sources, starting with idxml, contents already checked above, so checking integrity of the data over repeated r/w
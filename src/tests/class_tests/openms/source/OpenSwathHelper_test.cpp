@@ -131,6 +131,147 @@ START_SECTION(static void selectSwathTransitions(const OpenSwath::LightTargetedE
   // select all transitions between 200 and 500
   OpenSwathHelper::selectSwathTransitions(exp1, exp2, 1.0, 199.9, 500);
   TEST_EQUAL(exp2.getTransitions().size(), 2)
+  TEST_EQUAL(exp2.hasCompoundTransitionIndex(), false)
+
+  // transitions grouped by compound: selection keeps the grouping
+  LightTargetedExperiment exp3;
+  LightTargetedExperiment exp4;
+  LightCompound c1, c2, c3;
+  c1.id = "c1";
+  c2.id = "c2";
+  c3.id = "c3";
+  exp3.compounds.push_back(c1);
+  exp3.compounds.push_back(c2);
+  exp3.compounds.push_back(c3);
+  const char* refs[] = {"c2", "c1", "orphan", "c2", "c3", "c1"};
+  const double mzs[] = {250.0, 100.0, 300.0, 260.0, 400.0, 150.0};
+  for (Size i = 0; i < 6; i++)
+  {
+    LightTransition tr;
+    tr.transition_name = String(i);
+    tr.peptide_ref = refs[i];
+    tr.precursor_mz = mzs[i];
+    exp3.transitions.push_back(tr);
+  }
+  exp3.groupTransitionsByCompound();
+  TEST_EQUAL(exp3.hasCompoundTransitionIndex(), true)
+  TEST_EQUAL(exp3.compound_transition_offsets.size(), 4)
+  TEST_EQUAL(exp3.compound_transition_offsets[1], 2)
+  TEST_EQUAL(exp3.compound_transition_offsets[2], 4)
+  TEST_EQUAL(exp3.compound_transition_offsets[3], 5)
+  // stable within each compound, orphans last
+  TEST_EQUAL(exp3.transitions[0].transition_name, "1")
+  TEST_EQUAL(exp3.transitions[1].transition_name, "5")
+  TEST_EQUAL(exp3.transitions[2].transition_name, "0")
+  TEST_EQUAL(exp3.transitions[3].transition_name, "3")
+  TEST_EQUAL(exp3.transitions[4].transition_name, "4")
+  TEST_EQUAL(exp3.transitions[5].transition_name, "2")
+
+  OpenSwathHelper::selectSwathTransitions(exp3, exp4, 1.0, 199.9, 500);
+  TEST_EQUAL(exp4.getTransitions().size(), 4)
+  TEST_EQUAL(exp4.getCompounds().size(), 2)
+  TEST_EQUAL(exp4.hasCompoundTransitionIndex(), true)
+  TEST_EQUAL(exp4.compounds[0].id, "c2")
+  TEST_EQUAL(exp4.compounds[1].id, "c3")
+  TEST_EQUAL(exp4.compound_transition_offsets[1], 2)
+  TEST_EQUAL(exp4.compound_transition_offsets[2], 3)
+  TEST_EQUAL(exp4.transitions[3].transition_name, "2")
+
+  // adding transitions or compounds disables the offset table
+  LightTargetedExperiment exp5 = exp3;
+  exp5.transitions.push_back(exp5.transitions[0]); // appended transition of "c1"
+  TEST_EQUAL(exp5.hasCompoundTransitionIndex(), false)
+  TEST_EQUAL(exp5.validateCompoundTransitionIndex(), false)
+  exp5 = exp3;
+  exp5.compounds.push_back(c1);
+  TEST_EQUAL(exp5.hasCompoundTransitionIndex(), false)
+  // changes in place that break the grouping are found by validation
+  exp5 = exp3;
+  std::swap(exp5.compounds[0], exp5.compounds[1]);
+  TEST_EQUAL(exp5.validateCompoundTransitionIndex(), false)
+  TEST_EQUAL(exp5.hasCompoundTransitionIndex(), false)
+  exp5 = exp3;
+  std::swap(exp5.transitions[1], exp5.transitions[2]);
+  TEST_EQUAL(exp5.validateCompoundTransitionIndex(), false)
+  exp5.groupTransitionsByCompound();
+  TEST_EQUAL(exp5.hasCompoundTransitionIndex(), true)
+  // ... while changes within a compound keep it valid
+  std::swap(exp5.transitions[0], exp5.transitions[1]);
+  TEST_EQUAL(exp5.validateCompoundTransitionIndex(), true)
+  TEST_EQUAL(exp5.hasCompoundTransitionIndex(), true)
+  // an assigned table is only used after validation
+  LightTargetedExperiment exp6;
+  exp6.compounds = exp3.compounds;
+  exp6.transitions = exp3.transitions;
+  exp6.compound_transition_offsets = exp3.compound_transition_offsets;
+  TEST_EQUAL(exp6.hasCompoundTransitionIndex(), false)
+  TEST_EQUAL(exp6.validateCompoundTransitionIndex(), true)
+  TEST_EQUAL(exp6.hasCompoundTransitionIndex(), true)
+}
+END_SECTION
+
+START_SECTION(static void selectSwathTransitionIndices(const OpenSwath::LightTargetedExperiment& targeted_exp, std::vector<Size>& transition_indices, std::vector<Size>& compound_indices, double min_upper_edge_dist, double lower, double upper))
+{
+  LightTargetedExperiment exp;
+  LightCompound c1, c2, c3;
+  c1.id = "c1";
+  c2.id = "c2";
+  c2.protein_refs.push_back("p2");
+  c3.id = "c3";
+  exp.compounds.push_back(c1);
+  exp.compounds.push_back(c2);
+  exp.compounds.push_back(c3);
+  LightProtein p1, p2;
+  p1.id = "p1";
+  p2.id = "p2";
+  exp.proteins.push_back(p1);
+  exp.proteins.push_back(p2);
+  const char* refs[] = {"c2", "c1", "orphan", "c2", "c3", "c1"};
+  const double mzs[] = {250.0, 100.0, 300.0, 260.0, 400.0, 150.0};
+  for (Size i = 0; i < 6; i++)
+  {
+    LightTransition tr;
+    tr.transition_name = String(i);
+    tr.peptide_ref = refs[i];
+    tr.precursor_mz = mzs[i];
+    exp.transitions.push_back(tr);
+  }
+
+  // without and with compound index: same selection as selectSwathTransitions()
+  for (Size grouped = 0; grouped < 2; ++grouped)
+  {
+    if (grouped == 1)
+    {
+      exp.groupTransitionsByCompound();
+    }
+    std::vector<Size> transition_indices, compound_indices;
+    OpenSwathHelper::selectSwathTransitionIndices(exp, transition_indices, compound_indices, 1.0, 199.9, 500);
+    TEST_EQUAL(transition_indices.size(), 4)
+    TEST_EQUAL(compound_indices.size(), 2)
+    TEST_EQUAL(compound_indices[0], 1)
+    TEST_EQUAL(compound_indices[1], 2)
+
+    LightTargetedExperiment selected, reference;
+    OpenSwathHelper::selectTransitions(exp, transition_indices, compound_indices, selected);
+    OpenSwathHelper::selectSwathTransitions(exp, reference, 1.0, 199.9, 500);
+    TEST_EQUAL(selected.transitions.size(), reference.transitions.size())
+    for (Size i = 0; i < selected.transitions.size(); ++i)
+    {
+      TEST_EQUAL(selected.transitions[i].transition_name, reference.transitions[i].transition_name)
+    }
+    TEST_EQUAL(selected.compounds.size(), 2)
+    TEST_EQUAL(selected.compounds[0].id, "c2")
+    TEST_EQUAL(selected.proteins.size(), 1)
+    TEST_EQUAL(selected.proteins[0].id, "p2")
+    TEST_EQUAL(selected.hasCompoundTransitionIndex(), grouped == 1)
+    TEST_EQUAL(selected.compound_transition_offsets == reference.compound_transition_offsets, true)
+  }
+}
+END_SECTION
+
+START_SECTION(static void selectTransitions(const OpenSwath::LightTargetedExperiment& targeted_exp, const std::vector<Size>& transition_indices, const std::vector<Size>& compound_indices, OpenSwath::LightTargetedExperiment& selected_transitions))
+{
+  NOT_TESTABLE // tested above
 }
 END_SECTION
 
@@ -0,0 +1,167 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathOSWWriter.h>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(OpenSwathOSWWriter, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+OpenSwathOSWWriter* ptr = nullptr;
+OpenSwathOSWWriter* nullPointer = nullptr;
+
+START_SECTION(OpenSwathOSWWriter(const String& output_filename, const String& input_filename = "inputfile", bool ms1_scores = false, bool sonar = false, bool uis_scores = false))
+{
+  ptr = new OpenSwathOSWWriter("");
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->isActive(), false)
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(bool isCheckpointing() const)
+{
+  OpenSwathOSWWriter inactive("");
+  inactive.setCheckpointing(true);
+  TEST_EQUAL(inactive.isCheckpointing(), false)
+
+  OpenSwathOSWWriter writer("test.osw");
+  TEST_EQUAL(writer.isCheckpointing(), false)
+  writer.setCheckpointing(true);
+  TEST_EQUAL(writer.isCheckpointing(), true)
+}
+END_SECTION
+
+START_SECTION(String prepareCheckpoint(Size swath_window, Size batch, Size batch_size, Size nr_compounds) const)
+{
+  OpenSwathOSWWriter writer("test.osw");
+  TEST_STRING_EQUAL(writer.prepareCheckpoint(3, 1, 100, 42),
+                    "INSERT INTO CHECKPOINT (SWATH_WINDOW, BATCH, BATCH_SIZE, NR_COMPOUNDS) VALUES (3, 1, 100, 42); ")
+}
+END_SECTION
+
+String tmp_file;
+NEW_TMP_FILE(tmp_file);
+
+START_SECTION(void writeHeader())
+{
+  // a new run
+  OpenSwathOSWWriter writer(tmp_file, "swath.mzML");
+  writer.setCheckpointing(true);
+  writer.setCheckpointSources("library_sha1", "swath_sha1", "param_sha1");
+  writer.writeHeader();
+  TEST_EQUAL(writer.getNumberOfCheckpoints(), 0)
+
+  std::vector<String> lines;
+  lines.push_back(writer.prepareCheckpoint(0, 0, 2, 2));
+  lines.push_back(writer.prepareCheckpoint(0, 1, 2, 1));
+  writer.writeLines(lines);
+
+  // resume the run
+  OpenSwathOSWWriter resumed(tmp_file, "swath.mzML");
+  resumed.setCheckpointing(true);
+  resumed.setCheckpointSources("library_sha1", "swath_sha1", "param_sha1");
+  resumed.writeHeader();
+  TEST_EQUAL(resumed.getNumberOfCheckpoints(), 2)
+
+  // the same input file is required
+  OpenSwathOSWWriter other_input(tmp_file, "other.mzML");
+  other_input.setCheckpointing(true);
+  other_input.setCheckpointSources("library_sha1", "swath_sha1", "param_sha1");
+  TEST_EXCEPTION(Exception::IllegalArgument, other_input.writeHeader())
+}
+END_SECTION
+
+START_SECTION(void setCheckpointSources(const String& library_checksum, const String& input_checksum, const String& parameter_checksum))
+{
+  // the same content of library and input file is required
+  OpenSwathOSWWriter other_library(tmp_file, "swath.mzML");
+  other_library.setCheckpointing(true);
+  other_library.setCheckpointSources("other_sha1", "swath_sha1", "param_sha1");
+  TEST_EXCEPTION(Exception::IllegalArgument, other_library.writeHeader())
+
+  OpenSwathOSWWriter other_content(tmp_file, "swath.mzML");
+  other_content.setCheckpointing(true);
+  other_content.setCheckpointSources("library_sha1", "other_sha1", "param_sha1");
+  TEST_EXCEPTION(Exception::IllegalArgument, other_content.writeHeader())
+
+  // the same parameters are required
+  OpenSwathOSWWriter other_parameters(tmp_file, "swath.mzML");
+  other_parameters.setCheckpointing(true);
+  other_parameters.setCheckpointSources("library_sha1", "swath_sha1", "other_sha1");
+  TEST_EXCEPTION(Exception::IllegalArgument, other_parameters.writeHeader())
+
+  // the same scoring flags are required
+  OpenSwathOSWWriter other_ms1(tmp_file, "swath.mzML", true, false, false);
+  other_ms1.setCheckpointing(true);
+  other_ms1.setCheckpointSources("library_sha1", "swath_sha1", "param_sha1");
+  TEST_EXCEPTION(Exception::IllegalArgument, other_ms1.writeHeader())
+
+  OpenSwathOSWWriter other_uis(tmp_file, "swath.mzML", false, false, true);
+  other_uis.setCheckpointing(true);
+  other_uis.setCheckpointSources("library_sha1", "swath_sha1", "param_sha1");
+  TEST_EXCEPTION(Exception::IllegalArgument, other_uis.writeHeader())
+
+  // without checkpointing, the tables cannot be created again
+  OpenSwathOSWWriter no_checkpoints(tmp_file, "swath.mzML");
+  TEST_EXCEPTION(Exception::IllegalArgument, no_checkpoints.writeHeader())
+}
+END_SECTION
+
+START_SECTION(bool isCheckpointed(Size swath_window, Size batch, Size batch_size, Size nr_compounds) const)
+{
+  OpenSwathOSWWriter writer(tmp_file, "swath.mzML");
+  writer.setCheckpointing(true);
+  writer.setCheckpointSources("library_sha1", "swath_sha1", "param_sha1");
+  writer.writeHeader();
+  TEST_EQUAL(writer.isCheckpointed(0, 0, 2, 2), true)
+  TEST_EQUAL(writer.isCheckpointed(0, 1, 2, 1), true)
+  TEST_EQUAL(writer.isCheckpointed(1, 0, 2, 2), false)
+  // recorded with a different batch size
+  TEST_EXCEPTION(Exception::IllegalArgument, writer.isCheckpointed(0, 0, 3, 3))
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
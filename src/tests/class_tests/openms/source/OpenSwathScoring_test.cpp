@@ -119,7 +119,7 @@ START_SECTION((void getNormalized_library_intensities_(const std::vector<Transit
 }
 END_SECTION
 
-START_SECTION((OpenSwath::SpectrumPtr OpenSwathScoring::fetchSpectrumSwath(std::vector<OpenSwath::SwathMap> swath_maps,
+START_SECTION((OpenSwath::SpectrumPtr OpenSwathScoring::fetchSpectrumSwath(const std::vector<OpenSwath::SwathMap>& swath_maps,
                                                               double RT, int nr_spectra_to_add, double drift_lower, drift_upper)))
 {
   // test result for empty map
@@ -217,6 +217,84 @@ START_SECTION((OpenSwath::SpectrumPtr OpenSwathScoring::fetchSpectrumSwath(std::
 }
 END_SECTION
 
+START_SECTION((void setSpectrumCache(const boost::shared_ptr<OpenSwath_Spectrum_Cache>& cache)))
+{
+  PeakMap* eptr = new PeakMap;
+  MSSpectrum s;
+  Peak1D p;
+  p.setMZ(20.0);
+  p.setIntensity(200.0);
+  s.push_back(p);
+  s.setRT(10.0);
+  eptr->addSpectrum(s);
+  s.setRT(20.0);
+  eptr->addSpectrum(s);
+  s.setRT(30.0);
+  eptr->addSpectrum(s);
+  boost::shared_ptr<PeakMap > swath_map (eptr);
+  OpenSwath::SpectrumAccessPtr swath_ptr = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(swath_map);
+
+  OpenSwathScoring sc;
+  TEST_EQUAL(sc.getSpectrumCache().get() == nullptr, true)
+  boost::shared_ptr<OpenSwath_Spectrum_Cache> cache(new OpenSwath_Spectrum_Cache);
+  sc.setSpectrumCache(cache);
+  TEST_EQUAL(sc.getSpectrumCache() == cache, true)
+  TEST_REAL_SIMILAR(cache->getHitRate(), 0.0)
+
+  OpenSwath::SpectrumPtr sp = sc.fetchSpectrumSwath(swath_ptr, 20.0, 3, 0, 0);
+  TEST_EQUAL(cache->misses, 1)
+  TEST_EQUAL(cache->hits, 0)
+  TEST_REAL_SIMILAR(sp->getIntensityArray()->data[0], 600.0);
+
+  // RT 21.0 maps to the same closest spectrum -> cache hit, identical result
+  OpenSwath::SpectrumPtr sp2 = sc.fetchSpectrumSwath(swath_ptr, 21.0, 3, 0, 0);
+  TEST_EQUAL(cache->misses, 1)
+  TEST_EQUAL(cache->hits, 1)
+  TEST_EQUAL(sp2 == sp, true)
+  TEST_REAL_SIMILAR(cache->getHitRate(), 0.5)
+
+  // a different number of spectra to add up is a different entry
+  OpenSwath::SpectrumPtr sp3 = sc.fetchSpectrumSwath(swath_ptr, 20.0, 1, 0, 0);
+  TEST_EQUAL(cache->misses, 2)
+  TEST_EQUAL(cache->size(), 2)
+  TEST_REAL_SIMILAR(sp3->getIntensityArray()->data[0], 200.0);
+
+  // the same holds for the SONAR (multiple maps) interface
+  std::vector<OpenSwath::SwathMap> maps(1);
+  maps[0].sptr = swath_ptr;
+  OpenSwath::SpectrumPtr sp4 = sc.fetchSpectrumSwath(maps, 19.0, 3, 0, 0);
+  TEST_EQUAL(cache->hits, 2)
+  TEST_EQUAL(sp4 == sp, true)
+
+  // a light clone is a different map, even if it is allocated at the same address later
+  OpenSwath::SpectrumAccessPtr clone_ptr = swath_ptr->lightClone();
+  OpenSwath::SpectrumPtr sp5 = sc.fetchSpectrumSwath(clone_ptr, 20.0, 3, 0, 0);
+  TEST_EQUAL(cache->misses, 3)
+  TEST_EQUAL(sp5 == sp, false)
+  TEST_EQUAL(cache->size(), 3)
+
+  // least recently used spectra are removed first (here: 1 spectrum added up)
+  cache->setCapacity(2);
+  TEST_EQUAL(cache->size(), 2)
+  TEST_EQUAL(sc.fetchSpectrumSwath(swath_ptr, 20.0, 3, 0, 0) == sp, true)
+  TEST_EQUAL(cache->hits, 3)
+  sc.fetchSpectrumSwath(swath_ptr, 20.0, 1, 0, 0);
+  TEST_EQUAL(cache->misses, 4)
+  TEST_EQUAL(cache->size(), 2)
+  // ... now the spectrum of the clone is the least recently used one
+  sc.fetchSpectrumSwath(clone_ptr, 20.0, 3, 0, 0);
+  TEST_EQUAL(cache->misses, 5)
+  TEST_EQUAL(sc.fetchSpectrumSwath(swath_ptr, 20.0, 1, 0, 0) == sc.fetchSpectrumSwath(swath_ptr, 20.0, 1, 0, 0), true)
+  TEST_EQUAL(cache->hits, 5)
+
+  cache->clear();
+  TEST_EQUAL(cache->size(), 0)
+  TEST_EQUAL(cache->hits, 0)
+  TEST_EQUAL(cache->misses, 0)
+  TEST_EQUAL(cache->getCapacity(), 2)
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -35,6 +35,9 @@
 #include <OpenMS/CONCEPT/ClassTest.h>
 #include <OpenMS/test_config.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/KERNEL/MSChromatogram.h>
+
+#include <cmath>
 
 ///////////////////////////
 #include <OpenMS/TRANSFORMATIONS/RAW2PEAK/PeakPickerHiRes.h>
@@ -491,4 +494,75 @@ START_SECTION(void pick(const MSSpectrum& input, MSSpectrum& output, std::vector
     
 END_SECTION
 
+START_SECTION(bool isSelectedForPicking(const MSSpectrum& spectrum, const bool check_spectrum_type = true) const)
+{
+  MSSpectrum profile, centroid;
+  profile.setType(SpectrumSettings::PROFILE);
+  profile.setMSLevel(1);
+  centroid.setType(SpectrumSettings::CENTROID);
+  centroid.setMSLevel(2);
+
+  PeakPickerHiRes pp_select;
+  // auto mode: everything that is not centroided yet
+  TEST_EQUAL(pp_select.isSelectedForPicking(profile), true)
+  TEST_EQUAL(pp_select.isSelectedForPicking(centroid), false)
+
+  Param pp_select_param = pp_select.getParameters();
+  pp_select_param.setValue("ms_levels", ListUtils::create<Int>("2"));
+  pp_select.setParameters(pp_select_param);
+  TEST_EQUAL(pp_select.isSelectedForPicking(profile), false)
+  TEST_EXCEPTION(Exception::IllegalArgument, pp_select.isSelectedForPicking(centroid))
+  TEST_EQUAL(pp_select.isSelectedForPicking(centroid, false), true)
+}
+END_SECTION
+
+START_SECTION(void pickSpectra(std::vector<MSSpectrum>& spectra, const bool check_spectrum_type = true) const)
+{
+  PeakMap in_selection;
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("PeakPickerHiRes_spectrum_selection.mzML"), in_selection);
+
+  PeakPickerHiRes pp_batch;
+  Param pp_batch_param = pp_batch.getParameters();
+  pp_batch_param.setValue("ms_levels", ListUtils::create<Int>("2"));
+  pp_batch.setParameters(pp_batch_param);
+
+  PeakMap expected;
+  pp_batch.pickExperiment(in_selection, expected);
+
+  std::vector<MSSpectrum> spectra = in_selection.getSpectra();
+  pp_batch.pickSpectra(spectra);
+  ABORT_IF(spectra.size() != expected.size())
+  for (Size i = 0; i < spectra.size(); ++i)
+  {
+    TEST_EQUAL(spectra[i] == expected[i], true)
+  }
+}
+END_SECTION
+
+START_SECTION(void pickChromatograms(std::vector<MSChromatogram>& chromatograms) const)
+{
+  // chromatogram with two Gaussian peaks
+  MSChromatogram chrom;
+  for (Size i = 0; i < 100; ++i)
+  {
+    ChromatogramPeak p;
+    p.setRT(i);
+    p.setIntensity(1000.0 * std::exp(-0.5 * std::pow((i - 30.0) / 3.0, 2)) + 500.0 * std::exp(-0.5 * std::pow((i - 70.0) / 3.0, 2)));
+    chrom.push_back(p);
+  }
+  std::vector<MSChromatogram> chromatograms(3, chrom);
+
+  PeakPickerHiRes pp_chrom;
+  MSChromatogram expected;
+  pp_chrom.pick(chrom, expected);
+  TEST_EQUAL(expected.size(), 2)
+
+  pp_chrom.pickChromatograms(chromatograms);
+  for (Size i = 0; i < chromatograms.size(); ++i)
+  {
+    TEST_EQUAL(chromatograms[i] == expected, true)
+  }
+}
+END_SECTION
+
 END_TEST
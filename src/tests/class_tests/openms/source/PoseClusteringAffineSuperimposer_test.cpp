@@ -42,6 +42,10 @@
 
 #include <OpenMS/KERNEL/Feature.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace OpenMS;
 using namespace std;
 
@@ -338,6 +342,102 @@ START_SECTION(([EXTRA]virtual void run(const std::vector<Peak2D> & map_model, co
 }
 END_SECTION
 
+START_SECTION(([EXTRA] point_selection rt_stratified))
+{
+  std::vector<Peak2D> map_model, map_scene;
+
+  // two intense points without partners in the middle of the gradient: the
+  // most intense points would not contain the weak one at the end
+  double map1_rt[] = {1.0, 3.0, 3.1, 5.0};
+  double map2_rt[] = {1.4, 3.4, 3.5, 5.4};
+
+  double map1_mz[] = {1.0 , 50, 60, 5.0 };
+  double map2_mz[] = {1.02, 80, 90, 5.02};
+
+  double map1_int[] = {100, 1000, 1000, 10};
+  double map2_int[] = {100, 1000, 1000, 10};
+
+  for (Size i = 0; i < 4; i++)
+  {
+    Peak2D p;
+    p.setRT(map1_rt[i]);
+    p.setMZ(map1_mz[i]);
+    p.setIntensity(map1_int[i]);
+    map_model.push_back(p);
+    p.setRT(map2_rt[i]);
+    p.setMZ(map2_mz[i]);
+    p.setIntensity(map2_int[i]);
+    map_scene.push_back(p);
+  }
+
+  Param parameters;
+  parameters.setValue(String("scaling_bucket_size"), 0.01);
+  parameters.setValue(String("shift_bucket_size"), 0.1);
+  parameters.setValue(String("num_used_points"), 3);
+  parameters.setValue(String("point_selection"), "rt_stratified");
+  parameters.setValue(String("rt_strata"), 3);
+
+  TransformationDescription transformation;
+  PoseClusteringAffineSuperimposer pcat;
+  pcat.setParameters(parameters);
+
+  pcat.run(map_model, map_scene, transformation);
+
+  TEST_STRING_EQUAL(transformation.getModelType(), "linear")
+  parameters = transformation.getModelParameters();
+  TEST_EQUAL(parameters.size(), 2)
+  TEST_REAL_SIMILAR(parameters.getValue("slope"), 1.0)
+  TEST_REAL_SIMILAR(parameters.getValue("intercept"), -0.4)
+}
+END_SECTION
+
+START_SECTION(([EXTRA] hashing gives the same result for any number of threads))
+{
+  // more points than hashing blocks; scene RT = 1.01 * model RT + 2
+  std::vector<Peak2D> map_model, map_scene;
+  for (Size i = 0; i < 150; i++)
+  {
+    Peak2D p;
+    p.setRT(10.0 + 0.6 * i + 0.05 * (i % 7));
+    p.setMZ(300.0 + 2.3 * i);
+    p.setIntensity(100.0 + (i * 37) % 200);
+    map_model.push_back(p);
+    p.setRT(1.01 * p.getRT() + 2.0 + ((i % 5 == 0) ? 3.0 : 0.0)); // some outliers
+    p.setMZ(p.getMZ() + 0.001);
+    map_scene.push_back(p);
+  }
+
+  Param parameters;
+  parameters.setValue(String("scaling_bucket_size"), 0.001);
+  parameters.setValue(String("shift_bucket_size"), 0.1);
+  PoseClusteringAffineSuperimposer pcat;
+  pcat.setParameters(parameters);
+
+#ifdef _OPENMP
+  const int max_threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+#endif
+  TransformationDescription serial;
+  pcat.run(map_model, map_scene, serial);
+#ifdef _OPENMP
+  omp_set_num_threads(4);
+#endif
+  TransformationDescription parallel;
+  pcat.run(map_model, map_scene, parallel);
+#ifdef _OPENMP
+  omp_set_num_threads(max_threads);
+#endif
+
+  Param serial_params = serial.getModelParameters();
+  Param parallel_params = parallel.getModelParameters();
+  TEST_EQUAL((double)serial_params.getValue("slope"), (double)parallel_params.getValue("slope"))
+  TEST_EQUAL((double)serial_params.getValue("intercept"), (double)parallel_params.getValue("intercept"))
+  // and roughly the right one
+  TEST_EQUAL(fabs((double)parallel_params.getValue("slope") - 1.0 / 1.01) < 0.02, true)
+  TEST_EQUAL(fabs((double)parallel_params.getValue("intercept") + 2.0 / 1.01) < 2.0, true)
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -206,6 +206,46 @@ START_SECTION((void fit( std::vector<double>& search_engine_scores, std::vector<
 
 END_SECTION
 
+START_SECTION((void computeProbabilities(const std::vector<double>& search_engine_scores, std::vector<double>& probabilities) const))
+{
+	vector<double> scores = ListUtils::create<double>("4.12,-0.39,1.67,6.22,0.94");
+	vector<double> probabilities(1, 42.0);
+	ptr->computeProbabilities(scores, probabilities);
+	TEST_EQUAL(probabilities.size(), scores.size())
+	TOLERANCE_ABSOLUTE(0.000001)
+	for (Size i = 0; i < scores.size(); ++i)
+	{
+		TEST_REAL_SIMILAR(probabilities[i], ptr->computeProbability(scores[i]))
+	}
+}
+{
+	// fitting on a deterministic subsample yields (almost) the same model
+	vector<double> rand_score_vector;
+	CsvFile gauss_mix (OPENMS_GET_TEST_DATA_PATH("GaussMix_2_1D.csv"), ';');
+	StringList gauss_mix_strings;
+	gauss_mix.getRow(0, gauss_mix_strings);
+	for (StringList::const_iterator it = gauss_mix_strings.begin(); it != gauss_mix_strings.end(); ++it)
+	{
+		if (!it->empty()) rand_score_vector.push_back(it->toDouble());
+	}
+
+	PosteriorErrorProbabilityModel sub_model;
+	Param param;
+	param.setValue("incorrectly_assigned","Gauss");
+	param.setValue("fit_subsample_size", 500);
+	sub_model.setParameters(param);
+	vector<double> probabilities;
+	TEST_EQUAL(sub_model.fit(rand_score_vector, probabilities), true)
+	TEST_EQUAL(probabilities.size(), rand_score_vector.size())
+	TOLERANCE_ABSOLUTE(0.5)
+	TEST_REAL_SIMILAR(sub_model.getCorrectlyAssignedFitResult().x0 , 3.5)
+	TEST_REAL_SIMILAR(sub_model.getCorrectlyAssignedFitResult().sigma, 1.0)
+	TEST_REAL_SIMILAR(sub_model.getIncorrectlyAssignedFitResult().x0, 1.5)
+	TEST_REAL_SIMILAR(sub_model.getIncorrectlyAssignedFitResult().sigma, 0.5)
+	TEST_REAL_SIMILAR(sub_model.getNegativePrior(), 0.5)
+}
+END_SECTION
+
 START_SECTION((void fillDensities(std::vector<double>& x_scores,std::vector<double>& incorrect_density,std::vector<double>& correct_density)))
 NOT_TESTABLE
 //tested in fit
@@ -0,0 +1,179 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/SYSTEM/Profiler.h>
+///////////////////////////
+
+
+#include <fstream>
+#include <iterator>
+
+using namespace OpenMS;
+using namespace std;
+
+String readFile(const String& filename)
+{
+  ifstream is(filename.c_str());
+  return String(string(istreambuf_iterator<char>(is), istreambuf_iterator<char>()));
+}
+
+START_TEST(Profiler, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+Profiler& profiler = Profiler::getInstance();
+
+START_SECTION(static Profiler& getInstance())
+{
+  TEST_EQUAL(&Profiler::getInstance(), &profiler)
+  TEST_EQUAL(Profiler::isEnabled(), false)
+}
+END_SECTION
+
+START_SECTION(ScopedPhase(const char* name))
+{
+  // disabled: nothing is recorded
+  {
+    Profiler::ScopedPhase phase("disabled");
+  }
+  TEST_EQUAL(profiler.getPhases().size(), 0)
+
+  profiler.enable();
+  TEST_EQUAL(Profiler::isEnabled(), true)
+  {
+    Profiler::ScopedPhase outer("outer");
+    {
+      Profiler::ScopedPhase inner("inner");
+    }
+  }
+  vector<Profiler::PhaseRecord> phases = profiler.getPhases();
+  ABORT_IF(phases.size() != 2)
+  TEST_EQUAL(phases[0].name, "inner")
+  TEST_EQUAL(phases[0].depth, 1)
+  TEST_EQUAL(phases[1].name, "outer")
+  TEST_EQUAL(phases[1].depth, 0)
+  TEST_EQUAL(phases[0].thread, phases[1].thread)
+  TEST_EQUAL(phases[1].wall_time >= phases[0].wall_time, true)
+  TEST_EQUAL(phases[1].start <= phases[0].start, true)
+  profiler.disable();
+  TEST_EQUAL(Profiler::isEnabled(), false)
+}
+END_SECTION
+
+START_SECTION(void addCounter(const String& name, double value))
+{
+  profiler.enable();
+  profiler.addCounter("spectra", 2.0);
+  profiler.addCounter("spectra", 3.0);
+  OPENMS_PROFILE_COUNTER("peaks", 1.0);
+  map<String, double> counters = profiler.getCounters();
+  TEST_REAL_SIMILAR(counters["spectra"], 5.0)
+#ifdef ENABLE_PROFILING
+  TEST_REAL_SIMILAR(counters["peaks"], 1.0)
+#endif
+}
+END_SECTION
+
+START_SECTION(void addHistogramValue(const String& name, double value))
+{
+  profiler.addHistogramValue("size", 3.0);
+  profiler.addHistogramValue("size", 2.5);
+  profiler.addHistogramValue("size", 9.0);
+  profiler.addHistogramValue("size", 0.0);
+  Profiler::Histogram h = profiler.getHistograms()["size"];
+  TEST_EQUAL(h.count, 4)
+  TEST_REAL_SIMILAR(h.sum, 14.5)
+  TEST_REAL_SIMILAR(h.min, 0.0)
+  TEST_REAL_SIMILAR(h.max, 9.0)
+  TEST_EQUAL(h.non_positive, 1)
+  TEST_EQUAL(h.bins.size(), 2)
+  TEST_EQUAL(h.bins[1], 2) // [2, 4)
+  TEST_EQUAL(h.bins[3], 1) // [8, 16)
+
+  OPENMS_PROFILE_HISTOGRAM("matches", 5.0);
+#ifdef ENABLE_PROFILING
+  TEST_EQUAL(profiler.getHistograms()["matches"].count, 1)
+  TEST_EQUAL(profiler.getHistograms()["matches"].bins[2], 1) // [4, 8)
+#endif
+}
+END_SECTION
+
+START_SECTION(void clear())
+{
+  profiler.clear();
+  TEST_EQUAL(profiler.getPhases().size(), 0)
+  TEST_EQUAL(profiler.getCounters().size(), 0)
+  TEST_EQUAL(profiler.getHistograms().size(), 0)
+}
+END_SECTION
+
+START_SECTION(void store(const String& filename, ReportFormat format) const)
+{
+  profiler.enable();
+  for (Size i = 0; i < 2; ++i)
+  {
+    Profiler::ScopedPhase phase("loading \"data\"");
+  }
+  profiler.addCounter("spectra", 7.0);
+  profiler.disable();
+
+  String filename;
+  NEW_TMP_FILE(filename)
+  profiler.store(filename, Profiler::JSON);
+  String json = readFile(filename);
+  TEST_EQUAL(json.hasSubstring("\"name\": \"loading \\\"data\\\"\""), true)
+  TEST_EQUAL(json.hasSubstring("\"calls\": 2"), true)
+  TEST_EQUAL(json.hasSubstring("\"thread_utilization\""), true)
+  TEST_EQUAL(json.hasSubstring("\"spectra\": 7"), true)
+
+  NEW_TMP_FILE(filename)
+  profiler.store(filename, Profiler::CHROME_TRACE);
+  String trace = readFile(filename);
+  TEST_EQUAL(trace.hasSubstring("\"traceEvents\""), true)
+  TEST_EQUAL(trace.hasSubstring("\"ph\": \"X\""), true)
+  TEST_EQUAL(trace.hasSubstring("\"ph\": \"C\""), true)
+
+  TEST_EXCEPTION(Exception::UnableToCreateFile, profiler.store("/this/file/does/not/exist.json", Profiler::JSON))
+  profiler.clear();
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
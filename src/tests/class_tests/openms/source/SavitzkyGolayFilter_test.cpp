@@ -157,6 +157,114 @@ START_SECTION((template <typename PeakType> void filterExperiment(MSExperiment<P
 
 END_SECTION
 
+START_SECTION((void smoothIntensities(const double * in, double * out, Size n) const))
+{
+  SavitzkyGolayFilter sgolay;
+  Param param;
+  param.setValue("polynomial_order", 4);
+  param.setValue("frame_length", 11);
+  sgolay.setParameters(param);
+
+  // sizes below, at and above the frame size as well as across several
+  // blocks of the steady state
+  Size sizes[] = {5, 11, 12, 600};
+  for (Size s = 0; s < 4; ++s)
+  {
+    Size n = sizes[s];
+    MSSpectrum spectrum;
+    std::vector<double> in(n), out(n, -1.0);
+    for (Size i = 0; i < n; ++i)
+    {
+      double intensity = 100.0 * std::exp(-0.5 * std::pow((double(i % 80) - 40.0) / 6.0, 2)) + 5.0 * (1.0 + std::sin(0.7 * i));
+      Peak1D p;
+      p.setMZ(500.0 + 0.01 * i);
+      p.setIntensity(intensity);
+      spectrum.push_back(p);
+      in[i] = intensity;
+    }
+    MSSpectrum reference = spectrum;
+    sgolay.filter(spectrum.begin(), spectrum.end(), reference.begin());
+    sgolay.smoothIntensities(&in[0], &out[0], n);
+
+    for (Size i = 0; i < n; ++i)
+    {
+      if (n < 11)
+      {
+        // frame does not fit, nothing is written
+        TEST_REAL_SIMILAR(out[i], -1.0)
+      }
+      else
+      {
+        TEST_REAL_SIMILAR(out[i], reference[i].getIntensity())
+      }
+    }
+
+    // filter(MSSpectrum&) gives the same result and keeps the positions
+    MSSpectrum filtered = spectrum;
+    sgolay.filter(filtered);
+    TEST_EQUAL(filtered.size(), n)
+    for (Size i = 0; i < n; ++i)
+    {
+      TEST_REAL_SIMILAR(filtered[i].getMZ(), spectrum[i].getMZ())
+      TEST_REAL_SIMILAR(filtered[i].getIntensity(), reference[i].getIntensity())
+    }
+  }
+}
+END_SECTION
+
+START_SECTION([EXTRA] parallel filterExperiment equals filtering each spectrum and chromatogram)
+{
+  // the peak of the filterExperiment test, scaled per spectrum, once as
+  // spectra and once as chromatograms (some too short for the frame)
+  PeakMap exp;
+  for (Size s = 0; s < 12; ++s)
+  {
+    MSSpectrum spectrum;
+    MSChromatogram chromatogram;
+    for (Size i = 0; i < 9; ++i)
+    {
+      double intensity = (i == 3) ? 1.0 : (i == 4) ? 0.8 : (i == 5) ? 1.2 : 0.0;
+      spectrum.push_back(Peak1D(500.0 + 0.1 * i, (s + 1) * intensity));
+      if (s % 4 != 0 || i < 3)
+      {
+        chromatogram.push_back(ChromatogramPeak(1.0 * i, (s + 1) * intensity));
+      }
+    }
+    exp.addSpectrum(spectrum);
+    exp.addChromatogram(chromatogram);
+  }
+
+  SavitzkyGolayFilter sgolay;
+  sgolay.setParameters(param);
+
+  PeakMap reference = exp;
+  for (Size s = 0; s < reference.size(); ++s)
+  {
+    sgolay.filter(reference[s]);
+  }
+  for (Size c = 0; c < reference.getNrChromatograms(); ++c)
+  {
+    sgolay.filter(reference.getChromatogram(c));
+  }
+
+  sgolay.filterExperiment(exp);
+  TEST_REAL_SIMILAR(exp[0][4].getIntensity(), 1.14286)
+  for (Size s = 0; s < exp.size(); ++s)
+  {
+    TEST_EQUAL(exp[s].size(), 9)
+    for (Size i = 0; i < exp[s].size(); ++i)
+    {
+      TEST_EQUAL(exp[s][i].getIntensity(), reference[s][i].getIntensity())
+    }
+    TEST_EQUAL(exp.getChromatogram(s).size(), reference.getChromatogram(s).size())
+    for (Size i = 0; i < exp.getChromatogram(s).size(); ++i)
+    {
+      TEST_EQUAL(exp.getChromatogram(s)[i].getIntensity(), reference.getChromatogram(s)[i].getIntensity())
+    }
+  }
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -38,6 +38,7 @@
 ///////////////////////////
 #include <OpenMS/COMPARISON/CLUSTERING/SingleLinkage.h>
 #include <OpenMS/COMPARISON/CLUSTERING/ClusterAnalyzer.h>
+#include <OpenMS/COMPARISON/CLUSTERING/SparseDistanceGraph.h>
 #include <OpenMS/DATASTRUCTURES/DistanceMatrix.h>
 #include <vector>
 ///////////////////////////
@@ -141,6 +142,68 @@ START_SECTION((void operator()(DistanceMatrix< float > &original_distance, std::
 }
 END_SECTION
 
+START_SECTION((void clusterSparse(const SparseDistanceGraph &distances, std::vector<BinaryTreeNode>& cluster_tree, const float threshold=1) const))
+{
+	DistanceMatrix<float> matrix(6,666);
+	SparseDistanceGraph graph(6);
+	float values[6][6] = {{0}, {0.5f}, {0.8f, 0.3f}, {0.6f, 0.8f, 0.8f}, {0.8f, 0.8f, 0.8f, 0.4f}, {0.7f, 0.8f, 0.8f, 0.8f, 0.8f}};
+	for (Size i = 1; i < 6; ++i)
+	{
+		for (Size j = 0; j < i; ++j)
+		{
+			matrix.setValue(i, j, values[i][j]);
+			graph.addEdge(i, j, values[i][j]);
+		}
+	}
+
+	// same result as SLINK on the full matrix
+	vector< BinaryTreeNode > tree;
+	vector< BinaryTreeNode > result;
+	(*ptr)(matrix,tree);
+	ptr->clusterSparse(graph,result);
+	TEST_EQUAL(tree.size(), result.size());
+	for (Size i = 0; i < tree.size(); ++i)
+	{
+			TOLERANCE_ABSOLUTE(0.0001);
+			TEST_EQUAL(tree[i].left_child, result[i].left_child);
+			TEST_EQUAL(tree[i].right_child, result[i].right_child);
+			TEST_REAL_SIMILAR(tree[i].distance, result[i].distance);
+	}
+
+	// threshold: the remaining steps are dummy nodes
+	ptr->clusterSparse(graph,result,0.55f);
+	TEST_EQUAL(result.size(), 5);
+	ABORT_IF(result.size() != 5);
+	TEST_EQUAL(result[2].left_child, 0);
+	TEST_EQUAL(result[2].right_child, 1);
+	TEST_REAL_SIMILAR(result[2].distance, 0.5);
+	TEST_EQUAL(result[3].left_child, 0);
+	TEST_EQUAL(result[3].right_child, 3);
+	TEST_REAL_SIMILAR(result[3].distance, -1.0);
+	TEST_EQUAL(result[4].left_child, 0);
+	TEST_EQUAL(result[4].right_child, 5);
+	TEST_REAL_SIMILAR(result[4].distance, -1.0);
+
+	// unconnected components are joined by dummy nodes
+	SparseDistanceGraph sparse(4);
+	sparse.addEdge(3, 2, 0.2f);
+	sparse.addEdge(0, 1, 0.1f);
+	ptr->clusterSparse(sparse,result);
+	TEST_EQUAL(result.size(), 3);
+	ABORT_IF(result.size() != 3);
+	TEST_EQUAL(result[0].left_child, 0);
+	TEST_EQUAL(result[0].right_child, 1);
+	TEST_EQUAL(result[1].left_child, 2);
+	TEST_EQUAL(result[1].right_child, 3);
+	TEST_REAL_SIMILAR(result[1].distance, 0.2);
+	TEST_EQUAL(result[2].left_child, 0);
+	TEST_EQUAL(result[2].right_child, 2);
+	TEST_REAL_SIMILAR(result[2].distance, -1.0);
+
+	TEST_EXCEPTION(ClusterFunctor::InsufficientInput, ptr->clusterSparse(SparseDistanceGraph(1),result));
+}
+END_SECTION
+
 START_SECTION((static const String getProductName()))
 {
   TEST_EQUAL(ptr->getProductName(), "SingleLinkage")
@@ -0,0 +1,157 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/COMPARISON/CLUSTERING/SparseDistanceGraph.h>
+#include <vector>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(SparseDistanceGraph, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+SparseDistanceGraph* ptr = nullptr;
+SparseDistanceGraph* nullPointer = nullptr;
+START_SECTION(SparseDistanceGraph(Size dimensionsize=0))
+{
+	ptr = new SparseDistanceGraph();
+	TEST_NOT_EQUAL(ptr, nullPointer)
+	TEST_EQUAL(ptr->dimensionsize(), 0)
+	TEST_EQUAL(ptr->edgeCount(), 0)
+}
+END_SECTION
+
+START_SECTION(~SparseDistanceGraph())
+{
+	delete ptr;
+}
+END_SECTION
+
+START_SECTION(([SparseDistanceGraph::Edge] Edge(Size i, Size j, float d)))
+{
+	SparseDistanceGraph::Edge e(3, 1, 0.5f);
+	TEST_EQUAL(e.first, 1)
+	TEST_EQUAL(e.second, 3)
+	TEST_REAL_SIMILAR(e.distance, 0.5)
+}
+END_SECTION
+
+START_SECTION(([SparseDistanceGraph::Edge] bool operator<(const Edge& rhs) const))
+{
+	TEST_EQUAL(SparseDistanceGraph::Edge(5, 4, 0.1f) < SparseDistanceGraph::Edge(0, 1, 0.2f), true)
+	TEST_EQUAL(SparseDistanceGraph::Edge(0, 1, 0.2f) < SparseDistanceGraph::Edge(5, 4, 0.1f), false)
+	TEST_EQUAL(SparseDistanceGraph::Edge(0, 2, 0.2f) < SparseDistanceGraph::Edge(1, 0, 0.2f), false)
+	TEST_EQUAL(SparseDistanceGraph::Edge(1, 0, 0.2f) < SparseDistanceGraph::Edge(0, 2, 0.2f), true)
+}
+END_SECTION
+
+START_SECTION((Size dimensionsize() const))
+{
+	SparseDistanceGraph graph(6);
+	TEST_EQUAL(graph.dimensionsize(), 6)
+}
+END_SECTION
+
+START_SECTION((void addEdge(Size i, Size j, float distance)))
+{
+	SparseDistanceGraph graph(3);
+	graph.addEdge(2, 0, 0.7f);
+	graph.addEdge(1, 2, 0.3f);
+	TEST_EQUAL(graph.edgeCount(), 2)
+	TEST_EQUAL(graph.getEdges()[0].first, 0)
+	TEST_EQUAL(graph.getEdges()[0].second, 2)
+	TEST_REAL_SIMILAR(graph.getEdges()[0].distance, 0.7)
+	TEST_EXCEPTION(Exception::IndexOverflow, graph.addEdge(0, 3, 0.5f))
+	TEST_EXCEPTION(Exception::IllegalArgument, graph.addEdge(1, 1, 0.5f))
+}
+END_SECTION
+
+START_SECTION((void addEdges(const std::vector<Edge>& edges)))
+{
+	SparseDistanceGraph graph(4);
+	vector<SparseDistanceGraph::Edge> edges;
+	edges.push_back(SparseDistanceGraph::Edge(0, 1, 0.1f));
+	edges.push_back(SparseDistanceGraph::Edge(2, 3, 0.2f));
+	graph.addEdges(edges);
+	graph.addEdges(edges);
+	TEST_EQUAL(graph.edgeCount(), 4)
+}
+END_SECTION
+
+START_SECTION((Size edgeCount() const))
+{
+	NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((const std::vector<Edge>& getEdges() const))
+{
+	NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((void sortEdges()))
+{
+	SparseDistanceGraph graph(4);
+	graph.addEdge(0, 1, 0.9f);
+	graph.addEdge(2, 3, 0.2f);
+	graph.addEdge(1, 2, 0.2f);
+	graph.sortEdges();
+	TEST_EQUAL(graph.getEdges()[0].first, 1)
+	TEST_EQUAL(graph.getEdges()[1].first, 2)
+	TEST_EQUAL(graph.getEdges()[2].first, 0)
+}
+END_SECTION
+
+START_SECTION((void clear(Size dimensionsize=0)))
+{
+	SparseDistanceGraph graph(4);
+	graph.addEdge(0, 1, 0.9f);
+	graph.clear(10);
+	TEST_EQUAL(graph.dimensionsize(), 10)
+	TEST_EQUAL(graph.edgeCount(), 0)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
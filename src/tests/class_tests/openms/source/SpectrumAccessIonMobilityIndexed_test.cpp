@@ -0,0 +1,211 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SimpleOpenMSSpectraAccessFactory.h>
+
+///////////////////////////
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessIonMobilityIndexed.h>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+// one frame with ion mobility (m/z sorted, ion mobility scattered), one without
+boost::shared_ptr<PeakMap > getData()
+{
+  boost::shared_ptr<PeakMap > exp(new PeakMap);
+  MSSpectrum spec;
+  DataArrays::FloatDataArray fda;
+  fda.setName("Ion Mobility");
+  for (int k = 0; k < 500; k++)
+  {
+    Peak1D p;
+    p.setMZ(400.0 + k * 0.5);
+    p.setIntensity(1.0 + k);
+    spec.push_back(p);
+    fda.push_back(0.6 + 0.01 * ((k * 37) % 100));
+  }
+  spec.getFloatDataArrays().push_back(fda);
+  spec.setRT(10.0);
+  exp->addSpectrum(spec);
+
+  MSSpectrum spec2;
+  Peak1D p;
+  p.setMZ(500.0);
+  p.setIntensity(50.0);
+  spec2.push_back(p);
+  spec2.setRT(20.0);
+  exp->addSpectrum(spec2);
+  return exp;
+}
+
+// brute force reference: sum of all peaks within the open window
+double bruteForceSum(const OpenSwath::SpectrumPtr& s, double mz_start, double mz_end, double im_start, double im_end)
+{
+  double sum = 0;
+  const std::vector<double>& mz = s->getMZArray()->data;
+  const std::vector<double>& im = s->getDriftTimeArray()->data;
+  for (Size k = 0; k < mz.size(); k++)
+  {
+    if (mz[k] > mz_start && mz[k] < mz_end && im[k] > im_start && im[k] < im_end)
+    {
+      sum += s->getIntensityArray()->data[k];
+    }
+  }
+  return sum;
+}
+
+START_TEST(SpectrumAccessIonMobilityIndexed, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+SpectrumAccessIonMobilityIndexed* ptr = nullptr;
+SpectrumAccessIonMobilityIndexed* nullPointer = nullptr;
+
+boost::shared_ptr<PeakMap > exp = getData();
+OpenSwath::SpectrumAccessPtr expptr = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(exp);
+
+START_SECTION(SpectrumAccessIonMobilityIndexed(OpenSwath::ISpectrumAccess & origin, Size block_size = 128))
+{
+  ptr = new SpectrumAccessIonMobilityIndexed(*expptr, 16);
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->getNrSpectra(), 2)
+  TEST_EXCEPTION(Exception::InvalidParameter, SpectrumAccessIonMobilityIndexed(*expptr, 0))
+}
+END_SECTION
+
+START_SECTION(~SpectrumAccessIonMobilityIndexed())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(bool hasIonMobilityIndex(int id) const)
+{
+  SpectrumAccessIonMobilityIndexed indexed(*expptr);
+  TEST_EQUAL(indexed.hasIonMobilityIndex(0), true)
+  TEST_EQUAL(indexed.hasIonMobilityIndex(1), false)
+}
+END_SECTION
+
+START_SECTION(Size getNrPeaks(int id) const)
+{
+  SpectrumAccessIonMobilityIndexed indexed(*expptr);
+  TEST_EQUAL(indexed.getNrPeaks(0), 500)
+  TEST_EQUAL(indexed.getNrPeaks(1), 1)
+}
+END_SECTION
+
+START_SECTION(double integrateWindow(int id, double mz_start, double mz_end, double im_start, double im_end) const)
+{
+  OpenSwath::SpectrumPtr s = expptr->getSpectrumById(0);
+  for (Size block_size : {1, 7, 16, 1000})
+  {
+    SpectrumAccessIonMobilityIndexed indexed(*expptr, block_size);
+
+    // whole spectrum
+    TEST_REAL_SIMILAR(indexed.integrateWindow(0, 0.0, 1000.0, 0.0, 2.0), 500 * 501 / 2)
+
+    // empty windows
+    TEST_REAL_SIMILAR(indexed.integrateWindow(0, 0.0, 399.0, 0.0, 2.0), 0.0)
+    TEST_REAL_SIMILAR(indexed.integrateWindow(0, 0.0, 1000.0, 1.7, 2.0), 0.0)
+
+    // the window is open: peaks at the border are not included
+    TEST_REAL_SIMILAR(indexed.integrateWindow(0, 400.0, 401.0, 0.0, 2.0), 2.0)
+
+    for (double mz_start = 390.0; mz_start < 660.0; mz_start += 13.3)
+    {
+      for (double im_start = 0.55; im_start < 1.6; im_start += 0.17)
+      {
+        TEST_REAL_SIMILAR(indexed.integrateWindow(0, mz_start, mz_start + 25.0, im_start, im_start + 0.2),
+                          bruteForceSum(s, mz_start, mz_start + 25.0, im_start, im_start + 0.2))
+      }
+    }
+  }
+}
+END_SECTION
+
+START_SECTION(OpenSwath::SpectrumPtr getSpectrumByIdAndWindow(int id, double mz_start, double mz_end, double im_start, double im_end) const)
+{
+  SpectrumAccessIonMobilityIndexed indexed(*expptr, 7);
+  OpenSwath::SpectrumPtr s = expptr->getSpectrumById(0);
+
+  OpenSwath::SpectrumPtr filtered = indexed.getSpectrumByIdAndWindow(0, 450.0, 550.0, 0.8, 1.1);
+  TEST_EQUAL(filtered->getDriftTimeArray().get() != nullptr, true)
+  Size expected_size = 0;
+  for (Size k = 0; k < s->getMZArray()->data.size(); k++)
+  {
+    double mz = s->getMZArray()->data[k];
+    double im = s->getDriftTimeArray()->data[k];
+    if (mz > 450.0 && mz < 550.0 && im > 0.8 && im < 1.1) expected_size++;
+  }
+  TEST_EQUAL(filtered->getMZArray()->data.size(), expected_size)
+  TEST_EQUAL(filtered->getIntensityArray()->data.size(), expected_size)
+  TEST_EQUAL(filtered->getDriftTimeArray()->data.size(), expected_size)
+
+  // result is sorted by m/z and within the window
+  bool ok = true;
+  for (Size k = 0; k < filtered->getMZArray()->data.size(); k++)
+  {
+    double mz = filtered->getMZArray()->data[k];
+    double im = filtered->getDriftTimeArray()->data[k];
+    if (k > 0 && mz < filtered->getMZArray()->data[k - 1]) ok = false;
+    if (!(mz > 450.0 && mz < 550.0 && im > 0.8 && im < 1.1)) ok = false;
+  }
+  TEST_EQUAL(ok, true)
+
+  // spectra without ion mobility are returned unfiltered
+  OpenSwath::SpectrumPtr unfiltered = indexed.getSpectrumByIdAndWindow(1, 450.0, 460.0, 0.8, 1.1);
+  TEST_EQUAL(unfiltered->getMZArray()->data.size(), 1)
+}
+END_SECTION
+
+START_SECTION(boost::shared_ptr<OpenSwath::ISpectrumAccess> lightClone() const)
+{
+  SpectrumAccessIonMobilityIndexed indexed(*expptr, 7);
+  boost::shared_ptr<OpenSwath::ISpectrumAccess> clone = indexed.lightClone();
+  SpectrumAccessIonMobilityIndexed* indexed_clone = dynamic_cast<SpectrumAccessIonMobilityIndexed*>(clone.get());
+  TEST_NOT_EQUAL(indexed_clone, nullPointer)
+  TEST_EQUAL(indexed_clone->getNrSpectra(), 2)
+  TEST_REAL_SIMILAR(indexed_clone->integrateWindow(0, 450.0, 550.0, 0.8, 1.1), indexed.integrateWindow(0, 450.0, 550.0, 0.8, 1.1))
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -38,8 +38,11 @@
 ///////////////////////////
 
 #include <OpenMS/SYSTEM/SysInfo.h>
+#include <OpenMS/SYSTEM/File.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
+#include <fstream>
 #include <iostream>
+#include <vector>
 
 ///////////////////////////
 
@@ -75,4 +78,43 @@ START_SECTION(static bool getProcessMemoryConsumption(size_t& mem_virtual))
 }
 END_SECTION
 
+START_SECTION(static bool getProcessPeakMemoryConsumption(size_t& mem_virtual))
+{
+  size_t first, after;
+  TEST_EQUAL(SysInfo::getProcessPeakMemoryConsumption(first), true);
+  {
+    // touch 50 MB
+    std::vector<char> buffer(50 * 1024 * 1024, 1);
+    TEST_EQUAL(SysInfo::getProcessPeakMemoryConsumption(after), true);
+  }
+  STATUS("Peak memory: " << first << " KB before, " << after << " KB after allocating 50 MB")
+  TEST_EQUAL(after >= first, true)
+  TEST_EQUAL(after > 40000, true)
+}
+END_SECTION
+
+START_SECTION(static bool getProcessIOBytes(size_t& bytes_read, size_t& bytes_written))
+{
+  size_t read_before, written_before, read_after, written_after;
+  // not supported on all OS
+  if (SysInfo::getProcessIOBytes(read_before, written_before))
+  {
+    String filename = File::getTemporaryFile();
+    {
+      std::ofstream os(filename.c_str(), std::ios::binary);
+      std::vector<char> buffer(1024 * 1024, 1);
+      os.write(&buffer[0], buffer.size());
+    }
+    TEST_EQUAL(SysInfo::getProcessIOBytes(read_after, written_after), true);
+    TEST_EQUAL(written_after - written_before >= 1024 * 1024, true)
+    TEST_EQUAL(read_after >= read_before, true)
+  }
+  else
+  {
+    TEST_EQUAL(read_before, 0)
+    TEST_EQUAL(written_before, 0)
+  }
+}
+END_SECTION
+
 END_TEST
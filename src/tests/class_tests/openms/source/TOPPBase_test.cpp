@@ -524,6 +524,9 @@ START_SECTION(([EXTRA]String getStringOption_(const String& name) const))
 	p2.setValue("TOPPBaseTest:1:debug",0,"Sets the debug level");
 	p2.setValue("TOPPBaseTest:1:threads",1, "Sets the number of threads allowed to be used by the TOPP tool");
 	p2.setValue("TOPPBaseTest:1:no_progress","false","Disables progress logging to command line");
+	p2.setValue("TOPPBaseTest:1:profile","","Writes a report of the processing phases");
+	p2.setValue("TOPPBaseTest:1:profile_format","json","Format of the '-profile' report");
+	p2.setValidStrings("TOPPBaseTest:1:profile_format",ListUtils::create<String>("json,chrome_trace"));
 	p2.setValue("TOPPBaseTest:1:force","false","Overwrite tool specific checks.");
 	p2.setValue("TOPPBaseTest:1:test","false","Enables the test mode (needed for software testing only)");
 	//with restriction
@@ -356,6 +356,33 @@ START_SECTION(void getSpectrum(PeakSpectrum& spec, const AASequence& peptide, In
 
 END_SECTION
 
+START_SECTION(static void getPrefixMasses(std::vector<double>& prefix_masses, const AASequence& peptide))
+{
+  vector<double> prefix_masses(42, 1.0); // must be resized
+  AASequence seq = AASequence::fromString("(Acetyl)PEPTM(Oxidation)IDER");
+  TheoreticalSpectrumGenerator::getPrefixMasses(prefix_masses, seq);
+  TEST_EQUAL(prefix_masses.size(), seq.size() + 1)
+  double n_term_mod = seq.getNTerminalModification()->getDiffMonoMass();
+  TEST_REAL_SIMILAR(prefix_masses[0], n_term_mod)
+  for (Size i = 1; i <= seq.size(); ++i)
+  {
+    // internal weight does not include terminal modifications
+    TEST_REAL_SIMILAR(prefix_masses[i], seq.getPrefix(i).getMonoWeight(Residue::Internal) + n_term_mod)
+  }
+
+  // suffix masses follow from the ladder
+  seq = AASequence::fromString("DFPLANGER(Amidated)");
+  TheoreticalSpectrumGenerator::getPrefixMasses(prefix_masses, seq);
+  TEST_EQUAL(prefix_masses.size(), 10)
+  TEST_REAL_SIMILAR(prefix_masses[0], 0.0)
+  TEST_REAL_SIMILAR(prefix_masses[9] - prefix_masses[5], seq.getSuffix(4).getMonoWeight(Residue::Internal))
+
+  TheoreticalSpectrumGenerator::getPrefixMasses(prefix_masses, AASequence());
+  TEST_EQUAL(prefix_masses.size(), 1)
+  TEST_REAL_SIMILAR(prefix_masses[0], 0.0)
+}
+END_SECTION
+
 START_SECTION(([EXTRA] bugfix test where losses lead to formulae with negative element frequencies))
 {
   AASequence tmp_aa = AASequence::fromString("RDAGGPALKK");
@@ -41,6 +41,7 @@
 
 ///////////////////////////
 #include <OpenMS/ANALYSIS/OPENSWATH/TransitionPQPFile.h>
+#include <OpenMS/SYSTEM/File.h>
 ///////////////////////////
 
 using namespace OpenMS;
@@ -81,6 +82,140 @@ START_SECTION( void convertPQPToTargetedExperiment(const char * filename, OpenMS
 }
 END_SECTION
 
+START_SECTION( void convertTSVToPQP(const char* tsv_filename, FileTypes::Type filetype, const char* pqp_filename))
+{
+  // the direct conversion has to give the same library as the conversion through a TargetedExperiment
+  TransitionPQPFile pqp_file;
+  String tsv_in = OPENMS_GET_TEST_DATA_PATH("TransitionTSVFile_input.tsv");
+  String pqp_streamed, pqp_reference;
+  NEW_TMP_FILE(pqp_streamed)
+  NEW_TMP_FILE(pqp_reference)
+
+  pqp_file.convertTSVToPQP(tsv_in.c_str(), FileTypes::TSV, pqp_streamed.c_str());
+
+  TargetedExperiment targeted_exp;
+  pqp_file.convertTSVToTargetedExperiment(tsv_in.c_str(), FileTypes::TSV, targeted_exp);
+  pqp_file.convertTargetedExperimentToPQP(pqp_reference.c_str(), targeted_exp);
+
+  OpenSwath::LightTargetedExperiment exp_streamed, exp_reference;
+  pqp_file.convertPQPToTargetedExperiment(pqp_streamed.c_str(), exp_streamed, true);
+  pqp_file.convertPQPToTargetedExperiment(pqp_reference.c_str(), exp_reference, true);
+
+  TEST_EQUAL(exp_streamed.transitions.size(), 111)
+  TEST_EQUAL(exp_streamed.transitions.size(), exp_reference.transitions.size())
+  TEST_EQUAL(exp_streamed.compounds.size(), exp_reference.compounds.size())
+  TEST_EQUAL(exp_streamed.proteins.size(), exp_reference.proteins.size())
+
+  std::map<std::string, const OpenSwath::LightTransition*> reference_transitions;
+  for (Size i = 0; i < exp_reference.transitions.size(); i++)
+  {
+    reference_transitions[exp_reference.transitions[i].transition_name] = &exp_reference.transitions[i];
+  }
+  for (Size i = 0; i < exp_streamed.transitions.size(); i++)
+  {
+    const OpenSwath::LightTransition& tr = exp_streamed.transitions[i];
+    TEST_EQUAL(reference_transitions.find(tr.transition_name) != reference_transitions.end(), true)
+    if (reference_transitions.find(tr.transition_name) == reference_transitions.end()) continue;
+    const OpenSwath::LightTransition& ref = *reference_transitions[tr.transition_name];
+    TEST_EQUAL(tr.peptide_ref, ref.peptide_ref)
+    TEST_REAL_SIMILAR(tr.precursor_mz, ref.precursor_mz)
+    TEST_REAL_SIMILAR(tr.product_mz, ref.product_mz)
+    TEST_REAL_SIMILAR(tr.library_intensity, ref.library_intensity)
+    TEST_EQUAL(tr.fragment_charge, ref.fragment_charge)
+    TEST_EQUAL(tr.decoy, ref.decoy)
+    TEST_EQUAL(tr.detecting_transition, ref.detecting_transition)
+    TEST_EQUAL(tr.identifying_transition, ref.identifying_transition)
+    TEST_EQUAL(tr.quantifying_transition, ref.quantifying_transition)
+  }
+
+  std::map<std::string, const OpenSwath::LightCompound*> reference_compounds;
+  for (Size i = 0; i < exp_reference.compounds.size(); i++)
+  {
+    reference_compounds[exp_reference.compounds[i].id] = &exp_reference.compounds[i];
+  }
+  for (Size i = 0; i < exp_streamed.compounds.size(); i++)
+  {
+    const OpenSwath::LightCompound& c = exp_streamed.compounds[i];
+    TEST_EQUAL(reference_compounds.find(c.id) != reference_compounds.end(), true)
+    if (reference_compounds.find(c.id) == reference_compounds.end()) continue;
+    const OpenSwath::LightCompound& ref = *reference_compounds[c.id];
+    TEST_EQUAL(c.sequence, ref.sequence)
+    TEST_EQUAL(c.charge, ref.charge)
+    TEST_REAL_SIMILAR(c.rt, ref.rt)
+    TEST_EQUAL(c.peptide_group_label, ref.peptide_group_label)
+    TEST_EQUAL(c.protein_refs.size(), ref.protein_refs.size())
+    TEST_EQUAL(c.modifications.size(), ref.modifications.size())
+  }
+
+  // duplicate transition identifiers are rejected
+  String tsv_duplicate;
+  NEW_TMP_FILE(tsv_duplicate)
+  {
+    std::ifstream in(tsv_in.c_str());
+    std::ofstream out(tsv_duplicate.c_str());
+    std::string line;
+    std::getline(in, line);
+    out << line << "\n";
+    std::getline(in, line);
+    out << line << "\n" << line << "\n";
+  }
+  TEST_EXCEPTION(Exception::IllegalArgument, pqp_file.convertTSVToPQP(tsv_duplicate.c_str(), FileTypes::TSV, pqp_streamed.c_str()))
+  // ... and the incomplete output is removed
+  TEST_EQUAL(File::exists(pqp_streamed), false)
+
+  // a transition group with peptide and compound transitions is rejected (as
+  // it is by validateTargetedExperiment on the way through a TargetedExperiment)
+  String tsv_mixed;
+  NEW_TMP_FILE(tsv_mixed)
+  {
+    std::ifstream in(tsv_in.c_str());
+    std::ofstream out(tsv_mixed.c_str());
+    std::string line;
+    std::getline(in, line);
+    out << line << "\n";
+    std::getline(in, line);
+    out << line << "\n";
+    std::vector<String> fields;
+    String(line).split('\t', fields);
+    fields[10] = "Caffeine"; // CompoundName
+    fields[21] = "mixed_compound_transition"; // TransitionId
+    out << ListUtils::concatenate(fields, "\t") << "\n";
+  }
+  TargetedExperiment mixed_exp;
+  TransitionTSVFile tsv_file;
+  tsv_file.convertTSVToTargetedExperiment(tsv_mixed.c_str(), FileTypes::TSV, mixed_exp);
+  TEST_EXCEPTION(Exception::IllegalArgument, tsv_file.validateTargetedExperiment(mixed_exp))
+  TEST_EXCEPTION(Exception::IllegalArgument, pqp_file.convertTSVToPQP(tsv_mixed.c_str(), FileTypes::TSV, pqp_streamed.c_str()))
+  TEST_EQUAL(File::exists(pqp_streamed), false)
+
+  // small chunks (one transaction each) give the same result as a single chunk,
+  // including precursors and peptide groups that span several chunks
+  String pqp_chunked;
+  NEW_TMP_FILE(pqp_chunked)
+  pqp_file.convertTSVToPQP(tsv_in.c_str(), FileTypes::TSV, pqp_streamed.c_str());
+  pqp_file.convertTSVToPQP(tsv_in.c_str(), FileTypes::TSV, pqp_chunked.c_str(), 7);
+  OpenSwath::LightTargetedExperiment exp_single, exp_chunked;
+  pqp_file.convertPQPToTargetedExperiment(pqp_streamed.c_str(), exp_single, true);
+  pqp_file.convertPQPToTargetedExperiment(pqp_chunked.c_str(), exp_chunked, true);
+  TEST_EQUAL(exp_chunked.transitions.size(), exp_single.transitions.size())
+  TEST_EQUAL(exp_chunked.compounds.size(), exp_single.compounds.size())
+  TEST_EQUAL(exp_chunked.proteins.size(), exp_single.proteins.size())
+  for (Size i = 0; i < std::min(exp_chunked.transitions.size(), exp_single.transitions.size()); i++)
+  {
+    TEST_EQUAL(exp_chunked.transitions[i].transition_name, exp_single.transitions[i].transition_name)
+    TEST_EQUAL(exp_chunked.transitions[i].peptide_ref, exp_single.transitions[i].peptide_ref)
+    TEST_EQUAL(exp_chunked.transitions[i].decoy, exp_single.transitions[i].decoy)
+  }
+  for (Size i = 0; i < std::min(exp_chunked.compounds.size(), exp_single.compounds.size()); i++)
+  {
+    TEST_EQUAL(exp_chunked.compounds[i].id, exp_single.compounds[i].id)
+    TEST_EQUAL(exp_chunked.compounds[i].sequence, exp_single.compounds[i].sequence)
+    TEST_EQUAL(exp_chunked.compounds[i].peptide_group_label, exp_single.compounds[i].peptide_group_label)
+    TEST_EQUAL(exp_chunked.compounds[i].protein_refs.size(), exp_single.compounds[i].protein_refs.size())
+  }
+}
+END_SECTION
+
 START_SECTION( void validateTargetedExperiment(OpenMS::TargetedExperiment & targeted_exp))
 {
   NOT_TESTABLE
@@ -81,6 +81,76 @@ START_SECTION( void convertTSVToTargetedExperiment(const char * filename, OpenMS
 }
 END_SECTION
 
+START_SECTION( void convertTSVToTargetedExperiment(const char * filename, FileTypes::Type filetype, OpenSwath::LightTargetedExperiment & targeted_exp))
+{
+  // the light experiment is read chunk by chunk, it has to match the full one
+  TransitionTSVFile tsv_file;
+  String tsv_in = OPENMS_GET_TEST_DATA_PATH("TransitionTSVFile_input.tsv");
+
+  TargetedExperiment targeted_exp;
+  OpenSwath::LightTargetedExperiment light_exp;
+  tsv_file.convertTSVToTargetedExperiment(tsv_in.c_str(), FileTypes::TSV, targeted_exp);
+  tsv_file.convertTSVToTargetedExperiment(tsv_in.c_str(), FileTypes::TSV, light_exp);
+
+  TEST_EQUAL(targeted_exp.getTransitions().size(), 111)
+  TEST_EQUAL(light_exp.getTransitions().size(), targeted_exp.getTransitions().size())
+  TEST_EQUAL(light_exp.getCompounds().size(), targeted_exp.getPeptides().size() + targeted_exp.getCompounds().size())
+  TEST_EQUAL(light_exp.getProteins().size(), targeted_exp.getProteins().size())
+
+  // transitions are grouped by compound
+  TEST_EQUAL(light_exp.hasCompoundTransitionIndex(), true)
+  for (Size c = 0; c < light_exp.compounds.size(); c++)
+  {
+    for (Size i = light_exp.compound_transition_offsets[c]; i < light_exp.compound_transition_offsets[c + 1]; i++)
+    {
+      TEST_EQUAL(light_exp.transitions[i].peptide_ref, light_exp.compounds[c].id)
+    }
+  }
+
+  // interleaved compounds: the transitions are moved next to the first
+  // transition of their compound, keeping the order within each compound
+  String tsv_interleaved;
+  NEW_TMP_FILE(tsv_interleaved)
+  {
+    std::ifstream in(tsv_in.c_str());
+    std::ofstream out(tsv_interleaved.c_str());
+    std::string header, line_a, line_b;
+    std::getline(in, header);
+    std::getline(in, line_a);
+    std::getline(in, line_b);
+    std::vector<String> fields_a, fields_b;
+    String(line_a).split('\t', fields_a);
+    String(line_b).split('\t', fields_b);
+    TEST_NOT_EQUAL(fields_a[20], fields_b[20]) // TransitionGroupId
+    out << header << "\n";
+    const char* names[] = {"a0", "b0", "a1", "b1", "a2"};
+    for (Size i = 0; i < 5; i++)
+    {
+      std::vector<String>& fields = names[i][0] == 'a' ? fields_a : fields_b;
+      fields[21] = names[i]; // TransitionId
+      out << ListUtils::concatenate(fields, "\t") << "\n";
+    }
+  }
+  OpenSwath::LightTargetedExperiment interleaved_exp;
+  tsv_file.convertTSVToTargetedExperiment(tsv_interleaved.c_str(), FileTypes::TSV, interleaved_exp);
+  TEST_EQUAL(interleaved_exp.transitions.size(), 5)
+  TEST_EQUAL(interleaved_exp.compounds.size(), 2)
+  TEST_EQUAL(interleaved_exp.hasCompoundTransitionIndex(), true)
+  ABORT_IF(interleaved_exp.transitions.size() != 5 || interleaved_exp.compounds.size() != 2)
+  const char* grouped_names[] = {"a0", "a1", "a2", "b0", "b1"};
+  for (Size i = 0; i < 5; i++)
+  {
+    TEST_EQUAL(interleaved_exp.transitions[i].transition_name, grouped_names[i])
+  }
+  TEST_EQUAL(interleaved_exp.compounds[0].id, interleaved_exp.transitions[0].peptide_ref)
+  TEST_EQUAL(interleaved_exp.compounds[1].id, interleaved_exp.transitions[3].peptide_ref)
+  TEST_EQUAL(interleaved_exp.compound_transition_offsets.size(), 3)
+  TEST_EQUAL(interleaved_exp.compound_transition_offsets[0], 0)
+  TEST_EQUAL(interleaved_exp.compound_transition_offsets[1], 3)
+  TEST_EQUAL(interleaved_exp.compound_transition_offsets[2], 5)
+}
+END_SECTION
+
 START_SECTION( void validateTargetedExperiment(OpenMS::TargetedExperiment & targeted_exp))
 {
   NOT_TESTABLE
@@ -0,0 +1,215 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/VISUAL/OnDiscSpectrumCache.h>
+
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(OnDiscSpectrumCache, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+// two MS1 spectra (19914 and 19800 peaks), the meta data only is in memory
+OnDiscMSExperiment on_disc;
+on_disc.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
+boost::shared_ptr<PeakMap> peaks = on_disc.getMetaData();
+MSSpectrum first = on_disc.getSpectrum(0);
+MSSpectrum second = on_disc.getSpectrum(1);
+
+OnDiscSpectrumCache* ptr = nullptr;
+OnDiscSpectrumCache* nullPointer = nullptr;
+START_SECTION((OnDiscSpectrumCache(const OnDiscMSExperiment& on_disc, const boost::shared_ptr<PeakMap>& peaks, Size max_peaks)))
+{
+  ptr = new OnDiscSpectrumCache(on_disc, peaks, 100000);
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->getLoadedPeakCount(), 0)
+  TEST_EQUAL(ptr->getMaxPeakCount(), 100000)
+  TEST_EQUAL(ptr->isLoaded(0), false)
+}
+END_SECTION
+
+START_SECTION((~OnDiscSpectrumCache()))
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((void request(const std::vector<Size>& needed, const std::vector<Size>& prefetch = std::vector<Size>())))
+{
+  OnDiscSpectrumCache cache(on_disc, peaks, 100000);
+  cache.request(vector<Size>(1, 1));
+  cache.waitForRequests();
+  TEST_EQUAL(cache.transferLoaded(), true)
+  TEST_EQUAL(cache.isLoaded(0), false)
+  TEST_EQUAL(cache.isLoaded(1), true)
+  TEST_EQUAL((*peaks)[0].size(), 0)
+  TEST_EQUAL((*peaks)[1].size(), second.size())
+
+  // needed and prefetched spectra
+  cache.request(vector<Size>(1, 1), vector<Size>(1, 0));
+  cache.waitForRequests();
+  TEST_EQUAL(cache.transferLoaded(), true)
+  TEST_EQUAL(cache.isLoaded(0), true)
+  TEST_EQUAL(cache.getLoadedPeakCount(), first.size() + second.size())
+}
+END_SECTION
+
+START_SECTION((bool transferLoaded()))
+{
+  OnDiscSpectrumCache cache(on_disc, peaks, 100000);
+  // spectra in memory count as loaded
+  TEST_EQUAL(cache.isLoaded(0), true)
+  TEST_EQUAL(cache.transferLoaded(), false)
+
+  for (Size i = 0; i < peaks->size(); ++i)
+  {
+    (*peaks)[i].clear(false);
+  }
+  OnDiscSpectrumCache cache2(on_disc, peaks, 100000);
+  cache2.request(vector<Size>(1, 0));
+  cache2.waitForRequests();
+  TEST_EQUAL(cache2.transferLoaded(), true)
+  TEST_EQUAL((*peaks)[0].size(), first.size())
+  TEST_REAL_SIMILAR((*peaks)[0][0].getMZ(), first[0].getMZ())
+  TEST_REAL_SIMILAR((*peaks)[0][0].getIntensity(), first[0].getIntensity())
+  TEST_REAL_SIMILAR((*peaks)[0].back().getMZ(), first.back().getMZ())
+  TEST_REAL_SIMILAR((*peaks)[0].getRT(), first.getRT())
+  TEST_EQUAL(cache2.transferLoaded(), false)
+}
+END_SECTION
+
+START_SECTION((void waitForRequests()))
+{
+  // tested above
+  NOT_TESTABLE
+}
+END_SECTION
+
+START_SECTION((bool isLoaded(Size index) const))
+{
+  OnDiscSpectrumCache cache(on_disc, peaks, 100000);
+  TEST_EQUAL(cache.isLoaded(0), true)
+  TEST_EQUAL(cache.isLoaded(1), false)
+  TEST_EQUAL(cache.isLoaded(2), false)
+}
+END_SECTION
+
+START_SECTION((Size getLoadedPeakCount() const))
+{
+  // limit for one spectrum only: the least recently requested one is removed
+  for (Size i = 0; i < peaks->size(); ++i)
+  {
+    (*peaks)[i].clear(false);
+  }
+  OnDiscSpectrumCache cache(on_disc, peaks, 30000);
+  cache.request(vector<Size>(1, 0));
+  cache.waitForRequests();
+  cache.transferLoaded();
+  TEST_EQUAL(cache.getLoadedPeakCount(), first.size())
+
+  cache.request(vector<Size>(1, 1));
+  cache.waitForRequests();
+  cache.transferLoaded();
+  TEST_EQUAL(cache.getLoadedPeakCount(), second.size())
+  TEST_EQUAL(cache.isLoaded(0), false)
+  TEST_EQUAL(cache.isLoaded(1), true)
+  TEST_EQUAL((*peaks)[0].size(), 0)
+  TEST_EQUAL((*peaks)[1].size(), second.size())
+
+  // needed spectra are kept even if they exceed the limit
+  OnDiscSpectrumCache small(on_disc, peaks, 100);
+  TEST_EQUAL(small.getLoadedPeakCount(), second.size())
+  small.request(vector<Size>(1, 1));
+  small.waitForRequests();
+  small.transferLoaded();
+  TEST_EQUAL(small.isLoaded(1), true)
+}
+END_SECTION
+
+START_SECTION(([EXTRA] repeating a request does not reload spectra if the limit is exceeded))
+{
+  for (Size i = 0; i < peaks->size(); ++i)
+  {
+    (*peaks)[i].clear(false);
+  }
+  // limit for one spectrum only, the prefetched one does not fit
+  OnDiscSpectrumCache cache(on_disc, peaks, 30000);
+
+  // sizes are unknown at first: both spectra are requested and kept (pinned)
+  cache.request(vector<Size>(1, 1), vector<Size>(1, 0));
+  cache.waitForRequests();
+  TEST_EQUAL(cache.transferLoaded(), true)
+  TEST_EQUAL(cache.isLoaded(0), true)
+  TEST_EQUAL(cache.isLoaded(1), true)
+
+  // the same request (e.g. a repaint) now knows the sizes and drops the prefetched spectrum
+  cache.request(vector<Size>(1, 1), vector<Size>(1, 0));
+  cache.waitForRequests();
+  TEST_EQUAL(cache.transferLoaded(), false)
+  TEST_EQUAL(cache.isLoaded(0), false)
+  TEST_EQUAL(cache.isLoaded(1), true)
+  TEST_EQUAL(cache.getLoadedPeakCount(), second.size())
+
+  // ... and does not load it again (no load/evict/repaint cycle)
+  for (Size k = 0; k < 3; ++k)
+  {
+    cache.request(vector<Size>(1, 1), vector<Size>(1, 0));
+    cache.waitForRequests();
+    TEST_EQUAL(cache.transferLoaded(), false)
+    TEST_EQUAL(cache.isLoaded(0), false)
+    TEST_EQUAL(cache.getLoadedPeakCount(), second.size())
+  }
+}
+END_SECTION
+
+START_SECTION((Size getMaxPeakCount() const))
+{
+  OnDiscSpectrumCache cache(on_disc, peaks, 42);
+  TEST_EQUAL(cache.getMaxPeakCount(), 42)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -0,0 +1,227 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/VISUAL/PeakMapTilePyramid.h>
+
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(PeakMapTilePyramid, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+PeakMapTilePyramid* ptr = nullptr;
+PeakMapTilePyramid* nullPointer = nullptr;
+START_SECTION((PeakMapTilePyramid()))
+{
+  ptr = new PeakMapTilePyramid();
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->empty(), true)
+  TEST_EQUAL(ptr->getLevelCount(), 0)
+}
+END_SECTION
+
+START_SECTION((~PeakMapTilePyramid()))
+{
+  delete ptr;
+}
+END_SECTION
+
+// 8 MS1 scans at RT 0..70 with peaks at m/z 100..170, one MS2 scan in between
+MSExperiment exp;
+for (Size s = 0; s < 8; ++s)
+{
+  MSSpectrum spec;
+  spec.setMSLevel(1);
+  spec.setRT(s * 10.0);
+  for (Size p = 0; p < 8; ++p)
+  {
+    Peak1D peak;
+    peak.setMZ(100.0 + p * 10.0);
+    peak.setIntensity(float(s * 8 + p));
+    spec.push_back(peak);
+  }
+  exp.addSpectrum(spec);
+
+  if (s == 3)
+  {
+    MSSpectrum ms2;
+    ms2.setMSLevel(2);
+    ms2.setRT(35.0);
+    Peak1D peak;
+    peak.setMZ(500.0);
+    peak.setIntensity(1000.0);
+    ms2.push_back(peak);
+    exp.addSpectrum(ms2);
+  }
+}
+
+START_SECTION((void build(const MSExperiment& map, Size max_bins = 1 << 23, Size min_bins = 64, const std::atomic<bool>* cancel = nullptr)))
+{
+  PeakMapTilePyramid pyramid;
+  pyramid.build(exp, 64, 2);
+  TEST_EQUAL(pyramid.empty(), false)
+  TEST_REAL_SIMILAR(pyramid.getMinRT(), 0.0)
+  TEST_REAL_SIMILAR(pyramid.getMinMZ(), 100.0)
+  // 8x8, 4x4, 2x2
+  TEST_EQUAL(pyramid.getLevelCount(), 3)
+
+  const PeakMapTilePyramid::Level& fine = pyramid.getLevel(0);
+  TEST_EQUAL(fine.rt_bins, 8)
+  TEST_EQUAL(fine.mz_bins, 8)
+  TEST_REAL_SIMILAR(fine.rt_bin_width, 70.0 / 8)
+  TEST_REAL_SIMILAR(fine.mz_bin_width, 70.0 / 8)
+  // MS2 peaks are ignored
+  float max_fine = -1.0;
+  for (Size rt = 0; rt < fine.rt_bins; ++rt)
+  {
+    for (Size mz = 0; mz < fine.mz_bins; ++mz)
+    {
+      max_fine = std::max(max_fine, fine.getMaxIntensity(rt, mz));
+    }
+  }
+  TEST_REAL_SIMILAR(max_fine, 63.0)
+  TEST_REAL_SIMILAR(fine.getMaxIntensity(0, 0), 0.0)
+  TEST_REAL_SIMILAR(fine.getMaxIntensity(2, 5), 21.0)
+  TEST_REAL_SIMILAR(fine.getMaxIntensity(7, 7), 63.0)
+  // one peak per bin: sum and maximum agree
+  TEST_REAL_SIMILAR(fine.getSumIntensity(2, 5), 21.0)
+  TEST_REAL_SIMILAR(fine.getSumIntensity(7, 7), 63.0)
+
+  const PeakMapTilePyramid::Level& coarse = pyramid.getLevel(2);
+  TEST_EQUAL(coarse.rt_bins, 2)
+  TEST_EQUAL(coarse.mz_bins, 2)
+  TEST_REAL_SIMILAR(coarse.rt_bin_width, 70.0 / 2)
+  TEST_REAL_SIMILAR(coarse.getMaxIntensity(0, 0), 27.0)
+  TEST_REAL_SIMILAR(coarse.getMaxIntensity(0, 1), 31.0)
+  TEST_REAL_SIMILAR(coarse.getMaxIntensity(1, 0), 59.0)
+  TEST_REAL_SIMILAR(coarse.getMaxIntensity(1, 1), 63.0)
+  // 16 peaks per bin, the MS2 peak is not included
+  TEST_REAL_SIMILAR(coarse.getSumIntensity(0, 0), 216.0)
+  TEST_REAL_SIMILAR(coarse.getSumIntensity(0, 1), 280.0)
+  TEST_REAL_SIMILAR(coarse.getSumIntensity(1, 0), 728.0)
+  TEST_REAL_SIMILAR(coarse.getSumIntensity(1, 1), 792.0)
+
+  // fewer bins than scans: RT gets at most sqrt(max_bins) bins
+  pyramid.build(exp, 16, 2);
+  TEST_EQUAL(pyramid.getLevel(0).rt_bins, 4)
+  TEST_EQUAL(pyramid.getLevel(0).mz_bins, 4)
+  TEST_REAL_SIMILAR(pyramid.getLevel(0).getMaxIntensity(1, 2), 29.0)
+  TEST_REAL_SIMILAR(pyramid.getLevel(0).getSumIntensity(1, 2), 98.0)
+
+  // cancelled build
+  std::atomic<bool> cancel(true);
+  pyramid.build(exp, 64, 2, &cancel);
+  TEST_EQUAL(pyramid.empty(), true)
+  cancel = false;
+  pyramid.build(exp, 64, 2, &cancel);
+  TEST_EQUAL(pyramid.getLevelCount(), 3)
+
+  // no MS1 data
+  MSExperiment empty;
+  pyramid.build(empty);
+  TEST_EQUAL(pyramid.empty(), true)
+}
+END_SECTION
+
+START_SECTION((Size findLevel(double rt_resolution, double mz_resolution) const))
+{
+  PeakMapTilePyramid pyramid;
+  TEST_EQUAL(pyramid.findLevel(1.0, 1.0), 0)
+  pyramid.build(exp, 64, 2);
+  // bin widths: 8.75 (level 0), 17.5 (level 1), 35 (level 2)
+  TEST_EQUAL(pyramid.findLevel(100.0, 100.0), 2)
+  TEST_EQUAL(pyramid.findLevel(20.0, 100.0), 1)
+  TEST_EQUAL(pyramid.findLevel(100.0, 9.0), 0)
+  TEST_EQUAL(pyramid.findLevel(1.0, 100.0), 3)
+}
+END_SECTION
+
+START_SECTION((void clear()))
+{
+  PeakMapTilePyramid pyramid;
+  pyramid.build(exp, 64, 2);
+  pyramid.clear();
+  TEST_EQUAL(pyramid.empty(), true)
+  TEST_EQUAL(pyramid.getLevelCount(), 0)
+}
+END_SECTION
+
+START_SECTION((const Level& getLevel(Size index) const))
+{
+  // tested above
+  NOT_TESTABLE
+}
+END_SECTION
+
+START_SECTION((double getMinRT() const))
+{
+  // tested above
+  NOT_TESTABLE
+}
+END_SECTION
+
+START_SECTION((double getMinMZ() const))
+{
+  // tested above
+  NOT_TESTABLE
+}
+END_SECTION
+
+START_SECTION((Size getLevelCount() const))
+{
+  // tested above
+  NOT_TESTABLE
+}
+END_SECTION
+
+START_SECTION((bool empty() const))
+{
+  // tested above
+  NOT_TESTABLE
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -0,0 +1,146 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/VISUAL/TOPPASScene.h>
+
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+typedef TOPPASScene::TOPPProcess TOPPProcess;
+
+// a process with the given number of threads and memory (no QProcess or tool needed for scheduling)
+TOPPProcess makeProcess(const QString& name, int threads, Size memory = 0)
+{
+  return TOPPProcess(nullptr, name, QStringList(), nullptr, threads, memory);
+}
+
+START_TEST(TOPPASScene, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+START_SECTION((static bool fitsResources(const TOPPProcess & process, const QList<TOPPProcess> & running, int allowed_threads, Size allowed_memory)))
+{
+  QList<TOPPProcess> running;
+  // anything fits if nothing is running, even if it exceeds the budget on its own
+  TEST_EQUAL(TOPPASScene::fitsResources(makeProcess("a", 2), running, 4, 0), true)
+  TEST_EQUAL(TOPPASScene::fitsResources(makeProcess("a", 8, 2000), running, 4, 1000), true)
+
+  // thread budget
+  running << makeProcess("r", 3);
+  TEST_EQUAL(TOPPASScene::fitsResources(makeProcess("a", 1), running, 4, 0), true)
+  TEST_EQUAL(TOPPASScene::fitsResources(makeProcess("a", 2), running, 4, 0), false)
+  TEST_EQUAL(TOPPASScene::fitsResources(makeProcess("a", 8), running, 4, 0), false)
+
+  // memory budget (0 = unlimited)
+  running.clear();
+  running << makeProcess("r", 1, 600);
+  TEST_EQUAL(TOPPASScene::fitsResources(makeProcess("a", 1, 400), running, 4, 1000), true)
+  TEST_EQUAL(TOPPASScene::fitsResources(makeProcess("a", 1, 500), running, 4, 1000), false)
+  TEST_EQUAL(TOPPASScene::fitsResources(makeProcess("a", 1, 500), running, 4, 0), true)
+}
+END_SECTION
+
+START_SECTION((static int selectNextProcess(const QList<TOPPProcess> & pending, const QList<int> & critical_path_lengths, const QList<TOPPProcess> & running, int allowed_threads, Size allowed_memory)))
+{
+  QList<TOPPProcess> pending, running;
+  QList<int> lengths;
+  TEST_EQUAL(TOPPASScene::selectNextProcess(pending, lengths, running, 4, 0), -1)
+
+  // longest critical path first, the first one enqueued on ties
+  pending << makeProcess("a", 1) << makeProcess("b", 1) << makeProcess("c", 1);
+  lengths << 1 << 3 << 3;
+  TEST_EQUAL(TOPPASScene::selectNextProcess(pending, lengths, running, 4, 0), 1)
+
+  // a process that does not fit is skipped (smaller ones backfill)
+  pending.clear();
+  lengths.clear();
+  pending << makeProcess("a", 1) << makeProcess("b", 4);
+  lengths << 1 << 5;
+  running << makeProcess("r", 2);
+  TEST_EQUAL(TOPPASScene::selectNextProcess(pending, lengths, running, 4, 0), 0)
+  pending.removeAt(0);
+  lengths.removeAt(0);
+  TEST_EQUAL(TOPPASScene::selectNextProcess(pending, lengths, running, 4, 0), -1)
+
+  // admission order of a whole queue: run all processes which fit, finish
+  // the oldest running one when nothing else fits
+  pending.clear();
+  lengths.clear();
+  running.clear();
+  pending << makeProcess("A", 2) << makeProcess("B", 1) << makeProcess("C", 4) << makeProcess("D", 1) << makeProcess("E", 8);
+  lengths << 1 << 3 << 2 << 1 << 1;
+  QStringList order;
+  QList<int> max_threads; // threads in use after each start
+  while (!pending.empty())
+  {
+    int next = TOPPASScene::selectNextProcess(pending, lengths, running, 4, 0);
+    if (next == -1)
+    {
+      TEST_EQUAL(running.empty(), false)
+      running.removeFirst();
+      continue;
+    }
+    order << pending[next].command;
+    running << pending.takeAt(next);
+    lengths.removeAt(next);
+    int threads = 0;
+    for (int i = 0; i < running.size(); ++i)
+    {
+      threads += running[i].threads;
+    }
+    max_threads << threads;
+  }
+  // B has the longest critical path, C (4 threads) waits while A and D backfill,
+  // E exceeds the budget on its own and runs alone
+  TEST_EQUAL(order.join(",").toStdString(), "B,A,D,C,E")
+  TEST_EQUAL(max_threads[0], 1)
+  TEST_EQUAL(max_threads[1], 3)
+  TEST_EQUAL(max_threads[2], 4)
+  TEST_EQUAL(max_threads[3], 4)
+  TEST_EQUAL(max_threads[4], 8)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
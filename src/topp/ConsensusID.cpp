@@ -250,7 +250,11 @@ protected:
       id_mapping[input_map.getProteinIdentifications()[i].getIdentifier()] = i;
     }
 
-    // compute consensus:
+    // compute consensus (for all features at once):
+    vector<vector<PeptideIdentification>*> ids_list;
+    vector<Size> runs_list;
+    ids_list.reserve(input_map.size());
+    runs_list.reserve(input_map.size());
     for (typename MapType::Iterator map_it = input_map.begin();
          map_it != input_map.end(); ++map_it)
     {
@@ -263,8 +267,10 @@ protected:
       }
       Size n_repeats = *max_element(times_seen.begin(), times_seen.end());
 
-      consensus->apply(ids, number_of_runs * n_repeats);
+      ids_list.push_back(&ids);
+      runs_list.push_back(number_of_runs * n_repeats);
     }
+    consensus->apply(ids_list, runs_list);
 
     // create new identification run:
     setProteinIdentifications_(input_map.getProteinIdentifications());
@@ -375,12 +381,20 @@ protected:
       ConsensusMap grouping;
       linker.group(maps, grouping);
 
-      // compute consensus
+      // compute consensus (for all spectra at once):
+      vector<vector<PeptideIdentification>*> ids_list;
+      ids_list.reserve(grouping.size());
+      for (ConsensusMap::Iterator it = grouping.begin(); it != grouping.end();
+           ++it)
+      {
+        ids_list.push_back(&(it->getPeptideIdentifications()));
+      }
+      consensus->apply(ids_list, vector<Size>(ids_list.size(), prot_ids.size()));
+
       pep_ids.clear();
       for (ConsensusMap::Iterator it = grouping.begin(); it != grouping.end();
            ++it)
       {
-        consensus->apply(it->getPeptideIdentifications(), prot_ids.size());
         if (!it->getPeptideIdentifications().empty())
         {
           PeptideIdentification& pep_id = it->getPeptideIdentifications()[0];
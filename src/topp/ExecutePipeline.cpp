@@ -58,6 +58,10 @@ using namespace std;
   In order to really use this tool in batch-mode, you can provide a TOPPAS resource file (.trf) which specifies the
   input files for the input nodes in your pipeline.
 
+  Independent branches of the pipeline and the rounds of a node (one per input file) are run in parallel, as long as
+  the threads of all running tools (see @p num_jobs) and their memory estimated from the size of their input (see
+  @p max_memory) stay within the given limits. Tools on the longest remaining chain of the pipeline are started first.
+
   <B> *.trf files </B>
 
  A TOPPAS resource file (<TT>*.trf</TT>) specifies the locations of input files for a pipeline.
@@ -108,8 +112,10 @@ protected:
     setValidFormats_("in", ListUtils::create<String>("toppas"));
     registerStringOption_("out_dir", "<directory>", "", "Directory for output files (default: user's home directory)", false);
     registerStringOption_("resource_file", "<file>", "", "A TOPPAS resource file (*.trf) specifying the files this workflow is to be applied to", false);
-    registerIntOption_("num_jobs", "<integer>", 1, "Maximum number of jobs running in parallel", false, false);
+    registerIntOption_("num_jobs", "<integer>", 1, "Maximum number of threads used by all jobs running in parallel (a job uses as many threads as its 'threads' parameter specifies; a job requiring more threads is run alone)", false, false);
     setMinInt_("num_jobs", 1);
+    registerIntOption_("max_memory", "<MB>", 0, "Maximum memory (in MB) of all jobs running in parallel, estimated from the size of their input files (0 = unlimited)", false, true);
+    setMinInt_("max_memory", 0);
   }
 
   ExitCodes main_(int argc, const char ** argv) override
@@ -118,6 +124,7 @@ protected:
     QString out_dir_name = getStringOption_("out_dir").toQString();
     QString resource_file = getStringOption_("resource_file").toQString();
     int num_jobs = getIntOption_("num_jobs");
+    int max_memory = getIntOption_("max_memory");
 
     QApplication a(argc, const_cast<char **>(argv), false);
 
@@ -137,6 +144,7 @@ protected:
 
     ts.load(toppas_file);
     ts.setAllowedThreads(num_jobs);
+    ts.setAllowedMemory(max_memory);
 
     if (resource_file != "")
     {
@@ -37,6 +37,8 @@
 #include <OpenMS/MATH/STATISTICS/PosteriorErrorProbabilityModel.h>
 #include <OpenMS/FORMAT/IdXMLFile.h>
 
+#include <memory>
+
 using namespace OpenMS;
 using namespace Math; //PosteriorErrorProbabilityModel
 using namespace std;
@@ -81,6 +83,9 @@ using namespace std;
     If parameter @p top_hits_only is set, only the top hits of each peptide identification are used for the estimation process.
     Additionally, if 'top_hits_only' is set, target/decoy information is available and a @ref TOPP_FalseDiscoveryRate run was performed previously, an additional plot will be generated with target and decoy bins ('out_plot' must not be empty).
     A peptide hit is assumed to be a target if its q-value is smaller than @p fdr_for_targets_smaller.
+
+    The models for the different search engines (and charge states, if @p split_charge is set) are independent of each other and are fitted concurrently (unless plots are requested).
+    For very large data sets, the fit can be restricted to a deterministic subsample of the scores (see @p fit_algorithm:fit_subsample_size); all PSMs are scored afterwards.
     The plots are saved as a Gnuplot file. An attempt is made to call Gnuplot, which will create a PDF file containing all steps of the estimation. If this fails, the user has to run Gnuplot manually - or adjust the PATH environment such that Gnuplot can be found and retry.
 
     @note Currently mzIdentML (mzid) is not directly supported as an input/output format of this tool. Convert mzid files to/from idXML using @ref TOPP_IDFileConverter if necessary.
@@ -167,8 +172,6 @@ protected:
     vector<ProteinIdentification> protein_ids;
     vector<PeptideIdentification> peptide_ids;
     file.load(inputfile_name, protein_ids, peptide_ids);
-    PosteriorErrorProbabilityModel PEP_model;
-    PEP_model.setParameters(fit_algorithm);
     //-------------------------------------------------------------
     // calculations
     //-------------------------------------------------------------
@@ -205,46 +208,67 @@ protected:
 
     String out_plot = fit_algorithm.getValue("out_plot").toString().trim();
 
-    for (auto & score : all_scores)
+    // the models are independent of each other: fit them concurrently, each with its own model instance
+    vector<map<String, vector<vector<double> > >::iterator> fit_jobs;
+    for (auto it = all_scores.begin(); it != all_scores.end(); ++it) { fit_jobs.push_back(it); }
+    vector<String> engines(fit_jobs.size());
+    vector<Int> charges(fit_jobs.size(), -1);
+    vector<std::unique_ptr<PosteriorErrorProbabilityModel> > PEP_models(fit_jobs.size());
+    vector<bool> fit_ok(fit_jobs.size(), false);
+
+    // plots of different models may share a file name, so plotting forces serial fitting
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1) if (out_plot.empty())
+#endif
+    for (SignedSize i = 0; i < (SignedSize)fit_jobs.size(); ++i)
     {
       vector<String> engine_info;
-      score.first.split(',', engine_info);
-      String engine = engine_info[0];
-      Int charge = (engine_info.size() == 2) ? engine_info[1].toInt() : -1;
+      fit_jobs[i]->first.split(',', engine_info);
+      engines[i] = engine_info[0];
+      charges[i] = (engine_info.size() == 2) ? engine_info[1].toInt() : -1;
 
+      Param model_param = fit_algorithm;
       if (split_charge)
       {
         // only adapt plot output if plot is requested (this badly violates the output rules and needs to change!)
         // one way to fix this: plot charges into a single file (no renaming of output file needed) - but this requires major code restructuring
-        if (!out_plot.empty()) fit_algorithm.setValue("out_plot", out_plot + "_charge_" + String(charge));
-        PEP_model.setParameters(fit_algorithm);
+        if (!out_plot.empty()) model_param.setValue("out_plot", out_plot + "_charge_" + String(charges[i]));
       }
+      PEP_models[i].reset(new PosteriorErrorProbabilityModel());
+      PEP_models[i]->setParameters(model_param);
 
       // fit to score vector
-      bool return_value = PEP_model.fit(score.second[0]);
+      fit_ok[i] = PEP_models[i]->fit(fit_jobs[i]->second[0]);
+    }
+
+    // report and update the scores in a fixed order
+    for (Size i = 0; i < fit_jobs.size(); ++i)
+    {
+      const String& engine = engines[i];
+      vector<vector<double> >& scores = fit_jobs[i]->second;
 
-      if (!return_value) 
+      if (!fit_ok[i])
       {
         writeLog_("Unable to fit data. Algorithm did not run through for the following search engine: " + engine);
         if (!ignore_bad_data) { return UNEXPECTED_RESULT; }
       }
 
-      if (return_value)
+      if (fit_ok[i])
       {
         // plot target_decoy
         if (!out_plot.empty() 
          && top_hits_only 
          && target_decoy_available 
-         && (!score.second[0].empty()))
+         && (!scores[0].empty()))
         {
-          PEP_model.plotTargetDecoyEstimation(score.second[1], score.second[2]); //target, decoy
+          PEP_models[i]->plotTargetDecoyEstimation(scores[1], scores[2]); //target, decoy
         }
         
         bool unable_to_fit_data(true), data_might_not_be_well_fit(true);
         PosteriorErrorProbabilityModel::updateScores(
-         PEP_model,
+         *PEP_models[i],
          engine,
-         charge,
+         charges[i],
          prob_correct,
          split_charge,
          protein_ids,
@@ -38,6 +38,7 @@
 #include <OpenMS/FORMAT/PeakTypeEstimator.h>
 
 #include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataPickingConsumer.h>
 
 using namespace OpenMS;
 using namespace std;
@@ -124,44 +125,6 @@ public:
 
 protected:
 
-  /**
-    @brief Helper class for the Low Memory peak-picking
-  */
-  class PPHiResMzMLConsumer :
-    public MSDataWritingConsumer
-  {
-
-  public:
-
-    PPHiResMzMLConsumer(String filename, const PeakPickerHiRes& pp) :
-      MSDataWritingConsumer(filename),
-      ms_levels_(pp.getParameters().getValue("ms_levels").toIntList())
-    {
-      pp_ = pp;
-    }
-
-    void processSpectrum_(MapType::SpectrumType& s) override
-    {
-      if (!ListUtils::contains(ms_levels_, s.getMSLevel())) {return;}
-
-      MapType::SpectrumType sout;
-      pp_.pick(s, sout);
-      s = sout;  // todo: swap? (requires implementation)
-    }
-
-    void processChromatogram_(MapType::ChromatogramType & c) override
-    {
-      MapType::ChromatogramType c_out;
-      pp_.pick(c, c_out);
-      c = c_out;
-    }
-
-  private:
-
-    PeakPickerHiRes pp_;
-    std::vector<Int> ms_levels_;
-  };
-
   void registerOptionsAndFlags_() override
   {
     registerInputFile_("in", "<file>", "", "input profile data file ");
@@ -183,10 +146,13 @@ protected:
   ExitCodes doLowMemAlgorithm(const PeakPickerHiRes& pp)
   {
     ///////////////////////////////////
-    // Create the consumer object, add data processing
+    // Create the consumer objects, add data processing
     ///////////////////////////////////
-    PPHiResMzMLConsumer pp_consumer(out, pp);
-    pp_consumer.addDataProcessing(getProcessingInfo_(DataProcessing::PEAK_PICKING));
+    PlainMSDataWritingConsumer writer(out);
+    writer.addDataProcessing(getProcessingInfo_(DataProcessing::PEAK_PICKING));
+
+    // picks batches of spectra in parallel before they are written
+    MSDataPickingConsumer pp_consumer(&writer, pp, 1000, !getFlag_("force"));
 
     ///////////////////////////////////
     // Create new MSDataReader and set our consumer
@@ -194,6 +160,7 @@ protected:
     MzMLFile mz_data_file;
     mz_data_file.setLogType(log_type_);
     mz_data_file.transform(in, &pp_consumer);
+    pp_consumer.flush();
 
     return EXECUTION_OK;
   }
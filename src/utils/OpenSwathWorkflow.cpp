@@ -44,6 +44,7 @@
 #include <OpenMS/FORMAT/FeatureXMLFile.h>
 #include <OpenMS/FORMAT/TransformationXMLFile.h>
 #include <OpenMS/FORMAT/SwathFile.h>
+#include <OpenMS/SYSTEM/File.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/SwathWindowLoader.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/TransitionTSVFile.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/TransitionPQPFile.h>
@@ -74,6 +75,9 @@
 #include <cassert>
 #include <limits>
 
+#include <QFile>
+#include <QCryptographicHash>
+
 // #define OPENSWATH_WORKFLOW_DEBUG
 
 using namespace OpenMS;
@@ -183,6 +187,22 @@ using namespace OpenMS;
   In addition, the extracted chromatograms can be written out using the
   @p -out_chrom parameter.
 
+  <h4> Resuming interrupted runs </h4>
+
+  With @p -checkpoint, every completed unit of work (a batch of compounds of
+  a SWATH window, see @p -batchSize) is recorded in the @p -out_osw file
+  together with its features. If the run is interrupted (e.g. on preemptible
+  cluster nodes), rerunning the identical command continues the existing
+  output file and only processes the remaining batches. The RT normalization
+  is repeated on restart. Checksums of the library, the input files and the
+  parameters (including the content of the RT normalization and SWATH window
+  files) as well as the scoring flags (@p -use_ms1_traces,
+  @p -enable_uis_scoring, @p -sonar) are stored in the output file; changing
+  any of them, the input file name or the batch size in between is detected
+  and reported as an error. The library is hashed completely at every start.
+  The input files are only hashed by their size and a sample of their
+  content, as reading multi-GB files completely would delay the start.
+
   <h4> Feature list output format </h4>
 
   The tab-separated feature output contains the following information:
@@ -465,6 +485,8 @@ protected:
     registerOutputFile_("out_chrom", "<file>", "", "Also output all computed chromatograms output in mzML (chrom.mzML) or sqMass (SQLite format)", false, true);
     setValidFormats_("out_chrom", ListUtils::create<String>("mzML,sqMass"));
 
+    registerFlag_("checkpoint", "Record the completed batches in the OSW output (-out_osw) and, if the output already exists, resume the interrupted run by skipping them. Cannot be combined with -out_chrom or -sonar. The library (-tr) is hashed completely at every start, the input files (-in) only by their size and a sample of their content.", true);
+
     // misc options
     registerDoubleOption_("min_upper_edge_dist", "<double>", 0.0, "Minimal distance to the edge to still consider a precursor, in Thomson", false, true);
     registerFlag_("sonar", "data is scanning SWATH data");
@@ -516,7 +538,7 @@ protected:
 
     registerIntOption_("batchSize", "<number>", 250, "The batch size of chromatograms to process (0 means to only have one batch, sensible values are around 250-1000)", false, true);
     setMinInt_("batchSize", 0);
-    registerIntOption_("outer_loop_threads", "<number>", -1, "How many threads should be used for the outer loop (-1 use all threads, use 4 to analyze 4 SWATH windows in memory at once).", false, true);
+    registerIntOption_("outer_loop_threads", "<number>", -1, "How many SWATH windows may be analyzed (and held in memory) at once (-1 no limit besides the number of threads). All threads work on the batches of these windows.", false, true);
 
     registerIntOption_("ms1_isotopes", "<number>", 0, "The number of MS1 isotopes used for extraction", false, true);
     setMinInt_("ms1_isotopes", 0);
@@ -629,6 +651,65 @@ protected:
     }
   }
 
+  /**
+    @brief Checksum of a (potentially very large) input file for -checkpoint
+
+    Reading multi-GB DIA files completely would delay the start of every
+    run, the checksum is computed from the file size and a bounded sample of
+    the content (the beginning, the middle and the end). The modification
+    time is not used, a file copied to another node stays the same.
+  */
+  String computeInputChecksum_(const String& filename) const
+  {
+    const qint64 sample_size = 1 << 20;
+    QCryptographicHash crypto(QCryptographicHash::Sha1);
+    QFile file(filename.toQString());
+    file.open(QFile::ReadOnly);
+    const qint64 size = file.size();
+    crypto.addData(QByteArray::number(size));
+    const qint64 starts[] = {0, size / 2 - sample_size / 2, size - sample_size};
+    for (Size i = 0; i < 3; ++i)
+    {
+      file.seek(std::max(starts[i], qint64(0)));
+      crypto.addData(file.read(sample_size));
+    }
+    return String((QString)crypto.result().toHex());
+  }
+
+  /**
+    @brief Checksum of the parameters that influence the results for -checkpoint
+
+    Covers all parameters except the input and output files (which are
+    checked separately) and those that only affect the execution (threads,
+    logging, caching). The content of the RT normalization and SWATH window
+    files is included.
+  */
+  String computeParameterChecksum_() const
+  {
+    const std::set<String> ignored = {"in", "tr", "out_features", "out_tsv", "out_osw", "out_chrom", "checkpoint",
+      "threads", "outer_loop_threads", "debug", "log", "no_progress", "ini", "instance", "write_ini", "write_ctd",
+      "profile", "profile_format", "readOptions", "tempDirectory"};
+    const StringList files = ListUtils::create<String>("tr_irt,tr_irt_nonlinear,rt_norm,swath_windows_file");
+
+    QCryptographicHash crypto(QCryptographicHash::Sha1);
+    const Param& param = getParam_();
+    for (Param::ParamIterator it = param.begin(); it != param.end(); ++it)
+    {
+      const String name = it.getName();
+      if (ignored.count(name) || name.hasPrefix("Debugging:"))
+      {
+        continue;
+      }
+      String entry = name + "=" + it->value.toString() + "\n";
+      if (ListUtils::contains(files, name) && !it->value.toString().empty())
+      {
+        entry += FileHandler::computeFileHash(it->value.toString()) + "\n";
+      }
+      crypto.addData(entry.c_str(), int(entry.size()));
+    }
+    return String((QString)crypto.result().toHex());
+  }
+
   ExitCodes main_(int, const char **) override
   {
     ///////////////////////////////////
@@ -663,6 +744,7 @@ protected:
     String swath_windows_file = getStringOption_("swath_windows_file");
 
     String out_chrom = getStringOption_("out_chrom");
+    bool checkpoint = getFlag_("checkpoint");
     bool split_file = getFlag_("split_file_input");
     bool use_emg_score = getFlag_("use_elution_model_score");
     bool force = getFlag_("force");
@@ -721,6 +803,11 @@ protected:
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
           "OSW output files can only be generated in combination with PQP input files (-tr).");
     }
+    if (checkpoint && (out_osw.empty() || !out_chrom.empty() || sonar))
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "Checkpointing (-checkpoint) requires -out_osw and cannot be combined with -out_chrom or -sonar.");
+    }
 
     // Check swath window input
     if (!swath_windows_file.empty())
@@ -787,15 +874,27 @@ protected:
     LOG_INFO << "Loaded " << transition_exp.getProteins().size() << " proteins, " <<
       transition_exp.getCompounds().size() << " compounds with " << transition_exp.getTransitions().size() << " transitions." << std::endl;
 
-    if (tr_type == FileTypes::PQP)
+    if (checkpoint && File::exists(out_osw))
+    {
+      LOG_INFO << "Continuing the existing output file " << out_osw << " (-checkpoint)." << std::endl;
+    }
+    else if (tr_type == FileTypes::PQP)
     {
       remove(out_osw.c_str());
       if (!out_osw.empty())
       {
-        std::ifstream  src(tr_file.c_str(), std::ios::binary);
-        std::ofstream  dst(out_osw.c_str(), std::ios::binary);
-
-        dst << src.rdbuf();
+        // when checkpointing, an interrupted copy may not be mistaken for a started run
+        String out_osw_copy = checkpoint ? out_osw + ".part" : out_osw;
+        {
+          std::ifstream  src(tr_file.c_str(), std::ios::binary);
+          std::ofstream  dst(out_osw_copy.c_str(), std::ios::binary);
+
+          dst << src.rdbuf();
+        }
+        if (checkpoint)
+        {
+          File::rename(out_osw_copy, out_osw);
+        }
       }
     }
 
@@ -874,6 +973,17 @@ protected:
     FeatureMap out_featureFile;
     OpenSwathTSVWriter tsvwriter(out_tsv, file_list[0], use_ms1_traces, sonar, enable_uis_scoring); // only active if filename not empty
     OpenSwathOSWWriter oswwriter(out_osw, file_list[0], use_ms1_traces, sonar, enable_uis_scoring); // only active if filename not empty
+    oswwriter.setCheckpointing(checkpoint);
+    if (checkpoint)
+    {
+      // a resumed run needs to use the same library, input files and parameters
+      String input_checksum;
+      for (Size i = 0; i < file_list.size(); ++i)
+      {
+        input_checksum += (i > 0 ? "," : "") + computeInputChecksum_(file_list[i]);
+      }
+      oswwriter.setCheckpointSources(FileHandler::computeFileHash(tr_file), input_checksum, computeParameterChecksum_());
+    }
 
     ///////////////////////////////////
     // Extract and score
@@ -56,6 +56,7 @@
 #include <OpenMS/FILTERING/TRANSFORMERS/Normalizer.h>
 
 #include <OpenMS/CHEMISTRY/TheoreticalSpectrumGenerator.h>
+#include <OpenMS/CHEMISTRY/LightPeptide.h>
 #include <OpenMS/KERNEL/Peak1D.h>
 #include <OpenMS/FORMAT/IdXMLFile.h>
 
@@ -452,6 +453,42 @@ class SimpleSearchEngine :
       Size max_peptide_length = getIntOption_("peptide:max_size");
       Size count_proteins(0), count_peptides(0);
 
+      // Precursor mass prefilter: the mass of an unmodified peptide is computed from a residue mass table
+      // (no AASequence needed). Fixed residue modifications change it by a known amount, terminal fixed
+      // and variable modifications by an amount within [min_mod_delta, max_mod_delta]. Peptides without
+      // any precursor in that range are discarded before modified AASequences are created.
+      const LightPeptide::MassTable residue_masses;
+      vector<double> fixed_residue_delta(256, 0.0);
+      double min_n_term_delta(0), max_n_term_delta(0), min_c_term_delta(0), max_c_term_delta(0);
+      for (const ResidueModification& mod : fixed_modifications)
+      {
+        const double delta = mod.getDiffMonoMass();
+        const ResidueModification::TermSpecificity term_spec = mod.getTermSpecificity();
+        if (term_spec == ResidueModification::ANYWHERE)
+        {
+          // as in ModifiedPeptideGenerator, the last matching fixed modification is applied
+          fixed_residue_delta[static_cast<unsigned char>(mod.getOrigin())] = delta;
+        }
+        else if (term_spec == ResidueModification::N_TERM || term_spec == ResidueModification::PROTEIN_N_TERM)
+        {
+          min_n_term_delta = std::min(min_n_term_delta, delta);
+          max_n_term_delta = std::max(max_n_term_delta, delta);
+        }
+        else
+        {
+          min_c_term_delta = std::min(min_c_term_delta, delta);
+          max_c_term_delta = std::max(max_c_term_delta, delta);
+        }
+      }
+      double min_var_delta(0), max_var_delta(0);
+      for (const ResidueModification& mod : variable_modifications)
+      {
+        min_var_delta = std::min(min_var_delta, mod.getDiffMonoMass());
+        max_var_delta = std::max(max_var_delta, mod.getDiffMonoMass());
+      }
+      const double min_mod_delta = min_n_term_delta + min_c_term_delta + max_variable_mods_per_peptide * min_var_delta;
+      const double max_mod_delta = max_n_term_delta + max_c_term_delta + max_variable_mods_per_peptide * max_var_delta;
+
 #ifdef _OPENMP
 #pragma omp parallel for schedule(static)
 #endif
@@ -505,6 +542,30 @@ class SimpleSearchEngine :
 #endif
           ++count_peptides;
 
+          // skip peptides for which no modified variant can match a precursor
+          {
+            const LightPeptide light_peptide(c);
+            double fixed_mass = light_peptide.getMonoWeight(residue_masses);
+            for (const char* aa = c.begin(); aa != c.end(); ++aa)
+            {
+              fixed_mass += fixed_residue_delta[static_cast<unsigned char>(*aa)];
+            }
+            double low_mass = fixed_mass + min_mod_delta;
+            double high_mass = fixed_mass + max_mod_delta;
+            if (precursor_mass_tolerance_unit_ppm) // ppm
+            {
+              low_mass -= 0.5 * low_mass * precursor_mass_tolerance * 1e-6;
+              high_mass += 0.5 * high_mass * precursor_mass_tolerance * 1e-6;
+            }
+            else // Dalton
+            {
+              low_mass -= 0.5 * precursor_mass_tolerance;
+              high_mass += 0.5 * precursor_mass_tolerance;
+            }
+            multimap<double, Size>::const_iterator low_it = multimap_mass_2_scan_index.lower_bound(low_mass);
+            if (low_it == multimap_mass_2_scan_index.end() || low_it->first > high_mass) { continue; }
+          }
+
           vector<AASequence> all_modified_peptides;
 
           // this critial section is because ResidueDB is not thread safe and new residues are created based on the PTMs
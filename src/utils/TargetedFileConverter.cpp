@@ -152,6 +152,19 @@ protected:
     //--------------------------------------------------------------------------- 
     // Start Conversion
     //--------------------------------------------------------------------------- 
+
+    // TSV to PQP is converted directly (chunk by chunk), without keeping the
+    // whole transition list in memory
+    if ((in_type == FileTypes::TSV || in_type == FileTypes::MRM) && out_type == FileTypes::PQP)
+    {
+      Param reader_parameters = getParam_().copy("algorithm:", true);
+      TransitionPQPFile pqp_writer = TransitionPQPFile();
+      pqp_writer.setLogType(log_type_);
+      pqp_writer.setParameters(reader_parameters);
+      pqp_writer.convertTSVToPQP(in.c_str(), in_type, out.c_str());
+      return EXECUTION_OK;
+    }
+
     TargetedExperiment targeted_exp;
     if (in_type == FileTypes::TSV || in_type == FileTypes::MRM)
     {